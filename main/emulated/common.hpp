@@ -8,3 +8,5 @@
 #include "common/fifo.hpp"
 #include "common/buffer.hpp"
 #include "common/memory.hpp"
+#include "common/bitmap.hpp"
+#include "common/random.hpp"
@@ -0,0 +1,248 @@
+#pragma once
+//
+// Mixed emulations for packed bit vectors
+//
+//
+
+#include <cstdint>
+#include <cstring>
+
+#include "base.hpp"
+
+
+namespace MEMU::Common {
+
+    class Bitmap
+    {
+    public:
+        constexpr static int    word_bits = 64;
+
+        constexpr static int    WordCount(int size);
+
+    private:
+        const int           size;
+        const int           word_count;
+
+        uint64_t*           words;
+
+    public:
+        Bitmap(int size);
+        Bitmap(const Bitmap& obj);
+        ~Bitmap();
+
+        int                 GetSize() const;
+        int                 GetWordCount() const;
+        bool                CheckBound(int index) const;
+
+        const uint64_t*     GetWords() const;
+        uint64_t*           GetWords();
+
+        uint64_t            GetWord(int word) const;
+        void                SetWord(int word, uint64_t value);
+
+        bool                Get(int index) const;
+        void                Set(int index, bool value = true);
+        void                Reset(int index);
+
+        void                SetRange(int begin, int end);
+
+        bool                Any() const;
+        int                 Count() const;
+        int                 FindFirstSet() const;
+        int                 FindFirstReset() const;
+
+        void                Clear();
+        void                Fill();
+
+        void                Or(const Bitmap& obj);
+        void                And(const Bitmap& obj);
+        void                AndNot(const Bitmap& obj);
+
+        void                operator=(const Bitmap& obj);
+    };
+}
+
+
+
+// class MEMU::Common::Bitmap
+namespace MEMU::Common {
+    /*
+    const int           size;
+    const int           word_count;
+
+    uint64_t*           words;
+    */
+
+    constexpr int Bitmap::WordCount(int size)
+    {
+        return (size + word_bits - 1) / word_bits;
+    }
+
+    Bitmap::Bitmap(int size)
+        : size          (size)
+        , word_count    (WordCount(size))
+        , words         (new uint64_t[WordCount(size)]())
+    { }
+
+    Bitmap::Bitmap(const Bitmap& obj)
+        : size          (obj.size)
+        , word_count    (obj.word_count)
+        , words         (new uint64_t[obj.word_count])
+    {
+        memcpy(words, obj.words, sizeof(uint64_t) * word_count);
+    }
+
+    Bitmap::~Bitmap()
+    {
+        delete[] words;
+    }
+
+    inline int Bitmap::GetSize() const
+    {
+        return size;
+    }
+
+    inline int Bitmap::GetWordCount() const
+    {
+        return word_count;
+    }
+
+    inline bool Bitmap::CheckBound(int index) const
+    {
+        return index >= 0 && index < size;
+    }
+
+    inline const uint64_t* Bitmap::GetWords() const
+    {
+        return words;
+    }
+
+    inline uint64_t* Bitmap::GetWords()
+    {
+        return words;
+    }
+
+    inline uint64_t Bitmap::GetWord(int word) const
+    {
+        return words[word];
+    }
+
+    inline void Bitmap::SetWord(int word, uint64_t value)
+    {
+        words[word] = value;
+    }
+
+    inline bool Bitmap::Get(int index) const
+    {
+        return (words[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    inline void Bitmap::Set(int index, bool value)
+    {
+        uint64_t mask = (uint64_t)1 << (index % word_bits);
+
+        if (value)
+            words[index / word_bits] |=  mask;
+        else
+            words[index / word_bits] &= ~mask;
+    }
+
+    inline void Bitmap::Reset(int index)
+    {
+        words[index / word_bits] &= ~((uint64_t)1 << (index % word_bits));
+    }
+
+    void Bitmap::SetRange(int begin, int end)
+    {
+        // Set bits in [begin, end)
+        while (begin < end)
+        {
+            int word  = begin / word_bits;
+            int shift = begin % word_bits;
+            int count = word_bits - shift < end - begin ? word_bits - shift : end - begin;
+
+            words[word] |= (count == word_bits ? ~(uint64_t)0 : (((uint64_t)1 << count) - 1)) << shift;
+
+            begin += count;
+        }
+    }
+
+    bool Bitmap::Any() const
+    {
+        for (int i = 0; i < word_count; i++)
+            if (words[i])
+                return true;
+
+        return false;
+    }
+
+    int Bitmap::Count() const
+    {
+        int count = 0;
+
+        for (int i = 0; i < word_count; i++)
+            count += __builtin_popcountll(words[i]);
+
+        return count;
+    }
+
+    int Bitmap::FindFirstSet() const
+    {
+        for (int i = 0; i < word_count; i++)
+            if (words[i])
+                return i * word_bits + __builtin_ctzll(words[i]);
+
+        return -1;
+    }
+
+    int Bitmap::FindFirstReset() const
+    {
+        for (int i = 0; i < word_count; i++)
+            if (~words[i])
+            {
+                int index = i * word_bits + __builtin_ctzll(~words[i]);
+
+                // *NOTICE: Padding bits of the last word are always treated as reset
+                return index < size ? index : -1;
+            }
+
+        return -1;
+    }
+
+    void Bitmap::Clear()
+    {
+        memset(words, 0, sizeof(uint64_t) * word_count);
+    }
+
+    void Bitmap::Fill()
+    {
+        memset(words, 0xFF, sizeof(uint64_t) * word_count);
+
+        // Keep padding bits of the last word reset
+        if (size % word_bits)
+            words[word_count - 1] &= ((uint64_t)1 << (size % word_bits)) - 1;
+    }
+
+    void Bitmap::Or(const Bitmap& obj)
+    {
+        for (int i = 0; i < word_count && i < obj.word_count; i++)
+            words[i] |= obj.words[i];
+    }
+
+    void Bitmap::And(const Bitmap& obj)
+    {
+        for (int i = 0; i < word_count && i < obj.word_count; i++)
+            words[i] &= obj.words[i];
+    }
+
+    void Bitmap::AndNot(const Bitmap& obj)
+    {
+        for (int i = 0; i < word_count && i < obj.word_count; i++)
+            words[i] &= ~obj.words[i];
+    }
+
+    void Bitmap::operator=(const Bitmap& obj)
+    {
+        memcpy(words, obj.words, sizeof(uint64_t) * (word_count < obj.word_count ? word_count : obj.word_count));
+    }
+}
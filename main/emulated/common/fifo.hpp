@@ -67,7 +67,7 @@ namespace MEMU::Common {
             void                operator=(const Iterator& obj);
         };
 
-    private:
+    protected:
         const int           size;
 
         TPayload*           memory;
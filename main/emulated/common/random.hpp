@@ -0,0 +1,217 @@
+#pragma once
+//
+// Fast pseudo-random stimulus generator (xoshiro256**, seeded by splitmix64)
+//
+//
+
+#include <cstdint>
+#include <cstddef>
+
+#include "base.hpp"
+
+
+namespace MEMU::Common {
+
+    class Random
+    {
+    private:
+        uint64_t            state[4];
+
+        static uint64_t     Rotl(uint64_t x, int k);
+
+    public:
+        static uint64_t     SplitMix64(uint64_t& x);
+
+    public:
+        Random(uint64_t seed = 0);
+        Random(const Random& obj);
+        ~Random();
+
+        void                Seed(uint64_t seed);
+        void                Jump();
+
+        uint64_t            Next();
+        uint32_t            Next32();
+        uint64_t            NextBounded(uint64_t bound);
+        uint32_t            NextBounded32(uint32_t bound);
+        bool                NextChance(uint32_t one_in);
+
+        void                Fill(uint64_t* dst, size_t count);
+        void                Fill(uint32_t* dst, size_t count);
+        void                FillBounded(uint64_t* dst, size_t count, uint64_t bound);
+        void                FillBounded(int* dst, size_t count, uint32_t bound);
+
+        void                operator=(const Random& obj);
+    };
+}
+
+
+// class MEMU::Common::Random
+namespace MEMU::Common {
+    /*
+    uint64_t            state[4];
+    */
+
+    inline uint64_t Random::Rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline uint64_t Random::SplitMix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+        return z ^ (z >> 31);
+    }
+
+    Random::Random(uint64_t seed)
+    {
+        Seed(seed);
+    }
+
+    Random::Random(const Random& obj)
+    {
+        *this = obj;
+    }
+
+    Random::~Random()
+    { }
+
+    void Random::Seed(uint64_t seed)
+    {
+        // splitmix64 expands any seed (including 0) into a non-zero xoshiro state
+        for (int i = 0; i < 4; i++)
+            state[i] = SplitMix64(seed);
+    }
+
+    void Random::Jump()
+    {
+        // Equivalent to 2^128 calls of Next(), for non-overlapping sub-streams
+        static constexpr uint64_t jump[] = {
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+        };
+
+        uint64_t s[4] = { 0, 0, 0, 0 };
+
+        for (uint64_t word : jump)
+            for (int b = 0; b < 64; b++)
+            {
+                if (word & ((uint64_t)1 << b))
+                    for (int i = 0; i < 4; i++)
+                        s[i] ^= state[i];
+
+                Next();
+            }
+
+        for (int i = 0; i < 4; i++)
+            state[i] = s[i];
+    }
+
+    inline uint64_t Random::Next()
+    {
+        uint64_t result = Rotl(state[1] * 5, 7) * 9;
+        uint64_t t      = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+
+        state[2] ^= t;
+        state[3]  = Rotl(state[3], 45);
+
+        return result;
+    }
+
+    inline uint32_t Random::Next32()
+    {
+        return (uint32_t)(Next() >> 32);
+    }
+
+    inline uint64_t Random::NextBounded(uint64_t bound)
+    {
+        // Uniform in [0, bound), full 64-bit range when bound is 0
+        if (!bound)
+            return Next();
+
+        // Lemire's multiply-shift with rejection of the biased low fraction
+        unsigned __int128 m = (unsigned __int128) Next() * bound;
+
+        if ((uint64_t) m < bound)
+        {
+            uint64_t threshold = -bound % bound;
+
+            while ((uint64_t) m < threshold)
+                m = (unsigned __int128) Next() * bound;
+        }
+
+        return (uint64_t)(m >> 64);
+    }
+
+    inline uint32_t Random::NextBounded32(uint32_t bound)
+    {
+        if (!bound)
+            return Next32();
+
+        uint64_t m = (uint64_t) Next32() * bound;
+
+        if ((uint32_t) m < bound)
+        {
+            uint32_t threshold = -bound % bound;
+
+            while ((uint32_t) m < threshold)
+                m = (uint64_t) Next32() * bound;
+        }
+
+        return (uint32_t)(m >> 32);
+    }
+
+    inline bool Random::NextChance(uint32_t one_in)
+    {
+        return !NextBounded32(one_in);
+    }
+
+    void Random::Fill(uint64_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = Next();
+    }
+
+    void Random::Fill(uint32_t* dst, size_t count)
+    {
+        // Two 32-bit outputs per 64-bit step
+        size_t i = 0;
+
+        for (; i + 1 < count; i += 2)
+        {
+            uint64_t value = Next();
+
+            dst[i]     = (uint32_t)(value >> 32);
+            dst[i + 1] = (uint32_t) value;
+        }
+
+        if (i < count)
+            dst[i] = Next32();
+    }
+
+    void Random::FillBounded(uint64_t* dst, size_t count, uint64_t bound)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = NextBounded(bound);
+    }
+
+    void Random::FillBounded(int* dst, size_t count, uint32_t bound)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = (int) NextBounded32(bound);
+    }
+
+    void Random::operator=(const Random& obj)
+    {
+        for (int i = 0; i < 4; i++)
+            state[i] = obj.state[i];
+    }
+}
@@ -5,6 +5,7 @@
 //
 
 #include <list>
+#include <vector>
 #include <cstring>
 #include <bitset>
 
@@ -73,75 +74,60 @@ namespace MEMU::Core::Issue {
             void    Apply(Entry& entry) const;
         };
 
-        class CheckpointEntry {
-        private:
-            bool    busy;
-
-        public:
-            CheckpointEntry();
-            CheckpointEntry(const CheckpointEntry& obj);
-            ~CheckpointEntry();
-
-            bool    GetBusy() const;
-            void    SetBusy(bool busy);
-
-            void    Clear();
-
-            void    Allocate(const Entry& entry);
-            void    Restore(Entry& entry) const;
-        };
-
         class Checkpoint {
         private:
-            CheckpointEntry*    entries;
+            MEMU::Common::Bitmap    busy;   // [prf_size]
         
         public:
-            Checkpoint();
+            Checkpoint(int size);
             Checkpoint(const Checkpoint& obj);
             ~Checkpoint();
 
-            int                     GetSize() const;
-            bool                    CheckBound(int index) const;
+            int         GetSize() const;
+            bool        CheckBound(int index) const;
 
-            const CheckpointEntry&  GetEntry(int index) const;
-            CheckpointEntry&        GetEntry(int index);
-            void                    SetEntry(int index, const CheckpointEntry& entry);
+            bool        GetBusy(int index) const;
+            void        SetBusy(int index, bool busy);
 
-            void                    Land(int index);
+            void        Land(int index);
+            void        Land(const MEMU::Common::Bitmap& landed);
 
-            void                    Clear();
+            void        Clear();
 
-            void                    Allocate(const Entry* entries);
-            void                    Restore(Entry* entries) const;
+            void        Allocate(const MEMU::Common::Bitmap& busy);
+            void        Restore(MEMU::Common::Bitmap& busy) const;
 
-            void                    operator=(const Checkpoint& obj);
+            void        operator=(const Checkpoint& obj);
         };
 
     private:
-        constexpr static int    prf_size                = EMULATED_PRF_SIZE;
+        const int               prf_size;
 
-        constexpr static int    gc_count                = EMULATED_SCOREBOARD_GC_COUNT;
+        const int               gc_count;
 
-        Entry*              entries;        // [prf_size]
+        MEMU::Common::Bitmap    busy;       // [prf_size]
 
-        EntryModification*  modification;   // [prf_size]
+        MEMU::Common::Bitmap    forward;    // [prf_size]
 
-        Checkpoint*         checkpoints;    // [gc_count]
+        MEMU::Common::Bitmap    landed;     // [prf_size]
 
-        int                 checkpoint_allocate;
+        EntryModification*      modification;   // [prf_size]
 
-        int                 checkpoint_restore;
+        vector<Checkpoint>      checkpoints;    // [gc_count]
+
+        int                     checkpoint_allocate;
+
+        int                     checkpoint_restore;
 
     public:
-        Scoreboard();
+        Scoreboard(const CoreGeometry& geometry = CoreGeometry());
         Scoreboard(const Scoreboard& obj);
         ~Scoreboard();
 
         int                 GetSize() const;
         bool                CheckBound(int index) const;
 
-        const Entry&        GetEntry(int index) const;
-        Entry&              GetEntry(int index);
+        Entry               GetEntry(int index) const;
         void                SetEntry(int index, const Entry& entry);
 
         bool                IsBusy(int index) const;
@@ -234,18 +220,18 @@ namespace MEMU::Core::Issue {
         };
 
     private:
-        constexpr static int    rat_size     = EMULATED_RAT_SIZE;
+        const int               rat_size;
 
         Entry*                  entries      /*[rat_size]*/;
 
         EntryModification*      modification /*[rat_size]*/;
 
     public:
-        ShadowRegisterAliasTable();
+        ShadowRegisterAliasTable(const CoreGeometry& geometry = CoreGeometry());
         ShadowRegisterAliasTable(const ShadowRegisterAliasTable& obj);
         ~ShadowRegisterAliasTable();
 
-        constexpr int       GetSize() const;
+        int                 GetSize() const;
 
         const Entry&        GetEntry(int index) const;
         void                SetEntry(int index, const Entry& entry);
@@ -325,59 +311,41 @@ namespace MEMU::Core::Issue {
             void    Apply(Entry& dst) const;
         };
 
-        class CheckpointEntry {
-        private:
-            bool    V;
-
-        public:
-            CheckpointEntry();
-            CheckpointEntry(const CheckpointEntry& obj);
-            ~CheckpointEntry();
-
-            bool    GetValid() const;
-            void    SetValid(bool V);
-
-            void    Allocate(const Entry& entry);
-            void    Restore(Entry& entry) const;
-        };
-
         class Checkpoint {
         private:
-            constexpr static int    gc_size      = EMULATED_PRF_SIZE;
-
-            CheckpointEntry*    entries;
+            MEMU::Common::Bitmap    valid;  // [rat_size]
 
         public:
-            Checkpoint();
+            Checkpoint(int size);
             Checkpoint(const Checkpoint& obj);
             ~Checkpoint();
 
-            int                     GetSize() const;
-            bool                    CheckBound(int index) const;
+            int         GetSize() const;
+            bool        CheckBound(int index) const;
 
-            const CheckpointEntry&  GetEntry(int index) const;
-            CheckpointEntry&        GetEntry(int index);
-            void                    SetEntry(int index, const CheckpointEntry& entry);
+            bool        GetValid(int index) const;
+            void        SetValid(int index, bool V);
 
-            bool                    GetValid(int index) const;
-            void                    SetValid(int index, bool V);
+            void        Clear();
 
-            void                    Allocate(const Entry* entries);
-            void                    Restore(Entry* entries) const;
+            void        Allocate(const MEMU::Common::Bitmap& valid);
+            void        Restore(MEMU::Common::Bitmap& valid) const;
 
-            void                    operator=(const Checkpoint& obj);
+            void        operator=(const Checkpoint& obj);
         };
 
     private:
-        constexpr static int    rat_size     = EMULATED_RAT_SIZE;
+        const int               rat_size;
 
-        constexpr static int    gc_count     = EMULATED_RAT_GC_COUNT;
+        const int               gc_count;
 
         Entry*                  entries      /*[rat_size]*/;
 
+        MEMU::Common::Bitmap    valid        /*[rat_size]*/;
+
         EntryModification*      modification /*[rat_size]*/; 
 
-        Checkpoint*             checkpoints  /*[gc_count]*/;
+        vector<Checkpoint>      checkpoints  /*[gc_count]*/;
 
         const Scoreboard*       scoreboard;
 
@@ -393,14 +361,13 @@ namespace MEMU::Core::Issue {
         bool                Touch(bool FV, int FID, int ARF, int* PRF);
 
     public:
-        RegisterAliasTable(const Scoreboard* scoreboard);
+        RegisterAliasTable(const Scoreboard* scoreboard, const CoreGeometry& geometry = CoreGeometry());
         RegisterAliasTable(const RegisterAliasTable& obj);
         ~RegisterAliasTable();
 
-        constexpr int           GetSize() const;
+        int                     GetSize() const;
 
-        const Entry&            GetEntry(int index) const;
-        Entry&                  GetEntry(int index);
+        Entry                   GetEntry(int index) const;
         void                    SetEntry(int index, const Entry& entry);
 
         const Scoreboard*       GetScoreboard() const;
@@ -410,6 +377,7 @@ namespace MEMU::Core::Issue {
 
         void                    Clear();
         bool                    IsFull() const;
+        int                     GetFreeCount() const;
 
         bool                    Touch(int FID, int ARF, int* PRF = 0);
         void                    Writeback(int PRF);
@@ -496,6 +464,8 @@ namespace MEMU::Core::Issue {
         : modified          (false)
         , modified_busy     (false)
         , modified_forward  (false)
+        , modified_land     (false)
+        , modified_takeoff  (false)
         , busy              (false)
         , forward           (false)
     { }
@@ -504,6 +474,8 @@ namespace MEMU::Core::Issue {
         : modified          (obj.modified)
         , modified_busy     (obj.modified_busy)
         , modified_forward  (obj.modified_forward)
+        , modified_land     (obj.modified_land)
+        , modified_takeoff  (obj.modified_takeoff)
         , busy              (obj.busy)
         , forward           (obj.forward)
     { }
@@ -577,81 +549,32 @@ namespace MEMU::Core::Issue {
         if (IsBusyModified())
             entry.SetBusy(busy);
 
-        if (!IsForwardModified())
+        if (IsForwardModified())
             entry.SetForward(forward);
     }
 }
 
 
-// class MEMU::Core::Issue::Scoreboard::CheckpointEntry
-namespace MEMU::Core::Issue {
-    /*
-    bool    busy;
-    */
-
-    Scoreboard::CheckpointEntry::CheckpointEntry()
-        : busy  (false)
-    { }
-
-    Scoreboard::CheckpointEntry::CheckpointEntry(const CheckpointEntry& obj)
-        : busy  (obj.busy)
-    { }
-
-    Scoreboard::CheckpointEntry::~CheckpointEntry()
-    { }
-
-    inline bool Scoreboard::CheckpointEntry::GetBusy() const
-    {
-        return busy;
-    }
-
-    inline void Scoreboard::CheckpointEntry::SetBusy(bool busy)
-    {
-        this->busy = busy;
-    }
-
-    inline void Scoreboard::CheckpointEntry::Clear()
-    {
-        busy = false;
-    }
-
-    inline void Scoreboard::CheckpointEntry::Allocate(const Entry& entry)
-    {
-        busy = entry.IsBusy();
-    }
-
-    inline void Scoreboard::CheckpointEntry::Restore(Entry& entry) const
-    {
-        entry.SetBusy(busy);
-    }
-}
-
-
 // class MEMU::Core::Issue::Scoreboard::Checkpoint
 namespace MEMU::Core::Issue {
     /*
-    CheckpointEntry*    entries;
+    MEMU::Common::Bitmap    busy;
     */
 
-    Scoreboard::Checkpoint::Checkpoint()
-        : entries   (new CheckpointEntry[prf_size]())
+    Scoreboard::Checkpoint::Checkpoint(int size)
+        : busy  (size)
     { }
 
     Scoreboard::Checkpoint::Checkpoint(const Checkpoint& obj)
-        : entries   (new CheckpointEntry[prf_size])
-    { 
-        for (int i = 0; i < prf_size; i++)
-            entries[i] = obj.entries[i];
-    }
+        : busy  (obj.busy)
+    { }
 
     Scoreboard::Checkpoint::~Checkpoint()
-    {
-        delete[] entries;
-    }
+    { }
 
     inline int Scoreboard::Checkpoint::GetSize() const
     {
-        return prf_size;
+        return busy.GetSize();
     }
 
     inline bool Scoreboard::Checkpoint::CheckBound(int index) const
@@ -659,48 +582,44 @@ namespace MEMU::Core::Issue {
         return index >= 0 && index < GetSize();
     }
 
-    inline const Scoreboard::CheckpointEntry& Scoreboard::Checkpoint::GetEntry(int index) const
+    inline bool Scoreboard::Checkpoint::GetBusy(int index) const
     {
-        return entries[index];
+        return busy.Get(index);
     }
 
-    inline Scoreboard::CheckpointEntry& Scoreboard::Checkpoint::GetEntry(int index)
+    inline void Scoreboard::Checkpoint::SetBusy(int index, bool busy)
     {
-        return entries[index];
+        this->busy.Set(index, busy);
     }
 
-    inline void Scoreboard::Checkpoint::SetEntry(int index, const CheckpointEntry& entry)
+    inline void Scoreboard::Checkpoint::Land(int index)
     {
-        entries[index] = entry;
+        busy.Reset(index);
     }
 
-    inline void Scoreboard::Checkpoint::Land(int index)
+    inline void Scoreboard::Checkpoint::Land(const MEMU::Common::Bitmap& landed)
     {
-        entries[index].SetBusy(false);
+        busy.AndNot(landed);
     }
 
-    void Scoreboard::Checkpoint::Clear()
+    inline void Scoreboard::Checkpoint::Clear()
     {
-        for (int i = 0; i < GetSize(); i++)
-            entries[i].Clear();
+        busy.Clear();
     }
 
-    void Scoreboard::Checkpoint::Allocate(const Entry* entries)
+    inline void Scoreboard::Checkpoint::Allocate(const MEMU::Common::Bitmap& busy)
     {
-        for (int i = 0; i < GetSize(); i++)
-            this->entries[i].Allocate(entries[i]);
+        this->busy = busy;
     }
 
-    void Scoreboard::Checkpoint::Restore(Entry* entries) const
+    inline void Scoreboard::Checkpoint::Restore(MEMU::Common::Bitmap& busy) const
     {
-        for (int i = 0; i < GetSize(); i++)
-            this->entries[i].Restore(entries[i]);
+        busy = this->busy;
     }
 
-    void Scoreboard::Checkpoint::operator=(const Checkpoint& obj)
+    inline void Scoreboard::Checkpoint::operator=(const Checkpoint& obj)
     {
-        for (int i = 0; i < GetSize() && i < obj.GetSize(); i++)
-            this->entries[i] = obj.entries[i];
+        busy = obj.busy;
     }
 }
 
@@ -708,43 +627,55 @@ namespace MEMU::Core::Issue {
 // class MEMU::Core::Issue::Scoreboard
 namespace MEMU::Core::Issue {
     /*
-    constexpr static int    prf_size                = EMULATED_PRF_SIZE;
+    const int               prf_size;
+
+    const int               gc_count;
 
-    constexpr static int    gc_count                = EMULATED_SCOREBOARD_GC_COUNT;
+    MEMU::Common::Bitmap    busy;
 
-    Entry*              entries;
+    MEMU::Common::Bitmap    forward;
 
-    EntryModification*  modification;
+    MEMU::Common::Bitmap    landed;
+
+    EntryModification*      modification;
+
+    vector<Checkpoint>      checkpoints;
+
+    int                     checkpoint_allocate;
+
+    int                     checkpoint_restore;
     */
 
-    Scoreboard::Scoreboard()
-        : entries               (new Entry[prf_size]())
+    Scoreboard::Scoreboard(const CoreGeometry& geometry)
+        : prf_size              (geometry.GetPRFSize())
+        , gc_count              (geometry.GetScoreboardGCCount())
+        , busy                  (prf_size)
+        , forward               (prf_size)
+        , landed                (prf_size)
         , modification          (new EntryModification[prf_size]())
-        , checkpoints           (new Checkpoint[gc_count]())
+        , checkpoints           (gc_count, Checkpoint(prf_size))
         , checkpoint_allocate   (-1)
         , checkpoint_restore    (-1)
     { }
 
     Scoreboard::Scoreboard(const Scoreboard& obj)
-        : entries               (new Entry[prf_size])
-        , modification          (new EntryModification[prf_size])
-        , checkpoints           (new Checkpoint[gc_count])
+        : prf_size              (obj.prf_size)
+        , gc_count              (obj.gc_count)
+        , busy                  (obj.busy)
+        , forward               (obj.forward)
+        , landed                (obj.landed)
+        , modification          (new EntryModification[obj.prf_size])
+        , checkpoints           (obj.checkpoints)
         , checkpoint_allocate   (-1)
         , checkpoint_restore    (-1)
     { 
         for (int i = 0; i < prf_size; i++)
-        {
-            entries[i]      = obj.entries[i];
             modification[i] = obj.modification[i];
-            checkpoints[i]  = obj.checkpoints[i];
-        }
     }
 
     Scoreboard::~Scoreboard()
     { 
-        delete[] entries;
         delete[] modification;
-        delete[] checkpoints;
     }
 
     inline int Scoreboard::GetSize() const
@@ -757,29 +688,30 @@ namespace MEMU::Core::Issue {
         return index >= 0 && index < GetSize();
     }
 
-    inline const Scoreboard::Entry& Scoreboard::GetEntry(int index) const
+    inline Scoreboard::Entry Scoreboard::GetEntry(int index) const
     {
-        return entries[index];
-    }
+        Entry entry;
 
-    inline Scoreboard::Entry& Scoreboard::GetEntry(int index)
-    {
-        return entries[index];
+        entry.SetBusy   (busy.Get(index));
+        entry.SetForward(forward.Get(index));
+
+        return entry;
     }
 
     inline void Scoreboard::SetEntry(int index, const Entry& entry)
     {
-        entries[index] = entry;
+        busy.Set   (index, entry.IsBusy());
+        forward.Set(index, entry.IsForward());
     }
 
     inline bool Scoreboard::IsBusy(int index) const
     {
-        return entries[index].IsBusy();
+        return busy.Get(index);
     }
 
     inline bool Scoreboard::IsForward(int index) const
     {
-        return entries[index].IsForward();
+        return forward.Get(index);
     }
 
     inline void Scoreboard::Land(int index)
@@ -850,37 +782,53 @@ namespace MEMU::Core::Issue {
 
     void Scoreboard::Clear()
     {
-        for (int i = 0; i < GetSize(); i++)
-            entries[i].Clear();
+        busy.Clear();
+        forward.Clear();
     }
 
     void Scoreboard::Eval()
     {
         // checkpoint allocate
         if (checkpoint_allocate != -1)
-            checkpoints[checkpoint_allocate].Allocate(entries);
+            checkpoints[checkpoint_allocate].Allocate(busy);
+
+        // Clear forward flag at every clock cycle
+        // *NOTE: Data in forwarding network only holds for a cycle
+        forward.Clear();
+
+        bool land = false;
 
         for (int i = 0; i < GetSize(); i++)
         {
-            // Clear forward flag at every clock cycle
-            // *NOTE: Data in forwarding network only holds for a cycle
-            entries[i].SetForward(false);
-
-            //
             if (modification[i].IsModified())
             {
-                modification[i].Apply(entries[i]);
+                Entry entry = GetEntry(i);
 
-                // Checkpoint write-through on PRF land
+                modification[i].Apply(entry);
+
+                SetEntry(i, entry);
+
+                // Collect landed PRFs for checkpoint write-through
                 if (modification[i].IsLandModified())
-                    for (int j = 0; j < GetCheckpointCount(); j++)
-                        checkpoints[j].Land(i);
+                {
+                    landed.Set(i);
+                    land = true;
+                }
             }
         }
 
+        // Checkpoint write-through on PRF land
+        if (land)
+        {
+            for (int j = 0; j < GetCheckpointCount(); j++)
+                checkpoints[j].Land(landed);
+
+            landed.Clear();
+        }
+
         // checkpoint restore
         if (checkpoint_restore != -1)
-            checkpoints[checkpoint_restore].Restore(entries);
+            checkpoints[checkpoint_restore].Restore(busy);
 
         ResetInput();
     }
@@ -1085,72 +1033,26 @@ namespace MEMU::Core::Issue {
 }
 
 
-// class MEMU::Core::Issue::RegisterAliasTable::CheckpointEntry
-namespace MEMU::Core::Issue {
-    /*
-    bool    V;
-    */
-
-    RegisterAliasTable::CheckpointEntry::CheckpointEntry()
-        : V (false)
-    { }
-
-    RegisterAliasTable::CheckpointEntry::CheckpointEntry(const CheckpointEntry& obj)
-        : V (obj.V)
-    { }
-
-    RegisterAliasTable::CheckpointEntry::~CheckpointEntry()
-    { }
-
-    inline bool RegisterAliasTable::CheckpointEntry::GetValid() const
-    {
-        return V;
-    }
-
-    inline void RegisterAliasTable::CheckpointEntry::SetValid(bool V)
-    {
-        this->V = V;
-    }
-
-    inline void RegisterAliasTable::CheckpointEntry::Allocate(const Entry& entry)
-    {
-        V = entry.GetValid();
-    }
-
-    inline void RegisterAliasTable::CheckpointEntry::Restore(Entry& entry) const
-    {
-        entry.SetValid(V);
-    }
-}
-
-
 // class MEMU::Core::Issue::RegisterAliasTable::Checkpoint
 namespace MEMU::Core::Issue {
     /*
-    constexpr static int    gc_size;
-
-    CheckpointEntry*    entries;
+    MEMU::Common::Bitmap    valid;
     */
 
-    RegisterAliasTable::Checkpoint::Checkpoint()
-        : entries   (new CheckpointEntry[gc_size]())
+    RegisterAliasTable::Checkpoint::Checkpoint(int size)
+        : valid (size)
     { }
 
     RegisterAliasTable::Checkpoint::Checkpoint(const Checkpoint& obj)
-        : entries   (new CheckpointEntry[gc_size])
-    {
-        for (int i = 0; i < gc_size; i++)
-            entries[i] = obj.entries[i];
-    }
+        : valid (obj.valid)
+    { }
 
     RegisterAliasTable::Checkpoint::~Checkpoint()
-    {
-        delete[] entries;
-    }
+    { }
 
     inline int RegisterAliasTable::Checkpoint::GetSize() const
     {
-        return gc_size;
+        return valid.GetSize();
     }
 
     inline bool RegisterAliasTable::Checkpoint::CheckBound(int index) const
@@ -1158,47 +1060,34 @@ namespace MEMU::Core::Issue {
         return index >= 0 && index < GetSize();
     }
 
-    inline const RegisterAliasTable::CheckpointEntry& RegisterAliasTable::Checkpoint::GetEntry(int index) const
-    {
-        return entries[index];
-    }
-
-    inline RegisterAliasTable::CheckpointEntry& RegisterAliasTable::Checkpoint::GetEntry(int index)
-    {
-        return entries[index];
-    }
-
-    inline void RegisterAliasTable::Checkpoint::SetEntry(int index, const CheckpointEntry& entry)
+    inline bool RegisterAliasTable::Checkpoint::GetValid(int index) const
     {
-        entries[index] = entry;
+        return valid.Get(index);
     }
 
-    inline bool RegisterAliasTable::Checkpoint::GetValid(int index) const
+    inline void RegisterAliasTable::Checkpoint::SetValid(int index, bool V)
     {
-        return entries[index].GetValid();
+        valid.Set(index, V);
     }
 
-    inline void RegisterAliasTable::Checkpoint::SetValid(int index, bool V)
+    inline void RegisterAliasTable::Checkpoint::Clear()
     {
-        entries[index].SetValid(V);
+        valid.Clear();
     }
 
-    void RegisterAliasTable::Checkpoint::Allocate(const Entry* entries)
+    inline void RegisterAliasTable::Checkpoint::Allocate(const MEMU::Common::Bitmap& valid)
     {
-        for (int i = 0; i < GetSize(); i++)
-            this->entries[i].Allocate(entries[i]);
+        this->valid = valid;
     }
 
-    void RegisterAliasTable::Checkpoint::Restore(Entry* entries) const
+    inline void RegisterAliasTable::Checkpoint::Restore(MEMU::Common::Bitmap& valid) const
     {
-        for (int i = 0; i < GetSize(); i++)
-            this->entries[i].Restore(entries[i]);
+        valid = this->valid;
     }
 
-    void RegisterAliasTable::Checkpoint::operator=(const Checkpoint& obj)
+    inline void RegisterAliasTable::Checkpoint::operator=(const Checkpoint& obj)
     {
-        for (int i = 0; i < GetSize() && i < obj.GetSize(); i++)
-            this->entries[i] = obj.entries[i];
+        valid = obj.valid;
     }
 }
 
@@ -1206,15 +1095,17 @@ namespace MEMU::Core::Issue {
 // class MEMU::Core::Issue::RegisterAliasTable
 namespace MEMU::Core::Issue {
     /*
-    constexpr static int    rat_size     = EMULATED_RAT_SIZE;
+    const int               rat_size;
 
-    constexpr static int    gc_size      = EMULATED_RAT_GC_SIZE;
+    const int               gc_count;
 
     Entry*                  entries;      // [rat_size]
 
+    MEMU::Common::Bitmap    valid;        // [rat_size], holds V bits of entries
+
     EntryModification*      modification; // [rat_size]
 
-    Checkpoint*             checkpoints;   // [gc_size]
+    vector<Checkpoint>      checkpoints;  // [gc_count]
 
     const Scoreboard*       scoreboard;
 
@@ -1222,10 +1113,13 @@ namespace MEMU::Core::Issue {
     int                     checkpoint_restore;
     */
 
-    RegisterAliasTable::RegisterAliasTable(const Scoreboard* scoreboard)
-        : entries               (new Entry[rat_size]())
+    RegisterAliasTable::RegisterAliasTable(const Scoreboard* scoreboard, const CoreGeometry& geometry)
+        : rat_size              (geometry.GetRATSize())
+        , gc_count              (geometry.GetRATGCCount())
+        , entries               (new Entry[rat_size]())
+        , valid                 (rat_size)
         , modification          (new EntryModification[rat_size]())
-        , checkpoints           (new Checkpoint[gc_count]())
+        , checkpoints           (gc_count, Checkpoint(rat_size))
         , scoreboard            (scoreboard)
         , checkpoint_allocate   (-1)
         , checkpoint_restore    (-1)
@@ -1235,9 +1129,12 @@ namespace MEMU::Core::Issue {
     }    
 
     RegisterAliasTable::RegisterAliasTable(const RegisterAliasTable& obj)
-        : entries               (new Entry[rat_size])
-        , modification          (new EntryModification[rat_size])
-        , checkpoints           (new Checkpoint[gc_count])
+        : rat_size              (obj.rat_size)
+        , gc_count              (obj.gc_count)
+        , entries               (new Entry[obj.rat_size])
+        , valid                 (obj.valid)
+        , modification          (new EntryModification[obj.rat_size])
+        , checkpoints           (obj.checkpoints)
         , scoreboard            (obj.scoreboard)
         , checkpoint_allocate   (obj.checkpoint_allocate)
         , checkpoint_restore    (obj.checkpoint_restore)
@@ -1247,38 +1144,33 @@ namespace MEMU::Core::Issue {
             entries[i]      = obj.entries[i];
             modification[i] = obj.modification[i];
         }
-
-        for (int i = 0; i < gc_count; i++)
-        {
-            checkpoints[i] = obj.checkpoints[i];
-        }
     }
     
     RegisterAliasTable::~RegisterAliasTable()
     {
         delete[] entries;
         delete[] modification;
-        delete[] checkpoints;
     }
 
-    constexpr int RegisterAliasTable::GetSize() const
+    inline int RegisterAliasTable::GetSize() const
     {
         return rat_size;
     }
 
-    inline const RegisterAliasTable::Entry& RegisterAliasTable::GetEntry(int index) const
+    inline RegisterAliasTable::Entry RegisterAliasTable::GetEntry(int index) const
     {
-        return entries[index];
-    }
+        Entry entry(entries[index]);
 
-    inline RegisterAliasTable::Entry& RegisterAliasTable::GetEntry(int index)
-    {
-        return entries[index];
+        entry.SetValid(valid.Get(index));
+
+        return entry;
     }
 
     inline void RegisterAliasTable::SetEntry(int index, const Entry& entry)
     {
         entries[index] = entry;
+
+        valid.Set(index, entry.GetValid());
     }
 
     inline const Scoreboard* RegisterAliasTable::GetScoreboard() const
@@ -1298,7 +1190,7 @@ namespace MEMU::Core::Issue {
 
         // PRF Query CAM
         for (int i = 0; i < GetSize(); i++)
-            if (entries[i].GetValid() && (entries[i].GetARF() == arf))
+            if (valid.Get(i) && (entries[i].GetARF() == arf))
                 return entries[i].GetPRF();
 
         return -1;
@@ -1311,6 +1203,8 @@ namespace MEMU::Core::Issue {
             entries[i].Clear();
             entries[i].SetPRF(i);
         }
+
+        valid.Clear();
     }
 
     bool RegisterAliasTable::IsFull() const
@@ -1322,6 +1216,17 @@ namespace MEMU::Core::Issue {
         return true;
     }
 
+    int RegisterAliasTable::GetFreeCount() const
+    {
+        int count = 0;
+
+        for (int i = 0; i < GetSize(); i++)
+            if (!entries[i].GetNRA())
+                count++;
+
+        return count;
+    }
+
     int RegisterAliasTable::GetNextEntry() const
     {
         // Selection tree.
@@ -1343,7 +1248,7 @@ namespace MEMU::Core::Issue {
         // Invalidate all other same-ARF entries.
         // Should be implemented with a CAM in actual circuit.
         for (int i = 0; i < GetSize(); i++)
-            if (entries[i].GetValid() && entries[i].GetARF() == ARF)
+            if (valid.Get(i) && entries[i].GetARF() == ARF)
             {
                 modification[i].SetValid(false);
 
@@ -1392,7 +1297,7 @@ namespace MEMU::Core::Issue {
         for (int i = 0; i < GetSize(); i++)
             if (entries[i].GetARF() == ARF)
             {
-                if (!invalidated && entries[i].GetValid())
+                if (!invalidated && valid.Get(i))
                 {
                     modification[i].SetValid(false);
                     invalidated = true;
@@ -1485,18 +1390,24 @@ namespace MEMU::Core::Issue {
     {
         // Checkpoint allocate
         if (checkpoint_allocate != -1)
-            checkpoints[checkpoint_allocate].Allocate(entries);
+            checkpoints[checkpoint_allocate].Allocate(valid);
 
         // Write entries
         for (int i = 0; i < GetSize(); i++)
         {
             if (modification[i].IsModified())
-                modification[i].Apply(entries[i]);
+            {
+                Entry entry = GetEntry(i);
+
+                modification[i].Apply(entry);
+
+                SetEntry(i, entry);
+            }
         }
 
         // Checkpoint restore
         if (checkpoint_restore != -1)
-            checkpoints[checkpoint_restore].Restore(entries);
+            checkpoints[checkpoint_restore].Restore(valid);
 
         //
         ResetInput();
@@ -1705,15 +1616,16 @@ namespace MEMU::Core::Issue {
 // class MEMU::Core::Issue::ShadowRegisterAliasTable
 namespace MEMU::Core::Issue {
     /*
-    constexpr static int    rat_size     = EMULATED_RAT_SIZE;
+    const int               rat_size;
 
     Entry*                  entries;
 
     EntryModification*      modification;
     */
 
-    ShadowRegisterAliasTable::ShadowRegisterAliasTable()
-        : entries       (new Entry[rat_size]())
+    ShadowRegisterAliasTable::ShadowRegisterAliasTable(const CoreGeometry& geometry)
+        : rat_size      (geometry.GetRATSize())
+        , entries       (new Entry[rat_size]())
         , modification  (new EntryModification[rat_size]())
     { 
         for (int i = 0; i < rat_size; i++)
@@ -1721,8 +1633,9 @@ namespace MEMU::Core::Issue {
     }
 
     ShadowRegisterAliasTable::ShadowRegisterAliasTable(const ShadowRegisterAliasTable& obj)
-        : entries       (new Entry[rat_size])
-        , modification  (new EntryModification[rat_size])
+        : rat_size      (obj.rat_size)
+        , entries       (new Entry[obj.rat_size])
+        , modification  (new EntryModification[obj.rat_size])
     {
         for (int i = 0; i < rat_size; i++)
         {
@@ -1737,7 +1650,7 @@ namespace MEMU::Core::Issue {
         delete[] modification;
     }
 
-    constexpr int ShadowRegisterAliasTable::GetSize() const
+    inline int ShadowRegisterAliasTable::GetSize() const
     {
         return rat_size;
     }
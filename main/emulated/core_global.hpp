@@ -130,23 +130,38 @@ namespace MEMU::Core {
         : public MEMU::Common::FIFO<fgr_t>
     {
     private:
-        static constexpr int    size = EMULATED_GC_COUNT;
+        fgr_t*          transfer;       // [size]
+        int             transfer_begin;
+        int             transfer_count;
 
     public:
-        GlobalCheckpointWALK();
+        GlobalCheckpointWALK(const CoreGeometry& geometry = CoreGeometry());
         GlobalCheckpointWALK(const GlobalCheckpointWALK& obj);
         ~GlobalCheckpointWALK();
+
+        fgr_t*          GetTransferBuffer();
+        void            Transfer(int begin, int count);
+
+        virtual void    Eval() override;
     };
 
     //
     class GlobalCheckpointTable 
         : public MEMU::Common::FIFO<GlobalCheckpointTableEntry>
     {
+    public:
+        constexpr static int    fgr_space = 1 << (8 * sizeof(fgr_t));
+
     private:
-        static constexpr int    size = EMULATED_GC_COUNT;
+        int*                    fgr_slots;      // [fgr_space], -1 for no slot
+        MEMU::Common::Bitmap    valid;          // [size]
+        MEMU::Common::Bitmap    invalidating;   // [size]
+
+        void            Unindex(int index);
+        void            UnindexAll();
 
     public:
-        GlobalCheckpointTable();
+        GlobalCheckpointTable(const CoreGeometry& geometry = CoreGeometry());
         GlobalCheckpointTable(const GlobalCheckpointTable& obj);
         ~GlobalCheckpointTable();
 
@@ -154,6 +169,10 @@ namespace MEMU::Core {
         bool            PopFGR();
 
         bool            RestoreFGR(fgr_t FGR, int* GCA, GlobalCheckpointWALK* WALK = nullptr);
+
+        void            Clear();
+
+        virtual void    Eval() override;
     };
 }
 
@@ -528,31 +547,112 @@ namespace MEMU::Core {
 
 // class MEMU::Core::GlobalCheckpointWALK
 namespace MEMU::Core {
-    GlobalCheckpointWALK::GlobalCheckpointWALK()
-        : FIFO  (size)
+    /*
+    fgr_t*          transfer;
+    int             transfer_begin;
+    int             transfer_count;
+    */
+
+    GlobalCheckpointWALK::GlobalCheckpointWALK(const CoreGeometry& geometry)
+        : FIFO              (geometry.GetGCCount())
+        , transfer          (new fgr_t[geometry.GetGCCount()]())
+        , transfer_begin    (0)
+        , transfer_count    (0)
     { }
 
     GlobalCheckpointWALK::GlobalCheckpointWALK(const GlobalCheckpointWALK& obj)
-        : FIFO  (obj)
-    { }
+        : FIFO              (obj)
+        , transfer          (new fgr_t[obj.GetSize()])
+        , transfer_begin    (obj.transfer_begin)
+        , transfer_count    (obj.transfer_count)
+    {
+        memcpy(transfer, obj.transfer, sizeof(fgr_t) * GetSize());
+    }
 
     GlobalCheckpointWALK::~GlobalCheckpointWALK()
-    { }
+    {
+        delete[] transfer;
+    }
+
+    inline fgr_t* GlobalCheckpointWALK::GetTransferBuffer()
+    {
+        return transfer;
+    }
+
+    inline void GlobalCheckpointWALK::Transfer(int begin, int count)
+    {
+        // *NOTICE: Slots [begin, begin + count) of transfer buffer (wrapped around) are
+        //          written into WALK FIFO on Eval.
+        transfer_begin = begin;
+        transfer_count = count;
+    }
+
+    void GlobalCheckpointWALK::Eval()
+    {
+        if (transfer_count)
+        {
+            int first = size - transfer_begin < transfer_count ? size - transfer_begin : transfer_count;
+
+            memcpy(memory + transfer_begin, transfer + transfer_begin, sizeof(fgr_t) * first);
+            memcpy(memory, transfer, sizeof(fgr_t) * (transfer_count - first));
+
+            transfer_count = 0;
+        }
+
+        FIFO::Eval();
+    }
 }
 
 
 // class MEMU::Core::GlobalCheckpointTable
 namespace MEMU::Core {
-    GlobalCheckpointTable::GlobalCheckpointTable()
-        : FIFO      (size)
-    { }
+    /*
+    int*                    fgr_slots;
+    MEMU::Common::Bitmap    valid;
+    MEMU::Common::Bitmap    invalidating;
+    */
+
+    GlobalCheckpointTable::GlobalCheckpointTable(const CoreGeometry& geometry)
+        : FIFO          (geometry.GetGCCount())
+        , fgr_slots     (new int[fgr_space])
+        , valid         (geometry.GetGCCount())
+        , invalidating  (geometry.GetGCCount())
+    {
+        memset(fgr_slots, -1, sizeof(int) * fgr_space);
+    }
 
     GlobalCheckpointTable::GlobalCheckpointTable(const GlobalCheckpointTable& obj)
-        : FIFO      (obj)
-    { }
+        : FIFO          (obj)
+        , fgr_slots     (new int[fgr_space])
+        , valid         (obj.valid)
+        , invalidating  (obj.invalidating)
+    {
+        memset(fgr_slots, -1, sizeof(int) * fgr_space);
+
+        // Only slots indexed by their own FGR are live
+        for (int j = 0; j < size; j++)
+            if (obj.fgr_slots[memory[j].GetFGR()] == j)
+                fgr_slots[memory[j].GetFGR()] = j;
+    }
 
     GlobalCheckpointTable::~GlobalCheckpointTable()
-    { }
+    {
+        delete[] fgr_slots;
+    }
+
+    inline void GlobalCheckpointTable::Unindex(int index)
+    {
+        if (fgr_slots[memory[index].GetFGR()] == index)
+            fgr_slots[memory[index].GetFGR()] = -1;
+    }
+
+    void GlobalCheckpointTable::UnindexAll()
+    {
+        // *NOTICE: Any indexed FGR points to a slot still holding that FGR, so
+        //          clearing by slot resets the whole index in O(size).
+        for (int j = 0; j < size; j++)
+            Unindex(j);
+    }
 
     inline bool GlobalCheckpointTable::PushFGR(fgr_t FGR, int GCA)
     {
@@ -566,56 +666,127 @@ namespace MEMU::Core {
 
     bool GlobalCheckpointTable::RestoreFGR(fgr_t FGR, int* GCA, GlobalCheckpointWALK* WALK)
     {
-        // CAM Query of FGR entry
-        int restore = -1;
-        for (int i = 0; i < GetSize(); i++)
-        {
-            const GlobalCheckpointTableEntry& entry = GetPayload(i);
-
-            if (entry.GetValid() && entry.GetFGR() == FGR)
-            {
-                *GCA = entry.GetGCA();
-                restore = i;
-
-                break;
-            }
-        }
+        // CAM Query of FGR entry, by FGR index
+        int restore = fgr_slots[FGR];
 
-        if (restore == -1)
+        if (restore == -1 || !valid.Get(restore))
             return false;
 
-        int restore_ptr = restore + 1;
+        *GCA = GetPayload(restore).GetGCA();
+
+        int restore_ptr = restore + 1 == GetSize() ? 0 : restore + 1;
 
-        // Manipulate V bits (left-handed pseudo-loop combinational)
-        int j = restore_ptr;
-        do 
+        // Invalidate younger checkpoints [restore_ptr, wptr) by mask
+        if (restore_ptr < GetWritePointer())
+            invalidating.SetRange(restore_ptr, GetWritePointer());
+        else if (restore_ptr > GetWritePointer())
         {
-            GlobalCheckpointTableEntry entry = GetPayload(j);
+            invalidating.SetRange(restore_ptr, GetSize());
+            invalidating.SetRange(0, GetWritePointer());
+        }
 
-            if (!entry.GetValid())
-                break;
+        if (!WALK)
+            return true;
+
+        // Bulk transfer of FGRs [rptr, restore] into WALK FIFO
+        int    count    = restore_ptr - GetReadPointer();
+        fgr_t* transfer = WALK->GetTransferBuffer();
 
-            entry.SetValid(false);
+        if (count <= 0)
+            count += GetSize();
 
-            SetPayload(j, entry);
+        for (int i = 0, j = GetReadPointer(); i < count; i++)
+        {
+            transfer[j] = GetPayload(j).GetFGR();
 
-            if (--j < 0)
-                j = size;
-        } 
-        while (j != restore_ptr);
+            if (++j == GetSize())
+                j = 0;
+        }
 
-        // Write into WALK FIFO
-        for (int i = 0; i < GetSize(); i++)
-            WALK->SetPayload(i, GetPayload(i).GetFGR());
+        WALK->Transfer(GetReadPointer(), count);
 
         // Manipulate Wptr&Rptr of WALK FIFO
         WALK->SetReadPointer(GetReadPointer());
         WALK->SetReadPointerB(GetReadPointerB());
 
         WALK->SetWritePointer(restore_ptr);
-        WALK->SetWritePointerB(restore_ptr > GetWritePointer() ? !GetWritePointerB() : GetWritePointerB());
+        WALK->SetWritePointerB(restore_ptr > GetReadPointer() ? GetReadPointerB() : !GetReadPointerB());
 
         return true;
     }
-}
 
+    void GlobalCheckpointTable::Clear()
+    {
+        UnindexAll();
+
+        FIFO::Clear();
+
+        valid       .Clear();
+        invalidating.Clear();
+    }
+
+    void GlobalCheckpointTable::Eval()
+    {
+        bool rebuild = set_rptr != -1 || set_rptrb != -1 || set_wptr != -1 || set_wptrb != -1;
+
+        // Drop FGR index of popped slots before they could be overwritten
+        for (int i = 0, j = rptr; i < delta_rptr; i++)
+        {
+            Unindex(j);
+
+            valid.Reset(j);
+
+            if (++j == size)
+                j = 0;
+        }
+
+        int push_ptr   = wptr;
+        int push_count = delta_wptr;
+
+        // Drop FGR index of slots about to be overwritten
+        for (auto iter = modification.begin(); iter != modification.end(); iter++)
+            Unindex(iter->GetIndex());
+
+        FIFO::Eval();
+
+        // Index pushed slots
+        for (int i = 0, j = push_ptr; i < push_count; i++)
+        {
+            fgr_slots[memory[j].GetFGR()] = j;
+
+            valid.Set(j, memory[j].GetValid());
+
+            if (++j == size)
+                j = 0;
+        }
+
+        // Invalidate younger checkpoints on restore
+        for (int j = invalidating.FindFirstSet(); j != -1; j = invalidating.FindFirstSet())
+        {
+            memory[j].SetValid(false);
+
+            valid       .Reset(j);
+            invalidating.Reset(j);
+        }
+
+        // Pointers were overridden, re-index all slots (slow path)
+        if (rebuild)
+        {
+            UnindexAll();
+
+            valid.Clear();
+
+            for (int i = 0, j = rptr; i < GetCount(); i++)
+            {
+                if (memory[j].GetValid())
+                {
+                    fgr_slots[memory[j].GetFGR()] = j;
+                    valid.Set(j);
+                }
+
+                if (++j == size)
+                    j = 0;
+            }
+        }
+    }
+}
@@ -26,3 +26,114 @@ typedef     uint64_t                pc_t;
 
 // Type definition of FGR Value
 typedef     uint16_t                fgr_t;
+
+
+namespace MEMU::Core {
+
+    // Core geometry (sizes of core structures)
+    class CoreGeometry {
+    private:
+        int     gc_count;
+        int     arf_size;
+        int     prf_size;
+        int     rob_size;
+
+    public:
+        constexpr CoreGeometry();
+        constexpr CoreGeometry(int gc_count, int arf_size, int prf_size, int rob_size);
+
+        constexpr int   GetGCCount() const;
+        constexpr int   GetARFSize() const;
+        constexpr int   GetPRFSize() const;
+        constexpr int   GetROBSize() const;
+
+        constexpr int   GetScoreboardGCCount() const;
+        constexpr int   GetRATSize() const;
+        constexpr int   GetRATGCCount() const;
+
+        void            SetGCCount(int gc_count);
+        void            SetARFSize(int arf_size);
+        void            SetPRFSize(int prf_size);
+        void            SetROBSize(int rob_size);
+    };
+}
+
+
+// class MEMU::Core::CoreGeometry
+namespace MEMU::Core {
+    /*
+    int     gc_count;
+    int     arf_size;
+    int     prf_size;
+    int     rob_size;
+    */
+
+    constexpr CoreGeometry::CoreGeometry()
+        : gc_count  (EMULATED_GC_COUNT)
+        , arf_size  (EMULATED_ARF_SIZE)
+        , prf_size  (EMULATED_PRF_SIZE)
+        , rob_size  (EMULATED_ROB_SIZE)
+    { }
+
+    constexpr CoreGeometry::CoreGeometry(int gc_count, int arf_size, int prf_size, int rob_size)
+        : gc_count  (gc_count)
+        , arf_size  (arf_size)
+        , prf_size  (prf_size)
+        , rob_size  (rob_size)
+    { }
+
+    constexpr int CoreGeometry::GetGCCount() const
+    {
+        return gc_count;
+    }
+
+    constexpr int CoreGeometry::GetARFSize() const
+    {
+        return arf_size;
+    }
+
+    constexpr int CoreGeometry::GetPRFSize() const
+    {
+        return prf_size;
+    }
+
+    constexpr int CoreGeometry::GetROBSize() const
+    {
+        return rob_size;
+    }
+
+    constexpr int CoreGeometry::GetScoreboardGCCount() const
+    {
+        return gc_count;
+    }
+
+    constexpr int CoreGeometry::GetRATSize() const
+    {
+        return prf_size;
+    }
+
+    constexpr int CoreGeometry::GetRATGCCount() const
+    {
+        return gc_count;
+    }
+
+    inline void CoreGeometry::SetGCCount(int gc_count)
+    {
+        this->gc_count = gc_count;
+    }
+
+    inline void CoreGeometry::SetARFSize(int arf_size)
+    {
+        this->arf_size = arf_size;
+    }
+
+    inline void CoreGeometry::SetPRFSize(int prf_size)
+    {
+        this->prf_size = prf_size;
+    }
+
+    inline void CoreGeometry::SetROBSize(int rob_size)
+    {
+        this->rob_size = rob_size;
+    }
+}
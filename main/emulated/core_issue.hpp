@@ -4,6 +4,8 @@
 //
 //
 
+#include <vector>
+
 #include "base.hpp"
 #include "core_global.hpp"
 
@@ -15,28 +17,193 @@ namespace MEMU::Core::Issue {
     class PhysicalRegisterFile final : public MEMU::Emulated
     {
     private:
-        arch_t      prfs[EMULATED_PRF_SIZE] = { 0 };
-        int         writing_index;
-        arch_t      writing_value;
+        const int   prf_size;
+        const int   read_ports;
+        const int   write_ports;
+        const bool  bypass;
+
+        arch_t*     prfs;           // [prf_size]
+
+        int*        writing_index;  // [write_ports]
+        arch_t*     writing_value;  // [write_ports]
+        int         writing_count;
+
+        int         reading_count;
 
     public:
-        PhysicalRegisterFile();
+        PhysicalRegisterFile(const CoreGeometry& geometry = CoreGeometry(),
+                             int read_ports = 2, int write_ports = 1, bool bypass = false);
         PhysicalRegisterFile(const PhysicalRegisterFile& obj);
         ~PhysicalRegisterFile();
 
-        constexpr int   GetCapacity() const;
+        int             GetCapacity() const;
+        int             GetReadPorts() const;
+        int             GetWritePorts() const;
+        bool            IsBypassEnabled() const;
+
+        int             GetReadCount() const;
+        int             GetWriteCount() const;
 
         bool            CheckBound(int index) const;
 
         arch_t          Get(int index) const;
-        void            Set(int index, arch_t value);
+        bool            Set(int index, arch_t value);
+
+        bool            Read(int index, arch_t* value);
+
+        void            ResetInput();
 
         virtual void    Eval() override;
     };
 
     class ReorderBuffer final : public MEMU::Emulated
     {
-        // TODO
+    private:
+        const int               size;
+        const int               width;
+        const int               gc_count;
+
+        int*                    FIDs;               // [size]
+        int*                    dstPRFs;            // [size]
+        int*                    exceptions;         // [size], -1 for no exception
+        fgr_t*                  FGRs;               // [size]
+        MEMU::Common::Bitmap    done;               // [size]
+
+        uint64_t                head;               // sequence of the oldest entry
+        uint64_t                tail;               // sequence of the next allocated entry
+
+        uint64_t*               checkpoints;        // [gc_count], tail sequence on checkpoint
+
+        int                     delta_tail;
+
+        int*                    writeback;          // [width]
+        int*                    writeback_exception;// [width]
+        int                     writeback_count;
+
+        int                     checkpoint_allocate;
+        uint64_t                checkpoint_allocate_tail;
+        int                     checkpoint_restore;
+        bool                    flush;
+
+        int                     commit_head;
+        int                     commit_count;
+
+    public:
+        ReorderBuffer(const CoreGeometry& geometry = CoreGeometry(), int width = 1);
+        ReorderBuffer(const ReorderBuffer& obj);
+        ~ReorderBuffer();
+
+        int             GetSize() const;
+        int             GetWidth() const;
+        int             GetCount() const;
+        int             GetRemainingSize() const;
+
+        bool            IsEmpty() const;
+        bool            IsFull() const;
+        bool            CheckBound(int index) const;
+
+        int             GetHead() const;
+        int             GetTail() const;
+
+        int             GetFID(int index) const;
+        int             GetDstPRF(int index) const;
+        int             GetException(int index) const;
+        fgr_t           GetFGR(int index) const;
+        bool            IsDone(int index) const;
+
+        bool            IsExceptionPending() const;
+
+        int             GetCommitCount() const;
+        int             GetCommitIndex(int i) const;
+
+        int             Allocate(int FID, int dstPRF, fgr_t FGR);
+        bool            Writeback(int index, int exception = -1);
+
+        void            AllocateCheckpoint(int index);
+        void            RestoreCheckpoint(int index);
+        void            Flush();
+
+        void            ResetInput();
+        void            Clear();
+
+        virtual void    Eval() override;
+
+        void            operator=(const ReorderBuffer& obj) = delete;
+    };
+
+    class IssueQueue final : public MEMU::Emulated
+    {
+    private:
+        const int                           size;
+        const int                           width;
+        const int                           wakeup_width;
+        const int                           prf_size;
+
+        int*                                FIDs;           // [size]
+        int*                                dstPRFs;        // [size]
+        int*                                src1PRFs;       // [size], -1 for no operand
+        int*                                src2PRFs;       // [size], -1 for no operand
+
+        MEMU::Common::Bitmap                valid;          // [size]
+        MEMU::Common::Bitmap                ready1;         // [size]
+        MEMU::Common::Bitmap                ready2;         // [size]
+        MEMU::Common::Bitmap                allocating;     // [size]
+
+        std::vector<MEMU::Common::Bitmap>   older;          // [size][size], entries older than the row
+        std::vector<MEMU::Common::Bitmap>   waiting1;       // [prf_size][size], entries waiting on the tag
+        std::vector<MEMU::Common::Bitmap>   waiting2;       // [prf_size][size]
+
+        int*                                allocate;       // [width]
+        int                                 allocate_count;
+
+        int*                                wakeup;         // [wakeup_width]
+        int                                 wakeup_count;
+
+        bool                                flush;
+        bool                                flush_younger;
+        int                                 flush_FID;
+
+        int*                                selected;       // [width]
+        int                                 selected_count;
+
+    public:
+        IssueQueue(int size, int width = 1, int wakeup_width = 1, const CoreGeometry& geometry = CoreGeometry());
+        IssueQueue(const IssueQueue& obj);
+        ~IssueQueue();
+
+        int             GetSize() const;
+        int             GetWidth() const;
+        int             GetWakeupWidth() const;
+        int             GetCount() const;
+
+        bool            IsEmpty() const;
+        bool            IsFull() const;
+        bool            CheckBound(int index) const;
+
+        bool            IsValid(int index) const;
+        bool            IsReady(int index) const;
+        bool            IsSrc1Ready(int index) const;
+        bool            IsSrc2Ready(int index) const;
+
+        int             GetFID(int index) const;
+        int             GetDstPRF(int index) const;
+        int             GetSrc1PRF(int index) const;
+        int             GetSrc2PRF(int index) const;
+
+        int             GetSelectCount() const;
+        int             GetSelected(int i) const;
+
+        int             Allocate(int FID, int dstPRF, int src1PRF, bool src1Ready, int src2PRF, bool src2Ready);
+        bool            Wakeup(int PRF);
+        void            Flush();
+        void            Flush(int FID);
+
+        void            ResetInput();
+        void            Clear();
+
+        virtual void    Eval() override;
+
+        void            operator=(const IssueQueue& obj) = delete;
     };
 }
 
@@ -44,29 +211,88 @@ namespace MEMU::Core::Issue {
 
 // class MEMU::Core::Issue::PhysicalRegisterFile
 namespace MEMU::Core::Issue {
+    /*
+    const int   prf_size;
+    const int   read_ports;
+    const int   write_ports;
+    const bool  bypass;
+
+    arch_t*     prfs;
+
+    int*        writing_index;
+    arch_t*     writing_value;
+    int         writing_count;
+
+    int         reading_count;
+    */
 
     //
-    PhysicalRegisterFile::PhysicalRegisterFile()
-        : writing_index(-1)
+    PhysicalRegisterFile::PhysicalRegisterFile(const CoreGeometry& geometry, int read_ports, int write_ports, bool bypass)
+        : prf_size      (geometry.GetPRFSize())
+        , read_ports    (read_ports)
+        , write_ports   (write_ports)
+        , bypass        (bypass)
+        , prfs          (new arch_t[geometry.GetPRFSize()]())
+        , writing_index (new int[write_ports]())
+        , writing_value (new arch_t[write_ports]())
+        , writing_count (0)
+        , reading_count (0)
     {  }
 
     PhysicalRegisterFile::PhysicalRegisterFile(const PhysicalRegisterFile& obj)
-        : writing_index(-1)
+        : prf_size      (obj.prf_size)
+        , read_ports    (obj.read_ports)
+        , write_ports   (obj.write_ports)
+        , bypass        (obj.bypass)
+        , prfs          (new arch_t[obj.prf_size])
+        , writing_index (new int[obj.write_ports]())
+        , writing_value (new arch_t[obj.write_ports]())
+        , writing_count (0)
+        , reading_count (0)
     {
-        memcpy(prfs, obj.prfs, sizeof(int64_t) * EMULATED_PRF_SIZE);
+        memcpy(prfs, obj.prfs, sizeof(arch_t) * prf_size);
     }
 
     PhysicalRegisterFile::~PhysicalRegisterFile()
-    {  }
+    {
+        delete[] prfs;
+        delete[] writing_index;
+        delete[] writing_value;
+    }
+
+    inline int PhysicalRegisterFile::GetCapacity() const
+    {
+        return prf_size;
+    }
 
-    constexpr int PhysicalRegisterFile::GetCapacity() const
+    inline int PhysicalRegisterFile::GetReadPorts() const
     {
-        return EMULATED_PRF_SIZE;
+        return read_ports;
+    }
+
+    inline int PhysicalRegisterFile::GetWritePorts() const
+    {
+        return write_ports;
+    }
+
+    inline bool PhysicalRegisterFile::IsBypassEnabled() const
+    {
+        return bypass;
+    }
+
+    inline int PhysicalRegisterFile::GetReadCount() const
+    {
+        return reading_count;
+    }
+
+    inline int PhysicalRegisterFile::GetWriteCount() const
+    {
+        return writing_count;
     }
 
     inline bool PhysicalRegisterFile::CheckBound(int index) const
     {
-        return (index >= 0) && (index < EMULATED_PRF_SIZE);
+        return (index >= 0) && (index < prf_size);
     }
 
     inline arch_t PhysicalRegisterFile::Get(int index) const
@@ -74,20 +300,735 @@ namespace MEMU::Core::Issue {
         return prfs[index];
     }
 
-    inline void PhysicalRegisterFile::Set(int index, arch_t value)
+    inline bool PhysicalRegisterFile::Set(int index, arch_t value)
     {
-        writing_index = index;
-        writing_value = value;
+        if (writing_count == write_ports)
+            return false;
+
+        writing_index[writing_count] = index;
+        writing_value[writing_count] = value;
+
+        writing_count++;
+
+        return true;
     }
 
-    void PhysicalRegisterFile::Eval()
+    bool PhysicalRegisterFile::Read(int index, arch_t* value)
     {
-        if (writing_index < 0)
-            return;
+        if (reading_count == read_ports)
+            return false;
+
+        reading_count++;
+
+        // Same-cycle forwarding from write ports, higher port takes priority.
+        // *NOTICE: The DFF-based RAM in issue_prf.v does not forward writes to read ports,
+        //          so bypassing is disabled by default to keep read-after-write timing of RTL.
+        if (bypass)
+            for (int i = writing_count - 1; i >= 0; i--)
+                if (writing_index[i] == index)
+                {
+                    *value = writing_value[i];
+                    return true;
+                }
+
+        *value = prfs[index];
+
+        return true;
+    }
 
-        prfs[writing_index] = writing_value;
+    void PhysicalRegisterFile::ResetInput()
+    {
+        writing_count = 0;
+        reading_count = 0;
+    }
+
+    void PhysicalRegisterFile::Eval()
+    {
+        for (int i = 0; i < writing_count; i++)
+            prfs[writing_index[i]] = writing_value[i];
         
-        writing_index = -1;
+        ResetInput();
     }
 }
 
+
+
+// class MEMU::Core::Issue::ReorderBuffer
+namespace MEMU::Core::Issue {
+    /*
+    const int               size;
+    const int               width;
+    const int               gc_count;
+
+    int*                    FIDs;
+    int*                    dstPRFs;
+    int*                    exceptions;
+    fgr_t*                  FGRs;
+    MEMU::Common::Bitmap    done;
+
+    uint64_t                head;
+    uint64_t                tail;
+
+    uint64_t*               checkpoints;
+
+    int                     delta_tail;
+
+    int*                    writeback;
+    int*                    writeback_exception;
+    int                     writeback_count;
+
+    int                     checkpoint_allocate;
+    uint64_t                checkpoint_allocate_tail;
+    int                     checkpoint_restore;
+    bool                    flush;
+
+    int                     commit_head;
+    int                     commit_count;
+    */
+
+    ReorderBuffer::ReorderBuffer(const CoreGeometry& geometry, int width)
+        : size                      (geometry.GetROBSize())
+        , width                     (width)
+        , gc_count                  (geometry.GetGCCount())
+        , FIDs                      (new int[geometry.GetROBSize()]())
+        , dstPRFs                   (new int[geometry.GetROBSize()]())
+        , exceptions                (new int[geometry.GetROBSize()]())
+        , FGRs                      (new fgr_t[geometry.GetROBSize()]())
+        , done                      (geometry.GetROBSize())
+        , head                      (0)
+        , tail                      (0)
+        , checkpoints               (new uint64_t[geometry.GetGCCount()]())
+        , delta_tail                (0)
+        , writeback                 (new int[width]())
+        , writeback_exception       (new int[width]())
+        , writeback_count           (0)
+        , checkpoint_allocate       (-1)
+        , checkpoint_allocate_tail  (0)
+        , checkpoint_restore        (-1)
+        , flush                     (false)
+        , commit_head               (0)
+        , commit_count              (0)
+    { }
+
+    ReorderBuffer::ReorderBuffer(const ReorderBuffer& obj)
+        : size                      (obj.size)
+        , width                     (obj.width)
+        , gc_count                  (obj.gc_count)
+        , FIDs                      (new int[obj.size])
+        , dstPRFs                   (new int[obj.size])
+        , exceptions                (new int[obj.size])
+        , FGRs                      (new fgr_t[obj.size])
+        , done                      (obj.done)
+        , head                      (obj.head)
+        , tail                      (obj.tail)
+        , checkpoints               (new uint64_t[obj.gc_count])
+        , delta_tail                (obj.delta_tail)
+        , writeback                 (new int[obj.width])
+        , writeback_exception       (new int[obj.width])
+        , writeback_count           (obj.writeback_count)
+        , checkpoint_allocate       (obj.checkpoint_allocate)
+        , checkpoint_allocate_tail  (obj.checkpoint_allocate_tail)
+        , checkpoint_restore        (obj.checkpoint_restore)
+        , flush                     (obj.flush)
+        , commit_head               (obj.commit_head)
+        , commit_count              (obj.commit_count)
+    {
+        memcpy(FIDs      , obj.FIDs      , sizeof(int)   * size);
+        memcpy(dstPRFs   , obj.dstPRFs   , sizeof(int)   * size);
+        memcpy(exceptions, obj.exceptions, sizeof(int)   * size);
+        memcpy(FGRs      , obj.FGRs      , sizeof(fgr_t) * size);
+
+        memcpy(checkpoints, obj.checkpoints, sizeof(uint64_t) * gc_count);
+
+        memcpy(writeback          , obj.writeback          , sizeof(int) * width);
+        memcpy(writeback_exception, obj.writeback_exception, sizeof(int) * width);
+    }
+
+    ReorderBuffer::~ReorderBuffer()
+    {
+        delete[] FIDs;
+        delete[] dstPRFs;
+        delete[] exceptions;
+        delete[] FGRs;
+        delete[] checkpoints;
+        delete[] writeback;
+        delete[] writeback_exception;
+    }
+
+    inline int ReorderBuffer::GetSize() const
+    {
+        return size;
+    }
+
+    inline int ReorderBuffer::GetWidth() const
+    {
+        return width;
+    }
+
+    inline int ReorderBuffer::GetCount() const
+    {
+        return (int)(tail - head);
+    }
+
+    inline int ReorderBuffer::GetRemainingSize() const
+    {
+        return size - GetCount();
+    }
+
+    inline bool ReorderBuffer::IsEmpty() const
+    {
+        return head == tail;
+    }
+
+    inline bool ReorderBuffer::IsFull() const
+    {
+        return GetCount() == size;
+    }
+
+    inline bool ReorderBuffer::CheckBound(int index) const
+    {
+        return index >= 0 && index < size;
+    }
+
+    inline int ReorderBuffer::GetHead() const
+    {
+        return (int)(head % size);
+    }
+
+    inline int ReorderBuffer::GetTail() const
+    {
+        return (int)(tail % size);
+    }
+
+    inline int ReorderBuffer::GetFID(int index) const
+    {
+        return FIDs[index];
+    }
+
+    inline int ReorderBuffer::GetDstPRF(int index) const
+    {
+        return dstPRFs[index];
+    }
+
+    inline int ReorderBuffer::GetException(int index) const
+    {
+        return exceptions[index];
+    }
+
+    inline fgr_t ReorderBuffer::GetFGR(int index) const
+    {
+        return FGRs[index];
+    }
+
+    inline bool ReorderBuffer::IsDone(int index) const
+    {
+        return done.Get(index);
+    }
+
+    inline bool ReorderBuffer::IsExceptionPending() const
+    {
+        return !IsEmpty() && done.Get(GetHead()) && exceptions[GetHead()] >= 0;
+    }
+
+    inline int ReorderBuffer::GetCommitCount() const
+    {
+        return commit_count;
+    }
+
+    inline int ReorderBuffer::GetCommitIndex(int i) const
+    {
+        // *NOTICE: Committed entries are only readable until next allocation
+        int index = commit_head + i;
+
+        return index < size ? index : index - size;
+    }
+
+    int ReorderBuffer::Allocate(int FID, int dstPRF, fgr_t FGR)
+    {
+        if (delta_tail == width || delta_tail == GetRemainingSize())
+            return -1;
+
+        // Entries beyond tail are invisible before Eval, so write them in-place
+        int index = (int)((tail + delta_tail) % size);
+
+        FIDs[index]       = FID;
+        dstPRFs[index]    = dstPRF;
+        exceptions[index] = -1;
+        FGRs[index]       = FGR;
+
+        done.Reset(index);
+
+        delta_tail++;
+
+        return index;
+    }
+
+    bool ReorderBuffer::Writeback(int index, int exception)
+    {
+        if (writeback_count == width)
+            return false;
+
+        writeback          [writeback_count] = index;
+        writeback_exception[writeback_count] = exception;
+
+        writeback_count++;
+
+        return true;
+    }
+
+    inline void ReorderBuffer::AllocateCheckpoint(int index)
+    {
+        // *NOTICE: Checkpoint covers the entries allocated before this call
+        checkpoint_allocate      = index;
+        checkpoint_allocate_tail = tail + delta_tail;
+    }
+
+    inline void ReorderBuffer::RestoreCheckpoint(int index)
+    {
+        checkpoint_restore = index;
+    }
+
+    inline void ReorderBuffer::Flush()
+    {
+        flush = true;
+    }
+
+    void ReorderBuffer::ResetInput()
+    {
+        delta_tail      = 0;
+        writeback_count = 0;
+
+        checkpoint_allocate = -1;
+        checkpoint_restore  = -1;
+
+        flush = false;
+    }
+
+    void ReorderBuffer::Clear()
+    {
+        head = 0;
+        tail = 0;
+
+        done.Clear();
+
+        commit_head  = 0;
+        commit_count = 0;
+    }
+
+    void ReorderBuffer::Eval()
+    {
+        // Writeback
+        for (int i = 0; i < writeback_count; i++)
+        {
+            done.Set(writeback[i]);
+            exceptions[writeback[i]] = writeback_exception[i];
+        }
+
+        // In-order commit, stalls on exception at head
+        commit_head  = GetHead();
+        commit_count = 0;
+
+        while (commit_count < width && head != tail)
+        {
+            int index = (int)(head % size);
+
+            if (!done.Get(index) || exceptions[index] >= 0)
+                break;
+
+            head++;
+            commit_count++;
+        }
+
+        // Checkpoint allocate
+        if (checkpoint_allocate != -1)
+            checkpoints[checkpoint_allocate] = checkpoint_allocate_tail;
+
+        // Allocate, or truncate on flush and checkpoint restore
+        if (flush)
+            tail = head;
+        else if (checkpoint_restore != -1)
+            tail = checkpoints[checkpoint_restore] > head ? checkpoints[checkpoint_restore] : head;
+        else
+            tail += delta_tail;
+
+        ResetInput();
+    }
+}
+
+
+// class MEMU::Core::Issue::IssueQueue
+namespace MEMU::Core::Issue {
+    /*
+    const int                           size;
+    const int                           width;
+    const int                           wakeup_width;
+    const int                           prf_size;
+
+    int*                                FIDs;
+    int*                                dstPRFs;
+    int*                                src1PRFs;
+    int*                                src2PRFs;
+
+    MEMU::Common::Bitmap                valid;
+    MEMU::Common::Bitmap                ready1;
+    MEMU::Common::Bitmap                ready2;
+    MEMU::Common::Bitmap                allocating;
+
+    std::vector<MEMU::Common::Bitmap>   older;
+    std::vector<MEMU::Common::Bitmap>   waiting1;
+    std::vector<MEMU::Common::Bitmap>   waiting2;
+
+    int*                                allocate;
+    int                                 allocate_count;
+
+    int*                                wakeup;
+    int                                 wakeup_count;
+
+    bool                                flush;
+    bool                                flush_younger;
+    int                                 flush_FID;
+
+    int*                                selected;
+    int                                 selected_count;
+    */
+
+    IssueQueue::IssueQueue(int size, int width, int wakeup_width, const CoreGeometry& geometry)
+        : size              (size)
+        , width             (width)
+        , wakeup_width      (wakeup_width)
+        , prf_size          (geometry.GetPRFSize())
+        , FIDs              (new int[size]())
+        , dstPRFs           (new int[size]())
+        , src1PRFs          (new int[size]())
+        , src2PRFs          (new int[size]())
+        , valid             (size)
+        , ready1            (size)
+        , ready2            (size)
+        , allocating        (size)
+        , older             (size, MEMU::Common::Bitmap(size))
+        , waiting1          (geometry.GetPRFSize(), MEMU::Common::Bitmap(size))
+        , waiting2          (geometry.GetPRFSize(), MEMU::Common::Bitmap(size))
+        , allocate          (new int[width]())
+        , allocate_count    (0)
+        , wakeup            (new int[wakeup_width]())
+        , wakeup_count      (0)
+        , flush             (false)
+        , flush_younger     (false)
+        , flush_FID         (0)
+        , selected          (new int[width]())
+        , selected_count    (0)
+    { }
+
+    IssueQueue::IssueQueue(const IssueQueue& obj)
+        : size              (obj.size)
+        , width             (obj.width)
+        , wakeup_width      (obj.wakeup_width)
+        , prf_size          (obj.prf_size)
+        , FIDs              (new int[obj.size])
+        , dstPRFs           (new int[obj.size])
+        , src1PRFs          (new int[obj.size])
+        , src2PRFs          (new int[obj.size])
+        , valid             (obj.valid)
+        , ready1            (obj.ready1)
+        , ready2            (obj.ready2)
+        , allocating        (obj.allocating)
+        , older             (obj.older)
+        , waiting1          (obj.waiting1)
+        , waiting2          (obj.waiting2)
+        , allocate          (new int[obj.width])
+        , allocate_count    (obj.allocate_count)
+        , wakeup            (new int[obj.wakeup_width])
+        , wakeup_count      (obj.wakeup_count)
+        , flush             (obj.flush)
+        , flush_younger     (obj.flush_younger)
+        , flush_FID         (obj.flush_FID)
+        , selected          (new int[obj.width])
+        , selected_count    (obj.selected_count)
+    {
+        memcpy(FIDs    , obj.FIDs    , sizeof(int) * size);
+        memcpy(dstPRFs , obj.dstPRFs , sizeof(int) * size);
+        memcpy(src1PRFs, obj.src1PRFs, sizeof(int) * size);
+        memcpy(src2PRFs, obj.src2PRFs, sizeof(int) * size);
+
+        memcpy(allocate, obj.allocate, sizeof(int) * width);
+        memcpy(wakeup  , obj.wakeup  , sizeof(int) * wakeup_width);
+        memcpy(selected, obj.selected, sizeof(int) * width);
+    }
+
+    IssueQueue::~IssueQueue()
+    {
+        delete[] FIDs;
+        delete[] dstPRFs;
+        delete[] src1PRFs;
+        delete[] src2PRFs;
+        delete[] allocate;
+        delete[] wakeup;
+        delete[] selected;
+    }
+
+    inline int IssueQueue::GetSize() const
+    {
+        return size;
+    }
+
+    inline int IssueQueue::GetWidth() const
+    {
+        return width;
+    }
+
+    inline int IssueQueue::GetWakeupWidth() const
+    {
+        return wakeup_width;
+    }
+
+    inline int IssueQueue::GetCount() const
+    {
+        return valid.Count();
+    }
+
+    inline bool IssueQueue::IsEmpty() const
+    {
+        return !valid.Any();
+    }
+
+    inline bool IssueQueue::IsFull() const
+    {
+        return valid.FindFirstReset() == -1;
+    }
+
+    inline bool IssueQueue::CheckBound(int index) const
+    {
+        return index >= 0 && index < size;
+    }
+
+    inline bool IssueQueue::IsValid(int index) const
+    {
+        return valid.Get(index);
+    }
+
+    inline bool IssueQueue::IsReady(int index) const
+    {
+        return valid.Get(index) && ready1.Get(index) && ready2.Get(index);
+    }
+
+    inline bool IssueQueue::IsSrc1Ready(int index) const
+    {
+        return ready1.Get(index);
+    }
+
+    inline bool IssueQueue::IsSrc2Ready(int index) const
+    {
+        return ready2.Get(index);
+    }
+
+    inline int IssueQueue::GetFID(int index) const
+    {
+        return FIDs[index];
+    }
+
+    inline int IssueQueue::GetDstPRF(int index) const
+    {
+        return dstPRFs[index];
+    }
+
+    inline int IssueQueue::GetSrc1PRF(int index) const
+    {
+        return src1PRFs[index];
+    }
+
+    inline int IssueQueue::GetSrc2PRF(int index) const
+    {
+        return src2PRFs[index];
+    }
+
+    inline int IssueQueue::GetSelectCount() const
+    {
+        return selected_count;
+    }
+
+    inline int IssueQueue::GetSelected(int i) const
+    {
+        // *NOTICE: Selected entries are only readable until next allocation
+        return selected[i];
+    }
+
+    int IssueQueue::Allocate(int FID, int dstPRF, int src1PRF, bool src1Ready, int src2PRF, bool src2Ready)
+    {
+        if (allocate_count == width)
+            return -1;
+
+        // Find a free slot, slots being allocated are invisible before Eval
+        int index = -1;
+
+        for (int i = 0; i < valid.GetWordCount(); i++)
+        {
+            uint64_t free = ~(valid.GetWord(i) | allocating.GetWord(i));
+
+            if (free)
+            {
+                index = i * MEMU::Common::Bitmap::word_bits + __builtin_ctzll(free);
+                break;
+            }
+        }
+
+        if (index == -1 || index >= size)
+            return -1;
+
+        FIDs    [index] = FID;
+        dstPRFs [index] = dstPRF;
+        src1PRFs[index] = src1PRF;
+        src2PRFs[index] = src2PRF;
+
+        ready1.Set(index, src1PRF < 0 || src1Ready);
+        ready2.Set(index, src2PRF < 0 || src2Ready);
+
+        allocating.Set(index);
+
+        allocate[allocate_count++] = index;
+
+        return index;
+    }
+
+    bool IssueQueue::Wakeup(int PRF)
+    {
+        if (wakeup_count == wakeup_width)
+            return false;
+
+        wakeup[wakeup_count++] = PRF;
+
+        return true;
+    }
+
+    inline void IssueQueue::Flush()
+    {
+        flush = true;
+    }
+
+    void IssueQueue::Flush(int FID)
+    {
+        // *NOTICE: Entries fetched after FID are flushed, including the ones allocated
+        //          and selected in the same cycle. Multiple requests keep the oldest one.
+        if (!flush_younger || FID < flush_FID)
+            flush_FID = FID;
+
+        flush_younger = true;
+    }
+
+    void IssueQueue::ResetInput()
+    {
+        for (int i = 0; i < allocate_count; i++)
+            allocating.Reset(allocate[i]);
+
+        allocate_count = 0;
+        wakeup_count   = 0;
+
+        flush         = false;
+        flush_younger = false;
+    }
+
+    void IssueQueue::Clear()
+    {
+        valid.Clear();
+
+        for (int i = 0; i < prf_size; i++)
+        {
+            waiting1[i].Clear();
+            waiting2[i].Clear();
+        }
+
+        selected_count = 0;
+    }
+
+    void IssueQueue::Eval()
+    {
+        // Oldest-first select among entries ready in last cycle.
+        // The rank of a ready entry is the count of older ready entries, 
+        // entries ranked below 'width' are selected.
+        const int word_count = valid.GetWordCount();
+
+        selected_count = 0;
+
+        for (int i = 0; i < word_count; i++)
+        {
+            uint64_t ready = valid.GetWord(i) & ready1.GetWord(i) & ready2.GetWord(i);
+
+            for (; ready; ready &= ready - 1)
+            {
+                int index = i * MEMU::Common::Bitmap::word_bits + __builtin_ctzll(ready);
+                int rank  = 0;
+
+                for (int j = 0; j < word_count && rank < width; j++)
+                    rank += __builtin_popcountll(older[index].GetWord(j) 
+                        & valid.GetWord(j) & ready1.GetWord(j) & ready2.GetWord(j));
+
+                if (rank < width)
+                {
+                    selected[rank] = index;
+                    selected_count++;
+                }
+            }
+        }
+
+        for (int i = 0; i < selected_count; i++)
+            valid.Reset(selected[i]);
+
+        // Allocate, in order of age
+        for (int i = 0; i < allocate_count; i++)
+        {
+            int index = allocate[i];
+
+            for (int j = 0; j < size; j++)
+                older[j].Reset(index);
+
+            older[index] = valid;
+
+            valid.Set(index);
+
+            if (!ready1.Get(index))
+                waiting1[src1PRFs[index]].Set(index);
+
+            if (!ready2.Get(index))
+                waiting2[src2PRFs[index]].Set(index);
+        }
+
+        // Tag broadcast wakeup
+        for (int i = 0; i < wakeup_count; i++)
+        {
+            ready1.Or(waiting1[wakeup[i]]);
+            ready2.Or(waiting2[wakeup[i]]);
+
+            waiting1[wakeup[i]].Clear();
+            waiting2[wakeup[i]].Clear();
+        }
+
+        //
+        if (flush)
+            Clear();
+        else if (flush_younger)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                if (!valid.Get(i) || FIDs[i] <= flush_FID)
+                    continue;
+
+                if (!ready1.Get(i))
+                    waiting1[src1PRFs[i]].Reset(i);
+
+                if (!ready2.Get(i))
+                    waiting2[src2PRFs[i]].Reset(i);
+
+                valid.Reset(i);
+            }
+
+            int count = 0;
+
+            for (int i = 0; i < selected_count; i++)
+                if (FIDs[selected[i]] <= flush_FID)
+                    selected[count++] = selected[i];
+
+            selected_count = count;
+        }
+
+        ResetInput();
+    }
+}
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <atomic>
 #include <initializer_list>
 
 
@@ -20,6 +21,11 @@
 //
 #define CSR_ADDRESS_MASK            0xFFF
 
+//
+#define CSR_COUNTER_DEFAULT_CPI_NUMERATOR       1
+#define CSR_COUNTER_DEFAULT_CPI_DENOMINATOR     1
+#define CSR_COUNTER_DEFAULT_CYCLES_PER_TICK     1
+
 //
 // Ratified Standard CSRs (based on riscv-privileged-20211203)
 
@@ -514,7 +520,7 @@ namespace Jasse {
     public:
         RVCSR(const RVCSRDefinition& def);
         RVCSR(const RVCSR& obj);
-        ~RVCSR();
+        virtual ~RVCSR();
 
         csraddr_t               GetAddress() const noexcept;
         RVCSRPrivLevel          GetPrivLevel() const noexcept;
@@ -524,6 +530,9 @@ namespace Jasse {
 
         virtual bool            CheckBitBound(int bit) noexcept;
 
+        // Called once the CSR was allocated into a CSR space, before any access.
+        virtual void            Attach(RVCSRSpace* CSRs) noexcept;
+
         // *NOTICE: CSRs may have side effects on read or write, they are not specified to be pure.
         //          And they might not be capable of getting or setting valid values without any
         //          side effect.
@@ -582,52 +591,102 @@ namespace Jasse {
     };
 
     
-    // CSR space
-    class RVCSRSpace {
+    // CSR counters, base of lazily derived counter CSRs ('mcycle', 'minstret', 'time' .etc)
+    // *NOTICE: Only the retired instruction count is advanced by the instance, once per retired
+    //          instruction. Cycle and time are derived on read, from a configurable CPI (as a
+    //          fraction) and time base (cycles per 'time' tick). Counter writes are recorded as
+    //          offsets to the derived values, those of CSR instructions (Write*) applying after the
+    //          writing instruction retires. Idle cycles (e.g. skipped in WFI) are fed separately,
+    //          advancing cycle and time but not instret.
+    class RVCSRCounters {
+    private:
+        uint64_t    instret;
+        uint64_t    idle;
 
-#define __RVCSRSPACE_SUB_L2_SIZE            16
-#define __RVCSRSPACE_SUB_L1_SIZE            16
-#define __RVCSRSPACE_ARR_SIZE               16
+        uint64_t    instret_offset;
+        uint64_t    cycle_offset;
+        uint64_t    time_offset;
 
-    private:
-        class SubspaceL2 { // Space -> L1 -> L2, address splitted every 4 bits
-        private:
-            RVCSR**     csrs;
+        uint32_t    cpi_numerator;
+        uint32_t    cpi_denominator;
+        uint64_t    cycles_per_tick;
+
+        uint64_t    GetRawCycle(uint64_t instret) const noexcept;
 
-        public:
-            SubspaceL2();
-            SubspaceL2(const SubspaceL2& obj) = delete;
-            ~SubspaceL2();
+    public:
+        RVCSRCounters() noexcept;
+        RVCSRCounters(const RVCSRCounters& obj) noexcept;
+        ~RVCSRCounters() noexcept;
+
+        void        Retire() noexcept;
+        void        Retire(uint64_t count) noexcept;
 
-            RVCSR*  SetCSR(int index, const RVCSRAllocator allocator) noexcept;
-            RVCSR*  GetCSR(int index) noexcept;
+        uint64_t    GetRetired() const noexcept;
 
-            void    ToList(RVCSRList& list) const noexcept;
+        void        Idle(uint64_t cycles) noexcept;
+        uint64_t    GetIdle() const noexcept;
 
-            void    operator=(const SubspaceL2& obj) = delete;
-        };
+        uint64_t    GetInstret() const noexcept;
+        uint64_t    GetCycle() const noexcept;
+        uint64_t    GetTime() const noexcept;
 
-        class SubspaceL1 {
-        private:
-            SubspaceL2**    subspaces;
+        void        SetInstret(uint64_t value) noexcept;
+        void        SetCycle(uint64_t value) noexcept;
+        void        SetTime(uint64_t value) noexcept;
 
-        public:
-            SubspaceL1();
-            SubspaceL1(const SubspaceL1& obj) = delete;
-            ~SubspaceL1();
+        void        WriteInstret(uint64_t value) noexcept;
+        void        WriteCycle(uint64_t value) noexcept;
 
-            RVCSR*  SetCSR(int index, const RVCSRAllocator allocator) noexcept;
-            RVCSR*  GetCSR(int index) noexcept;
+        uint32_t    GetCPINumerator() const noexcept;
+        uint32_t    GetCPIDenominator() const noexcept;
+        uint64_t    GetCyclesPerTick() const noexcept;
 
-            void    ToList(RVCSRList& list) const noexcept;
+        void        SetCPI(uint32_t numerator, uint32_t denominator = 1) noexcept;
+        void        SetCyclesPerTick(uint64_t cycles_per_tick) noexcept;
+
+        void        Reset() noexcept;
+    };
 
-            void    operator=(const SubspaceL1& obj) = delete;
-        };
 
-        SubspaceL1**        subspaces;
+    // CSR binding, resolved CSR cached by the user (e.g. decoded instruction)
+    // *NOTICE: Only valid for the revision of CSR space it was resolved in, re-resolved
+    //          automatically otherwise. Revisions are unique process-wide, never reused by
+    //          another or a re-allocated CSR space. Revision 0 is never bound.
+    //          @see RVCSRSpace::GetCSR(int, RVCSRBinding&)
+    typedef struct {
+        uint64_t            revision;
+        RVCSR*              csr;
+    } RVCSRBinding;
+
+    
+    // CSR space
+    class RVCSRSpace {
+
+#define __RVCSRSPACE_SIZE                   (1 << 12)
+
+    public:
+        // Hot machine-mode CSRs of trap procedures, directly accessed without lookup
+        typedef struct {
+            RVCSR*  mstatus;
+            RVCSR*  mepc;
+            RVCSR*  mcause;
+            RVCSR*  mtvec;
+            RVCSR*  mtval;
+        } MachineTrapCSRs;
+
+    private:
+        RVCSR**             csrs;         // flat, indexed by CSR address
+
+        MachineTrapCSRs     machine;
+
+        uint64_t            revision;     // renewed on every CSR (re-)allocation, invalidates bindings
+
+        static uint64_t     NextRevision() noexcept;
+
+        RVCSRCounters       counters;
 
         mutable RVCSRList   list;         // list conversion lazy cache
-        bool                list_unsync;
+        mutable bool        list_unsync;
 
     public:
         RVCSRSpace() noexcept;
@@ -643,11 +702,19 @@ namespace Jasse {
         RVCSR*              SetCSR(const RVCSRDefinition& definition) noexcept;
         RVCSR*              SetCSR(int address, const RVCSRAllocator allocator) noexcept;
         RVCSR*              GetCSR(int address) const noexcept;
+        RVCSR*              GetCSR(int address, RVCSRBinding& binding) const noexcept;
         RVCSR*              GetCSR(const RVCSRDefinition& definition) const noexcept;
         
         RVCSR*              RequireCSR(int address, const char* hint_name = nullptr) const;
         RVCSR*              RequireCSR(const RVCSRDefinition& definition) const;
 
+        const MachineTrapCSRs&  GetMachineTrapCSRs() const noexcept;
+
+        RVCSRCounters&          GetCounters() noexcept;
+        const RVCSRCounters&    GetCounters() const noexcept;
+
+        uint64_t            GetRevision() const noexcept;
+
         const RVCSRList&    ToList() const noexcept;
 
         void                operator=(const RVCSRSpace& obj) = delete;
@@ -716,94 +783,171 @@ namespace Jasse {
     {
         return bit >= 0 && bit < 64;
     }
+
+    void RVCSR::Attach(RVCSRSpace* CSRs) noexcept
+    { }
 }
 
 
-// Implementation of: class RVCSRSpace::SubspaceL2
+// Implementation of: class RVCSRCounters
 namespace Jasse {
     /*
-    RVCSR**     csrs;
+    uint64_t    instret;
+    uint64_t    idle;
+
+    uint64_t    instret_offset;
+    uint64_t    cycle_offset;
+    uint64_t    time_offset;
+
+    uint32_t    cpi_numerator;
+    uint32_t    cpi_denominator;
+    uint64_t    cycles_per_tick;
     */
 
-    RVCSRSpace::SubspaceL2::SubspaceL2()
-        : csrs  (new RVCSR*[__RVCSRSPACE_SUB_L2_SIZE]())
+    RVCSRCounters::RVCSRCounters() noexcept
+        : instret           (0)
+        , idle              (0)
+        , instret_offset    (0)
+        , cycle_offset      (0)
+        , time_offset       (0)
+        , cpi_numerator     (CSR_COUNTER_DEFAULT_CPI_NUMERATOR)
+        , cpi_denominator   (CSR_COUNTER_DEFAULT_CPI_DENOMINATOR)
+        , cycles_per_tick   (CSR_COUNTER_DEFAULT_CYCLES_PER_TICK)
     { }
 
-    RVCSRSpace::SubspaceL2::~SubspaceL2()
-    { 
-        for (int i = 0; i < __RVCSRSPACE_SUB_L2_SIZE; i++)
-            if (csrs[i])
-                delete csrs[i];
+    RVCSRCounters::RVCSRCounters(const RVCSRCounters& obj) noexcept
+        : instret           (obj.instret)
+        , idle              (obj.idle)
+        , instret_offset    (obj.instret_offset)
+        , cycle_offset      (obj.cycle_offset)
+        , time_offset       (obj.time_offset)
+        , cpi_numerator     (obj.cpi_numerator)
+        , cpi_denominator   (obj.cpi_denominator)
+        , cycles_per_tick   (obj.cycles_per_tick)
+    { }
 
-        delete[] csrs;
+    RVCSRCounters::~RVCSRCounters() noexcept
+    { }
+
+    inline uint64_t RVCSRCounters::GetRawCycle(uint64_t instret) const noexcept
+    {
+        if (cpi_numerator == cpi_denominator)
+            return instret + idle;
+
+        return (uint64_t)(((unsigned __int128) instret * cpi_numerator) / cpi_denominator) + idle;
     }
 
-    inline RVCSR* RVCSRSpace::SubspaceL2::SetCSR(int index, const RVCSRAllocator allocator) noexcept
+    inline void RVCSRCounters::Retire() noexcept
     {
-        if (csrs[index & 0x00F])
-            delete csrs[index & 0x00F];
+        instret++;
+    }
 
-        return (csrs[index & 0x00F] = allocator());
+    inline void RVCSRCounters::Retire(uint64_t count) noexcept
+    {
+        instret += count;
     }
 
-    inline RVCSR* RVCSRSpace::SubspaceL2::GetCSR(int index) noexcept
+    inline uint64_t RVCSRCounters::GetRetired() const noexcept
     {
-        return csrs[index & 0x00F];
+        return instret;
     }
 
-    void RVCSRSpace::SubspaceL2::ToList(RVCSRList& list) const noexcept
+    inline void RVCSRCounters::Idle(uint64_t cycles) noexcept
     {
-        for (int i = 0; i < __RVCSRSPACE_SUB_L2_SIZE; i++)
-            if (csrs[i])
-                list.Add(csrs[i]->GetDefinition());
+        idle += cycles;
     }
-}
 
- 
-// Implementation of: class RVCSRSpace::SubspaceL1
-namespace Jasse {
-    /*
-    SubspaceL2**    subspaces;
-    */
+    inline uint64_t RVCSRCounters::GetIdle() const noexcept
+    {
+        return idle;
+    }
 
-    RVCSRSpace::SubspaceL1::SubspaceL1()
-        : subspaces (new SubspaceL2*[__RVCSRSPACE_SUB_L1_SIZE]())
-    { }
+    inline uint64_t RVCSRCounters::GetInstret() const noexcept
+    {
+        return instret + instret_offset;
+    }
 
-    RVCSRSpace::SubspaceL1::~SubspaceL1()
+    inline uint64_t RVCSRCounters::GetCycle() const noexcept
     {
-        for (int i = 0; i < __RVCSRSPACE_SUB_L1_SIZE; i++)
-            if (subspaces[i])
-                delete subspaces[i];
+        return GetRawCycle(instret) + cycle_offset;
+    }
 
-        delete[] subspaces;
+    inline uint64_t RVCSRCounters::GetTime() const noexcept
+    {
+        return GetRawCycle(instret) / cycles_per_tick + time_offset;
     }
 
-    inline RVCSR* RVCSRSpace::SubspaceL1::SetCSR(int index, const RVCSRAllocator allocator) noexcept
+    inline void RVCSRCounters::SetInstret(uint64_t value) noexcept
     {
-        int indexL1 = (index & 0x0F0) >> 4;
+        instret_offset = value - instret;
+    }
 
-        if (!subspaces[indexL1])
-            subspaces[indexL1] = new SubspaceL2();
+    inline void RVCSRCounters::SetCycle(uint64_t value) noexcept
+    {
+        cycle_offset = value - GetRawCycle(instret);
+    }
 
-        return subspaces[indexL1]->SetCSR(index, allocator);
+    inline void RVCSRCounters::SetTime(uint64_t value) noexcept
+    {
+        time_offset = value - GetRawCycle(instret) / cycles_per_tick;
     }
 
-    inline RVCSR* RVCSRSpace::SubspaceL1::GetCSR(int index) noexcept
+    inline void RVCSRCounters::WriteInstret(uint64_t value) noexcept
     {
-        int indexL1 = (index & 0x0F0) >> 4;
+        // written by an instruction, taking effect after its own retirement
+        instret_offset = value - (instret + 1);
+    }
 
-        if (!subspaces[indexL1])
-            return nullptr;
-        else
-            return subspaces[indexL1]->GetCSR(index);
+    inline void RVCSRCounters::WriteCycle(uint64_t value) noexcept
+    {
+        // cycles of the writing instruction itself not counted, as of 'minstret'
+        cycle_offset = value - GetRawCycle(instret + 1);
+    }
+
+    inline uint32_t RVCSRCounters::GetCPINumerator() const noexcept
+    {
+        return cpi_numerator;
+    }
+
+    inline uint32_t RVCSRCounters::GetCPIDenominator() const noexcept
+    {
+        return cpi_denominator;
+    }
+
+    inline uint64_t RVCSRCounters::GetCyclesPerTick() const noexcept
+    {
+        return cycles_per_tick;
+    }
+
+    void RVCSRCounters::SetCPI(uint32_t numerator, uint32_t denominator) noexcept
+    {
+        // derived values kept continuous across re-configuration
+        uint64_t cycle = GetCycle();
+        uint64_t time  = GetTime();
+
+        cpi_numerator   = numerator;
+        cpi_denominator = denominator ? denominator : 1;
+
+        SetCycle(cycle);
+        SetTime(time);
+    }
+
+    void RVCSRCounters::SetCyclesPerTick(uint64_t cycles_per_tick) noexcept
+    {
+        uint64_t time = GetTime();
+
+        this->cycles_per_tick = cycles_per_tick ? cycles_per_tick : 1;
+
+        SetTime(time);
     }
 
-    void RVCSRSpace::SubspaceL1::ToList(RVCSRList& list) const noexcept
+    void RVCSRCounters::Reset() noexcept
     {
-        for (int i = 0; i < __RVCSRSPACE_SUB_L1_SIZE; i++)
-            if (subspaces[i])
-                subspaces[i]->ToList(list);
+        instret         = 0;
+        idle            = 0;
+        instret_offset  = 0;
+        cycle_offset    = 0;
+        time_offset     = 0;
     }
 }
 
@@ -906,11 +1050,23 @@ namespace Jasse {
 // Implementation of: class RVCSRSpace
 namespace Jasse {
     /*
-    SubspaceL1**    subspaces;
+    RVCSR**             csrs;
+
+    MachineTrapCSRs     machine;
+
+    uint64_t            revision;
+
+    RVCSRCounters       counters;
+
+    mutable RVCSRList   list;
+    mutable bool        list_unsync;
     */
 
     RVCSRSpace::RVCSRSpace() noexcept
-        : subspaces     (new SubspaceL1*[__RVCSRSPACE_ARR_SIZE]())
+        : csrs          (new RVCSR*[__RVCSRSPACE_SIZE]())
+        , machine       ({ nullptr, nullptr, nullptr, nullptr, nullptr })
+        , revision      (NextRevision())
+        , counters      ()
         , list          ()
         , list_unsync   (true)
     { }
@@ -929,16 +1085,16 @@ namespace Jasse {
 
     RVCSRSpace::~RVCSRSpace() noexcept
     {
-        for (int i = 0; i < __RVCSRSPACE_ARR_SIZE; i++)
-            if (subspaces[i])
-                delete subspaces[i];
+        for (int i = 0; i < __RVCSRSPACE_SIZE; i++)
+            if (csrs[i])
+                delete csrs[i];
 
-        delete[] subspaces;
+        delete[] csrs;
     }
 
     inline bool RVCSRSpace::CheckBound(int index) const noexcept
     {
-        return index >= 0 && index < (1 << 12);
+        return index >= 0 && index < __RVCSRSPACE_SIZE;
     }
 
     void RVCSRSpace::SetCSRs(std::initializer_list<const RVCSRDefinition> list) noexcept
@@ -961,23 +1117,53 @@ namespace Jasse {
     RVCSR* RVCSRSpace::SetCSR(int address, const RVCSRAllocator allocator) noexcept
     {
         list_unsync = true;
+        revision    = NextRevision();
+
+        address &= CSR_ADDRESS_MASK;
+
+        if (csrs[address])
+            delete csrs[address];
 
-        int index = (address & 0xF00) >> 8;
+        RVCSR* csr = (csrs[address] = allocator());
 
-        if (!subspaces[index])
-            subspaces[index] = new SubspaceL1();
+        csr->Attach(this);
 
-        return subspaces[index]->SetCSR(address, allocator);
+        switch (address)
+        {
+            case CSR_mstatus:   machine.mstatus = csr;  break;
+            case CSR_mepc:      machine.mepc    = csr;  break;
+            case CSR_mcause:    machine.mcause  = csr;  break;
+            case CSR_mtvec:     machine.mtvec   = csr;  break;
+            case CSR_mtval:     machine.mtval   = csr;  break;
+
+            default:
+                break;
+        }
+
+        return csr;
     }
 
-    RVCSR* RVCSRSpace::GetCSR(int address) const noexcept
+    inline RVCSR* RVCSRSpace::GetCSR(int address) const noexcept
     {
-        int index = (address & 0xF00) >> 8;
+        return csrs[address & CSR_ADDRESS_MASK];
+    }
 
-        if (!subspaces[index])
-            return nullptr;
-        else
-            return subspaces[index]->GetCSR(address);
+    inline uint64_t RVCSRSpace::NextRevision() noexcept
+    {
+        static std::atomic<uint64_t> epoch(0);
+
+        return ++epoch;
+    }
+
+    inline RVCSR* RVCSRSpace::GetCSR(int address, RVCSRBinding& binding) const noexcept
+    {
+        if (binding.revision != revision)
+        {
+            binding.revision = revision;
+            binding.csr      = GetCSR(address);
+        }
+
+        return binding.csr;
     }
 
     inline RVCSR* RVCSRSpace::GetCSR(const RVCSRDefinition& definition) const noexcept
@@ -992,13 +1178,7 @@ namespace Jasse {
 
     RVCSR* RVCSRSpace::RequireCSR(int address, const char* hint_name) const
     {
-        int index = (address & 0xF00) >> 8;
-
-        RVCSR* csr;
-        if (!subspaces[index])
-            csr = nullptr;
-        else
-            csr = subspaces[index]->GetCSR(address);
+        RVCSR* csr = GetCSR(address);
 
         if (!csr)
         {
@@ -1021,15 +1201,37 @@ namespace Jasse {
         return RequireCSR(definition.address, definition.name.c_str());
     }
 
+    inline const RVCSRSpace::MachineTrapCSRs& RVCSRSpace::GetMachineTrapCSRs() const noexcept
+    {
+        return machine;
+    }
+
+    inline RVCSRCounters& RVCSRSpace::GetCounters() noexcept
+    {
+        return counters;
+    }
+
+    inline const RVCSRCounters& RVCSRSpace::GetCounters() const noexcept
+    {
+        return counters;
+    }
+
+    inline uint64_t RVCSRSpace::GetRevision() const noexcept
+    {
+        return revision;
+    }
+
     const RVCSRList& RVCSRSpace::ToList() const noexcept
     {
         if (list_unsync)
         {
             list.Clear();
 
-            for (int i = 0; i < __RVCSRSPACE_ARR_SIZE; i++)
-                if (subspaces[i])
-                    subspaces[i]->ToList(list);
+            for (int i = 0; i < __RVCSRSPACE_SIZE; i++)
+                if (csrs[i])
+                    list.Add(csrs[i]->GetDefinition());
+
+            list_unsync = false;
         }
 
         return list;
@@ -25,6 +25,8 @@ namespace Jasse {
 
         const RVCodepoint*  codepoint; // eliminated copy-on-construct
 
+        mutable RVCSRBinding    csr_binding; // decode-time CSR binding, resolved on first execution
+
     public:
         RVInstruction(
             insnraw_t           insn,
@@ -46,6 +48,8 @@ namespace Jasse {
 
         const RVCodepoint*          GetCodepoint() const;
 
+        RVCSRBinding&               GetCSRBinding() const;
+
         const std::string&          GetName() const;
         RVCodepoint::Textualizer    GetTextualizer() const;
         RVCodepoint::Executor       GetExecutor() const;
@@ -157,6 +161,7 @@ namespace Jasse {
         , rs1           (rs1)
         , rs2           (rs2)
         , codepoint     (codepoint)
+        , csr_binding   ({ 0, nullptr })
     { }
 
     RVInstruction::RVInstruction()
@@ -166,6 +171,7 @@ namespace Jasse {
         , rs1           (0)
         , rs2           (0)
         , codepoint     (nullptr)
+        , csr_binding   ({ 0, nullptr })
     { }
 
     RVInstruction::RVInstruction(const RVInstruction& obj)
@@ -175,6 +181,7 @@ namespace Jasse {
         , rs1           (obj.rs1)
         , rs2           (obj.rs2)
         , codepoint     (obj.codepoint)
+        , csr_binding   (obj.csr_binding)
     { }
 
     RVInstruction::~RVInstruction()
@@ -210,6 +217,11 @@ namespace Jasse {
         return codepoint;
     }
 
+    inline RVCSRBinding& RVInstruction::GetCSRBinding() const
+    {
+        return csr_binding;
+    }
+
     inline const std::string& RVInstruction::GetName() const
     {
         return codepoint->GetName();
@@ -228,6 +240,8 @@ namespace Jasse {
     inline void RVInstruction::SetRaw(insnraw_t insn)
     {
         this->insn = insn;
+
+        csr_binding.revision = 0;
     }
 
     inline void RVInstruction::SetImmediate(imm_t imm)
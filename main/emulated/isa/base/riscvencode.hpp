@@ -5,8 +5,13 @@
 // Encoder infrastructure
 //
 
+#include <new>
+
 #include "riscvdef.hpp"
 
+
+#define RV_ENCODER_STORAGE_SIZE                 32
+
 namespace Jasse {
     // RISC-V Instruction Encoder
     class RVEncoder {
@@ -39,8 +44,19 @@ namespace Jasse {
         RVEncoder&          RS2(int rs2) noexcept;
     };
 
+    // RISC-V Instruction Encoder in-place storage
+    typedef struct {
+        alignas(alignof(void*)) unsigned char   bytes[RV_ENCODER_STORAGE_SIZE];
+    } RVEncoderStorage;
+
     // RISC-V Instruction Encoder Allocator
-    typedef RVEncoder*  (*RVEncoderAllocator)(void);
+    // *NOTICE: Encoders are constructed in-place on the storage given by the caller (usually on stack),
+    //          so no heap allocation nor deletion is involved in instruction code generation.
+    typedef RVEncoder*  (*RVEncoderAllocator)(RVEncoderStorage* storage);
+
+    //
+    template<class TEncoder, class... Args>
+    RVEncoder*  EmplaceRVEncoder(RVEncoderStorage* storage, Args... args) noexcept;
 }
 
 
@@ -108,3 +124,16 @@ namespace Jasse {
         return rs2_required;
     }
 }
+
+
+// Implementation of utilities
+namespace Jasse {
+    //
+    template<class TEncoder, class... Args>
+    inline RVEncoder* EmplaceRVEncoder(RVEncoderStorage* storage, Args... args) noexcept
+    {
+        static_assert(sizeof(TEncoder) <= sizeof(RVEncoderStorage), "encoder exceeds RVEncoderStorage");
+
+        return new (storage) TEncoder(args...);
+    }
+}
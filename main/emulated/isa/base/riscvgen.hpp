@@ -7,6 +7,8 @@
 
 #include <random>
 #include <set>
+#include <vector>
+#include <algorithm>
 
 #include "riscvdef.hpp"
 #include "riscvcodeset.hpp"
@@ -20,6 +22,51 @@
 
 
 namespace Jasse {
+    // RISC-V Code Generator random engine (xoshiro256**, seeded by splitmix64)
+    // *NOTICE: Each generator instance owns its random state, so generators could run on different
+    //          threads, and be reproduced individually by seed.
+    class RVCodeGenRandom {
+    private:
+        uint64_t    state[4];
+
+    public:
+        RVCodeGenRandom(uint64_t seed = 0) noexcept;
+        RVCodeGenRandom(const RVCodeGenRandom& obj) noexcept;
+        ~RVCodeGenRandom() noexcept;
+
+        void        Seed(uint64_t seed) noexcept;
+
+        uint64_t    Next() noexcept;
+        uint32_t    Next32() noexcept;
+
+        uint32_t    NextRange32(uint32_t lower_range, uint32_t upper_range) noexcept;
+        uint64_t    NextRange64(uint64_t lower_range, uint64_t upper_range) noexcept;
+    };
+
+    // RISC-V Code Generator weighted sampling table (Walker's alias method)
+    // *NOTICE: Built in O(n) from integer weights, sampled in O(1) with two random draws.
+    //          Rebuild only when the weights change.
+    class RVCodeGenAliasTable {
+    private:
+        std::vector<uint32_t>   threshold;
+        std::vector<uint32_t>   alias;
+
+    public:
+        RVCodeGenAliasTable() noexcept;
+        RVCodeGenAliasTable(const std::vector<uint32_t>& weights) noexcept;
+        RVCodeGenAliasTable(const RVCodeGenAliasTable& obj) noexcept;
+        ~RVCodeGenAliasTable() noexcept;
+
+        bool        Build(const std::vector<uint32_t>& weights) noexcept;
+        void        Clear() noexcept;
+
+        size_t      GetSize() const noexcept;
+        bool        IsEmpty() const noexcept;
+
+        uint32_t    Sample(RVCodeGenRandom& rand) const noexcept;
+    };
+
+
     // RISC-V Code Generator execluded codepoint collection iterator
     using RVCodeGenExclusionIterator      = std::set<const RVCodepoint*>::iterator;
     using RVCodeGenExclusionConstIterator = std::set<const RVCodepoint*>::const_iterator;
@@ -69,7 +116,7 @@ namespace Jasse {
     public:
         RVCodeGenConstraint(int code);
         RVCodeGenConstraint(const RVCodeGenConstraint& obj);
-        ~RVCodeGenConstraint();
+        virtual ~RVCodeGenConstraint();
 
         int     GetCode() const;
         int     GetTypeCode() const;
@@ -124,7 +171,7 @@ namespace Jasse {
 
 
     // RISC-V Code Generator function
-    typedef insnraw_t   (*RVCodeGen)(const RVCodeGenConstraints* constraints);
+    typedef insnraw_t   (*RVCodeGen)(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints);
 }
 
 
@@ -140,6 +187,219 @@ namespace Jasse {
 
 
 
+// Implementation of: class RVCodeGenRandom
+namespace Jasse {
+    /*
+    uint64_t    state[4];
+    */
+
+    RVCodeGenRandom::RVCodeGenRandom(uint64_t seed) noexcept
+    {
+        Seed(seed);
+    }
+
+    RVCodeGenRandom::RVCodeGenRandom(const RVCodeGenRandom& obj) noexcept
+    {
+        std::copy(obj.state, obj.state + 4, state);
+    }
+
+    RVCodeGenRandom::~RVCodeGenRandom() noexcept
+    { }
+
+    void RVCodeGenRandom::Seed(uint64_t seed) noexcept
+    {
+        // splitmix64 expansion, never yielding an all-zero state
+        for (int i = 0; i < 4; i++)
+        {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    inline uint64_t RVCodeGenRandom::Next() noexcept
+    {
+        uint64_t result = state[1] * 5;
+        uint64_t t      = state[1] << 17;
+
+        result = ((result << 7) | (result >> 57)) * 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+
+        state[2] ^= t;
+        state[3]  = (state[3] << 45) | (state[3] >> 19);
+
+        return result;
+    }
+
+    inline uint32_t RVCodeGenRandom::Next32() noexcept
+    {
+        return (uint32_t)(Next() >> 32);
+    }
+
+    inline uint32_t RVCodeGenRandom::NextRange32(uint32_t lower_range, uint32_t upper_range) noexcept
+    {
+        // Uniform in [lower_range, upper_range], by multiply-shift with rejection of the biased fraction
+        uint32_t span = upper_range - lower_range + 1;
+
+        if (!span)
+            return Next32();
+
+        uint64_t m = (uint64_t) Next32() * span;
+
+        if ((uint32_t) m < span)
+        {
+            uint32_t threshold = -span % span;
+
+            while ((uint32_t) m < threshold)
+                m = (uint64_t) Next32() * span;
+        }
+
+        return lower_range + (uint32_t)(m >> 32);
+    }
+
+    inline uint64_t RVCodeGenRandom::NextRange64(uint64_t lower_range, uint64_t upper_range) noexcept
+    {
+        uint64_t span = upper_range - lower_range + 1;
+
+        if (!span)
+            return Next();
+
+        unsigned __int128 m = (unsigned __int128) Next() * span;
+
+        if ((uint64_t) m < span)
+        {
+            uint64_t threshold = -span % span;
+
+            while ((uint64_t) m < threshold)
+                m = (unsigned __int128) Next() * span;
+        }
+
+        return lower_range + (uint64_t)(m >> 64);
+    }
+}
+
+
+// Implementation of: class RVCodeGenAliasTable
+namespace Jasse {
+    /*
+    std::vector<uint32_t>   threshold;
+    std::vector<uint32_t>   alias;
+    */
+
+    RVCodeGenAliasTable::RVCodeGenAliasTable() noexcept
+        : threshold     ()
+        , alias         ()
+    { }
+
+    RVCodeGenAliasTable::RVCodeGenAliasTable(const std::vector<uint32_t>& weights) noexcept
+        : threshold     ()
+        , alias         ()
+    {
+        Build(weights);
+    }
+
+    RVCodeGenAliasTable::RVCodeGenAliasTable(const RVCodeGenAliasTable& obj) noexcept
+        : threshold     (obj.threshold)
+        , alias         (obj.alias)
+    { }
+
+    RVCodeGenAliasTable::~RVCodeGenAliasTable() noexcept
+    { }
+
+    bool RVCodeGenAliasTable::Build(const std::vector<uint32_t>& weights) noexcept
+    {
+        Clear();
+
+        uint64_t sum = 0;
+        for (uint32_t weight : weights)
+            sum += weight;
+
+        if (!sum)
+            return false;
+
+        size_t n = weights.size();
+
+        // Scaled probabilities, averaging at 1.0
+        std::vector<double>     scaled(n);
+        std::vector<uint32_t>   small;
+        std::vector<uint32_t>   large;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            scaled[i] = (double) weights[i] * n / sum;
+
+            if (scaled[i] < 1.0)
+                small.push_back(i);
+            else
+                large.push_back(i);
+        }
+
+        threshold.resize(n);
+        alias    .resize(n);
+
+        while (!small.empty() && !large.empty())
+        {
+            uint32_t s = small.back(); small.pop_back();
+            uint32_t l = large.back();
+
+            threshold[s] = (uint32_t)(scaled[s] * 4294967296.0);
+            alias    [s] = l;
+
+            if ((scaled[l] -= 1.0 - scaled[s]) < 1.0)
+            {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Remaining columns are full, up to rounding error
+        for (uint32_t i : large)
+        {
+            threshold[i] = UINT32_MAX;
+            alias    [i] = i;
+        }
+
+        for (uint32_t i : small)
+        {
+            threshold[i] = UINT32_MAX;
+            alias    [i] = i;
+        }
+
+        return true;
+    }
+
+    void RVCodeGenAliasTable::Clear() noexcept
+    {
+        threshold.clear();
+        alias    .clear();
+    }
+
+    inline size_t RVCodeGenAliasTable::GetSize() const noexcept
+    {
+        return threshold.size();
+    }
+
+    inline bool RVCodeGenAliasTable::IsEmpty() const noexcept
+    {
+        return threshold.empty();
+    }
+
+    inline uint32_t RVCodeGenAliasTable::Sample(RVCodeGenRandom& rand) const noexcept
+    {
+        uint32_t column = rand.NextRange32(0, threshold.size() - 1);
+
+        return rand.Next32() < threshold[column] ? column : alias[column];
+    }
+}
+
+
 // Implementation of: class RVCodeGenExclusion
 namespace Jasse {
     /*
@@ -0,0 +1,91 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSR (Control and Status Register)
+//
+// Cycle Counter 'cycle' (read-only shadow of 'mcycle')
+// *NOTICE: Derived on read from the retired instruction count of CSR space, writes ignored.
+//          @see RVCSRCounters
+//
+
+#include "base/riscvcsr.hpp"
+
+
+namespace Jasse::CSR {
+
+    class RVCSR_cycle : public RVCSR {
+    private:
+        RVCSRCounters*  counters;
+
+    public:
+        RVCSR_cycle() noexcept;
+        RVCSR_cycle(const RVCSR_cycle& obj) noexcept;
+        ~RVCSR_cycle() noexcept;
+
+        virtual void        Attach(RVCSRSpace* CSRs) noexcept override;
+
+        virtual bool        GetValue(csr_t* dst) const noexcept override;
+        virtual bool        SetValue(csr_t value) noexcept override;
+
+        virtual csr_t       Read(RVCSRSpace* CSRs) noexcept override;
+        virtual void        Write(RVCSRSpace* CSRs, csr_t value) noexcept override;
+    };
+
+    // CSR 'cycle' instance allocator
+    RVCSR* __allocator_RVCSR_cycle() noexcept
+    {
+        return new RVCSR_cycle();
+    }
+
+    // CSR 'cycle' definition
+    csrdef cycle = { CSR_cycle, "cycle", &__allocator_RVCSR_cycle };
+}
+
+
+// Implementation of: class RVCSR_cycle
+namespace Jasse::CSR {
+    /*
+    RVCSRCounters*  counters;
+    */
+
+    RVCSR_cycle::RVCSR_cycle() noexcept
+        : RVCSR     (cycle)
+        , counters  (nullptr)
+    { }
+
+    RVCSR_cycle::RVCSR_cycle(const RVCSR_cycle& obj) noexcept
+        : RVCSR     (obj)
+        , counters  (obj.counters)
+    { }
+
+    RVCSR_cycle::~RVCSR_cycle() noexcept
+    { }
+
+    void RVCSR_cycle::Attach(RVCSRSpace* CSRs) noexcept
+    {
+        counters = &CSRs->GetCounters();
+    }
+
+    bool RVCSR_cycle::GetValue(csr_t* dst) const noexcept
+    {
+        if (!counters)
+            return false;
+
+        *dst = counters->GetCycle();
+        return true;
+    }
+
+    bool RVCSR_cycle::SetValue(csr_t value) noexcept
+    {
+        return false;
+    }
+
+    csr_t RVCSR_cycle::Read(RVCSRSpace* CSRs) noexcept
+    {
+        return counters ? counters->GetCycle() : 0;
+    }
+
+    void RVCSR_cycle::Write(RVCSRSpace* CSRs, csr_t value) noexcept
+    {
+        // read-only, writes ignored
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSR (Control and Status Register)
+//
+// Instructions-Retired Counter 'instret' (read-only shadow of 'minstret')
+// *NOTICE: Derived on read from the retired instruction count of CSR space, writes ignored.
+//          @see RVCSRCounters
+//
+
+#include "base/riscvcsr.hpp"
+
+
+namespace Jasse::CSR {
+
+    class RVCSR_instret : public RVCSR {
+    private:
+        RVCSRCounters*  counters;
+
+    public:
+        RVCSR_instret() noexcept;
+        RVCSR_instret(const RVCSR_instret& obj) noexcept;
+        ~RVCSR_instret() noexcept;
+
+        virtual void        Attach(RVCSRSpace* CSRs) noexcept override;
+
+        virtual bool        GetValue(csr_t* dst) const noexcept override;
+        virtual bool        SetValue(csr_t value) noexcept override;
+
+        virtual csr_t       Read(RVCSRSpace* CSRs) noexcept override;
+        virtual void        Write(RVCSRSpace* CSRs, csr_t value) noexcept override;
+    };
+
+    // CSR 'instret' instance allocator
+    RVCSR* __allocator_RVCSR_instret() noexcept
+    {
+        return new RVCSR_instret();
+    }
+
+    // CSR 'instret' definition
+    csrdef instret = { CSR_instret, "instret", &__allocator_RVCSR_instret };
+}
+
+
+// Implementation of: class RVCSR_instret
+namespace Jasse::CSR {
+    /*
+    RVCSRCounters*  counters;
+    */
+
+    RVCSR_instret::RVCSR_instret() noexcept
+        : RVCSR     (instret)
+        , counters  (nullptr)
+    { }
+
+    RVCSR_instret::RVCSR_instret(const RVCSR_instret& obj) noexcept
+        : RVCSR     (obj)
+        , counters  (obj.counters)
+    { }
+
+    RVCSR_instret::~RVCSR_instret() noexcept
+    { }
+
+    void RVCSR_instret::Attach(RVCSRSpace* CSRs) noexcept
+    {
+        counters = &CSRs->GetCounters();
+    }
+
+    bool RVCSR_instret::GetValue(csr_t* dst) const noexcept
+    {
+        if (!counters)
+            return false;
+
+        *dst = counters->GetInstret();
+        return true;
+    }
+
+    bool RVCSR_instret::SetValue(csr_t value) noexcept
+    {
+        return false;
+    }
+
+    csr_t RVCSR_instret::Read(RVCSRSpace* CSRs) noexcept
+    {
+        return counters ? counters->GetInstret() : 0;
+    }
+
+    void RVCSR_instret::Write(RVCSRSpace* CSRs, csr_t value) noexcept
+    {
+        // read-only, writes ignored
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSR (Control and Status Register)
+//
+// Machine Cycle Counter 'mcycle'
+// *NOTICE: Derived on read from the retired instruction count of CSR space, writes recorded
+//          as offset. @see RVCSRCounters
+//
+
+#include "base/riscvcsr.hpp"
+
+
+namespace Jasse::CSR {
+
+    class RVCSR_mcycle : public RVCSR {
+    private:
+        RVCSRCounters*  counters;
+
+    public:
+        RVCSR_mcycle() noexcept;
+        RVCSR_mcycle(const RVCSR_mcycle& obj) noexcept;
+        ~RVCSR_mcycle() noexcept;
+
+        virtual void        Attach(RVCSRSpace* CSRs) noexcept override;
+
+        virtual bool        GetValue(csr_t* dst) const noexcept override;
+        virtual bool        SetValue(csr_t value) noexcept override;
+
+        virtual csr_t       Read(RVCSRSpace* CSRs) noexcept override;
+        virtual void        Write(RVCSRSpace* CSRs, csr_t value) noexcept override;
+    };
+
+    // CSR 'mcycle' instance allocator
+    RVCSR* __allocator_RVCSR_mcycle() noexcept
+    {
+        return new RVCSR_mcycle();
+    }
+
+    // CSR 'mcycle' definition
+    csrdef mcycle = { CSR_mcycle, "mcycle", &__allocator_RVCSR_mcycle };
+}
+
+
+// Implementation of: class RVCSR_mcycle
+namespace Jasse::CSR {
+    /*
+    RVCSRCounters*  counters;
+    */
+
+    RVCSR_mcycle::RVCSR_mcycle() noexcept
+        : RVCSR     (mcycle)
+        , counters  (nullptr)
+    { }
+
+    RVCSR_mcycle::RVCSR_mcycle(const RVCSR_mcycle& obj) noexcept
+        : RVCSR     (obj)
+        , counters  (obj.counters)
+    { }
+
+    RVCSR_mcycle::~RVCSR_mcycle() noexcept
+    { }
+
+    void RVCSR_mcycle::Attach(RVCSRSpace* CSRs) noexcept
+    {
+        counters = &CSRs->GetCounters();
+    }
+
+    bool RVCSR_mcycle::GetValue(csr_t* dst) const noexcept
+    {
+        if (!counters)
+            return false;
+
+        *dst = counters->GetCycle();
+        return true;
+    }
+
+    bool RVCSR_mcycle::SetValue(csr_t value) noexcept
+    {
+        if (!counters)
+            return false;
+
+        counters->SetCycle(value);
+        return true;
+    }
+
+    csr_t RVCSR_mcycle::Read(RVCSRSpace* CSRs) noexcept
+    {
+        return counters ? counters->GetCycle() : 0;
+    }
+
+    void RVCSR_mcycle::Write(RVCSRSpace* CSRs, csr_t value) noexcept
+    {
+        if (counters)
+            counters->WriteCycle(value);
+    }
+}
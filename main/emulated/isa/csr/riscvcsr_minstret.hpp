@@ -0,0 +1,96 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSR (Control and Status Register)
+//
+// Machine Instructions-Retired Counter 'minstret'
+// *NOTICE: Derived on read from the retired instruction count of CSR space, writes recorded
+//          as offset. @see RVCSRCounters
+//
+
+#include "base/riscvcsr.hpp"
+
+
+namespace Jasse::CSR {
+
+    class RVCSR_minstret : public RVCSR {
+    private:
+        RVCSRCounters*  counters;
+
+    public:
+        RVCSR_minstret() noexcept;
+        RVCSR_minstret(const RVCSR_minstret& obj) noexcept;
+        ~RVCSR_minstret() noexcept;
+
+        virtual void        Attach(RVCSRSpace* CSRs) noexcept override;
+
+        virtual bool        GetValue(csr_t* dst) const noexcept override;
+        virtual bool        SetValue(csr_t value) noexcept override;
+
+        virtual csr_t       Read(RVCSRSpace* CSRs) noexcept override;
+        virtual void        Write(RVCSRSpace* CSRs, csr_t value) noexcept override;
+    };
+
+    // CSR 'minstret' instance allocator
+    RVCSR* __allocator_RVCSR_minstret() noexcept
+    {
+        return new RVCSR_minstret();
+    }
+
+    // CSR 'minstret' definition
+    csrdef minstret = { CSR_minstret, "minstret", &__allocator_RVCSR_minstret };
+}
+
+
+// Implementation of: class RVCSR_minstret
+namespace Jasse::CSR {
+    /*
+    RVCSRCounters*  counters;
+    */
+
+    RVCSR_minstret::RVCSR_minstret() noexcept
+        : RVCSR     (minstret)
+        , counters  (nullptr)
+    { }
+
+    RVCSR_minstret::RVCSR_minstret(const RVCSR_minstret& obj) noexcept
+        : RVCSR     (obj)
+        , counters  (obj.counters)
+    { }
+
+    RVCSR_minstret::~RVCSR_minstret() noexcept
+    { }
+
+    void RVCSR_minstret::Attach(RVCSRSpace* CSRs) noexcept
+    {
+        counters = &CSRs->GetCounters();
+    }
+
+    bool RVCSR_minstret::GetValue(csr_t* dst) const noexcept
+    {
+        if (!counters)
+            return false;
+
+        *dst = counters->GetInstret();
+        return true;
+    }
+
+    bool RVCSR_minstret::SetValue(csr_t value) noexcept
+    {
+        if (!counters)
+            return false;
+
+        counters->SetInstret(value);
+        return true;
+    }
+
+    csr_t RVCSR_minstret::Read(RVCSRSpace* CSRs) noexcept
+    {
+        return counters ? counters->GetInstret() : 0;
+    }
+
+    void RVCSR_minstret::Write(RVCSRSpace* CSRs, csr_t value) noexcept
+    {
+        if (counters)
+            counters->WriteInstret(value);
+    }
+}
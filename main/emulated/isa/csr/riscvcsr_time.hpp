@@ -0,0 +1,95 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSR (Control and Status Register)
+//
+// Timer 'time' (read-only shadow of memory-mapped 'mtime')
+// *NOTICE: Derived on read from the retired instruction count of CSR space, writes ignored.
+//          @see RVCSRCounters
+//
+
+#include "base/riscvcsr.hpp"
+
+
+namespace Jasse::CSR {
+
+    class RVCSR_time : public RVCSR {
+    private:
+        RVCSRCounters*  counters;
+
+    public:
+        RVCSR_time() noexcept;
+        RVCSR_time(const RVCSR_time& obj) noexcept;
+        ~RVCSR_time() noexcept;
+
+        virtual void        Attach(RVCSRSpace* CSRs) noexcept override;
+
+        virtual bool        GetValue(csr_t* dst) const noexcept override;
+        virtual bool        SetValue(csr_t value) noexcept override;
+
+        virtual csr_t       Read(RVCSRSpace* CSRs) noexcept override;
+        virtual void        Write(RVCSRSpace* CSRs, csr_t value) noexcept override;
+    };
+
+    // CSR 'time' instance allocator
+    RVCSR* __allocator_RVCSR_time() noexcept
+    {
+        return new RVCSR_time();
+    }
+
+    // CSR 'time' definition
+    csrdef time = { CSR_time, "time", &__allocator_RVCSR_time };
+}
+
+
+// Implementation of: class RVCSR_time
+namespace Jasse::CSR {
+    /*
+    RVCSRCounters*  counters;
+    */
+
+    RVCSR_time::RVCSR_time() noexcept
+        : RVCSR     (time)
+        , counters  (nullptr)
+    { }
+
+    RVCSR_time::RVCSR_time(const RVCSR_time& obj) noexcept
+        : RVCSR     (obj)
+        , counters  (obj.counters)
+    { }
+
+    RVCSR_time::~RVCSR_time() noexcept
+    { }
+
+    void RVCSR_time::Attach(RVCSRSpace* CSRs) noexcept
+    {
+        counters = &CSRs->GetCounters();
+    }
+
+    bool RVCSR_time::GetValue(csr_t* dst) const noexcept
+    {
+        if (!counters)
+            return false;
+
+        *dst = counters->GetTime();
+        return true;
+    }
+
+    bool RVCSR_time::SetValue(csr_t value) noexcept
+    {
+        if (!counters)
+            return false;
+
+        counters->SetTime(value);
+        return true;
+    }
+
+    csr_t RVCSR_time::Read(RVCSRSpace* CSRs) noexcept
+    {
+        return counters ? counters->GetTime() : 0;
+    }
+
+    void RVCSR_time::Write(RVCSRSpace* CSRs, csr_t value) noexcept
+    {
+        // read-only, writes ignored
+    }
+}
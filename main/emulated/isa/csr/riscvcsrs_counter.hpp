@@ -0,0 +1,22 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture CSRs (Control and Status Register)
+//
+// Counter/Timer CSRs, lazily derived from retired instruction count
+// *NOTICE: RV32-only upper halves ('mcycleh', 'cycleh' .etc) not included.
+//
+
+#include "riscvcsr_mcycle.hpp"
+#include "riscvcsr_minstret.hpp"
+#include "riscvcsr_cycle.hpp"
+#include "riscvcsr_instret.hpp"
+#include "riscvcsr_time.hpp"
+
+
+namespace Jasse::CSR {
+
+    static const RVCSRList COUNTERS {
+        mcycle,         minstret,
+        cycle,          time,           instret
+    };
+}
@@ -121,6 +121,34 @@ namespace Jasse {
     //          was properly fetched or decoded.
     typedef     RVEEIStatus     (*RVExecEEIHandler)(RVInstance&, RVExecStatus, RVInstruction*);
 
+    // RISC-V Instance Execution Observer
+    // *NOTICE: Notified right before the execution of each decoded instruction, with architectural
+    //          states not yet modified by the instruction (e.g. for functional coverage collection).
+    class RVExecObserver {
+    public:
+        virtual void    PreExecute(const RVInstruction& insn, const RVExecContext& ctx) noexcept = 0;
+    };
+
+    // RISC-V Instance Basic Block Observer
+    // *NOTICE: Notified once per executed basic block, with the start PC and the count of executed
+    //          instructions in it. A block ends wherever the next executed PC does not follow the
+    //          last one (taken branches, jumps, traps and trap returns, and held PC of WFI).
+    //          The last block stays pending until the next control transfer, @see RVInstance::FlushBlock.
+    class RVExecBlockObserver {
+    public:
+        virtual void    PostBlock(addr_t start, uint64_t length) noexcept = 0;
+    };
+
+    // RISC-V Instance Sampling Observer
+    // *NOTICE: Notified right before the execution of every N-th decoded instruction, N returned by
+    //          the previous sample (never 0), and right after each JAL/JALR taken with PC already at
+    //          the jump target. Nothing is called for other instructions, unlike the execution observer.
+    class RVExecSampleObserver {
+    public:
+        virtual uint64_t    PreSample(const RVInstruction& insn, const RVExecContext& ctx) noexcept = 0;
+        virtual void        PostJump(const RVInstruction& insn, const RVExecContext& ctx) noexcept = 0;
+    };
+
     // RISC-V Instance
     class RVInstance {
     public:
@@ -139,6 +167,16 @@ namespace Jasse {
 
         RVExecEEIHandler        exec_handler;
 
+        RVExecObserver*         exec_observer;
+
+        RVExecBlockObserver*    block_observer;
+        addr_t                  block_start;
+        addr_t                  block_next;
+        uint64_t                block_length;
+
+        RVExecSampleObserver*   sample_observer;
+        uint64_t                sample_countdown;
+
     public:
         RVInstance(const RVDecoderCollection&   decoders,
                    RVArchitectural&&            arch,
@@ -169,6 +207,16 @@ namespace Jasse {
         RVExecEEIHandler                GetExecEEI() const noexcept;
         void                            SetExecEEI(RVExecEEIHandler exec_handler) noexcept;
 
+        RVExecObserver*                 GetExecObserver() const noexcept;
+        void                            SetExecObserver(RVExecObserver* exec_observer) noexcept;
+
+        RVExecBlockObserver*            GetBlockObserver() const noexcept;
+        void                            SetBlockObserver(RVExecBlockObserver* block_observer) noexcept;
+        void                            FlushBlock() noexcept;
+
+        RVExecSampleObserver*           GetSampleObserver() const noexcept;
+        void                            SetSampleObserver(RVExecSampleObserver* sample_observer, uint64_t countdown) noexcept;
+
         RVTrapProcedures&               GetTrapProcedures() noexcept;
         const RVTrapProcedures&         GetTrapProcedures() const noexcept;
         void                            SetTrapProcedures(const RVTrapProcedures& trap_procedures) noexcept;
@@ -511,6 +559,16 @@ namespace Jasse {
 
     RVExecEEIHandler        exec_handler;
 
+    RVExecObserver*         exec_observer;
+
+    RVExecBlockObserver*    block_observer;
+    addr_t                  block_start;
+    addr_t                  block_next;
+    uint64_t                block_length;
+
+    RVExecSampleObserver*   sample_observer;
+    uint64_t                sample_countdown;
+
     RVTrapProcedures        trap;
     */
 
@@ -526,6 +584,13 @@ namespace Jasse {
         , CSRs              (CSRs)
         , trap_procedures   (trap_procedures)
         , exec_handler      (exec_handler)
+        , exec_observer     (nullptr)
+        , block_observer    (nullptr)
+        , block_start       (0)
+        , block_next        (0)
+        , block_length      (0)
+        , sample_observer   (nullptr)
+        , sample_countdown  (0)
     { }
 
     RVInstance::~RVInstance() noexcept
@@ -591,6 +656,47 @@ namespace Jasse {
         this->exec_handler = exec_handler;
     }
 
+    inline RVExecObserver* RVInstance::GetExecObserver() const noexcept
+    {
+        return exec_observer;
+    }
+
+    inline void RVInstance::SetExecObserver(RVExecObserver* exec_observer) noexcept
+    {
+        this->exec_observer = exec_observer;
+    }
+
+    inline RVExecBlockObserver* RVInstance::GetBlockObserver() const noexcept
+    {
+        return block_observer;
+    }
+
+    inline void RVInstance::SetBlockObserver(RVExecBlockObserver* block_observer) noexcept
+    {
+        this->block_observer = block_observer;
+
+        block_length = 0;
+    }
+
+    inline void RVInstance::FlushBlock() noexcept
+    {
+        if (block_observer && block_length)
+            block_observer->PostBlock(block_start, block_length);
+
+        block_length = 0;
+    }
+
+    inline RVExecSampleObserver* RVInstance::GetSampleObserver() const noexcept
+    {
+        return sample_observer;
+    }
+
+    inline void RVInstance::SetSampleObserver(RVExecSampleObserver* sample_observer, uint64_t countdown) noexcept
+    {
+        this->sample_observer  = sample_observer;
+        this->sample_countdown = countdown ? countdown : 1;
+    }
+
     inline RVTrapProcedures& RVInstance::GetTrapProcedures() noexcept
     {
         return trap_procedures;
@@ -660,10 +766,38 @@ namespace Jasse {
             return EXEC_NOT_DECODED;
         }
 
+        // basic block boundary, where PC does not follow the last executed instruction
+        if (block_observer)
+        {
+            addr_t pc = arch.XLEN() == XLEN32 ? arch.PC().pc32 : arch.PC().pc64;
+
+            if (pc != block_next || !block_length)
+            {
+                if (block_length)
+                    block_observer->PostBlock(block_start, block_length);
+
+                block_start  = pc;
+                block_length = 0;
+            }
+
+            block_length++;
+            block_next = arch.XLEN() == XLEN32 ? (arch32_t)(pc + 4) : pc + 4;
+        }
+
         // execution
+        if (exec_observer)
+            exec_observer->PreExecute(decoded, ctx);
+
+        if (sample_observer && !--sample_countdown)
+            sample_countdown = sample_observer->PreSample(decoded, ctx);
+
         RVExecStatus exec_status = decoded.Execute(ctx);
         RVEEIStatus  eei_status  = EEI_BYPASS;
 
+        // JAL (0x6F) and JALR (0x67) alike under the mask
+        if (sample_observer && exec_status == EXEC_PC_JUMP && (decoded.GetRaw() & 0x77) == 0x67)
+            sample_observer->PostJump(decoded, ctx);
+
         // - note: @see RVExecStatus
         ASSERT(exec_status != EXEC_FETCH_ACCESS_FAULT);
         ASSERT(exec_status != EXEC_FETCH_ADDRESS_MISALIGNED);
@@ -672,6 +806,21 @@ namespace Jasse {
         if (exec_handler)
             eei_status = exec_handler(*this, exec_status, &decoded);
 
+        // retirement, counter CSRs derived from it on read (@see RVCSRCounters)
+        switch (exec_status)
+        {
+            case EXEC_SEQUENTIAL:
+            case EXEC_PC_HOLD:
+            case EXEC_PC_JUMP:
+            case EXEC_TRAP_RETURN:
+            case EXEC_WAIT_FOR_INTERRUPT:
+                CSRs.GetCounters().Retire();
+                break;
+
+            default:
+                break;
+        }
+
         if (eei_status == EEI_BYPASS)
         {
             if (exec_status == EXEC_SEQUENTIAL)
@@ -792,6 +941,13 @@ namespace Jasse {
         return *this;
     }
 
+    inline RVInstance::Builder& RVInstance::Builder::CSR(const RVCSRList& CSRs) noexcept
+    {
+        for (auto iter = CSRs.Begin(); iter != CSRs.End(); iter++)
+            this->_CSR.Add(*iter);
+        return *this;
+    }
+
     inline RVInstance::Builder& RVInstance::Builder::TrapProcedures(const RVTrapProcedures& trap_procedures) noexcept
     {
         this->trap_procedures = trap_procedures;
@@ -0,0 +1,286 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture Emulator (Jasse)
+//
+// Basic-block vector collection over fixed instruction intervals, in SimPoint '.bb' format
+//
+// *NOTICE: Fed by RVInstance::Eval as its basic block observer, one hash table update per
+//          executed basic block. Blocks executed by the JIT (@see RVJIT) are not reported.
+//          A block is attributed as a whole to the interval in which it ends.
+//
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+
+#include "riscv.hpp"
+
+
+//
+#define RV_BBV_DEFAULT_INTERVAL                 100000000   // SimPoint 3.0 default
+
+#define RV_BBV_INITIAL_CAPACITY                 1024        // power of 2
+
+
+namespace Jasse {
+
+    // RISC-V Basic-Block Vector Collector
+    // *NOTICE: Counts are of instructions (block executions weighted by block length), per
+    //          block ID assigned 1-based on first execution and kept across intervals.
+    //          Per-interval counts are kept in an open-addressing table, reset by clearing only
+    //          the slots used in the interval. Each interval is written as one line of
+    //          'T:<id>:<count> ...' as soon as it completes.
+    class RVBBVCollector : public RVExecBlockObserver {
+    public:
+        typedef struct {
+            addr_t      start;
+            uint32_t    id;         // 0 for empty slot
+            uint64_t    count;
+        } Entry;
+
+    private:
+        std::ostream*                           os;
+
+        uint64_t                                interval;
+        uint64_t                                boundary;
+        uint64_t                                retired;
+        uint64_t                                intervals;
+
+        std::vector<Entry>                      table;
+        std::vector<uint32_t>                   used;       // slots in order of first use
+
+        std::unordered_map<addr_t, uint32_t>    ids;
+        std::vector<addr_t>                     blocks;     // start of each block ID
+
+        static size_t           Hash(addr_t start) noexcept;
+
+        Entry&                  Probe(addr_t start) noexcept;
+        void                    Grow() noexcept;
+        void                    Emit() noexcept;
+
+    public:
+        RVBBVCollector(std::ostream* os = nullptr, uint64_t interval = RV_BBV_DEFAULT_INTERVAL) noexcept;
+        RVBBVCollector(const RVBBVCollector& obj) = delete;
+        ~RVBBVCollector() noexcept;
+
+        std::ostream*           GetOutput() const noexcept;
+        void                    SetOutput(std::ostream* os) noexcept;
+
+        uint64_t                GetInterval() const noexcept;
+        uint64_t                GetIntervalCount() const noexcept;
+        uint64_t                GetInstructionCount() const noexcept;
+
+        size_t                  GetBlockCount() const noexcept;
+        addr_t                  GetBlockStart(uint32_t id) const noexcept;
+
+        virtual void            PostBlock(addr_t start, uint64_t length) noexcept override;
+
+        void                    Flush() noexcept;
+        void                    Reset() noexcept;
+
+        void                    PrintBlocks(std::ostream& os) const;
+
+        void                    operator=(const RVBBVCollector& obj) = delete;
+    };
+}
+
+
+// Implementation of: class RVBBVCollector
+namespace Jasse {
+    /*
+    std::ostream*                           os;
+
+    uint64_t                                interval;
+    uint64_t                                boundary;
+    uint64_t                                retired;
+    uint64_t                                intervals;
+
+    std::vector<Entry>                      table;
+    std::vector<uint32_t>                   used;
+
+    std::unordered_map<addr_t, uint32_t>    ids;
+    std::vector<addr_t>                     blocks;
+    */
+
+    RVBBVCollector::RVBBVCollector(std::ostream* os, uint64_t interval) noexcept
+        : os        (os)
+        , interval  (interval ? interval : 1)
+        , boundary  (interval ? interval : 1)
+        , retired   (0)
+        , intervals (0)
+        , table     (RV_BBV_INITIAL_CAPACITY, Entry { 0, 0, 0 })
+        , used      ()
+        , ids       ()
+        , blocks    ()
+    { }
+
+    RVBBVCollector::~RVBBVCollector() noexcept
+    { }
+
+    inline std::ostream* RVBBVCollector::GetOutput() const noexcept
+    {
+        return os;
+    }
+
+    inline void RVBBVCollector::SetOutput(std::ostream* os) noexcept
+    {
+        this->os = os;
+    }
+
+    inline uint64_t RVBBVCollector::GetInterval() const noexcept
+    {
+        return interval;
+    }
+
+    inline uint64_t RVBBVCollector::GetIntervalCount() const noexcept
+    {
+        return intervals;
+    }
+
+    inline uint64_t RVBBVCollector::GetInstructionCount() const noexcept
+    {
+        return retired;
+    }
+
+    inline size_t RVBBVCollector::GetBlockCount() const noexcept
+    {
+        return blocks.size();
+    }
+
+    inline addr_t RVBBVCollector::GetBlockStart(uint32_t id) const noexcept
+    {
+        return blocks[id - 1];
+    }
+
+    inline size_t RVBBVCollector::Hash(addr_t start) noexcept
+    {
+        return (size_t)(((start >> 1) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    inline RVBBVCollector::Entry& RVBBVCollector::Probe(addr_t start) noexcept
+    {
+        const size_t mask = table.size() - 1;
+
+        size_t slot = Hash(start) & mask;
+
+        while (table[slot].id && table[slot].start != start)
+            slot = (slot + 1) & mask;
+
+        Entry& entry = table[slot];
+
+        // first execution in the interval
+        if (!entry.id)
+        {
+            auto iter = ids.find(start);
+
+            if (iter == ids.end())
+            {
+                blocks.push_back(start);
+                iter = ids.emplace(start, blocks.size()).first;
+            }
+
+            entry.start = start;
+            entry.id    = iter->second;
+
+            used.push_back(slot);
+        }
+
+        return entry;
+    }
+
+    void RVBBVCollector::Grow() noexcept
+    {
+        // kept under half load, rehashed in order of first use
+        std::vector<Entry> entries;
+
+        entries.reserve(used.size());
+        for (uint32_t slot : used)
+            entries.push_back(table[slot]);
+
+        table.assign(table.size() * 2, Entry { 0, 0, 0 });
+        used.clear();
+
+        const size_t mask = table.size() - 1;
+
+        for (const Entry& entry : entries)
+        {
+            size_t slot = Hash(entry.start) & mask;
+
+            while (table[slot].id)
+                slot = (slot + 1) & mask;
+
+            table[slot] = entry;
+            used.push_back(slot);
+        }
+    }
+
+    void RVBBVCollector::Emit() noexcept
+    {
+        if (used.empty())
+            return;
+
+        if (os)
+        {
+            *os << "T";
+
+            for (uint32_t slot : used)
+                *os << ":" << table[slot].id << ":" << table[slot].count << " ";
+
+            *os << "\n";
+        }
+
+        for (uint32_t slot : used)
+            table[slot] = Entry { 0, 0, 0 };
+
+        used.clear();
+
+        intervals++;
+    }
+
+    void RVBBVCollector::PostBlock(addr_t start, uint64_t length) noexcept
+    {
+        Probe(start).count += length;
+
+        if (used.size() * 2 > table.size())
+            Grow();
+
+        retired += length;
+
+        if (retired >= boundary)
+        {
+            Emit();
+
+            boundary = (retired / interval + 1) * interval;
+        }
+    }
+
+    void RVBBVCollector::Flush() noexcept
+    {
+        // partial last interval
+        Emit();
+
+        if (os)
+            os->flush();
+    }
+
+    void RVBBVCollector::Reset() noexcept
+    {
+        table.assign(RV_BBV_INITIAL_CAPACITY, Entry { 0, 0, 0 });
+        used.clear();
+
+        ids.clear();
+        blocks.clear();
+
+        boundary  = interval;
+        retired   = 0;
+        intervals = 0;
+    }
+
+    void RVBBVCollector::PrintBlocks(std::ostream& os) const
+    {
+        // block ID to start PC, for mapping simulation points back to code
+        for (size_t i = 0; i < blocks.size(); i++)
+            os << (i + 1) << " 0x" << std::hex << blocks[i] << std::dec << std::endl;
+    }
+}
@@ -0,0 +1,1101 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture Emulator (Jasse)
+//
+// Event-driven device bus: MMIO device mapping, discrete event queue, CLINT and console devices
+//
+// *NOTICE: Simulated time is counted in instruction slots (one slot per evaluated instruction),
+//          and jumps straight to the next pending event while the hart waits in WFI.
+//          'mip'/'mie' CSRs are not implemented in Jasse yet, pending interrupts are tracked
+//          by RVPlatform, and all M-mode interrupt sources are treated as locally enabled
+//          (only gated by 'mstatus.MIE').
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <algorithm>
+
+#include "riscv.hpp"
+#include "riscvexcept.hpp"
+#include "base/riscvmem.hpp"
+
+
+//
+#define RV_EVENT_NEVER                          UINT64_MAX
+
+
+// CLINT (Core-Local Interruptor), SiFive-compatible layout of single hart
+#define RV_CLINT_DEFAULT_BASE                   0x02000000U
+#define RV_CLINT_SIZE                           0x00010000U
+
+#define RV_CLINT_MSIP                           0x0000
+#define RV_CLINT_MTIMECMP                       0x4000
+#define RV_CLINT_MTIME                          0xBFF8
+
+#define RV_CLINT_DEFAULT_INSNS_PER_TICK         1
+
+
+// Console, 16550 UART stand-in (byte registers, no FIFO control or interrupt)
+#define RV_CONSOLE_DEFAULT_BASE                 0x10000000U
+#define RV_CONSOLE_SIZE                         0x00000100U
+
+#define RV_CONSOLE_RBR_THR                      0x00
+#define RV_CONSOLE_LSR                          0x05
+
+#define RV_CONSOLE_LSR_DR                       0x01
+#define RV_CONSOLE_LSR_THRE                     0x20
+#define RV_CONSOLE_LSR_TEMT                     0x40
+
+
+namespace Jasse {
+
+    class RVEventQueue;
+
+    // RISC-V Event ID
+    typedef     uint64_t        RVEventId;
+
+    // RISC-V Event Listener
+    class RVEventListener {
+    public:
+        virtual void            OnEvent(RVEventQueue& queue, uint64_t tag) noexcept = 0;
+    };
+
+    // RISC-V Discrete Event Queue, keyed on simulated time (instruction slots)
+    class RVEventQueue {
+    public:
+        typedef struct {
+            uint64_t            when;
+            RVEventId           id;
+            RVEventListener*    listener;   // nullptr if cancelled
+            uint64_t            tag;
+        } Event;
+
+    private:
+        uint64_t                now;
+        RVEventId               next_id;
+
+        std::vector<Event>      heap;       // min-heap on (when, id)
+
+        static bool             Later(const Event& a, const Event& b) noexcept;
+
+        void                    Fire(uint64_t until) noexcept;
+
+    public:
+        RVEventQueue() noexcept;
+        RVEventQueue(const RVEventQueue& obj) = delete;
+        ~RVEventQueue() noexcept;
+
+        uint64_t                GetNow() const noexcept;
+        uint64_t                GetNext() noexcept;
+        size_t                  GetPendingCount() const noexcept;
+
+        RVEventId               Schedule(uint64_t when, RVEventListener* listener, uint64_t tag = 0) noexcept;
+        RVEventId               ScheduleAfter(uint64_t delay, RVEventListener* listener, uint64_t tag = 0) noexcept;
+        bool                    Cancel(RVEventId id) noexcept;
+
+        void                    Advance(uint64_t to) noexcept;
+        void                    Step() noexcept;
+
+        void                    Reset() noexcept;
+
+        void                    operator=(const RVEventQueue& obj) = delete;
+    };
+
+
+    // RISC-V MMIO Device
+    class RVDevice { // *pure virtual*
+    public:
+        virtual ~RVDevice() noexcept { }
+
+        virtual const char*     GetName() const noexcept = 0;
+        virtual addr_t          GetSize() const noexcept = 0;
+
+        virtual RVMOPStatus     Read (addr_t offset, RVMOPWidth width, data_t* dst) noexcept = 0;
+        virtual RVMOPStatus     Write(addr_t offset, RVMOPWidth width, data_t  src) noexcept = 0;
+    };
+
+    // RISC-V Interrupt Target, receiving interrupt line levels from devices
+    class RVInterruptTarget {
+    public:
+        virtual void            SetInterruptPending(RVTrapCause cause, bool pending) noexcept = 0;
+    };
+
+
+    // RISC-V Device Bus, MMIO devices mapped over backing memory
+    // *NOTICE: Device ranges are non-overlapping intervals in an ordered tree keyed on base,
+    //          looked up by predecessor search. Instruction fetch from device ranges faults.
+    class RVDeviceBus : public RVMemoryInterface {
+    public:
+        typedef struct {
+            addr_t      base;
+            addr_t      size;
+            RVDevice*   device;
+        } Mapping;
+
+    private:
+        RVMemoryInterface*          memory;
+
+        std::map<addr_t, Mapping>   mappings;
+
+        addr_t                      lowest;
+        addr_t                      highest;    // inclusive
+
+        const Mapping*              last;
+
+    public:
+        RVDeviceBus(RVMemoryInterface* memory = nullptr) noexcept;
+        RVDeviceBus(const RVDeviceBus& obj) = delete;
+        ~RVDeviceBus() noexcept;
+
+        RVMemoryInterface*      GetMemory() noexcept;
+        void                    SetMemory(RVMemoryInterface* memory) noexcept;
+
+        bool                    Map(addr_t base, RVDevice* device) noexcept;
+        bool                    Unmap(RVDevice* device) noexcept;
+
+        size_t                  GetMappingCount() const noexcept;
+        const Mapping*          Find(addr_t address) noexcept;
+
+        virtual RVMOPStatus     ReadInsn (addr_t address, RVMOPWidth width, data_t* dst) override;
+        virtual RVMOPStatus     ReadData (addr_t address, RVMOPWidth width, data_t* dst) override;
+        virtual RVMOPStatus     WriteInsn(addr_t address, RVMOPWidth width, data_t  src) override;
+        virtual RVMOPStatus     WriteData(addr_t address, RVMOPWidth width, data_t  src) override;
+
+        void                    operator=(const RVDeviceBus& obj) = delete;
+    };
+
+
+    // CLINT, machine timer and software interrupt
+    class RVCLINT : public RVDevice, public RVEventListener {
+    private:
+        RVEventQueue*           queue;
+        RVInterruptTarget*      target;
+
+        uint64_t                insns_per_tick;
+        uint64_t                mtime_offset;
+        uint64_t                mtimecmp;
+        uint32_t                msip;
+
+        RVEventId               event;
+        bool                    scheduled;
+
+        void                    UpdateTimer() noexcept;
+
+    public:
+        RVCLINT(RVEventQueue* queue, RVInterruptTarget* target = nullptr,
+                uint64_t insns_per_tick = RV_CLINT_DEFAULT_INSNS_PER_TICK) noexcept;
+        RVCLINT(const RVCLINT& obj) = delete;
+        ~RVCLINT() noexcept;
+
+        RVInterruptTarget*      GetTarget() noexcept;
+        void                    SetTarget(RVInterruptTarget* target) noexcept;
+
+        uint64_t                GetInsnsPerTick() const noexcept;
+        void                    SetInsnsPerTick(uint64_t insns_per_tick) noexcept;
+
+        uint64_t                GetMTime() const noexcept;
+        void                    SetMTime(uint64_t mtime) noexcept;
+
+        uint64_t                GetMTimeCmp() const noexcept;
+        void                    SetMTimeCmp(uint64_t mtimecmp) noexcept;
+
+        uint32_t                GetMSIP() const noexcept;
+        void                    SetMSIP(uint32_t msip) noexcept;
+
+        virtual const char*     GetName() const noexcept override;
+        virtual addr_t          GetSize() const noexcept override;
+
+        virtual RVMOPStatus     Read (addr_t offset, RVMOPWidth width, data_t* dst) noexcept override;
+        virtual RVMOPStatus     Write(addr_t offset, RVMOPWidth width, data_t  src) noexcept override;
+
+        virtual void            OnEvent(RVEventQueue& queue, uint64_t tag) noexcept override;
+
+        void                    operator=(const RVCLINT& obj) = delete;
+    };
+
+
+    // Console, transmitted bytes collected (and echoed to output stream if any), received bytes
+    // fed by the host, optionally delayed in simulated time
+    class RVConsole : public RVDevice, public RVEventListener {
+    private:
+        RVEventQueue*               queue;
+        std::ostream*               output;
+
+        std::string                 transmitted;
+        std::deque<uint8_t>         received;
+
+        std::vector<std::string>    staged;
+
+    public:
+        RVConsole(RVEventQueue* queue, std::ostream* output = nullptr) noexcept;
+        RVConsole(const RVConsole& obj) = delete;
+        ~RVConsole() noexcept;
+
+        std::ostream*           GetOutput() noexcept;
+        void                    SetOutput(std::ostream* output) noexcept;
+
+        const std::string&      GetTransmitted() const noexcept;
+        void                    ClearTransmitted() noexcept;
+
+        void                    Receive(const std::string& data, uint64_t delay = 0) noexcept;
+        bool                    IsReceiveReady() const noexcept;
+
+        virtual const char*     GetName() const noexcept override;
+        virtual addr_t          GetSize() const noexcept override;
+
+        virtual RVMOPStatus     Read (addr_t offset, RVMOPWidth width, data_t* dst) noexcept override;
+        virtual RVMOPStatus     Write(addr_t offset, RVMOPWidth width, data_t  src) noexcept override;
+
+        virtual void            OnEvent(RVEventQueue& queue, uint64_t tag) noexcept override;
+
+        void                    operator=(const RVConsole& obj) = delete;
+    };
+
+
+    // RISC-V Platform, single hart driven with device bus and event queue
+    class RVPlatform : public RVInterruptTarget {
+    private:
+        RVInstance*             instance;
+
+        RVEventQueue            queue;
+        RVDeviceBus             bus;
+
+        uint32_t                pending;        // bit of each pending interrupt cause
+
+        bool                    fast_forward;
+        bool                    stalled;
+
+        uint64_t                wfi_count;
+        uint64_t                skipped;
+
+        bool                    Deliver() noexcept;
+
+    public:
+        RVPlatform(RVMemoryInterface* memory = nullptr) noexcept;
+        RVPlatform(const RVPlatform& obj) = delete;
+        ~RVPlatform() noexcept;
+
+        RVInstance*             GetInstance() noexcept;
+        void                    SetInstance(RVInstance* instance) noexcept;
+
+        RVEventQueue&           GetQueue() noexcept;
+        RVDeviceBus&            GetBus() noexcept;
+
+        bool                    IsFastForward() const noexcept;
+        void                    SetFastForward(bool fast_forward) noexcept;
+
+        uint32_t                GetPending() const noexcept;
+        virtual void            SetInterruptPending(RVTrapCause cause, bool pending) noexcept override;
+
+        bool                    IsStalled() const noexcept;
+        uint64_t                GetWFICount() const noexcept;
+        uint64_t                GetSkipped() const noexcept;
+
+        RVExecStatus            Step() noexcept;
+        RVExecStatus            Run(uint64_t max_insns, uint64_t* executed = nullptr) noexcept;
+
+        void                    operator=(const RVPlatform& obj) = delete;
+    };
+}
+
+
+// device register helpers
+namespace Jasse {
+
+    // read of register value, at byte offset inside the register
+    static inline RVMOPStatus __RVDevice_ReadRegister(uint64_t value, addr_t offset, uint32_t size, RVMOPWidth width, data_t* dst) noexcept
+    {
+        if (offset + width.length > size)
+            return MOP_ACCESS_FAULT;
+
+        dst->data64 = (value >> (offset * 8)) & width.mask;
+
+        return MOP_SUCCESS;
+    }
+
+    // write into register value, at byte offset inside the register
+    static inline RVMOPStatus __RVDevice_WriteRegister(uint64_t& value, addr_t offset, uint32_t size, RVMOPWidth width, data_t src) noexcept
+    {
+        if (offset + width.length > size)
+            return MOP_ACCESS_FAULT;
+
+        value = (value & ~(width.mask << (offset * 8))) | ((src.data64 & width.mask) << (offset * 8));
+
+        return MOP_SUCCESS;
+    }
+}
+
+
+// Implementation of: class RVEventQueue
+namespace Jasse {
+    /*
+    uint64_t                now;
+    RVEventId               next_id;
+
+    std::vector<Event>      heap;
+    */
+
+    RVEventQueue::RVEventQueue() noexcept
+        : now       (0)
+        , next_id   (0)
+        , heap      ()
+    { }
+
+    RVEventQueue::~RVEventQueue() noexcept
+    { }
+
+    inline bool RVEventQueue::Later(const Event& a, const Event& b) noexcept
+    {
+        return a.when != b.when ? a.when > b.when : a.id > b.id;
+    }
+
+    inline uint64_t RVEventQueue::GetNow() const noexcept
+    {
+        return now;
+    }
+
+    uint64_t RVEventQueue::GetNext() noexcept
+    {
+        // cancelled events dropped lazily
+        while (!heap.empty() && !heap.front().listener)
+        {
+            std::pop_heap(heap.begin(), heap.end(), &Later);
+            heap.pop_back();
+        }
+
+        return heap.empty() ? RV_EVENT_NEVER : heap.front().when;
+    }
+
+    size_t RVEventQueue::GetPendingCount() const noexcept
+    {
+        return std::count_if(heap.begin(), heap.end(), [] (const Event& event) { return event.listener; });
+    }
+
+    RVEventId RVEventQueue::Schedule(uint64_t when, RVEventListener* listener, uint64_t tag) noexcept
+    {
+        RVEventId id = next_id++;
+
+        heap.push_back(Event { std::max(when, now), id, listener, tag });
+        std::push_heap(heap.begin(), heap.end(), &Later);
+
+        return id;
+    }
+
+    inline RVEventId RVEventQueue::ScheduleAfter(uint64_t delay, RVEventListener* listener, uint64_t tag) noexcept
+    {
+        return Schedule(delay > RV_EVENT_NEVER - now ? RV_EVENT_NEVER : now + delay, listener, tag);
+    }
+
+    bool RVEventQueue::Cancel(RVEventId id) noexcept
+    {
+        // *NOTICE: Linear search, only a few events pending per device.
+        for (Event& event : heap)
+            if (event.id == id && event.listener)
+            {
+                event.listener = nullptr;
+                return true;
+            }
+
+        return false;
+    }
+
+    void RVEventQueue::Fire(uint64_t until) noexcept
+    {
+        while (!heap.empty() && heap.front().when <= until)
+        {
+            std::pop_heap(heap.begin(), heap.end(), &Later);
+
+            Event event = heap.back();
+            heap.pop_back();
+
+            if (!event.listener)
+                continue;
+
+            now = event.when;
+
+            event.listener->OnEvent(*this, event.tag);
+        }
+    }
+
+    inline void RVEventQueue::Advance(uint64_t to) noexcept
+    {
+        if (!heap.empty() && heap.front().when <= to)
+            Fire(to);
+
+        now = to;
+    }
+
+    inline void RVEventQueue::Step() noexcept
+    {
+        Advance(now + 1);
+    }
+
+    void RVEventQueue::Reset() noexcept
+    {
+        now     = 0;
+        next_id = 0;
+
+        heap.clear();
+    }
+}
+
+
+// Implementation of: class RVDeviceBus
+namespace Jasse {
+    /*
+    RVMemoryInterface*          memory;
+
+    std::map<addr_t, Mapping>   mappings;
+
+    addr_t                      lowest;
+    addr_t                      highest;
+
+    const Mapping*              last;
+    */
+
+    RVDeviceBus::RVDeviceBus(RVMemoryInterface* memory) noexcept
+        : memory    (memory)
+        , mappings  ()
+        , lowest    (UINT64_MAX)
+        , highest   (0)
+        , last      (nullptr)
+    { }
+
+    RVDeviceBus::~RVDeviceBus() noexcept
+    { }
+
+    inline RVMemoryInterface* RVDeviceBus::GetMemory() noexcept
+    {
+        return memory;
+    }
+
+    inline void RVDeviceBus::SetMemory(RVMemoryInterface* memory) noexcept
+    {
+        this->memory = memory;
+    }
+
+    bool RVDeviceBus::Map(addr_t base, RVDevice* device) noexcept
+    {
+        addr_t size = device->GetSize();
+
+        if (!size || base + (size - 1) < base)
+            return false;
+
+        // overlapping with successor or predecessor
+        auto next = mappings.lower_bound(base);
+
+        if (next != mappings.end() && next->second.base <= base + (size - 1))
+            return false;
+
+        if (next != mappings.begin())
+        {
+            auto prev = std::prev(next);
+
+            if (prev->second.base + (prev->second.size - 1) >= base)
+                return false;
+        }
+
+        mappings[base] = Mapping { base, size, device };
+
+        lowest  = std::min(lowest,  base);
+        highest = std::max(highest, base + (size - 1));
+
+        last = nullptr;
+
+        return true;
+    }
+
+    bool RVDeviceBus::Unmap(RVDevice* device) noexcept
+    {
+        auto iter = std::find_if(mappings.begin(), mappings.end(),
+            [device] (const std::pair<const addr_t, Mapping>& entry) { return entry.second.device == device; });
+
+        if (iter == mappings.end())
+            return false;
+
+        mappings.erase(iter);
+
+        lowest  = mappings.empty() ? UINT64_MAX : mappings.begin()->second.base;
+        highest = mappings.empty() ? 0 : mappings.rbegin()->second.base + (mappings.rbegin()->second.size - 1);
+
+        last = nullptr;
+
+        return true;
+    }
+
+    inline size_t RVDeviceBus::GetMappingCount() const noexcept
+    {
+        return mappings.size();
+    }
+
+    inline const RVDeviceBus::Mapping* RVDeviceBus::Find(addr_t address) noexcept
+    {
+        // quick rejection for backing memory accesses out of all device ranges
+        if (address < lowest || address > highest)
+            return nullptr;
+
+        if (last && address - last->base < last->size)
+            return last;
+
+        auto iter = mappings.upper_bound(address);
+
+        if (iter == mappings.begin())
+            return nullptr;
+
+        const Mapping& mapping = std::prev(iter)->second;
+
+        if (address - mapping.base >= mapping.size)
+            return nullptr;
+
+        return last = &mapping;
+    }
+
+    RVMOPStatus RVDeviceBus::ReadInsn(addr_t address, RVMOPWidth width, data_t* dst)
+    {
+        if (Find(address))
+            return MOP_ACCESS_FAULT;
+
+        return memory ? memory->ReadInsn(address, width, dst) : MOP_ACCESS_FAULT;
+    }
+
+    RVMOPStatus RVDeviceBus::ReadData(addr_t address, RVMOPWidth width, data_t* dst)
+    {
+        const Mapping* mapping = Find(address);
+
+        if (!mapping)
+            return memory ? memory->ReadData(address, width, dst) : MOP_ACCESS_FAULT;
+
+        if (address - mapping->base + width.length > mapping->size)
+            return MOP_ACCESS_FAULT;
+
+        return mapping->device->Read(address - mapping->base, width, dst);
+    }
+
+    RVMOPStatus RVDeviceBus::WriteInsn(addr_t address, RVMOPWidth width, data_t src)
+    {
+        if (Find(address))
+            return MOP_ACCESS_FAULT;
+
+        return memory ? memory->WriteInsn(address, width, src) : MOP_ACCESS_FAULT;
+    }
+
+    RVMOPStatus RVDeviceBus::WriteData(addr_t address, RVMOPWidth width, data_t src)
+    {
+        const Mapping* mapping = Find(address);
+
+        if (!mapping)
+            return memory ? memory->WriteData(address, width, src) : MOP_ACCESS_FAULT;
+
+        if (address - mapping->base + width.length > mapping->size)
+            return MOP_ACCESS_FAULT;
+
+        return mapping->device->Write(address - mapping->base, width, src);
+    }
+}
+
+
+// Implementation of: class RVCLINT
+namespace Jasse {
+    /*
+    RVEventQueue*           queue;
+    RVInterruptTarget*      target;
+
+    uint64_t                insns_per_tick;
+    uint64_t                mtime_offset;
+    uint64_t                mtimecmp;
+    uint32_t                msip;
+
+    RVEventId               event;
+    bool                    scheduled;
+    */
+
+    RVCLINT::RVCLINT(RVEventQueue* queue, RVInterruptTarget* target, uint64_t insns_per_tick) noexcept
+        : queue             (queue)
+        , target            (target)
+        , insns_per_tick    (insns_per_tick ? insns_per_tick : 1)
+        , mtime_offset      (0)
+        , mtimecmp          (UINT64_MAX)
+        , msip              (0)
+        , event             (0)
+        , scheduled         (false)
+    { }
+
+    RVCLINT::~RVCLINT() noexcept
+    {
+        if (scheduled)
+            queue->Cancel(event);
+    }
+
+    inline RVInterruptTarget* RVCLINT::GetTarget() noexcept
+    {
+        return target;
+    }
+
+    void RVCLINT::SetTarget(RVInterruptTarget* target) noexcept
+    {
+        this->target = target;
+
+        UpdateTimer();
+    }
+
+    inline uint64_t RVCLINT::GetInsnsPerTick() const noexcept
+    {
+        return insns_per_tick;
+    }
+
+    void RVCLINT::SetInsnsPerTick(uint64_t insns_per_tick) noexcept
+    {
+        // mtime kept continuous across re-configuration
+        uint64_t mtime = GetMTime();
+
+        this->insns_per_tick = insns_per_tick ? insns_per_tick : 1;
+
+        SetMTime(mtime);
+    }
+
+    inline uint64_t RVCLINT::GetMTime() const noexcept
+    {
+        return queue->GetNow() / insns_per_tick + mtime_offset;
+    }
+
+    void RVCLINT::SetMTime(uint64_t mtime) noexcept
+    {
+        mtime_offset = mtime - queue->GetNow() / insns_per_tick;
+
+        UpdateTimer();
+    }
+
+    inline uint64_t RVCLINT::GetMTimeCmp() const noexcept
+    {
+        return mtimecmp;
+    }
+
+    void RVCLINT::SetMTimeCmp(uint64_t mtimecmp) noexcept
+    {
+        this->mtimecmp = mtimecmp;
+
+        UpdateTimer();
+    }
+
+    inline uint32_t RVCLINT::GetMSIP() const noexcept
+    {
+        return msip;
+    }
+
+    void RVCLINT::SetMSIP(uint32_t msip) noexcept
+    {
+        this->msip = msip & 0x1;
+
+        if (target)
+            target->SetInterruptPending(INTERRUPT_M_SOFTWARE, this->msip);
+    }
+
+    void RVCLINT::UpdateTimer() noexcept
+    {
+        if (scheduled)
+        {
+            queue->Cancel(event);
+            scheduled = false;
+        }
+
+        uint64_t mtime = GetMTime();
+
+        if (target)
+            target->SetInterruptPending(INTERRUPT_M_TIMER, mtime >= mtimecmp);
+
+        if (mtime >= mtimecmp)
+            return;
+
+        // next tick boundary of 'mtime' reaching 'mtimecmp', never scheduled on overflow
+        uint64_t ticks = mtimecmp - mtime;
+        uint64_t now   = queue->GetNow();
+
+        if (ticks > (RV_EVENT_NEVER - now) / insns_per_tick)
+            return;
+
+        event     = queue->Schedule(now - now % insns_per_tick + ticks * insns_per_tick, this);
+        scheduled = true;
+    }
+
+    const char* RVCLINT::GetName() const noexcept
+    {
+        return "clint";
+    }
+
+    addr_t RVCLINT::GetSize() const noexcept
+    {
+        return RV_CLINT_SIZE;
+    }
+
+    RVMOPStatus RVCLINT::Read(addr_t offset, RVMOPWidth width, data_t* dst) noexcept
+    {
+        if (offset >= RV_CLINT_MTIME && offset < RV_CLINT_MTIME + 8)
+            return __RVDevice_ReadRegister(GetMTime(), offset - RV_CLINT_MTIME, 8, width, dst);
+
+        if (offset >= RV_CLINT_MTIMECMP && offset < RV_CLINT_MTIMECMP + 8)
+            return __RVDevice_ReadRegister(mtimecmp, offset - RV_CLINT_MTIMECMP, 8, width, dst);
+
+        if (offset < RV_CLINT_MSIP + 4)
+            return __RVDevice_ReadRegister(msip, offset - RV_CLINT_MSIP, 4, width, dst);
+
+        dst->data64 = 0; // reserved, read as zero
+
+        return MOP_SUCCESS;
+    }
+
+    RVMOPStatus RVCLINT::Write(addr_t offset, RVMOPWidth width, data_t src) noexcept
+    {
+        RVMOPStatus status = MOP_SUCCESS;
+
+        if (offset >= RV_CLINT_MTIME && offset < RV_CLINT_MTIME + 8)
+        {
+            uint64_t value = GetMTime();
+
+            if ((status = __RVDevice_WriteRegister(value, offset - RV_CLINT_MTIME, 8, width, src)) == MOP_SUCCESS)
+                SetMTime(value);
+        }
+        else if (offset >= RV_CLINT_MTIMECMP && offset < RV_CLINT_MTIMECMP + 8)
+        {
+            uint64_t value = mtimecmp;
+
+            if ((status = __RVDevice_WriteRegister(value, offset - RV_CLINT_MTIMECMP, 8, width, src)) == MOP_SUCCESS)
+                SetMTimeCmp(value);
+        }
+        else if (offset < RV_CLINT_MSIP + 4)
+        {
+            uint64_t value = msip;
+
+            if ((status = __RVDevice_WriteRegister(value, offset - RV_CLINT_MSIP, 4, width, src)) == MOP_SUCCESS)
+                SetMSIP((uint32_t) value);
+        }
+
+        return status;
+    }
+
+    void RVCLINT::OnEvent(RVEventQueue&, uint64_t) noexcept
+    {
+        scheduled = false;
+
+        UpdateTimer();
+    }
+}
+
+
+// Implementation of: class RVConsole
+namespace Jasse {
+    /*
+    RVEventQueue*               queue;
+    std::ostream*               output;
+
+    std::string                 transmitted;
+    std::deque<uint8_t>         received;
+
+    std::vector<std::string>    staged;
+    */
+
+    RVConsole::RVConsole(RVEventQueue* queue, std::ostream* output) noexcept
+        : queue         (queue)
+        , output        (output)
+        , transmitted   ()
+        , received      ()
+        , staged        ()
+    { }
+
+    RVConsole::~RVConsole() noexcept
+    { }
+
+    inline std::ostream* RVConsole::GetOutput() noexcept
+    {
+        return output;
+    }
+
+    inline void RVConsole::SetOutput(std::ostream* output) noexcept
+    {
+        this->output = output;
+    }
+
+    inline const std::string& RVConsole::GetTransmitted() const noexcept
+    {
+        return transmitted;
+    }
+
+    inline void RVConsole::ClearTransmitted() noexcept
+    {
+        transmitted.clear();
+    }
+
+    void RVConsole::Receive(const std::string& data, uint64_t delay) noexcept
+    {
+        if (!delay)
+        {
+            received.insert(received.end(), data.begin(), data.end());
+            return;
+        }
+
+        staged.push_back(data);
+
+        queue->ScheduleAfter(delay, this, staged.size() - 1);
+    }
+
+    inline bool RVConsole::IsReceiveReady() const noexcept
+    {
+        return !received.empty();
+    }
+
+    const char* RVConsole::GetName() const noexcept
+    {
+        return "console";
+    }
+
+    addr_t RVConsole::GetSize() const noexcept
+    {
+        return RV_CONSOLE_SIZE;
+    }
+
+    RVMOPStatus RVConsole::Read(addr_t offset, RVMOPWidth, data_t* dst) noexcept
+    {
+        dst->data64 = 0;
+
+        switch (offset)
+        {
+            case RV_CONSOLE_RBR_THR:
+                if (!received.empty())
+                {
+                    dst->data64 = received.front();
+                    received.pop_front();
+                }
+                break;
+
+            case RV_CONSOLE_LSR:
+                dst->data64 = RV_CONSOLE_LSR_THRE | RV_CONSOLE_LSR_TEMT
+                            | (received.empty() ? 0 : RV_CONSOLE_LSR_DR);
+                break;
+
+            default:
+                break;
+        }
+
+        return MOP_SUCCESS;
+    }
+
+    RVMOPStatus RVConsole::Write(addr_t offset, RVMOPWidth, data_t src) noexcept
+    {
+        if (offset == RV_CONSOLE_RBR_THR)
+        {
+            transmitted.push_back((char) src.data8);
+
+            if (output)
+                output->put((char) src.data8);
+        }
+
+        return MOP_SUCCESS;
+    }
+
+    void RVConsole::OnEvent(RVEventQueue&, uint64_t tag) noexcept
+    {
+        std::string& data = staged[tag];
+
+        received.insert(received.end(), data.begin(), data.end());
+
+        data.clear();
+        data.shrink_to_fit();
+    }
+}
+
+
+// Implementation of: class RVPlatform
+namespace Jasse {
+    /*
+    RVInstance*             instance;
+
+    RVEventQueue            queue;
+    RVDeviceBus             bus;
+
+    uint32_t                pending;
+
+    bool                    fast_forward;
+    bool                    stalled;
+
+    uint64_t                wfi_count;
+    uint64_t                skipped;
+    */
+
+    RVPlatform::RVPlatform(RVMemoryInterface* memory) noexcept
+        : instance      (nullptr)
+        , queue         ()
+        , bus           (memory)
+        , pending       (0)
+        , fast_forward  (true)
+        , stalled       (false)
+        , wfi_count     (0)
+        , skipped       (0)
+    { }
+
+    RVPlatform::~RVPlatform() noexcept
+    { }
+
+    inline RVInstance* RVPlatform::GetInstance() noexcept
+    {
+        return instance;
+    }
+
+    inline void RVPlatform::SetInstance(RVInstance* instance) noexcept
+    {
+        this->instance = instance;
+    }
+
+    inline RVEventQueue& RVPlatform::GetQueue() noexcept
+    {
+        return queue;
+    }
+
+    inline RVDeviceBus& RVPlatform::GetBus() noexcept
+    {
+        return bus;
+    }
+
+    inline bool RVPlatform::IsFastForward() const noexcept
+    {
+        return fast_forward;
+    }
+
+    inline void RVPlatform::SetFastForward(bool fast_forward) noexcept
+    {
+        this->fast_forward = fast_forward;
+    }
+
+    inline uint32_t RVPlatform::GetPending() const noexcept
+    {
+        return pending;
+    }
+
+    void RVPlatform::SetInterruptPending(RVTrapCause cause, bool pending) noexcept
+    {
+        if (pending)
+            this->pending |=  (1U << cause);
+        else
+            this->pending &= ~(1U << cause);
+    }
+
+    inline bool RVPlatform::IsStalled() const noexcept
+    {
+        return stalled;
+    }
+
+    inline uint64_t RVPlatform::GetWFICount() const noexcept
+    {
+        return wfi_count;
+    }
+
+    inline uint64_t RVPlatform::GetSkipped() const noexcept
+    {
+        return skipped;
+    }
+
+    bool RVPlatform::Deliver() noexcept
+    {
+        RVCSR* mstatus = instance->GetCSRs().GetMachineTrapCSRs().mstatus;
+
+        if (!mstatus || !GET_CSR_FIELD(mstatus->Read(&instance->GetCSRs()), CSR_mstatus_FIELD_MIE))
+            return false;
+
+        // priority: MEI > MSI > MTI
+        static constexpr RVTrapCause priority[] = {
+            INTERRUPT_M_EXTERNAL, INTERRUPT_M_SOFTWARE, INTERRUPT_M_TIMER
+        };
+
+        for (RVTrapCause cause : priority)
+            if (pending & (1U << cause))
+            {
+                instance->Interrupt(cause);
+                return true;
+            }
+
+        return false;
+    }
+
+    RVExecStatus RVPlatform::Step() noexcept
+    {
+        stalled = false;
+
+        // interrupts taken ahead of the next instruction
+        if (pending)
+            Deliver();
+
+        RVExecStatus status = instance->Eval();
+
+        queue.Step();
+
+        if (status != EXEC_WAIT_FOR_INTERRUPT)
+            return status;
+
+        //
+        wfi_count++;
+
+        if (!pending)
+        {
+            if (!fast_forward) // spinning on WFI slot by slot
+                return status;
+
+            // simulated time jumps to the next event, until any interrupt pending
+            // *NOTICE: Idle slots fed to counters as idle cycles, 'mcycle' and 'time' advanced.
+            while (!pending)
+            {
+                uint64_t next = queue.GetNext();
+
+                if (next == RV_EVENT_NEVER)
+                {
+                    stalled = true;
+                    return status;
+                }
+
+                uint64_t idle = next - queue.GetNow();
+
+                instance->GetCSRs().GetCounters().Idle(idle);
+                skipped += idle;
+
+                queue.Advance(next);
+            }
+        }
+
+        // resumed, past WFI
+        if (instance->GetArch().XLEN() == XLEN32)
+            instance->GetArch().SetPC32(instance->GetArch().PC().pc32 + 4);
+        else
+            instance->GetArch().SetPC64(instance->GetArch().PC().pc64 + 4);
+
+        return status;
+    }
+
+    RVExecStatus RVPlatform::Run(uint64_t max_insns, uint64_t* executed) noexcept
+    {
+        RVExecStatus status = EXEC_SEQUENTIAL;
+
+        uint64_t count = 0;
+
+        while (count < max_insns)
+        {
+            status = Step();
+
+            count++;
+
+            if (stalled)
+                break;
+
+            if (status == EXEC_FETCH_ACCESS_FAULT
+             || status == EXEC_FETCH_ADDRESS_MISALIGNED
+             || status == EXEC_NOT_DECODED
+             || status == EXEC_NOT_IMPLEMENTED)
+                break;
+        }
+
+        if (executed)
+            *executed = count;
+
+        return status;
+    }
+}
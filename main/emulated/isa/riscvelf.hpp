@@ -0,0 +1,710 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture Emulator (Jasse)
+//
+// ELF32/ELF64 program loader, with PT_LOAD segment mapping and sorted symbol index
+//
+// *NOTICE: Little-endian RISC-V ELF only. The image file is mapped read-only and kept mapped
+//          while opened, segments and symbol names are referenced in place (zero-copy).
+//          Segments are loaded at virtual addresses by default (no address translation in
+//          Jasse), physical addresses on demand.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+
+#if defined(__unix__)
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+#include "riscv.hpp"
+#include "riscvmemutil.hpp"
+
+
+// ELF definitions in use (System V ABI)
+#define RV_ELF_MAGIC                            0x464C457FU     // "\x7F" "ELF", little-endian
+
+#define RV_ELF_CLASS_32                         1
+#define RV_ELF_CLASS_64                         2
+
+#define RV_ELF_DATA_LSB                         1
+
+#define RV_ELF_MACHINE_RISCV                    243
+
+#define RV_ELF_PT_LOAD                          1
+
+#define RV_ELF_SHT_SYMTAB                       2
+
+#define RV_ELF_SHN_UNDEF                        0
+
+#define RV_ELF_STT_NOTYPE                       0
+#define RV_ELF_STT_OBJECT                       1
+#define RV_ELF_STT_FUNC                         2
+#define RV_ELF_STT_SECTION                      3
+#define RV_ELF_STT_FILE                         4
+
+
+namespace Jasse {
+
+    // ELF structures, of each class
+    typedef struct {
+        uint8_t     ident[16];
+        uint16_t    type;
+        uint16_t    machine;
+        uint32_t    version;
+        uint32_t    entry;
+        uint32_t    phoff;
+        uint32_t    shoff;
+        uint32_t    flags;
+        uint16_t    ehsize;
+        uint16_t    phentsize;
+        uint16_t    phnum;
+        uint16_t    shentsize;
+        uint16_t    shnum;
+        uint16_t    shstrndx;
+    } RVELF32Header;
+
+    typedef struct {
+        uint8_t     ident[16];
+        uint16_t    type;
+        uint16_t    machine;
+        uint32_t    version;
+        uint64_t    entry;
+        uint64_t    phoff;
+        uint64_t    shoff;
+        uint32_t    flags;
+        uint16_t    ehsize;
+        uint16_t    phentsize;
+        uint16_t    phnum;
+        uint16_t    shentsize;
+        uint16_t    shnum;
+        uint16_t    shstrndx;
+    } RVELF64Header;
+
+    typedef struct {
+        uint32_t    type;
+        uint32_t    offset;
+        uint32_t    vaddr;
+        uint32_t    paddr;
+        uint32_t    filesz;
+        uint32_t    memsz;
+        uint32_t    flags;
+        uint32_t    align;
+    } RVELF32ProgramHeader;
+
+    typedef struct {
+        uint32_t    type;
+        uint32_t    flags;
+        uint64_t    offset;
+        uint64_t    vaddr;
+        uint64_t    paddr;
+        uint64_t    filesz;
+        uint64_t    memsz;
+        uint64_t    align;
+    } RVELF64ProgramHeader;
+
+    typedef struct {
+        uint32_t    name;
+        uint32_t    type;
+        uint32_t    flags;
+        uint32_t    addr;
+        uint32_t    offset;
+        uint32_t    size;
+        uint32_t    link;
+        uint32_t    info;
+        uint32_t    addralign;
+        uint32_t    entsize;
+    } RVELF32SectionHeader;
+
+    typedef struct {
+        uint32_t    name;
+        uint32_t    type;
+        uint64_t    flags;
+        uint64_t    addr;
+        uint64_t    offset;
+        uint64_t    size;
+        uint32_t    link;
+        uint32_t    info;
+        uint64_t    addralign;
+        uint64_t    entsize;
+    } RVELF64SectionHeader;
+
+    typedef struct {
+        uint32_t    name;
+        uint32_t    value;
+        uint32_t    size;
+        uint8_t     info;
+        uint8_t     other;
+        uint16_t    shndx;
+    } RVELF32Symbol;
+
+    typedef struct {
+        uint32_t    name;
+        uint8_t     info;
+        uint8_t     other;
+        uint16_t    shndx;
+        uint64_t    value;
+        uint64_t    size;
+    } RVELF64Symbol;
+
+
+    // RISC-V ELF Loader Status
+    typedef enum {
+        ELF_SUCCESS = 0,
+        ELF_OPEN_FAILED,
+        ELF_NOT_ELF,
+        ELF_UNSUPPORTED,
+        ELF_MALFORMED,
+        ELF_NOT_OPENED,
+        ELF_LOAD_FAILED
+    } RVELFStatus;
+
+    // RISC-V ELF Loadable Segment
+    typedef struct {
+        addr_t      vaddr;
+        addr_t      paddr;
+        uint64_t    offset;
+        uint64_t    filesz;
+        uint64_t    memsz;
+        uint32_t    flags;
+    } RVELFSegment;
+
+    // RISC-V ELF Symbol, name referenced in mapped image
+    typedef struct {
+        addr_t      address;
+        uint64_t    size;
+        const char* name;
+        uint8_t     type;
+        uint8_t     binding;
+    } RVELFSymbol;
+
+
+    // RISC-V ELF Symbol Index, sorted by address for address-to-symbol queries
+    class RVELFSymbolIndex {
+    private:
+        std::vector<RVELFSymbol>                        symbols;
+        std::unordered_map<std::string_view, size_t>    names;
+
+    public:
+        RVELFSymbolIndex() noexcept;
+        ~RVELFSymbolIndex() noexcept;
+
+        void                    Clear() noexcept;
+        void                    Add(const RVELFSymbol& symbol) noexcept;
+        void                    Build() noexcept;
+
+        size_t                  GetCount() const noexcept;
+        const RVELFSymbol&      Get(size_t index) const noexcept;
+
+        const RVELFSymbol*      Find(addr_t address) const noexcept;
+        const RVELFSymbol*      Lookup(std::string_view name) const noexcept;
+
+        std::vector<RVELFSymbol>::const_iterator    Begin() const noexcept;
+        std::vector<RVELFSymbol>::const_iterator    End() const noexcept;
+    };
+
+
+    // RISC-V ELF Image
+    class RVELFImage {
+    private:
+        int                         fd;
+        const uint8_t*              data;
+        size_t                      size;
+
+        XLen                        xlen;
+        addr_t                      entry;
+
+        bool                        physical;
+
+        std::vector<RVELFSegment>   segments;
+        RVELFSymbolIndex            symbols;
+
+        template<class THeader, class TProgramHeader, class TSectionHeader, class TSymbol>
+        RVELFStatus             Parse() noexcept;
+
+        bool                    InRange(uint64_t offset, uint64_t length) const noexcept;
+        addr_t                  GetLoadAddress(const RVELFSegment& segment) const noexcept;
+
+    public:
+        RVELFImage() noexcept;
+        RVELFImage(const RVELFImage& obj) = delete;
+        ~RVELFImage() noexcept;
+
+        RVELFStatus             Open(const char* path) noexcept;
+        void                    Close() noexcept;
+
+        bool                    IsOpened() const noexcept;
+
+        const uint8_t*          GetData() const noexcept;
+        size_t                  GetSize() const noexcept;
+
+        XLen                    GetXLEN() const noexcept;
+        addr_t                  GetEntry() const noexcept;
+
+        bool                    IsPhysical() const noexcept;
+        void                    SetPhysical(bool physical) noexcept;
+
+        const std::vector<RVELFSegment>&    GetSegments() const noexcept;
+        const RVELFSymbolIndex&             GetSymbols() const noexcept;
+
+        RVELFStatus             Load(RVMemoryInterface* memory) const noexcept;
+        RVELFStatus             Load(MappedLinearMemory* memory, uint64_t* mapped = nullptr) const noexcept;
+        RVELFStatus             Load(void* buffer, addr_t base, size_t length) const noexcept;
+
+        RVInstance::Builder&    Setup(RVInstance::Builder& builder) const noexcept;
+
+        void                    operator=(const RVELFImage& obj) = delete;
+    };
+}
+
+
+// Implementation of: class RVELFSymbolIndex
+namespace Jasse {
+    /*
+    std::vector<RVELFSymbol>                        symbols;
+    std::unordered_map<std::string_view, size_t>    names;
+    */
+
+    RVELFSymbolIndex::RVELFSymbolIndex() noexcept
+        : symbols   ()
+        , names     ()
+    { }
+
+    RVELFSymbolIndex::~RVELFSymbolIndex() noexcept
+    { }
+
+    void RVELFSymbolIndex::Clear() noexcept
+    {
+        symbols.clear();
+        names.clear();
+    }
+
+    inline void RVELFSymbolIndex::Add(const RVELFSymbol& symbol) noexcept
+    {
+        symbols.push_back(symbol);
+    }
+
+    void RVELFSymbolIndex::Build() noexcept
+    {
+        // ordered by address, the largest last among symbols of the same address
+        std::sort(symbols.begin(), symbols.end(), [] (const RVELFSymbol& a, const RVELFSymbol& b) {
+            return a.address != b.address ? a.address < b.address : a.size < b.size;
+        });
+
+        names.clear();
+        names.reserve(symbols.size());
+
+        for (size_t i = 0; i < symbols.size(); i++)
+            names.emplace(symbols[i].name, i);
+    }
+
+    inline size_t RVELFSymbolIndex::GetCount() const noexcept
+    {
+        return symbols.size();
+    }
+
+    inline const RVELFSymbol& RVELFSymbolIndex::Get(size_t index) const noexcept
+    {
+        return symbols[index];
+    }
+
+    const RVELFSymbol* RVELFSymbolIndex::Find(addr_t address) const noexcept
+    {
+        // the last symbol starting at or below the address, containing it if sized
+        auto iter = std::upper_bound(symbols.begin(), symbols.end(), address,
+            [] (addr_t address, const RVELFSymbol& symbol) { return address < symbol.address; });
+
+        if (iter == symbols.begin())
+            return nullptr;
+
+        const RVELFSymbol& symbol = *std::prev(iter);
+
+        if (symbol.size && address - symbol.address >= symbol.size)
+            return nullptr;
+
+        return &symbol;
+    }
+
+    const RVELFSymbol* RVELFSymbolIndex::Lookup(std::string_view name) const noexcept
+    {
+        auto iter = names.find(name);
+
+        return iter == names.end() ? nullptr : &symbols[iter->second];
+    }
+
+    inline std::vector<RVELFSymbol>::const_iterator RVELFSymbolIndex::Begin() const noexcept
+    {
+        return symbols.begin();
+    }
+
+    inline std::vector<RVELFSymbol>::const_iterator RVELFSymbolIndex::End() const noexcept
+    {
+        return symbols.end();
+    }
+}
+
+
+// Implementation of: class RVELFImage
+namespace Jasse {
+    /*
+    int                         fd;
+    const uint8_t*              data;
+    size_t                      size;
+
+    XLen                        xlen;
+    addr_t                      entry;
+
+    bool                        physical;
+
+    std::vector<RVELFSegment>   segments;
+    RVELFSymbolIndex            symbols;
+    */
+
+    RVELFImage::RVELFImage() noexcept
+        : fd        (-1)
+        , data      (nullptr)
+        , size      (0)
+        , xlen      (XLEN64)
+        , entry     (0)
+        , physical  (false)
+        , segments  ()
+        , symbols   ()
+    { }
+
+    RVELFImage::~RVELFImage() noexcept
+    {
+        Close();
+    }
+
+    RVELFStatus RVELFImage::Open(const char* path) noexcept
+    {
+        Close();
+
+#if defined(__unix__)
+        if ((fd = open(path, O_RDONLY)) < 0)
+            return ELF_OPEN_FAILED;
+
+        struct stat st;
+
+        if (fstat(fd, &st) || st.st_size < (off_t) sizeof(RVELF32Header))
+        {
+            Close();
+            return st.st_size < (off_t) sizeof(RVELF32Header) ? ELF_NOT_ELF : ELF_OPEN_FAILED;
+        }
+
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            Close();
+            return ELF_OPEN_FAILED;
+        }
+
+        data = (const uint8_t*) mapped;
+        size = st.st_size;
+#else
+        return ELF_OPEN_FAILED;
+#endif
+
+        //
+        uint32_t magic;
+        memcpy(&magic, data, sizeof(magic));
+
+        RVELFStatus status;
+
+        if (magic != RV_ELF_MAGIC)
+            status = ELF_NOT_ELF;
+        else if (data[5] != RV_ELF_DATA_LSB)
+            status = ELF_UNSUPPORTED;
+        else if (data[4] == RV_ELF_CLASS_32)
+            status = Parse<RVELF32Header, RVELF32ProgramHeader, RVELF32SectionHeader, RVELF32Symbol>();
+        else if (data[4] == RV_ELF_CLASS_64)
+            status = Parse<RVELF64Header, RVELF64ProgramHeader, RVELF64SectionHeader, RVELF64Symbol>();
+        else
+            status = ELF_UNSUPPORTED;
+
+        if (status != ELF_SUCCESS)
+            Close();
+
+        return status;
+    }
+
+    void RVELFImage::Close() noexcept
+    {
+#if defined(__unix__)
+        if (data)
+            munmap((void*) data, size);
+
+        if (fd >= 0)
+            close(fd);
+#endif
+
+        fd   = -1;
+        data = nullptr;
+        size = 0;
+
+        segments.clear();
+        symbols.Clear();
+    }
+
+    inline bool RVELFImage::InRange(uint64_t offset, uint64_t length) const noexcept
+    {
+        return offset <= size && length <= size - offset;
+    }
+
+    template<class THeader, class TProgramHeader, class TSectionHeader, class TSymbol>
+    RVELFStatus RVELFImage::Parse() noexcept
+    {
+        THeader header;
+
+        if (!InRange(0, sizeof(THeader)))
+            return ELF_MALFORMED;
+
+        memcpy(&header, data, sizeof(THeader));
+
+        if (header.machine != RV_ELF_MACHINE_RISCV)
+            return ELF_UNSUPPORTED;
+
+        xlen  = sizeof(THeader) == sizeof(RVELF32Header) ? XLEN32 : XLEN64;
+        entry = header.entry;
+
+        // program headers, loadable segments
+        if (header.phnum && (header.phentsize < sizeof(TProgramHeader)
+                         || !InRange(header.phoff, (uint64_t) header.phnum * header.phentsize)))
+            return ELF_MALFORMED;
+
+        for (int i = 0; i < header.phnum; i++)
+        {
+            TProgramHeader phdr;
+            memcpy(&phdr, data + header.phoff + (uint64_t) i * header.phentsize, sizeof(TProgramHeader));
+
+            if (phdr.type != RV_ELF_PT_LOAD)
+                continue;
+
+            if (phdr.filesz > phdr.memsz || !InRange(phdr.offset, phdr.filesz))
+                return ELF_MALFORMED;
+
+            segments.push_back(RVELFSegment { phdr.vaddr, phdr.paddr, phdr.offset, phdr.filesz, phdr.memsz, phdr.flags });
+        }
+
+        // section headers, symbol table (optional, stripped images accepted)
+        if (!header.shnum)
+            return ELF_SUCCESS;
+
+        if (header.shentsize < sizeof(TSectionHeader)
+         || !InRange(header.shoff, (uint64_t) header.shnum * header.shentsize))
+            return ELF_MALFORMED;
+
+        auto section = [this, &header] (int index) {
+            TSectionHeader shdr;
+            memcpy(&shdr, data + header.shoff + (uint64_t) index * header.shentsize, sizeof(TSectionHeader));
+            return shdr;
+        };
+
+        for (int i = 0; i < header.shnum; i++)
+        {
+            TSectionHeader symtab = section(i);
+
+            if (symtab.type != RV_ELF_SHT_SYMTAB)
+                continue;
+
+            if (symtab.link >= header.shnum || symtab.entsize < sizeof(TSymbol) || !InRange(symtab.offset, symtab.size))
+                return ELF_MALFORMED;
+
+            TSectionHeader strtab = section(symtab.link);
+
+            if (!InRange(strtab.offset, strtab.size) || !strtab.size || data[strtab.offset + strtab.size - 1])
+                return ELF_MALFORMED;
+
+            const char* strings = (const char*)(data + strtab.offset);
+
+            for (uint64_t offset = 0; offset + symtab.entsize <= symtab.size; offset += symtab.entsize)
+            {
+                TSymbol sym;
+                memcpy(&sym, data + symtab.offset + offset, sizeof(TSymbol));
+
+                uint8_t type = sym.info & 0xF;
+
+                if (sym.shndx == RV_ELF_SHN_UNDEF || type == RV_ELF_STT_SECTION || type == RV_ELF_STT_FILE)
+                    continue;
+
+                if (sym.name >= strtab.size || !strings[sym.name])
+                    continue;
+
+                symbols.Add(RVELFSymbol { sym.value, sym.size, strings + sym.name, type, (uint8_t)(sym.info >> 4) });
+            }
+        }
+
+        symbols.Build();
+
+        return ELF_SUCCESS;
+    }
+
+    inline bool RVELFImage::IsOpened() const noexcept
+    {
+        return data;
+    }
+
+    inline const uint8_t* RVELFImage::GetData() const noexcept
+    {
+        return data;
+    }
+
+    inline size_t RVELFImage::GetSize() const noexcept
+    {
+        return size;
+    }
+
+    inline XLen RVELFImage::GetXLEN() const noexcept
+    {
+        return xlen;
+    }
+
+    inline addr_t RVELFImage::GetEntry() const noexcept
+    {
+        return entry;
+    }
+
+    inline bool RVELFImage::IsPhysical() const noexcept
+    {
+        return physical;
+    }
+
+    inline void RVELFImage::SetPhysical(bool physical) noexcept
+    {
+        this->physical = physical;
+    }
+
+    inline const std::vector<RVELFSegment>& RVELFImage::GetSegments() const noexcept
+    {
+        return segments;
+    }
+
+    inline const RVELFSymbolIndex& RVELFImage::GetSymbols() const noexcept
+    {
+        return symbols;
+    }
+
+    inline addr_t RVELFImage::GetLoadAddress(const RVELFSegment& segment) const noexcept
+    {
+        return physical ? segment.paddr : segment.vaddr;
+    }
+
+    RVELFStatus RVELFImage::Load(RVMemoryInterface* memory) const noexcept
+    {
+        if (!data)
+            return ELF_NOT_OPENED;
+
+        if (MappedLinearMemory* mapped = dynamic_cast<MappedLinearMemory*>(memory))
+            return Load(mapped);
+
+        // through memory interface, double-words on aligned addresses and bytes elsewhere
+        for (const RVELFSegment& segment : segments)
+        {
+            addr_t address = GetLoadAddress(segment);
+
+            for (uint64_t i = 0; i < segment.memsz; )
+            {
+                data_t      value = { 0 };
+                RVMOPWidth  width = MOPW_BYTE;
+
+                if (!((address + i) & 0x7) && i + 8 <= segment.memsz)
+                    width = MOPW_DOUBLE_WORD;
+
+                if (i < segment.filesz)
+                    memcpy(&value, data + segment.offset + i, std::min<uint64_t>(width.length, segment.filesz - i));
+
+                if (memory->WriteData(address + i, width, value) != MOP_SUCCESS)
+                    return ELF_LOAD_FAILED;
+
+                i += width.length;
+            }
+        }
+
+        return ELF_SUCCESS;
+    }
+
+    RVELFStatus RVELFImage::Load(MappedLinearMemory* memory, uint64_t* mapped) const noexcept
+    {
+        if (!data)
+            return ELF_NOT_OPENED;
+
+        // whole file pages mapped (copy-on-write) where page offsets agree, edges copied
+        const size_t page = MappedLinearMemory::GetPageSize();
+
+        uint64_t mapped_bytes = 0;
+
+        for (const RVELFSegment& segment : segments)
+        {
+            addr_t   address = GetLoadAddress(segment);
+            uint8_t* host    = memory->GetHost(address, segment.memsz);
+
+            if (!host)
+                return ELF_LOAD_FAILED;
+
+            uint64_t head = 0, body = 0;
+
+            if ((uintptr_t) host % page == segment.offset % page)
+            {
+                head = std::min<uint64_t>((page - (uintptr_t) host % page) % page, segment.filesz);
+                body = (segment.filesz - head) / page * page;
+            }
+
+            if (body && memory->MapFile(address + head, fd, segment.offset + head, body))
+                mapped_bytes += body;
+            else
+                head = 0, body = 0;
+
+            memcpy(host, data + segment.offset, head);
+            memcpy(host + head + body, data + segment.offset + head + body, segment.filesz - head - body);
+
+            memory->Zero(address + segment.filesz, segment.memsz - segment.filesz);
+        }
+
+        if (mapped)
+            *mapped = mapped_bytes;
+
+        return ELF_SUCCESS;
+    }
+
+    RVELFStatus RVELFImage::Load(void* buffer, addr_t base, size_t length) const noexcept
+    {
+        // flat host buffer of [base, base + length), e.g. ROM arrays of verilated harnesses
+        if (!data)
+            return ELF_NOT_OPENED;
+
+        for (const RVELFSegment& segment : segments)
+        {
+            addr_t address = GetLoadAddress(segment);
+
+            if (address < base || address - base > length || segment.memsz > length - (address - base))
+                return ELF_LOAD_FAILED;
+
+            uint8_t* host = (uint8_t*) buffer + (address - base);
+
+            memcpy(host, data + segment.offset, segment.filesz);
+            memset(host + segment.filesz, 0, segment.memsz - segment.filesz);
+        }
+
+        return ELF_SUCCESS;
+    }
+
+    RVInstance::Builder& RVELFImage::Setup(RVInstance::Builder& builder) const noexcept
+    {
+        builder.XLEN(xlen);
+
+        if (xlen == XLEN32)
+            builder.StartupPC32((arch32_t) entry);
+        else
+            builder.StartupPC64(entry);
+
+        return builder;
+    }
+}
@@ -68,11 +68,15 @@ namespace Jasse {
 
 namespace Jasse {
 
+// Hot machine-mode CSR of trap procedures, without lookup. @see RVCSRSpace::MachineTrapCSRs
+#define __RV_TRAP_REQUIRE_CSR(CSRs, name) \
+    (CSRs->GetMachineTrapCSRs().name ? CSRs->GetMachineTrapCSRs().name : CSRs->RequireCSR(CSR_##name, #name))
+
     // M-mode Trap Enter Procedure
     void TrapEnterM(RVArchitecturalOOC* arch, RVCSRSpace* CSRs, RVTrapType type, RVTrapCause cause) noexcept(false)
     {
         // Write 'mepc' CSR
-        CSRs->RequireCSR(CSR_mepc, "mepc")
+        __RV_TRAP_REQUIRE_CSR(CSRs, mepc)
             ->Write(CSRs, arch->PC().pc64); // always zero-extended in XLEN=32, actually doesn't matter
         
 
@@ -90,12 +94,12 @@ namespace Jasse {
             SET_CSR_MXFIELD(mcause, CSR_mcause_FIELD_EXCEPTION_CODE, cause, MX64);
         }
 
-        CSRs->RequireCSR(CSR_mcause, "mcause")
+        __RV_TRAP_REQUIRE_CSR(CSRs, mcause)
             ->Write(CSRs, mcause);
         
 
         // Write 'mstatus' CSR
-        RVCSR* p_mstatus = CSRs->RequireCSR(CSR_mstatus, "mstatus");
+        RVCSR* p_mstatus = __RV_TRAP_REQUIRE_CSR(CSRs, mstatus);
 
         csr_t mstatus = p_mstatus->Read(CSRs); // read 'mstatus'
 
@@ -112,7 +116,7 @@ namespace Jasse {
 
 
         // Write PC
-        csr_t mtvec = CSRs->RequireCSR(CSR_mtvec, "mtvec")->Read(CSRs); // read 'mtvec'
+        csr_t mtvec = __RV_TRAP_REQUIRE_CSR(CSRs, mtvec)->Read(CSRs); // read 'mtvec'
 
         int mode = GET_CSR_FIELD(mtvec, CSR_mtvec_FIELD_MODE);
         if (mode == CSR_mtvec_FIELD_MODE_DEF_VECTORED && type == TRAP_INTERRUPT) // vectored interrupt trap
@@ -135,7 +139,7 @@ namespace Jasse {
     void TrapReturnM(RVArchitecturalOOC* arch, RVCSRSpace* CSRs) noexcept(false)
     {
         // Write 'mstatus' CSR
-        RVCSR* p_mstatus  = CSRs->RequireCSR(CSR_mstatus, "mstatus");
+        RVCSR* p_mstatus  = __RV_TRAP_REQUIRE_CSR(CSRs, mstatus);
 
         csr_t mstatus = p_mstatus->Read(CSRs); // read 'mstatus'
 
@@ -156,7 +160,7 @@ namespace Jasse {
 
 
         // Write PC
-        csr_t mepc = CSRs->RequireCSR(CSR_mepc, "mepc")->Read(CSRs);
+        csr_t mepc = __RV_TRAP_REQUIRE_CSR(CSRs, mepc)->Read(CSRs);
 
         if (arch->XLEN() == XLEN32) // XLEN=32
             arch->SetPC32((uint32_t)mepc);
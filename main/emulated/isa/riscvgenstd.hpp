@@ -5,6 +5,10 @@
 // Instruction Generator (CodeGen) Standard components
 //
 
+#include <map>
+#include <unordered_map>
+#include <ostream>
+
 #include "riscv.hpp"
 
 
@@ -19,6 +23,79 @@
 
 #define RV_CODEGEN_CODE_CSR_CANDIDATE               0x08
 
+//
+#define RV_CODEGEN_CODE_DISTRIBUTION_I              0x01
+
+#define RV_CODEGEN_CODE_DISTRIBUTION_I_IMM          0x11
+
+//
+#define RV_CODEGEN_CODE_MIX                         0x02
+
+#define RV_CODEGEN_CODE_MIX_WEIGHT                  0x02
+
+//
+#define RV_CODEGEN_CODE_DEPENDENCY                  0x03
+
+#define RV_CODEGEN_CODE_DEPENDENCY_GRx              0x03
+
+
+//
+#define RV_CODEGEN_DEPENDENCY_WINDOW                32
+
+#define RV_CODEGEN_RVTYPE_COUNT                     6
+
+
+// Functional coverage bins of codepoint
+#define RV_COVERAGE_BIN_EXECUTED                    0
+#define RV_COVERAGE_BIN_RD_X0                       1
+#define RV_COVERAGE_BIN_RS1_X0                      2
+#define RV_COVERAGE_BIN_RS2_X0                      3
+#define RV_COVERAGE_BIN_RS1_EQ_RS2                  4
+#define RV_COVERAGE_BIN_RD_EQ_RS1                   5
+#define RV_COVERAGE_BIN_RS1_ZERO                    6
+#define RV_COVERAGE_BIN_RS1_NEGATIVE                7
+#define RV_COVERAGE_BIN_RS1_ONES                    8
+#define RV_COVERAGE_BIN_RS1_MIN                     9
+#define RV_COVERAGE_BIN_RS1_MAX                     10
+#define RV_COVERAGE_BIN_RS2_ZERO                    11
+#define RV_COVERAGE_BIN_RS2_NEGATIVE                12
+#define RV_COVERAGE_BIN_RS2_ONES                    13
+#define RV_COVERAGE_BIN_RS2_MIN                     14
+#define RV_COVERAGE_BIN_RS2_MAX                     15
+#define RV_COVERAGE_BIN_IMM_ZERO                    16
+#define RV_COVERAGE_BIN_IMM_NEGATIVE                17
+#define RV_COVERAGE_BIN_IMM_POSITIVE                18
+
+#define RV_COVERAGE_BIN_COUNT                       19
+
+#define RV_COVERAGE_BIN(bin)                        (1U << (bin))
+
+#define RV_COVERAGE_BINS_RD                         (RV_COVERAGE_BIN(RV_COVERAGE_BIN_RD_X0))
+
+#define RV_COVERAGE_BINS_RS1                        (RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_X0) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_ZERO) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_NEGATIVE) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_ONES) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_MIN) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_MAX))
+
+#define RV_COVERAGE_BINS_RS2                        (RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_X0) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_ZERO) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_NEGATIVE) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_ONES) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_MIN) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_MAX))
+
+#define RV_COVERAGE_BINS_IMM                        (RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_ZERO) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_NEGATIVE) \
+                                                    | RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_POSITIVE))
+
+//
+#define RV_COVERAGE_CSR_COUNT                       4096
+
+#define RV_COVERAGE_DEFAULT_BOOST                   8
+#define RV_COVERAGE_DEFAULT_PATIENCE                256
+
 
 namespace Jasse {
     // RISC-V Code Generator integer range constraint
@@ -57,6 +134,179 @@ namespace Jasse {
 
         void                SetList(const RVCSRList& list) noexcept;
     };
+
+    // RISC-V Code Generator weighted integer distribution constraint
+    // *NOTICE: Buckets of [lower, upper] ranges, picked by weight, then uniformly sampled within.
+    class RVCodeGenConstraintDistributionI : public RVCodeGenConstraint {
+    public:
+        typedef struct {
+            uint64_t    lower_range;
+            uint64_t    upper_range;
+            uint32_t    weight;
+        } Bucket;
+
+    private:
+        std::vector<Bucket>             buckets;
+
+        mutable RVCodeGenAliasTable     table;
+        mutable bool                    dirty;
+
+    public:
+        RVCodeGenConstraintDistributionI(int code) noexcept;
+        RVCodeGenConstraintDistributionI(int code, std::initializer_list<Bucket> buckets) noexcept;
+        RVCodeGenConstraintDistributionI(const RVCodeGenConstraintDistributionI& obj) noexcept;
+        ~RVCodeGenConstraintDistributionI() noexcept;
+
+        void                        Add(uint64_t lower_range, uint64_t upper_range, uint32_t weight) noexcept;
+        void                        Clear() noexcept;
+
+        int                         GetSize() const noexcept;
+        const Bucket&               Get(int index) const noexcept;
+        void                        SetWeight(int index, uint32_t weight) noexcept;
+
+        bool                        IsEmpty() const noexcept;
+
+        uint64_t                    Sample(RVCodeGenRandom& rand) const noexcept;
+    };
+
+    // RISC-V Code Generator instruction mix weight constraint
+    // *NOTICE: Weight of codepoint is resolved in order of: per-codepoint weight, per-type weight,
+    //          then the default weight. Revision is bumped on any modification, so that generators
+    //          would rebuild their sampling tables only when weights actually changed.
+    class RVCodeGenConstraintMix : public RVCodeGenConstraint {
+    private:
+        std::map<const RVCodepoint*, uint32_t>  codepoint_weights;
+
+        uint32_t                                type_weights[RV_CODEGEN_RVTYPE_COUNT];
+        bool                                    type_weighted[RV_CODEGEN_RVTYPE_COUNT];
+
+        uint32_t                                default_weight;
+
+        uint64_t                                revision;
+
+    public:
+        RVCodeGenConstraintMix(int code, uint32_t default_weight = 1) noexcept;
+        RVCodeGenConstraintMix(const RVCodeGenConstraintMix& obj) noexcept;
+        ~RVCodeGenConstraintMix() noexcept;
+
+        void                        SetWeight(const RVCodepoint* codepoint, uint32_t weight) noexcept;
+        void                        SetWeight(RVCodepointType type, uint32_t weight) noexcept;
+        void                        SetDefaultWeight(uint32_t weight) noexcept;
+
+        void                        ResetWeight(const RVCodepoint* codepoint) noexcept;
+        void                        ResetWeight(RVCodepointType type) noexcept;
+        void                        Reset() noexcept;
+
+        uint32_t                    GetWeight(const RVCodepoint* codepoint) const noexcept;
+        uint32_t                    GetDefaultWeight() const noexcept;
+
+        uint64_t                    GetRevision() const noexcept;
+    };
+
+    // RISC-V Code Generator register dependency distance constraint
+    // *NOTICE: Weight of distance 0 is for independent (uniformly random) source registers, and
+    //          weight of distance d (1 ~ RV_CODEGEN_DEPENDENCY_WINDOW) is for reading the destination
+    //          of the d-th previous register-writing instruction.
+    //          The destination history is kept in the constraint instance, so one instance must not
+    //          be shared by generators running concurrently.
+    class RVCodeGenConstraintDependency : public RVCodeGenConstraint {
+    private:
+        uint32_t                        weights[RV_CODEGEN_DEPENDENCY_WINDOW + 1];
+
+        mutable RVCodeGenAliasTable     table;
+        mutable bool                    dirty;
+
+        mutable int                     history[RV_CODEGEN_DEPENDENCY_WINDOW];
+        mutable int                     history_head;
+        mutable int                     history_count;
+
+    public:
+        RVCodeGenConstraintDependency(int code) noexcept;
+        RVCodeGenConstraintDependency(int code, std::initializer_list<uint32_t> weights) noexcept;
+        RVCodeGenConstraintDependency(const RVCodeGenConstraintDependency& obj) noexcept;
+        ~RVCodeGenConstraintDependency() noexcept;
+
+        void                        SetWeight(int distance, uint32_t weight) noexcept;
+        uint32_t                    GetWeight(int distance) const noexcept;
+
+        void                        PushDestination(int rd) const noexcept;
+        int                         SampleSource(RVCodeGenRandom& rand) const noexcept;
+        void                        ResetHistory() const noexcept;
+    };
+
+
+    // RISC-V Code Generator functional coverage collector
+    // *NOTICE: Fed from execution (as the execution observer of RVInstance), with a bitmap of
+    //          operand bins per codepoint and a bitmap of accessed CSR addresses.
+    //          Applicable bins are derived from codepoint type by default. Bins that stay uncovered
+    //          after 'patience' hits of the codepoint are presumed unreachable (e.g. operands of ECALL,
+    //          or negative shift amount), and would gradually stop boosting the codepoint weight.
+    class RVCodeGenCoverage : public RVExecObserver {
+    public:
+        typedef struct {
+            const RVCodepoint*  codepoint;
+
+            uint32_t            mask;       // applicable bins
+            uint32_t            bins;       // covered bins
+
+            uint64_t            hits;
+            uint64_t            stale;      // hits since the last newly covered bin
+        } Entry;
+
+    private:
+        std::vector<Entry>                              entries;
+        std::unordered_map<const RVCodepoint*, int>     index;
+
+        uint64_t                                        csrs[RV_COVERAGE_CSR_COUNT / 64];
+
+        uint64_t                                        unknown;
+
+    public:
+        RVCodeGenCoverage() noexcept;
+        RVCodeGenCoverage(const RVCodepointCollection& codeset) noexcept;
+        RVCodeGenCoverage(const RVCodeGenCoverage& obj) noexcept;
+        ~RVCodeGenCoverage() noexcept;
+
+        static uint32_t         GetDefaultMask(RVCodepointType type) noexcept;
+        static const char*      GetBinName(int bin) noexcept;
+
+        void                    Add(const RVCodepoint* codepoint) noexcept;
+        void                    AddAll(const RVCodepointCollection& codeset) noexcept;
+        void                    SetMask(const RVCodepoint* codepoint, uint32_t mask) noexcept;
+
+        void                    Sample(const RVInstruction& insn, const RVArchitecturalOOC* arch) noexcept;
+        virtual void            PreExecute(const RVInstruction& insn, const RVExecContext& ctx) noexcept override;
+
+        void                    Reset() noexcept;
+
+        int                     GetSize() const noexcept;
+        const Entry&            Get(int index) const noexcept;
+        const Entry*            Find(const RVCodepoint* codepoint) const noexcept;
+
+        int                     GetBinCount() const noexcept;
+        int                     GetCoveredCount() const noexcept;
+        uint64_t                GetUnknownCount() const noexcept;
+
+        bool                    IsCSRCovered(csraddr_t address) const noexcept;
+        int                     GetCSRCoveredCount() const noexcept;
+        void                    GetUncoveredCSRs(const RVCSRList& candidates, RVCSRList& dst) const noexcept;
+
+        void                    Direct(RVCodeGenConstraintMix*  mix,
+                                       uint32_t                 base        = 1,
+                                       uint32_t                 boost       = RV_COVERAGE_DEFAULT_BOOST,
+                                       uint64_t                 patience    = RV_COVERAGE_DEFAULT_PATIENCE) const noexcept;
+
+        void                    Direct(RVCodeGenConstraintDistributionI*    distribution,
+                                       int                                  bucket,
+                                       int                                  bin,
+                                       uint32_t                             base,
+                                       uint32_t                             boost,
+                                       uint64_t                             patience    = RV_COVERAGE_DEFAULT_PATIENCE) const noexcept;
+
+        void                    Direct(RVCodeGenConstraintCSRList* candidates, const RVCSRList& all) const noexcept;
+
+        void                    Print(std::ostream& os) const;
+    };
 }
 
 
@@ -72,6 +322,16 @@ namespace Jasse {
     
     static constexpr RVCodeGenConstraintTrait<RVCodeGenConstraintCSRList>   RV_CODEGEN_CSR_CANDIDATE
         { RV_CODEGEN_CODE_CSR_CANDIDATE };
+
+
+    static constexpr RVCodeGenConstraintTrait<RVCodeGenConstraintDistributionI> RV_CODEGEN_IMM_DISTRIBUTION
+        { RV_CODEGEN_CODE_DISTRIBUTION_I_IMM };
+
+    static constexpr RVCodeGenConstraintTrait<RVCodeGenConstraintMix>           RV_CODEGEN_MIX_WEIGHT
+        { RV_CODEGEN_CODE_MIX_WEIGHT };
+
+    static constexpr RVCodeGenConstraintTrait<RVCodeGenConstraintDependency>    RV_CODEGEN_GRx_DEPENDENCY
+        { RV_CODEGEN_CODE_DEPENDENCY_GRx };
 }
 
 
@@ -160,3 +420,638 @@ namespace Jasse {
         this->list = list;
     }
 }
+
+
+// Implementation of: class RVCodeGenConstraintDistributionI
+namespace Jasse {
+    /*
+    std::vector<Bucket>             buckets;
+
+    mutable RVCodeGenAliasTable     table;
+    mutable bool                    dirty;
+    */
+
+    RVCodeGenConstraintDistributionI::RVCodeGenConstraintDistributionI(int code) noexcept
+        : RVCodeGenConstraint   (code)
+        , buckets               ()
+        , table                 ()
+        , dirty                 (true)
+    { }
+
+    RVCodeGenConstraintDistributionI::RVCodeGenConstraintDistributionI(int code, std::initializer_list<Bucket> buckets) noexcept
+        : RVCodeGenConstraint   (code)
+        , buckets               (buckets)
+        , table                 ()
+        , dirty                 (true)
+    { }
+
+    RVCodeGenConstraintDistributionI::RVCodeGenConstraintDistributionI(const RVCodeGenConstraintDistributionI& obj) noexcept
+        : RVCodeGenConstraint   (obj)
+        , buckets               (obj.buckets)
+        , table                 (obj.table)
+        , dirty                 (obj.dirty)
+    { }
+
+    RVCodeGenConstraintDistributionI::~RVCodeGenConstraintDistributionI() noexcept
+    { }
+
+    inline void RVCodeGenConstraintDistributionI::Add(uint64_t lower_range, uint64_t upper_range, uint32_t weight) noexcept
+    {
+        buckets.push_back(Bucket { lower_range, upper_range, weight });
+        dirty = true;
+    }
+
+    inline void RVCodeGenConstraintDistributionI::Clear() noexcept
+    {
+        buckets.clear();
+        dirty = true;
+    }
+
+    inline int RVCodeGenConstraintDistributionI::GetSize() const noexcept
+    {
+        return buckets.size();
+    }
+
+    inline const RVCodeGenConstraintDistributionI::Bucket& RVCodeGenConstraintDistributionI::Get(int index) const noexcept
+    {
+        return buckets[index];
+    }
+
+    inline void RVCodeGenConstraintDistributionI::SetWeight(int index, uint32_t weight) noexcept
+    {
+        buckets[index].weight = weight;
+        dirty = true;
+    }
+
+    bool RVCodeGenConstraintDistributionI::IsEmpty() const noexcept
+    {
+        if (dirty)
+        {
+            std::vector<uint32_t> weights;
+
+            for (const Bucket& bucket : buckets)
+                weights.push_back(bucket.weight);
+
+            table.Build(weights);
+            dirty = false;
+        }
+
+        return table.IsEmpty();
+    }
+
+    inline uint64_t RVCodeGenConstraintDistributionI::Sample(RVCodeGenRandom& rand) const noexcept
+    {
+        // *NOTICE: Call IsEmpty() first, which also rebuilds the sampling table when modified.
+        const Bucket& bucket = buckets[table.Sample(rand)];
+
+        return rand.NextRange64(bucket.lower_range, bucket.upper_range);
+    }
+}
+
+
+// Implementation of: class RVCodeGenConstraintMix
+namespace Jasse {
+    /*
+    std::map<const RVCodepoint*, uint32_t>  codepoint_weights;
+
+    uint32_t                                type_weights[RV_CODEGEN_RVTYPE_COUNT];
+    bool                                    type_weighted[RV_CODEGEN_RVTYPE_COUNT];
+
+    uint32_t                                default_weight;
+
+    uint64_t                                revision;
+    */
+
+    RVCodeGenConstraintMix::RVCodeGenConstraintMix(int code, uint32_t default_weight) noexcept
+        : RVCodeGenConstraint   (code)
+        , codepoint_weights     ()
+        , default_weight        (default_weight)
+        , revision              (0)
+    {
+        std::fill_n(type_weights , RV_CODEGEN_RVTYPE_COUNT, 0);
+        std::fill_n(type_weighted, RV_CODEGEN_RVTYPE_COUNT, false);
+    }
+
+    RVCodeGenConstraintMix::RVCodeGenConstraintMix(const RVCodeGenConstraintMix& obj) noexcept
+        : RVCodeGenConstraint   (obj)
+        , codepoint_weights     (obj.codepoint_weights)
+        , default_weight        (obj.default_weight)
+        , revision              (obj.revision)
+    {
+        std::copy(obj.type_weights , obj.type_weights  + RV_CODEGEN_RVTYPE_COUNT, type_weights);
+        std::copy(obj.type_weighted, obj.type_weighted + RV_CODEGEN_RVTYPE_COUNT, type_weighted);
+    }
+
+    RVCodeGenConstraintMix::~RVCodeGenConstraintMix() noexcept
+    { }
+
+    inline void RVCodeGenConstraintMix::SetWeight(const RVCodepoint* codepoint, uint32_t weight) noexcept
+    {
+        codepoint_weights[codepoint] = weight;
+        revision++;
+    }
+
+    inline void RVCodeGenConstraintMix::SetWeight(RVCodepointType type, uint32_t weight) noexcept
+    {
+        type_weights [type] = weight;
+        type_weighted[type] = true;
+        revision++;
+    }
+
+    inline void RVCodeGenConstraintMix::SetDefaultWeight(uint32_t weight) noexcept
+    {
+        default_weight = weight;
+        revision++;
+    }
+
+    inline void RVCodeGenConstraintMix::ResetWeight(const RVCodepoint* codepoint) noexcept
+    {
+        codepoint_weights.erase(codepoint);
+        revision++;
+    }
+
+    inline void RVCodeGenConstraintMix::ResetWeight(RVCodepointType type) noexcept
+    {
+        type_weighted[type] = false;
+        revision++;
+    }
+
+    void RVCodeGenConstraintMix::Reset() noexcept
+    {
+        codepoint_weights.clear();
+        std::fill_n(type_weighted, RV_CODEGEN_RVTYPE_COUNT, false);
+        revision++;
+    }
+
+    uint32_t RVCodeGenConstraintMix::GetWeight(const RVCodepoint* codepoint) const noexcept
+    {
+        auto iter = codepoint_weights.find(codepoint);
+
+        if (iter != codepoint_weights.end())
+            return iter->second;
+
+        if (type_weighted[codepoint->GetType()])
+            return type_weights[codepoint->GetType()];
+
+        return default_weight;
+    }
+
+    inline uint32_t RVCodeGenConstraintMix::GetDefaultWeight() const noexcept
+    {
+        return default_weight;
+    }
+
+    inline uint64_t RVCodeGenConstraintMix::GetRevision() const noexcept
+    {
+        return revision;
+    }
+}
+
+
+// Implementation of: class RVCodeGenConstraintDependency
+namespace Jasse {
+    /*
+    uint32_t                        weights[RV_CODEGEN_DEPENDENCY_WINDOW + 1];
+
+    mutable RVCodeGenAliasTable     table;
+    mutable bool                    dirty;
+
+    mutable int                     history[RV_CODEGEN_DEPENDENCY_WINDOW];
+    mutable int                     history_head;
+    mutable int                     history_count;
+    */
+
+    RVCodeGenConstraintDependency::RVCodeGenConstraintDependency(int code) noexcept
+        : RVCodeGenConstraint   (code)
+        , table                 ()
+        , dirty                 (true)
+        , history_head          (0)
+        , history_count         (0)
+    {
+        // all independent by default
+        std::fill_n(weights, RV_CODEGEN_DEPENDENCY_WINDOW + 1, 0);
+        weights[0] = 1;
+    }
+
+    RVCodeGenConstraintDependency::RVCodeGenConstraintDependency(int code, std::initializer_list<uint32_t> weights) noexcept
+        : RVCodeGenConstraint   (code)
+        , table                 ()
+        , dirty                 (true)
+        , history_head          (0)
+        , history_count         (0)
+    {
+        std::fill_n(this->weights, RV_CODEGEN_DEPENDENCY_WINDOW + 1, 0);
+        std::copy_n(weights.begin(), std::min((int) weights.size(), RV_CODEGEN_DEPENDENCY_WINDOW + 1), this->weights);
+    }
+
+    RVCodeGenConstraintDependency::RVCodeGenConstraintDependency(const RVCodeGenConstraintDependency& obj) noexcept
+        : RVCodeGenConstraint   (obj)
+        , table                 (obj.table)
+        , dirty                 (obj.dirty)
+        , history_head          (obj.history_head)
+        , history_count         (obj.history_count)
+    {
+        std::copy(obj.weights, obj.weights + RV_CODEGEN_DEPENDENCY_WINDOW + 1, weights);
+        std::copy(obj.history, obj.history + RV_CODEGEN_DEPENDENCY_WINDOW, history);
+    }
+
+    RVCodeGenConstraintDependency::~RVCodeGenConstraintDependency() noexcept
+    { }
+
+    inline void RVCodeGenConstraintDependency::SetWeight(int distance, uint32_t weight) noexcept
+    {
+        weights[distance] = weight;
+        dirty = true;
+    }
+
+    inline uint32_t RVCodeGenConstraintDependency::GetWeight(int distance) const noexcept
+    {
+        return weights[distance];
+    }
+
+    inline void RVCodeGenConstraintDependency::PushDestination(int rd) const noexcept
+    {
+        history_head = (history_head + 1) % RV_CODEGEN_DEPENDENCY_WINDOW;
+        history[history_head] = rd;
+
+        if (history_count < RV_CODEGEN_DEPENDENCY_WINDOW)
+            history_count++;
+    }
+
+    int RVCodeGenConstraintDependency::SampleSource(RVCodeGenRandom& rand) const noexcept
+    {
+        // Returns -1 for independent source register
+        if (dirty)
+        {
+            table.Build(std::vector<uint32_t>(weights, weights + RV_CODEGEN_DEPENDENCY_WINDOW + 1));
+            dirty = false;
+        }
+
+        if (table.IsEmpty())
+            return -1;
+
+        int distance = table.Sample(rand);
+
+        if (!distance || distance > history_count)
+            return -1;
+
+        return history[(history_head - distance + 1 + RV_CODEGEN_DEPENDENCY_WINDOW) % RV_CODEGEN_DEPENDENCY_WINDOW];
+    }
+
+    inline void RVCodeGenConstraintDependency::ResetHistory() const noexcept
+    {
+        history_head  = 0;
+        history_count = 0;
+    }
+}
+
+
+// Implementation of: class RVCodeGenCoverage
+namespace Jasse {
+    /*
+    std::vector<Entry>                              entries;
+    std::unordered_map<const RVCodepoint*, int>     index;
+
+    uint64_t                                        csrs[RV_COVERAGE_CSR_COUNT / 64];
+
+    uint64_t                                        unknown;
+    */
+
+    RVCodeGenCoverage::RVCodeGenCoverage() noexcept
+        : entries   ()
+        , index     ()
+        , unknown   (0)
+    {
+        std::fill_n(csrs, RV_COVERAGE_CSR_COUNT / 64, 0);
+    }
+
+    RVCodeGenCoverage::RVCodeGenCoverage(const RVCodepointCollection& codeset) noexcept
+        : RVCodeGenCoverage()
+    {
+        AddAll(codeset);
+    }
+
+    RVCodeGenCoverage::RVCodeGenCoverage(const RVCodeGenCoverage& obj) noexcept
+        : entries   (obj.entries)
+        , index     (obj.index)
+        , unknown   (obj.unknown)
+    {
+        std::copy(obj.csrs, obj.csrs + RV_COVERAGE_CSR_COUNT / 64, csrs);
+    }
+
+    RVCodeGenCoverage::~RVCodeGenCoverage() noexcept
+    { }
+
+    uint32_t RVCodeGenCoverage::GetDefaultMask(RVCodepointType type) noexcept
+    {
+        uint32_t mask = RV_COVERAGE_BIN(RV_COVERAGE_BIN_EXECUTED);
+
+        switch (type)
+        {
+            case RVTYPE_R:
+                return mask | RV_COVERAGE_BINS_RD | RV_COVERAGE_BINS_RS1 | RV_COVERAGE_BINS_RS2
+                            | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_EQ_RS2)
+                            | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RD_EQ_RS1);
+
+            case RVTYPE_I:
+                return mask | RV_COVERAGE_BINS_RD | RV_COVERAGE_BINS_RS1 | RV_COVERAGE_BINS_IMM
+                            | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RD_EQ_RS1);
+
+            case RVTYPE_S:
+            case RVTYPE_B:
+                return mask | RV_COVERAGE_BINS_RS1 | RV_COVERAGE_BINS_RS2 | RV_COVERAGE_BINS_IMM
+                            | RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_EQ_RS2);
+
+            case RVTYPE_U:
+            case RVTYPE_J:
+                return mask | RV_COVERAGE_BINS_RD | RV_COVERAGE_BINS_IMM;
+
+            [[unlikely]] default:
+                return mask;
+        }
+    }
+
+    const char* RVCodeGenCoverage::GetBinName(int bin) noexcept
+    {
+        static const char* names[RV_COVERAGE_BIN_COUNT] = {
+            "executed",
+            "rd=x0",        "rs1=x0",       "rs2=x0",       "rs1=rs2",      "rd=rs1",
+            "rs1:zero",     "rs1:neg",      "rs1:ones",     "rs1:min",      "rs1:max",
+            "rs2:zero",     "rs2:neg",      "rs2:ones",     "rs2:min",      "rs2:max",
+            "imm:zero",     "imm:neg",      "imm:pos"
+        };
+
+        return (bin >= 0 && bin < RV_COVERAGE_BIN_COUNT) ? names[bin] : "?";
+    }
+
+    void RVCodeGenCoverage::Add(const RVCodepoint* codepoint) noexcept
+    {
+        if (index.find(codepoint) != index.end())
+            return;
+
+        index[codepoint] = entries.size();
+        entries.push_back(Entry { codepoint, GetDefaultMask(codepoint->GetType()), 0, 0, 0 });
+    }
+
+    void RVCodeGenCoverage::AddAll(const RVCodepointCollection& codeset) noexcept
+    {
+        for (auto iter = codeset.Begin(); iter != codeset.End(); iter++)
+            Add(*iter);
+    }
+
+    void RVCodeGenCoverage::SetMask(const RVCodepoint* codepoint, uint32_t mask) noexcept
+    {
+        auto iter = index.find(codepoint);
+
+        if (iter != index.end())
+            entries[iter->second].mask = mask;
+    }
+
+    void RVCodeGenCoverage::Sample(const RVInstruction& insn, const RVArchitecturalOOC* arch) noexcept
+    {
+        auto iter = index.find(insn.GetCodepoint());
+
+        if (iter == index.end())
+        {
+            unknown++;
+            return;
+        }
+
+        Entry& entry = entries[iter->second];
+
+        // operand bins
+        uint32_t bins = RV_COVERAGE_BIN(RV_COVERAGE_BIN_EXECUTED);
+
+        int rd  = insn.GetRD();
+        int rs1 = insn.GetRS1();
+        int rs2 = insn.GetRS2();
+
+        if (rd  == RV_GR_X0)    bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_RD_X0);
+        if (rs1 == RV_GR_X0)    bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_X0);
+        if (rs2 == RV_GR_X0)    bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS2_X0);
+        if (rs1 == rs2)         bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_RS1_EQ_RS2);
+        if (rd  == rs1)         bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_RD_EQ_RS1);
+
+        // sign boundaries of source values, in XLEN
+        if (arch)
+        {
+            int         width = arch->XLEN() == XLEN32 ? 32 : 64;
+            uint64_t    ones  = width == 32 ? 0xFFFFFFFFULL : ~0ULL;
+            uint64_t    sign  = 1ULL << (width - 1);
+
+            uint64_t    values[2] = {
+                arch->GetGRx64Zext(rs1) & ones,
+                arch->GetGRx64Zext(rs2) & ones
+            };
+
+            for (int i = 0; i < 2; i++)
+            {
+                int offset = i ? RV_COVERAGE_BIN_RS2_ZERO : RV_COVERAGE_BIN_RS1_ZERO;
+
+                if (!values[i])                 bins |= RV_COVERAGE_BIN(offset);
+                if (values[i] & sign)           bins |= RV_COVERAGE_BIN(offset + 1);
+                if (values[i] == ones)          bins |= RV_COVERAGE_BIN(offset + 2);
+                if (values[i] == sign)          bins |= RV_COVERAGE_BIN(offset + 3);
+                if (values[i] == ones - sign)   bins |= RV_COVERAGE_BIN(offset + 4);
+            }
+        }
+
+        // sign boundaries of immediate (sign-extended on decode)
+        imm_t imm = insn.GetImmediate();
+
+        if (!imm)
+            bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_ZERO);
+        else if (imm & 0x80000000U)
+            bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_NEGATIVE);
+        else
+            bins |= RV_COVERAGE_BIN(RV_COVERAGE_BIN_IMM_POSITIVE);
+
+        //
+        entry.hits++;
+
+        if ((bins & entry.mask) & ~entry.bins)
+        {
+            entry.bins |= bins & entry.mask;
+            entry.stale = 0;
+        }
+        else
+            entry.stale++;
+
+        // CSR address of Zicsr instructions
+        insnraw_t raw = insn.GetRaw();
+
+        if (GET_STD_OPERAND(raw, RV_OPCODE) == RV_OPCODE_SYSTEM && GET_STD_OPERAND(raw, RV_FUNCT3))
+        {
+            uint32_t address = GET_STD_OPERAND(raw, RV_OPERAND_CSR);
+
+            csrs[address >> 6] |= 1ULL << (address & 0x3F);
+        }
+    }
+
+    void RVCodeGenCoverage::PreExecute(const RVInstruction& insn, const RVExecContext& ctx) noexcept
+    {
+        Sample(insn, ctx.arch);
+    }
+
+    void RVCodeGenCoverage::Reset() noexcept
+    {
+        for (Entry& entry : entries)
+        {
+            entry.bins  = 0;
+            entry.hits  = 0;
+            entry.stale = 0;
+        }
+
+        std::fill_n(csrs, RV_COVERAGE_CSR_COUNT / 64, 0);
+
+        unknown = 0;
+    }
+
+    inline int RVCodeGenCoverage::GetSize() const noexcept
+    {
+        return entries.size();
+    }
+
+    inline const RVCodeGenCoverage::Entry& RVCodeGenCoverage::Get(int index) const noexcept
+    {
+        return entries[index];
+    }
+
+    const RVCodeGenCoverage::Entry* RVCodeGenCoverage::Find(const RVCodepoint* codepoint) const noexcept
+    {
+        auto iter = index.find(codepoint);
+
+        return iter != index.end() ? &entries[iter->second] : nullptr;
+    }
+
+    int RVCodeGenCoverage::GetBinCount() const noexcept
+    {
+        int count = 0;
+
+        for (const Entry& entry : entries)
+            count += __builtin_popcount(entry.mask);
+
+        return count;
+    }
+
+    int RVCodeGenCoverage::GetCoveredCount() const noexcept
+    {
+        int count = 0;
+
+        for (const Entry& entry : entries)
+            count += __builtin_popcount(entry.bins & entry.mask);
+
+        return count;
+    }
+
+    inline uint64_t RVCodeGenCoverage::GetUnknownCount() const noexcept
+    {
+        return unknown;
+    }
+
+    inline bool RVCodeGenCoverage::IsCSRCovered(csraddr_t address) const noexcept
+    {
+        address &= CSR_ADDRESS_MASK;
+
+        return (csrs[address >> 6] >> (address & 0x3F)) & 1;
+    }
+
+    int RVCodeGenCoverage::GetCSRCoveredCount() const noexcept
+    {
+        int count = 0;
+
+        for (uint64_t word : csrs)
+            count += __builtin_popcountll(word);
+
+        return count;
+    }
+
+    void RVCodeGenCoverage::GetUncoveredCSRs(const RVCSRList& candidates, RVCSRList& dst) const noexcept
+    {
+        for (auto iter = candidates.Begin(); iter != candidates.End(); iter++)
+            if (!IsCSRCovered(iter->address))
+                dst.Add(*iter);
+    }
+
+    void RVCodeGenCoverage::Direct(RVCodeGenConstraintMix*  mix,
+                                   uint32_t                 base,
+                                   uint32_t                 boost,
+                                   uint64_t                 patience) const noexcept
+    {
+        // weight = base + boost * (uncovered bins), decaying with hits since the last newly covered bin
+        for (const Entry& entry : entries)
+        {
+            uint64_t uncovered = __builtin_popcount(entry.mask & ~entry.bins);
+            uint64_t weight    = base;
+
+            if (uncovered)
+                weight += boost * uncovered * patience / (patience + entry.stale);
+
+            if (mix->GetWeight(entry.codepoint) != weight)
+                mix->SetWeight(entry.codepoint, (uint32_t) std::min(weight, (uint64_t) UINT32_MAX));
+        }
+    }
+
+    void RVCodeGenCoverage::Direct(RVCodeGenConstraintDistributionI*    distribution,
+                                   int                                  bucket,
+                                   int                                  bin,
+                                   uint32_t                             base,
+                                   uint32_t                             boost,
+                                   uint64_t                             patience) const noexcept
+    {
+        // weight = base + boost * (codepoints missing the bin), each decaying as in the mix above
+        // *NOTICE: Mix weights only bring the codepoint itself, so a bin of rare operand values
+        //          (e.g. zero immediate, one out of 4096) is hardly closed by them. Bucket producing
+        //          the bin is weighted up instead, while any codepoint is still missing it.
+        uint64_t weight = base;
+
+        for (const Entry& entry : entries)
+            if ((entry.mask & ~entry.bins) & RV_COVERAGE_BIN(bin))
+                weight += boost * patience / (patience + entry.stale);
+
+        weight = std::min(weight, (uint64_t) UINT32_MAX);
+
+        if (distribution->Get(bucket).weight != weight)
+            distribution->SetWeight(bucket, (uint32_t) weight);
+    }
+
+    void RVCodeGenCoverage::Direct(RVCodeGenConstraintCSRList* candidates, const RVCSRList& all) const noexcept
+    {
+        // uncovered CSRs only, or all of them again once closed
+        RVCSRList uncovered;
+
+        GetUncoveredCSRs(all, uncovered);
+
+        candidates->SetList(uncovered.GetSize() ? uncovered : all);
+    }
+
+    void RVCodeGenCoverage::Print(std::ostream& os) const
+    {
+        for (const Entry& entry : entries)
+        {
+            os << std::left << std::setw(12) << entry.codepoint->GetName()
+               << std::right << std::setw(3) << __builtin_popcount(entry.bins & entry.mask)
+               << "/" << std::left << std::setw(3) << __builtin_popcount(entry.mask)
+               << std::right << std::setw(12) << entry.hits;
+
+            if (entry.mask & ~entry.bins)
+            {
+                os << "  missing:";
+
+                for (int bin = 0; bin < RV_COVERAGE_BIN_COUNT; bin++)
+                    if ((entry.mask & ~entry.bins) & RV_COVERAGE_BIN(bin))
+                        os << " " << GetBinName(bin);
+            }
+
+            os << std::endl;
+        }
+
+        os << GetCoveredCount() << "/" << GetBinCount() << " bin(s) covered, "
+           << GetCSRCoveredCount() << " CSR address(es) accessed";
+
+        if (unknown)
+            os << ", " << unknown << " sample(s) of unregistered codepoints";
+
+        os << std::endl;
+    }
+}
@@ -24,33 +24,105 @@ namespace Jasse {
 
     //
     const RVCodepoint*  Roll(const RVCodepointCollection& codeset);
+
+    //
+    uint32_t    Rand32(RVCodeGenRandom& rand, uint32_t lower_range, uint32_t upper_range) noexcept;
+    uint32_t    Rand32(RVCodeGenRandom& rand, const RVCodeGenConstraintRangeI* range) noexcept;
+    uint32_t    Rand32(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints, const RVCodeGenConstraintTrait<RVCodeGenConstraintRangeI>& trait) noexcept;
+
+    uint64_t    Rand64(RVCodeGenRandom& rand, uint64_t lower_range, uint64_t upper_range) noexcept;
+    uint64_t    Rand64(RVCodeGenRandom& rand, const RVCodeGenConstraintRangeI* range) noexcept;
+    uint64_t    Rand64(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints, const RVCodeGenConstraintTrait<RVCodeGenConstraintRangeI>& trait) noexcept;
+
+    //
+    const RVCodepoint*  Roll(RVCodeGenRandom& rand, const RVCodepointCollection& codeset) noexcept;
+
+    //
+    uint32_t    RandImm(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    uint32_t    RandRD(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    uint32_t    RandRS(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 }
 
 // RISC-V General Code Generators
 namespace Jasse {
 
-    insnraw_t   GenRVCodeGeneral(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeGeneral(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 
-    insnraw_t   GenRVCodeTypeR(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
-    insnraw_t   GenRVCodeTypeI(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
-    insnraw_t   GenRVCodeTypeS(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
-    insnraw_t   GenRVCodeTypeB(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
-    insnraw_t   GenRVCodeTypeU(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
-    insnraw_t   GenRVCodeTypeJ(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeR(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeI(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeS(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeB(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeU(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeTypeJ(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 
-    insnraw_t   GenRVCodeZeroOperand(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept;
+    insnraw_t   GenRVCodeZeroOperand(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVGeneral(const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVGeneral(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeR(const RVCodeGenConstraints* constraints) noexcept;
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeI(const RVCodeGenConstraints* constraints) noexcept;
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeS(const RVCodeGenConstraints* constraints) noexcept;
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeB(const RVCodeGenConstraints* constraints) noexcept;
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeU(const RVCodeGenConstraints* constraints) noexcept;
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeJ(const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeR(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeI(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeS(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeB(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeU(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeJ(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZeroOperand(const RVCodeGenConstraints* constraints) noexcept;
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZeroOperand(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept;
+}
+
+// RISC-V Bulk Code Generator
+namespace Jasse {
+
+#define RV_CODEGEN_BULK_SIZE                        256
+
+    // *NOTICE: Candidate codepoints are resolved once on construction (or SetCodeset), and each
+    //          generator owns its own random state. Generating instruction codes into the buffer
+    //          or the memory region would never touch the heap.
+    //          Candidates are picked uniformly, or by RV_CODEGEN_MIX_WEIGHT when present in constraints,
+    //          of which the sampling table is rebuilt only on weight revision.
+    class RVCodeGenerator {
+    private:
+        RVCodeGenRandom                 rand;
+
+        const RVCodeGenConstraints*     constraints;
+
+        std::vector<const RVCodepoint*> candidates;
+        std::vector<RVCodeGen>          codegens;
+
+        RVCodeGenAliasTable             mix;
+        const RVCodeGenConstraintMix*   mix_source;
+        uint64_t                        mix_revision;
+
+        bool                            __UpdateMix() noexcept;
+        uint32_t                        __Pick() noexcept;
+
+    public:
+        RVCodeGenerator(uint64_t seed = 0) noexcept;
+        RVCodeGenerator(const RVCodepointCollection&    codeset,
+                        const RVCodeGenConstraints*     constraints = nullptr,
+                        uint64_t                        seed        = 0) noexcept;
+        RVCodeGenerator(const RVCodeGenerator& obj) noexcept;
+        ~RVCodeGenerator() noexcept;
+
+        void                        Seed(uint64_t seed) noexcept;
+
+        RVCodeGenRandom&            GetRandom() noexcept;
+        const RVCodeGenRandom&      GetRandom() const noexcept;
+
+        const RVCodeGenConstraints* GetConstraints() const noexcept;
+        void                        SetConstraints(const RVCodeGenConstraints* constraints) noexcept;
+
+        void                        SetCodeset(const RVCodepointCollection& codeset) noexcept;
+        void                        SetCodeset(const RVCodepointCollection& codeset, const RVCodeGenExclusion& exclusion) noexcept;
+
+        size_t                      GetCandidateCount() const noexcept;
+        const RVCodepoint*          GetCandidate(int index) const noexcept;
+
+        const RVCodepoint*          Next(insnraw_t* insn) noexcept;
+
+        bool                        Generate(insnraw_t* dst, size_t count) noexcept;
+        size_t                      Generate(RVMemoryInterface* MI, addr_t address, size_t count) noexcept;
+    };
 }
 
 
@@ -118,12 +190,96 @@ namespace Jasse {
 
         return codeset.Get(Rand32(0, codeset.GetSize() - 1));
     }
+
+    //
+    inline uint32_t Rand32(RVCodeGenRandom& rand, uint32_t lower_range, uint32_t upper_range) noexcept
+    {
+        return rand.NextRange32(lower_range, upper_range);
+    }
+
+    inline uint32_t Rand32(RVCodeGenRandom& rand, const RVCodeGenConstraintRangeI* range) noexcept
+    {
+        if (!range)
+            return rand.Next32();
+        else
+            return rand.NextRange32((uint32_t) range->GetLowerRange(), (uint32_t) range->GetUpperRange());
+    }
+
+    inline uint32_t Rand32(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints, const RVCodeGenConstraintTrait<RVCodeGenConstraintRangeI>& trait) noexcept
+    {
+        return Rand32(rand, GetConstraint(constraints, trait));
+    }
+
+    //
+    inline uint64_t Rand64(RVCodeGenRandom& rand, uint64_t lower_range, uint64_t upper_range) noexcept
+    {
+        return rand.NextRange64(lower_range, upper_range);
+    }
+
+    inline uint64_t Rand64(RVCodeGenRandom& rand, const RVCodeGenConstraintRangeI* range) noexcept
+    {
+        if (!range)
+            return rand.Next();
+        else
+            return rand.NextRange64(range->GetLowerRange(), range->GetUpperRange());
+    }
+
+    inline uint64_t Rand64(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints, const RVCodeGenConstraintTrait<RVCodeGenConstraintRangeI>& trait) noexcept
+    {
+        return Rand64(rand, GetConstraint(constraints, trait));
+    }
+
+    //
+    inline const RVCodepoint* Roll(RVCodeGenRandom& rand, const RVCodepointCollection& codeset) noexcept
+    {
+        if (!codeset.GetSize())
+            return nullptr;
+
+        return codeset.Get(rand.NextRange32(0, codeset.GetSize() - 1));
+    }
+
+    //
+    inline uint32_t RandImm(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        const RVCodeGenConstraintDistributionI* distribution = GetConstraint(constraints, RV_CODEGEN_IMM_DISTRIBUTION);
+
+        if (distribution && !distribution->IsEmpty())
+            return (uint32_t) distribution->Sample(rand);
+
+        return Rand32(rand, constraints, RV_CODEGEN_IMM_RANGE);
+    }
+
+    inline uint32_t RandRD(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        uint32_t rd = Rand32(rand, constraints, RV_CODEGEN_GRx_RANGE);
+
+        const RVCodeGenConstraintDependency* dependency = GetConstraint(constraints, RV_CODEGEN_GRx_DEPENDENCY);
+
+        if (dependency)
+            dependency->PushDestination(rd);
+
+        return rd;
+    }
+
+    inline uint32_t RandRS(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        const RVCodeGenConstraintDependency* dependency = GetConstraint(constraints, RV_CODEGEN_GRx_DEPENDENCY);
+
+        int rs;
+        if (dependency && (rs = dependency->SampleSource(rand)) != -1)
+            return rs;
+
+        return Rand32(rand, constraints, RV_CODEGEN_GRx_RANGE);
+    }
 }
 
 
 // Implementation of General Code Generators
 namespace Jasse {
 
+    // *NOTICE: Source operands are always generated before the destination operand, so that register
+    //          dependency (RV_CODEGEN_GRx_DEPENDENCY) is never made on the instruction itself.
+    //
     // *NOTICE: It's recommended to call GenRVCodeType(X)(...) when generating corresponding type of RISC-V 
     //          instruction code (e.g. Calling GenRVCodeTypeR when generating R-type instructions). 
     //          Though the performance gain of calling individual function is not significant at all, it's
@@ -132,191 +288,376 @@ namespace Jasse {
     //          In design, generating any type of instruction codes can also be done by calling GenRVCodeGeneral,
     //          and wouldn't cause critical fault, but it's not always elegant depending on implementation.
 
-    insnraw_t GenRVCodeGeneral(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeGeneral(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
-
-        if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
         if (encoder->IsRS2Required())
-            encoder->SetRS2(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS2(RandRS(rand, constraints));
 
-        insn = encoder->Get();
-        delete encoder;
+        if (encoder->IsRDRequired())
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVGeneral(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVGeneral(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeGeneral(alloc, constraints);
+        return GenRVCodeGeneral(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeR(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeR(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
-
-        if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
         if (encoder->IsRS2Required())
-            encoder->SetRS2(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS2(RandRS(rand, constraints));
 
-        insn = encoder->Get();
-        delete encoder;
+        if (encoder->IsRDRequired())
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeR(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeR(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeTypeR(alloc, constraints);
+        return GenRVCodeTypeR(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeI(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeI(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
-
-        if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
-        insn = encoder->Get();
-        delete encoder;
+        if (encoder->IsRDRequired())
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeI(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeI(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeTypeI(alloc, constraints);
+        return GenRVCodeTypeI(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeS(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeS(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
         if (encoder->IsRS2Required())
-            encoder->SetRS2(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
-
-        insn = encoder->Get();
-        delete encoder;
+            encoder->SetRS2(RandRS(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeS(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeS(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeTypeS(alloc, constraints);
+        return GenRVCodeTypeS(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeB(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeB(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
         if (encoder->IsRS2Required())
-            encoder->SetRS2(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS2(RandRS(rand, constraints));
 
-        insn = encoder->Get();
-        delete encoder;
-
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeB(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeB(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeTypeB(alloc, constraints);
+        return GenRVCodeTypeB(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeU(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeU(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
-
-        insn = encoder->Get();
-        delete encoder;
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeU(const RVCodeGenConstraints* constraints) noexcept
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeU(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        return GenRVCodeTypeU(alloc, constraints);
+        return GenRVCodeTypeU(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVCodeTypeJ(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    insnraw_t GenRVCodeTypeJ(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            encoder->SetImmediate(Rand32(constraints, RV_CODEGEN_IMM_RANGE));
+            encoder->SetImmediate(RandImm(rand, constraints));
 
         if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRD(RandRD(rand, constraints));
+
+        return encoder->Get();
+    }
+
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeJ(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        return GenRVCodeTypeJ(alloc, rand, constraints);
+    }
+
+    insnraw_t GenRVCodeZeroOperand(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
+
+        return encoder->Get();
+    }
+
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZeroOperand(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints) noexcept
+    {
+        return GenRVCodeZeroOperand(alloc, rand, constraints);
+    }
+}
+
+
+// Implementation of: class RVCodeGenerator
+namespace Jasse {
+    /*
+    RVCodeGenRandom                 rand;
+
+    const RVCodeGenConstraints*     constraints;
+
+    std::vector<const RVCodepoint*> candidates;
+    std::vector<RVCodeGen>          codegens;
+
+    RVCodeGenAliasTable             mix;
+    const RVCodeGenConstraintMix*   mix_source;
+    uint64_t                        mix_revision;
+    */
+
+    RVCodeGenerator::RVCodeGenerator(uint64_t seed) noexcept
+        : rand          (seed)
+        , constraints   (nullptr)
+        , candidates    ()
+        , codegens      ()
+        , mix           ()
+        , mix_source    (nullptr)
+        , mix_revision  (0)
+    { }
+
+    RVCodeGenerator::RVCodeGenerator(const RVCodepointCollection&    codeset,
+                                     const RVCodeGenConstraints*     constraints,
+                                     uint64_t                        seed) noexcept
+        : rand          (seed)
+        , constraints   (constraints)
+        , candidates    ()
+        , codegens      ()
+        , mix           ()
+        , mix_source    (nullptr)
+        , mix_revision  (0)
+    {
+        SetCodeset(codeset);
+    }
+
+    RVCodeGenerator::RVCodeGenerator(const RVCodeGenerator& obj) noexcept
+        : rand          (obj.rand)
+        , constraints   (obj.constraints)
+        , candidates    (obj.candidates)
+        , codegens      (obj.codegens)
+        , mix           (obj.mix)
+        , mix_source    (obj.mix_source)
+        , mix_revision  (obj.mix_revision)
+    { }
+
+    RVCodeGenerator::~RVCodeGenerator() noexcept
+    { }
+
+    inline void RVCodeGenerator::Seed(uint64_t seed) noexcept
+    {
+        rand.Seed(seed);
+    }
+
+    inline RVCodeGenRandom& RVCodeGenerator::GetRandom() noexcept
+    {
+        return rand;
+    }
+
+    inline const RVCodeGenRandom& RVCodeGenerator::GetRandom() const noexcept
+    {
+        return rand;
+    }
+
+    inline const RVCodeGenConstraints* RVCodeGenerator::GetConstraints() const noexcept
+    {
+        return constraints;
+    }
 
-        insn = encoder->Get();
-        delete encoder;
+    inline void RVCodeGenerator::SetConstraints(const RVCodeGenConstraints* constraints) noexcept
+    {
+        this->constraints = constraints;
+        this->mix_source  = nullptr;
+    }
+
+    void RVCodeGenerator::SetCodeset(const RVCodepointCollection& codeset) noexcept
+    {
+        SetCodeset(codeset, RVCodeGenExclusion());
+    }
+
+    void RVCodeGenerator::SetCodeset(const RVCodepointCollection& codeset, const RVCodeGenExclusion& exclusion) noexcept
+    {
+        candidates.clear();
+        codegens.clear();
+
+        mix_source = nullptr;
+
+        for (auto iter = codeset.Begin(); iter != codeset.End(); iter++)
+        {
+            // codepoints without code generator are never rolled
+            if (!(*iter)->GetCodeGen() || exclusion.IsExcluded(*iter))
+                continue;
+
+            candidates.push_back(*iter);
+            codegens  .push_back((*iter)->GetCodeGen());
+        }
+    }
 
-        return insn;
+    inline size_t RVCodeGenerator::GetCandidateCount() const noexcept
+    {
+        return candidates.size();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVTypeJ(const RVCodeGenConstraints* constraints) noexcept
+    inline const RVCodepoint* RVCodeGenerator::GetCandidate(int index) const noexcept
     {
-        return GenRVCodeTypeJ(alloc, constraints);
+        return candidates[index];
     }
 
-    insnraw_t GenRVCodeZeroOperand(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints) noexcept
+    bool RVCodeGenerator::__UpdateMix() noexcept
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        // Returns false when no candidate could be picked
+        const RVCodeGenConstraintMix* weights = GetConstraint(constraints, RV_CODEGEN_MIX_WEIGHT);
+
+        if (!weights)
+        {
+            mix_source = nullptr;
+            return !candidates.empty();
+        }
+
+        if (weights != mix_source || weights->GetRevision() != mix_revision)
+        {
+            std::vector<uint32_t> table;
+
+            for (const RVCodepoint* candidate : candidates)
+                table.push_back(weights->GetWeight(candidate));
 
-        insn = encoder->Get();
-        delete encoder;
+            mix.Build(table);
+
+            mix_source   = weights;
+            mix_revision = weights->GetRevision();
+        }
+
+        return !mix.IsEmpty();
+    }
+
+    inline uint32_t RVCodeGenerator::__Pick() noexcept
+    {
+        if (mix_source)
+            return mix.Sample(rand);
 
-        return insn;
+        return rand.NextRange32(0, candidates.size() - 1);
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZeroOperand(const RVCodeGenConstraints* constraints) noexcept
+    const RVCodepoint* RVCodeGenerator::Next(insnraw_t* insn) noexcept
     {
-        return GenRVCodeZeroOperand(alloc, constraints);
+        if (!__UpdateMix())
+            return nullptr;
+
+        uint32_t index = __Pick();
+
+        *insn = codegens[index](rand, constraints);
+
+        return candidates[index];
+    }
+
+    bool RVCodeGenerator::Generate(insnraw_t* dst, size_t count) noexcept
+    {
+        if (!__UpdateMix())
+            return false;
+
+        if (mix_source)
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = codegens[mix.Sample(rand)](rand, constraints);
+        }
+        else
+        {
+            uint32_t bound = candidates.size() - 1;
+
+            for (size_t i = 0; i < count; i++)
+                dst[i] = codegens[rand.NextRange32(0, bound)](rand, constraints);
+        }
+
+        return true;
+    }
+
+    size_t RVCodeGenerator::Generate(RVMemoryInterface* MI, addr_t address, size_t count) noexcept
+    {
+        // Generated in fixed-size batches on stack, then stored word by word
+        insnraw_t buffer[RV_CODEGEN_BULK_SIZE];
+
+        size_t written = 0;
+
+        while (written < count)
+        {
+            size_t batch = std::min(count - written, (size_t) RV_CODEGEN_BULK_SIZE);
+
+            if (!Generate(buffer, batch))
+                break;
+
+            for (size_t i = 0; i < batch; i++, written++, address += 4)
+            {
+                data_t data;
+                data.data64 = 0;
+                data.data32 = buffer[i];
+
+                if (MI->WriteInsn(address, MOPW_WORD, data) != MOP_SUCCESS)
+                    return written;
+            }
+        }
+
+        return written;
     }
 }
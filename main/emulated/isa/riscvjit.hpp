@@ -0,0 +1,1379 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture Emulator (Jasse)
+//
+// Optional x86-64 host JIT (dynamic binary translation) of RV64I/RV64M hot blocks
+//
+// *NOTICE: Only straight-line RV64I/RV64M integer code (ending with a branch or jump) is
+//          translated. Zicsr/SYSTEM instructions, traps, and any instruction not translatable
+//          exit to the interpreter (RVInstance::Eval), where the EEI handler and trap procedures
+//          are invoked as usual. Translated instructions are NOT reported to the EEI handler
+//          or the execution, block and sampling observers, JIT is bypassed while any of them
+//          is installed.
+//          Host must be x86-64 with executable anonymous mappings, otherwise everything is
+//          interpreted.
+//
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#if defined(__x86_64__) && defined(__unix__)
+#   include <sys/mman.h>
+#   define RV_JIT_HOST_SUPPORTED                1
+#else
+#   define RV_JIT_HOST_SUPPORTED                0
+#endif
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_64m.hpp"
+
+
+//
+#define RV_JIT_DEFAULT_HOT_THRESHOLD            16
+
+#define RV_JIT_DEFAULT_CACHE_SIZE               (16 * 1024 * 1024)
+
+#define RV_JIT_DEFAULT_MAX_BLOCK_INSNS          64
+
+#define RV_JIT_LOOKUP_SIZE                      4096
+
+// upper bound of host code emitted for a single guest instruction
+#define RV_JIT_MAX_INSN_CODE_SIZE               128
+
+
+namespace Jasse {
+
+    class RVJIT;
+
+    // RISC-V JIT host-side guest context
+    // *NOTICE: Accessed by translated code through fixed offsets, field order matters.
+    typedef struct {
+        uint64_t                GR[RV_ARCH_REG_COUNT];
+        uint64_t                PC;
+
+        // fast memory path, guest [base, base + limit + 8) mapped onto host memory
+        uint64_t                mem_base;
+        uint64_t                mem_limit;
+        uint8_t*                mem_host;
+
+        // slow memory path
+        RVMemoryInterface*      MI;
+        uint64_t                fault;
+
+        RVJIT*                  jit;
+    } RVJITContext;
+
+    // RISC-V JIT translated block, returns the count of retired instructions with PC updated
+    typedef     uint32_t        (*RVJITBlock)(RVJITContext* ctx);
+
+    // RISC-V JIT statistics
+    typedef struct {
+        uint64_t    translated_blocks;
+        uint64_t    translated_insns;
+        uint64_t    jit_insns;
+        uint64_t    interpreted_insns;
+        uint64_t    cache_flushes;
+        uint64_t    verified_blocks;
+        uint64_t    mismatches;
+    } RVJITStatistics;
+
+    // RISC-V JIT verification mismatch
+    typedef struct {
+        addr_t      block;          // PC of the block
+        uint32_t    insns;          // instructions retired by the block
+        int         target;         // GR index, RV_JIT_MISMATCH_PC or RV_JIT_MISMATCH_MEMORY
+        addr_t      address;        // memory address, if any
+        uint64_t    jit_value;
+        uint64_t    ref_value;
+    } RVJITMismatch;
+
+#define RV_JIT_MISMATCH_PC                      -1
+#define RV_JIT_MISMATCH_MEMORY                  -2
+#define RV_JIT_MISMATCH_STATUS                  -3
+
+
+    // x86-64 machine code assembler of RISC-V JIT
+    class RVJITAssembler {
+    public:
+        // host registers in use
+        static constexpr int    RAX = 0;
+        static constexpr int    RCX = 1;
+        static constexpr int    RDX = 2;
+        static constexpr int    RBX = 3;
+        static constexpr int    RSI = 6;
+        static constexpr int    RDI = 7;
+
+        // condition codes
+        static constexpr int    CC_B  = 0x2;
+        static constexpr int    CC_AE = 0x3;
+        static constexpr int    CC_E  = 0x4;
+        static constexpr int    CC_NE = 0x5;
+        static constexpr int    CC_A  = 0x7;
+        static constexpr int    CC_L  = 0xC;
+        static constexpr int    CC_GE = 0xD;
+
+    private:
+        std::vector<uint8_t>    code;
+
+    public:
+        RVJITAssembler() noexcept;
+        ~RVJITAssembler() noexcept;
+
+        void                    Clear() noexcept;
+        size_t                  GetSize() const noexcept;
+        const uint8_t*          GetCode() const noexcept;
+
+        void                    Byte(uint8_t b) noexcept;
+        void                    Bytes(std::initializer_list<uint8_t> bytes) noexcept;
+        void                    Imm32(uint32_t imm) noexcept;
+        void                    Imm64(uint64_t imm) noexcept;
+
+        void                    Load(int reg, int32_t disp) noexcept;              // mov reg, [rbx + disp]
+        void                    Store(int32_t disp, int reg) noexcept;             // mov [rbx + disp], reg
+        void                    LoadGR(int reg, int gr) noexcept;
+        void                    StoreGR(int gr, int reg) noexcept;
+        void                    MovImm(int reg, uint64_t imm) noexcept;
+
+        void                    Prologue() noexcept;
+        void                    Exit(uint64_t pc, uint32_t count) noexcept;
+        void                    ExitPC(uint32_t count) noexcept;
+
+        size_t                  Jcc(int cc) noexcept;
+        size_t                  Jmp() noexcept;
+        void                    Bind(size_t label) noexcept;
+
+        void                    Call(const void* function) noexcept;
+    };
+
+
+    // RISC-V JIT
+    class RVJIT {
+    public:
+        typedef enum {
+            OP_NONE = 0,
+
+            OP_ADDI, OP_SLTI, OP_SLTIU, OP_ANDI, OP_ORI, OP_XORI,
+            OP_SLLI, OP_SRLI, OP_SRAI,
+            OP_ADDIW, OP_SLLIW, OP_SRLIW, OP_SRAIW,
+            OP_ADD, OP_SUB, OP_SLT, OP_SLTU, OP_AND, OP_OR, OP_XOR,
+            OP_SLL, OP_SRL, OP_SRA,
+            OP_ADDW, OP_SUBW, OP_SLLW, OP_SRLW, OP_SRAW,
+            OP_LUI, OP_AUIPC,
+            OP_JAL, OP_JALR,
+            OP_BEQ, OP_BNE, OP_BLT, OP_BLTU, OP_BGE, OP_BGEU,
+            OP_LD, OP_LW, OP_LH, OP_LB, OP_LWU, OP_LHU, OP_LBU,
+            OP_SD, OP_SW, OP_SH, OP_SB,
+            OP_FENCE,
+
+            OP_MUL, OP_MULH, OP_MULHU, OP_MULHSU, OP_MULW,
+            OP_DIV, OP_REM, OP_DIVU, OP_REMU,
+            OP_DIVW, OP_REMW, OP_DIVUW, OP_REMUW
+        } Op;
+
+        typedef struct {
+            addr_t      address;
+            uint32_t    length;
+            uint64_t    previous;
+            uint64_t    value;
+        } StoreRecord;
+
+    private:
+        typedef struct {
+            addr_t      pc;
+            RVJITBlock  block;
+        } LookupEntry;
+
+        RVInstance*                             instance;
+
+        uint32_t                                hot_threshold;
+        size_t                                  cache_size;
+        int                                     max_block_insns;
+        bool                                    verify;
+
+        uint8_t*                                cache;
+        size_t                                  cache_used;
+
+        std::unordered_map<addr_t, RVJITBlock>  blocks;     // nullptr for untranslatable
+        std::unordered_map<addr_t, uint32_t>    heat;
+        LookupEntry*                            lookup;
+
+        RVJITContext                            ctx;
+        RVJITAssembler                          assembler;
+
+        std::vector<StoreRecord>                store_log;
+
+        RVJITStatistics                         stats;
+        RVJITMismatch                           mismatch;
+
+        static Op               Classify(RVCodepoint::Executor executor) noexcept;
+
+        void                    AllocateCache() noexcept;
+        void                    ReleaseCache() noexcept;
+
+        void                    SyncIn() noexcept;
+        void                    SyncOut() noexcept;
+
+        RVJITBlock              Find(addr_t pc) noexcept;
+        RVJITBlock              Translate(addr_t pc) noexcept;
+        bool                    Emit(const RVInstruction& insn, Op op, addr_t pc, uint32_t count) noexcept;
+        void                    EmitMemory(const RVInstruction& insn, Op op, addr_t pc, uint32_t count) noexcept;
+
+        uint32_t                RunVerified(addr_t pc, RVJITBlock block) noexcept;
+        void                    Reject(addr_t pc) noexcept;
+
+    public:
+        RVJIT(RVInstance* instance) noexcept;
+        RVJIT(const RVJIT& obj) = delete;
+        ~RVJIT() noexcept;
+
+        static bool             IsHostSupported() noexcept;
+
+        RVInstance*             GetInstance() noexcept;
+
+        uint32_t                GetHotThreshold() const noexcept;
+        void                    SetHotThreshold(uint32_t hot_threshold) noexcept;
+
+        size_t                  GetCacheSize() const noexcept;
+        size_t                  GetCacheUsed() const noexcept;
+        void                    SetCacheSize(size_t cache_size) noexcept;
+
+        int                     GetMaxBlockInsns() const noexcept;
+        void                    SetMaxBlockInsns(int max_block_insns) noexcept;
+
+        bool                    IsVerify() const noexcept;
+        void                    SetVerify(bool verify) noexcept;
+
+        void                    SetFastMemory(addr_t base, void* host, size_t size) noexcept;
+        void                    ResetFastMemory() noexcept;
+
+        const RVJITStatistics&  GetStatistics() const noexcept;
+        const RVJITMismatch&    GetLastMismatch() const noexcept;
+
+        void                    Flush() noexcept;
+
+        RVExecStatus            Run(uint64_t max_insns, uint64_t* executed = nullptr) noexcept;
+
+        void                    LogStore(addr_t address, uint32_t length, uint64_t previous, uint64_t value) noexcept;
+
+        void                    operator=(const RVJIT& obj) = delete;
+    };
+}
+
+
+// JIT runtime helpers, called from translated code
+namespace Jasse {
+
+    static inline RVMOPWidth __RVJIT_Width(uint32_t length) noexcept
+    {
+        switch (length)
+        {
+            case 1:     return MOPW_BYTE;
+            case 2:     return MOPW_HALF_WORD;
+            case 4:     return MOPW_WORD;
+            default:    return MOPW_DOUBLE_WORD;
+        }
+    }
+
+    static uint64_t __RVJIT_Load(RVJITContext* ctx, uint64_t address, uint32_t length) noexcept
+    {
+        data_t data = { 0 };
+
+        if (ctx->MI->ReadData(address, __RVJIT_Width(length), &data) != MOP_SUCCESS)
+            ctx->fault = 1;
+
+        return data.data64;
+    }
+
+    static void __RVJIT_Store(RVJITContext* ctx, uint64_t address, uint64_t value, uint32_t length) noexcept
+    {
+        data_t previous = { 0 };
+
+        // previous value recorded for roll-back under verification
+        if (ctx->jit)
+            ctx->MI->ReadData(address, __RVJIT_Width(length), &previous);
+
+        if (ctx->MI->WriteData(address, __RVJIT_Width(length), { value }) != MOP_SUCCESS)
+        {
+            ctx->fault = 1;
+            return;
+        }
+
+        if (ctx->jit)
+            ctx->jit->LogStore(address, length, previous.data64, value);
+    }
+
+    // M-extension, same corner cases as RV64M executors
+    static uint64_t __RVJIT_MULHSU(uint64_t a, uint64_t b) noexcept
+    {
+        return (uint64_t)(((__int128)(int64_t) a * (__int128) b) >> 64);
+    }
+
+    static uint64_t __RVJIT_DIV(uint64_t a, uint64_t b) noexcept
+    {
+        if ((int64_t) a == INT64_MIN && (int64_t) b == -1)
+            return (uint64_t) INT64_MIN;
+
+        return !b ? UINT64_MAX : (uint64_t)((int64_t) a / (int64_t) b);
+    }
+
+    static uint64_t __RVJIT_REM(uint64_t a, uint64_t b) noexcept
+    {
+        if ((int64_t) a == INT64_MIN && (int64_t) b == -1)
+            return 0;
+
+        return !b ? a : (uint64_t)((int64_t) a % (int64_t) b);
+    }
+
+    static uint64_t __RVJIT_DIVU(uint64_t a, uint64_t b) noexcept
+    {
+        return !b ? UINT64_MAX : a / b;
+    }
+
+    static uint64_t __RVJIT_REMU(uint64_t a, uint64_t b) noexcept
+    {
+        return !b ? a : a % b;
+    }
+
+    static uint64_t __RVJIT_DIVW(uint64_t a, uint64_t b) noexcept
+    {
+        int32_t x = (int32_t) a, y = (int32_t) b;
+
+        if (x == INT32_MIN && y == -1)
+            return SEXT_W(INT32_MIN);
+
+        return !y ? UINT64_MAX : SEXT_W(x / y);
+    }
+
+    static uint64_t __RVJIT_REMW(uint64_t a, uint64_t b) noexcept
+    {
+        int32_t x = (int32_t) a, y = (int32_t) b;
+
+        if (x == INT32_MIN && y == -1)
+            return 0;
+
+        return !y ? SEXT_W(x) : SEXT_W(x % y);
+    }
+
+    static uint64_t __RVJIT_DIVUW(uint64_t a, uint64_t b) noexcept
+    {
+        uint32_t x = (uint32_t) a, y = (uint32_t) b;
+
+        return !y ? UINT64_MAX : SEXT_W(x / y);
+    }
+
+    static uint64_t __RVJIT_REMUW(uint64_t a, uint64_t b) noexcept
+    {
+        uint32_t x = (uint32_t) a, y = (uint32_t) b;
+
+        return !y ? SEXT_W(x) : SEXT_W(x % y);
+    }
+}
+
+
+// Implementation of: class RVJITAssembler
+namespace Jasse {
+    /*
+    std::vector<uint8_t>    code;
+    */
+
+#define __RVJIT_OFFSET(field)           ((int32_t) offsetof(RVJITContext, field))
+#define __RVJIT_OFFSET_GR(index)        (__RVJIT_OFFSET(GR) + (int32_t)((index) * sizeof(uint64_t)))
+
+    RVJITAssembler::RVJITAssembler() noexcept
+        : code  ()
+    { }
+
+    RVJITAssembler::~RVJITAssembler() noexcept
+    { }
+
+    inline void RVJITAssembler::Clear() noexcept
+    {
+        code.clear();
+    }
+
+    inline size_t RVJITAssembler::GetSize() const noexcept
+    {
+        return code.size();
+    }
+
+    inline const uint8_t* RVJITAssembler::GetCode() const noexcept
+    {
+        return code.data();
+    }
+
+    inline void RVJITAssembler::Byte(uint8_t b) noexcept
+    {
+        code.push_back(b);
+    }
+
+    inline void RVJITAssembler::Bytes(std::initializer_list<uint8_t> bytes) noexcept
+    {
+        code.insert(code.end(), bytes);
+    }
+
+    inline void RVJITAssembler::Imm32(uint32_t imm) noexcept
+    {
+        for (int i = 0; i < 4; i++)
+            code.push_back((uint8_t)(imm >> (i * 8)));
+    }
+
+    inline void RVJITAssembler::Imm64(uint64_t imm) noexcept
+    {
+        for (int i = 0; i < 8; i++)
+            code.push_back((uint8_t)(imm >> (i * 8)));
+    }
+
+    inline void RVJITAssembler::Load(int reg, int32_t disp) noexcept
+    {
+        Bytes({ 0x48, 0x8B, (uint8_t)(0x80 | (reg << 3) | RBX) });
+        Imm32(disp);
+    }
+
+    inline void RVJITAssembler::Store(int32_t disp, int reg) noexcept
+    {
+        Bytes({ 0x48, 0x89, (uint8_t)(0x80 | (reg << 3) | RBX) });
+        Imm32(disp);
+    }
+
+    inline void RVJITAssembler::LoadGR(int reg, int gr) noexcept
+    {
+        if (!gr) // xor reg32, reg32
+            Bytes({ 0x31, (uint8_t)(0xC0 | (reg << 3) | reg) });
+        else
+            Load(reg, __RVJIT_OFFSET_GR(gr));
+    }
+
+    inline void RVJITAssembler::StoreGR(int gr, int reg) noexcept
+    {
+        if (gr) // writes of x0 discarded
+            Store(__RVJIT_OFFSET_GR(gr), reg);
+    }
+
+    inline void RVJITAssembler::MovImm(int reg, uint64_t imm) noexcept
+    {
+        if ((int64_t) imm == (int64_t)(int32_t) imm) // mov reg, simm32
+        {
+            Bytes({ 0x48, 0xC7, (uint8_t)(0xC0 | reg) });
+            Imm32((uint32_t) imm);
+        }
+        else // movabs reg, imm64
+        {
+            Bytes({ 0x48, (uint8_t)(0xB8 | reg) });
+            Imm64(imm);
+        }
+    }
+
+    inline void RVJITAssembler::Prologue() noexcept
+    {
+        Bytes({ 0x53 });                // push rbx
+        Bytes({ 0x48, 0x89, 0xFB });    // mov rbx, rdi
+    }
+
+    inline void RVJITAssembler::Exit(uint64_t pc, uint32_t count) noexcept
+    {
+        MovImm(RAX, pc);
+        Store(__RVJIT_OFFSET(PC), RAX);
+        ExitPC(count);
+    }
+
+    inline void RVJITAssembler::ExitPC(uint32_t count) noexcept
+    {
+        Byte(0xB8);                     // mov eax, count
+        Imm32(count);
+        Bytes({ 0x5B, 0xC3 });          // pop rbx; ret
+    }
+
+    inline size_t RVJITAssembler::Jcc(int cc) noexcept
+    {
+        Bytes({ 0x0F, (uint8_t)(0x80 | cc) });
+        Imm32(0);
+
+        return code.size();
+    }
+
+    inline size_t RVJITAssembler::Jmp() noexcept
+    {
+        Byte(0xE9);
+        Imm32(0);
+
+        return code.size();
+    }
+
+    inline void RVJITAssembler::Bind(size_t label) noexcept
+    {
+        uint32_t rel = (uint32_t)(code.size() - label);
+
+        for (int i = 0; i < 4; i++)
+            code[label - 4 + i] = (uint8_t)(rel >> (i * 8));
+    }
+
+    inline void RVJITAssembler::Call(const void* function) noexcept
+    {
+        // stack kept 16-byte aligned by the pushed RBX in prologue
+        MovImm(RAX, (uint64_t) function);
+        Bytes({ 0xFF, 0xD0 });          // call rax
+    }
+}
+
+
+// Implementation of: class RVJIT
+namespace Jasse {
+    /*
+    RVInstance*                             instance;
+
+    uint32_t                                hot_threshold;
+    size_t                                  cache_size;
+    int                                     max_block_insns;
+    bool                                    verify;
+
+    uint8_t*                                cache;
+    size_t                                  cache_used;
+
+    std::unordered_map<addr_t, RVJITBlock>  blocks;
+    std::unordered_map<addr_t, uint32_t>    heat;
+    LookupEntry*                            lookup;
+
+    RVJITContext                            ctx;
+    RVJITAssembler                          assembler;
+
+    std::vector<StoreRecord>                store_log;
+
+    RVJITStatistics                         stats;
+    RVJITMismatch                           mismatch;
+    */
+
+    RVJIT::RVJIT(RVInstance* instance) noexcept
+        : instance          (instance)
+        , hot_threshold     (RV_JIT_DEFAULT_HOT_THRESHOLD)
+        , cache_size        (RV_JIT_DEFAULT_CACHE_SIZE)
+        , max_block_insns   (RV_JIT_DEFAULT_MAX_BLOCK_INSNS)
+        , verify            (false)
+        , cache             (nullptr)
+        , cache_used        (0)
+        , blocks            ()
+        , heat              ()
+        , lookup            (new LookupEntry[RV_JIT_LOOKUP_SIZE]())
+        , ctx               ()
+        , assembler         ()
+        , store_log         ()
+        , stats             ()
+        , mismatch          ()
+    {
+        ctx.MI  = instance->GetMI();
+        ctx.jit = nullptr;
+
+        ResetFastMemory();
+    }
+
+    RVJIT::~RVJIT() noexcept
+    {
+        ReleaseCache();
+
+        delete[] lookup;
+    }
+
+    inline bool RVJIT::IsHostSupported() noexcept
+    {
+        return RV_JIT_HOST_SUPPORTED;
+    }
+
+    RVJIT::Op RVJIT::Classify(RVCodepoint::Executor executor) noexcept
+    {
+        static const std::unordered_map<RVCodepoint::Executor, Op> ops = {
+            { &RV64IExecutor_ADDI,  OP_ADDI  }, { &RV64IExecutor_SLTI,  OP_SLTI  }, { &RV64IExecutor_SLTIU, OP_SLTIU },
+            { &RV64IExecutor_ANDI,  OP_ANDI  }, { &RV64IExecutor_ORI,   OP_ORI   }, { &RV64IExecutor_XORI,  OP_XORI  },
+            { &RV64IExecutor_SLLI,  OP_SLLI  }, { &RV64IExecutor_SRLI,  OP_SRLI  }, { &RV64IExecutor_SRAI,  OP_SRAI  },
+            { &RV64IExecutor_ADDIW, OP_ADDIW }, { &RV64IExecutor_SLLIW, OP_SLLIW }, { &RV64IExecutor_SRLIW, OP_SRLIW },
+            { &RV64IExecutor_SRAIW, OP_SRAIW },
+            { &RV64IExecutor_ADD,   OP_ADD   }, { &RV64IExecutor_SUB,   OP_SUB   }, { &RV64IExecutor_SLT,   OP_SLT   },
+            { &RV64IExecutor_SLTU,  OP_SLTU  }, { &RV64IExecutor_AND,   OP_AND   }, { &RV64IExecutor_OR,    OP_OR    },
+            { &RV64IExecutor_XOR,   OP_XOR   }, { &RV64IExecutor_SLL,   OP_SLL   }, { &RV64IExecutor_SRL,   OP_SRL   },
+            { &RV64IExecutor_SRA,   OP_SRA   },
+            { &RV64IExecutor_ADDW,  OP_ADDW  }, { &RV64IExecutor_SUBW,  OP_SUBW  }, { &RV64IExecutor_SLLW,  OP_SLLW  },
+            { &RV64IExecutor_SRLW,  OP_SRLW  }, { &RV64IExecutor_SRAW,  OP_SRAW  },
+            { &RV64IExecutor_LUI,   OP_LUI   }, { &RV64IExecutor_AUIPC, OP_AUIPC },
+            { &RV64IExecutor_JAL,   OP_JAL   }, { &RV64IExecutor_JALR,  OP_JALR  },
+            { &RV64IExecutor_BEQ,   OP_BEQ   }, { &RV64IExecutor_BNE,   OP_BNE   }, { &RV64IExecutor_BLT,   OP_BLT   },
+            { &RV64IExecutor_BLTU,  OP_BLTU  }, { &RV64IExecutor_BGE,   OP_BGE   }, { &RV64IExecutor_BGEU,  OP_BGEU  },
+            { &RV64IExecutor_LD,    OP_LD    }, { &RV64IExecutor_LW,    OP_LW    }, { &RV64IExecutor_LH,    OP_LH    },
+            { &RV64IExecutor_LB,    OP_LB    }, { &RV64IExecutor_LWU,   OP_LWU   }, { &RV64IExecutor_LHU,   OP_LHU   },
+            { &RV64IExecutor_LBU,   OP_LBU   },
+            { &RV64IExecutor_SD,    OP_SD    }, { &RV64IExecutor_SW,    OP_SW    }, { &RV64IExecutor_SH,    OP_SH    },
+            { &RV64IExecutor_SB,    OP_SB    },
+            { &RV64IExecutor_FENCE, OP_FENCE },
+            { &RV64MExecutor_MUL,   OP_MUL   }, { &RV64MExecutor_MULH,  OP_MULH  }, { &RV64MExecutor_MULHU, OP_MULHU },
+            { &RV64MExecutor_MULHSU,OP_MULHSU}, { &RV64MExecutor_MULW,  OP_MULW  },
+            { &RV64MExecutor_DIV,   OP_DIV   }, { &RV64MExecutor_REM,   OP_REM   }, { &RV64MExecutor_DIVU,  OP_DIVU  },
+            { &RV64MExecutor_REMU,  OP_REMU  }, { &RV64MExecutor_DIVW,  OP_DIVW  }, { &RV64MExecutor_REMW,  OP_REMW  },
+            { &RV64MExecutor_DIVUW, OP_DIVUW }, { &RV64MExecutor_REMUW, OP_REMUW }
+        };
+
+        auto iter = ops.find(executor);
+
+        return iter != ops.end() ? iter->second : OP_NONE;
+    }
+
+    void RVJIT::AllocateCache() noexcept
+    {
+#if RV_JIT_HOST_SUPPORTED
+        void* mapped = mmap(nullptr, cache_size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        cache = mapped == MAP_FAILED ? nullptr : (uint8_t*) mapped;
+#endif
+        cache_used = 0;
+    }
+
+    void RVJIT::ReleaseCache() noexcept
+    {
+#if RV_JIT_HOST_SUPPORTED
+        if (cache)
+            munmap(cache, cache_size);
+#endif
+        cache      = nullptr;
+        cache_used = 0;
+    }
+
+    inline RVInstance* RVJIT::GetInstance() noexcept
+    {
+        return instance;
+    }
+
+    inline uint32_t RVJIT::GetHotThreshold() const noexcept
+    {
+        return hot_threshold;
+    }
+
+    inline void RVJIT::SetHotThreshold(uint32_t hot_threshold) noexcept
+    {
+        this->hot_threshold = hot_threshold;
+    }
+
+    inline size_t RVJIT::GetCacheSize() const noexcept
+    {
+        return cache_size;
+    }
+
+    inline size_t RVJIT::GetCacheUsed() const noexcept
+    {
+        return cache_used;
+    }
+
+    void RVJIT::SetCacheSize(size_t cache_size) noexcept
+    {
+        Flush();
+        ReleaseCache();
+
+        this->cache_size = cache_size;
+    }
+
+    inline int RVJIT::GetMaxBlockInsns() const noexcept
+    {
+        return max_block_insns;
+    }
+
+    void RVJIT::SetMaxBlockInsns(int max_block_insns) noexcept
+    {
+        Flush();
+
+        this->max_block_insns = max_block_insns > 0 ? max_block_insns : 1;
+    }
+
+    inline bool RVJIT::IsVerify() const noexcept
+    {
+        return verify;
+    }
+
+    void RVJIT::SetVerify(bool verify) noexcept
+    {
+        // memory accesses all through the slow path (recorded) under verification
+        Flush();
+
+        this->verify = verify;
+        ctx.jit      = verify ? this : nullptr;
+    }
+
+    void RVJIT::SetFastMemory(addr_t base, void* host, size_t size) noexcept
+    {
+        // *NOTICE: Host memory must be the backing storage of the memory interface for guest
+        //          addresses [base, base + size), with no side effect on access.
+        Flush();
+
+        if (size < sizeof(uint64_t))
+        {
+            ResetFastMemory();
+            return;
+        }
+
+        ctx.mem_base  = base;
+        ctx.mem_limit = size - sizeof(uint64_t);
+        ctx.mem_host  = (uint8_t*) host;
+    }
+
+    void RVJIT::ResetFastMemory() noexcept
+    {
+        ctx.mem_base  = 0;
+        ctx.mem_limit = 0;
+        ctx.mem_host  = nullptr;
+    }
+
+    inline const RVJITStatistics& RVJIT::GetStatistics() const noexcept
+    {
+        return stats;
+    }
+
+    inline const RVJITMismatch& RVJIT::GetLastMismatch() const noexcept
+    {
+        return mismatch;
+    }
+
+    void RVJIT::Flush() noexcept
+    {
+        blocks.clear();
+        heat.clear();
+
+        std::fill_n(lookup, RV_JIT_LOOKUP_SIZE, LookupEntry { 0, nullptr });
+
+        cache_used = 0;
+
+        stats.cache_flushes++;
+    }
+
+    void RVJIT::SyncIn() noexcept
+    {
+        const RVArchitectural& arch = instance->GetArch();
+
+        ctx.GR[0] = 0;
+        for (int i = 1; i < RV_ARCH_REG_COUNT; i++)
+            ctx.GR[i] = arch.GetGRx64Zext(i);
+
+        ctx.PC = arch.PC().pc64;
+    }
+
+    void RVJIT::SyncOut() noexcept
+    {
+        RVArchitectural& arch = instance->GetArch();
+
+        for (int i = 1; i < RV_ARCH_REG_COUNT; i++)
+            arch.SetGRx64(i, ctx.GR[i]);
+
+        arch.SetPC64(ctx.PC);
+    }
+
+    inline RVJITBlock RVJIT::Find(addr_t pc) noexcept
+    {
+        LookupEntry& entry = lookup[(pc >> 2) & (RV_JIT_LOOKUP_SIZE - 1)];
+
+        if (entry.block && entry.pc == pc)
+            return entry.block;
+
+        auto iter = blocks.find(pc);
+
+        if (iter == blocks.end() || !iter->second)
+            return nullptr;
+
+        entry = { pc, iter->second };
+
+        return iter->second;
+    }
+
+    void RVJIT::Reject(addr_t pc) noexcept
+    {
+        blocks[pc] = nullptr;
+
+        LookupEntry& entry = lookup[(pc >> 2) & (RV_JIT_LOOKUP_SIZE - 1)];
+
+        if (entry.pc == pc)
+            entry = { 0, nullptr };
+    }
+
+    void RVJIT::LogStore(addr_t address, uint32_t length, uint64_t previous, uint64_t value) noexcept
+    {
+        store_log.push_back(StoreRecord { address, length, previous, value });
+    }
+
+    RVJITBlock RVJIT::Translate(addr_t pc) noexcept
+    {
+#if RV_JIT_HOST_SUPPORTED
+        if (!cache)
+            AllocateCache();
+
+        if (!cache)
+            return nullptr;
+
+        assembler.Clear();
+        assembler.Prologue();
+
+        addr_t      cur   = pc;
+        uint32_t    count = 0;
+        bool        ended = false;
+
+        while ((int) count < max_block_insns)
+        {
+            data_t          fetched;
+            RVInstruction   insn;
+
+            if (instance->GetMI()->ReadInsn(cur, MOPW_WORD, &fetched) != MOP_SUCCESS)
+                break;
+
+            if (!instance->GetDecoders().Decode(fetched.data32, insn))
+                break;
+
+            Op op = Classify(insn.GetExecutor());
+
+            if (op == OP_NONE)
+                break;
+
+            ended = Emit(insn, op, cur, count);
+
+            count++;
+
+            if (ended)
+                break;
+
+            cur += 4;
+        }
+
+        if (!count)
+            return nullptr;
+
+        if (!ended)
+            assembler.Exit(cur, count);
+
+        // code cache, flushed entirely once full
+        if (cache_used + assembler.GetSize() > cache_size)
+        {
+            Flush();
+
+            if (assembler.GetSize() > cache_size)
+                return nullptr;
+        }
+
+        uint8_t* entry = cache + cache_used;
+
+        memcpy(entry, assembler.GetCode(), assembler.GetSize());
+
+        cache_used += (assembler.GetSize() + 15) & ~((size_t) 15);
+
+        stats.translated_blocks++;
+        stats.translated_insns += count;
+
+        return (RVJITBlock) entry;
+#else
+        return nullptr;
+#endif
+    }
+
+    bool RVJIT::Emit(const RVInstruction& insn, Op op, addr_t pc, uint32_t count) noexcept
+    {
+        using A = RVJITAssembler;
+
+        RVJITAssembler& a = assembler;
+
+        const int       rd  = insn.GetRD();
+        const int       rs1 = insn.GetRS1();
+        const int       rs2 = insn.GetRS2();
+        const uint64_t  imm = SEXT_W(insn.GetImmediate());
+
+        const uint8_t   shamt6 = GET_STD_OPERAND(insn.GetRaw(), RV_OPERAND_SHAMT6);
+        const uint8_t   shamt5 = GET_STD_OPERAND(insn.GetRaw(), RV_OPERAND_SHAMT5);
+
+        switch (op)
+        {
+            // rax = rs1 op imm
+            case OP_ADDI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0x05 }); a.Imm32(imm); a.StoreGR(rd, A::RAX); break;
+            case OP_ANDI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0x25 }); a.Imm32(imm); a.StoreGR(rd, A::RAX); break;
+            case OP_ORI:    a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0x0D }); a.Imm32(imm); a.StoreGR(rd, A::RAX); break;
+            case OP_XORI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0x35 }); a.Imm32(imm); a.StoreGR(rd, A::RAX); break;
+
+            case OP_SLTI:
+            case OP_SLTIU:
+                a.LoadGR(A::RAX, rs1);
+                a.MovImm(A::RCX, imm);
+                a.Bytes({ 0x48, 0x39, 0xC8 });                                          // cmp rax, rcx
+                a.Bytes({ 0x0F, (uint8_t)(op == OP_SLTI ? 0x9C : 0x92), 0xC0 });        // setl/setb al
+                a.Bytes({ 0x0F, 0xB6, 0xC0 });                                          // movzx eax, al
+                a.StoreGR(rd, A::RAX);
+                break;
+
+            case OP_SLLI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0xC1, 0xE0, shamt6 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRLI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0xC1, 0xE8, shamt6 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRAI:   a.LoadGR(A::RAX, rs1); a.Bytes({ 0x48, 0xC1, 0xF8, shamt6 }); a.StoreGR(rd, A::RAX); break;
+
+            // 32-bit operations, then movsxd rax, eax
+            case OP_ADDIW:  a.LoadGR(A::RAX, rs1); a.Byte(0x05); a.Imm32(imm);             a.Bytes({ 0x48, 0x63, 0xC0 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SLLIW:  a.LoadGR(A::RAX, rs1); a.Bytes({ 0xC1, 0xE0, shamt5 });        a.Bytes({ 0x48, 0x63, 0xC0 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRLIW:  a.LoadGR(A::RAX, rs1); a.Bytes({ 0xC1, 0xE8, shamt5 });        a.Bytes({ 0x48, 0x63, 0xC0 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRAIW:  a.LoadGR(A::RAX, rs1); a.Bytes({ 0xC1, 0xF8, shamt5 });        a.Bytes({ 0x48, 0x63, 0xC0 }); a.StoreGR(rd, A::RAX); break;
+
+            // rax = rs1 op rcx(rs2)
+            case OP_ADD:
+            case OP_SUB:
+            case OP_AND:
+            case OP_OR:
+            case OP_XOR:
+            case OP_MUL:
+            {
+                a.LoadGR(A::RAX, rs1);
+                a.LoadGR(A::RCX, rs2);
+
+                switch (op)
+                {
+                    case OP_ADD:    a.Bytes({ 0x48, 0x01, 0xC8 });          break;
+                    case OP_SUB:    a.Bytes({ 0x48, 0x29, 0xC8 });          break;
+                    case OP_AND:    a.Bytes({ 0x48, 0x21, 0xC8 });          break;
+                    case OP_OR:     a.Bytes({ 0x48, 0x09, 0xC8 });          break;
+                    case OP_XOR:    a.Bytes({ 0x48, 0x31, 0xC8 });          break;
+                    default:        a.Bytes({ 0x48, 0x0F, 0xAF, 0xC1 });    break;  // imul rax, rcx
+                }
+
+                a.StoreGR(rd, A::RAX);
+                break;
+            }
+
+            case OP_SLT:
+            case OP_SLTU:
+                a.LoadGR(A::RAX, rs1);
+                a.LoadGR(A::RCX, rs2);
+                a.Bytes({ 0x48, 0x39, 0xC8 });
+                a.Bytes({ 0x0F, (uint8_t)(op == OP_SLT ? 0x9C : 0x92), 0xC0 });
+                a.Bytes({ 0x0F, 0xB6, 0xC0 });
+                a.StoreGR(rd, A::RAX);
+                break;
+
+            // shift amount in cl, masked by host as RISC-V does (6 bits, 5 bits in 32-bit)
+            case OP_SLL:    a.LoadGR(A::RAX, rs1); a.LoadGR(A::RCX, rs2); a.Bytes({ 0x48, 0xD3, 0xE0 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRL:    a.LoadGR(A::RAX, rs1); a.LoadGR(A::RCX, rs2); a.Bytes({ 0x48, 0xD3, 0xE8 }); a.StoreGR(rd, A::RAX); break;
+            case OP_SRA:    a.LoadGR(A::RAX, rs1); a.LoadGR(A::RCX, rs2); a.Bytes({ 0x48, 0xD3, 0xF8 }); a.StoreGR(rd, A::RAX); break;
+
+            case OP_ADDW:
+            case OP_SUBW:
+            case OP_SLLW:
+            case OP_SRLW:
+            case OP_SRAW:
+            case OP_MULW:
+            {
+                a.LoadGR(A::RAX, rs1);
+                a.LoadGR(A::RCX, rs2);
+
+                switch (op)
+                {
+                    case OP_ADDW:   a.Bytes({ 0x01, 0xC8 });                break;
+                    case OP_SUBW:   a.Bytes({ 0x29, 0xC8 });                break;
+                    case OP_SLLW:   a.Bytes({ 0xD3, 0xE0 });                break;
+                    case OP_SRLW:   a.Bytes({ 0xD3, 0xE8 });                break;
+                    case OP_SRAW:   a.Bytes({ 0xD3, 0xF8 });                break;
+                    default:        a.Bytes({ 0x0F, 0xAF, 0xC1 });          break;  // imul eax, ecx
+                }
+
+                a.Bytes({ 0x48, 0x63, 0xC0 });
+                a.StoreGR(rd, A::RAX);
+                break;
+            }
+
+            // rdx:rax = rax * rcx
+            case OP_MULH:
+            case OP_MULHU:
+                a.LoadGR(A::RAX, rs1);
+                a.LoadGR(A::RCX, rs2);
+                a.Bytes({ 0x48, 0xF7, (uint8_t)(op == OP_MULH ? 0xE9 : 0xE1) });       // imul/mul rcx
+                a.StoreGR(rd, A::RDX);
+                break;
+
+            // helper(rs1, rs2)
+            case OP_MULHSU:
+            case OP_DIV:
+            case OP_REM:
+            case OP_DIVU:
+            case OP_REMU:
+            case OP_DIVW:
+            case OP_REMW:
+            case OP_DIVUW:
+            case OP_REMUW:
+            {
+                const void* helper;
+
+                switch (op)
+                {
+                    case OP_MULHSU: helper = (const void*) &__RVJIT_MULHSU;  break;
+                    case OP_DIV:    helper = (const void*) &__RVJIT_DIV;     break;
+                    case OP_REM:    helper = (const void*) &__RVJIT_REM;     break;
+                    case OP_DIVU:   helper = (const void*) &__RVJIT_DIVU;    break;
+                    case OP_REMU:   helper = (const void*) &__RVJIT_REMU;    break;
+                    case OP_DIVW:   helper = (const void*) &__RVJIT_DIVW;    break;
+                    case OP_REMW:   helper = (const void*) &__RVJIT_REMW;    break;
+                    case OP_DIVUW:  helper = (const void*) &__RVJIT_DIVUW;   break;
+                    default:        helper = (const void*) &__RVJIT_REMUW;   break;
+                }
+
+                a.LoadGR(A::RDI, rs1);
+                a.LoadGR(A::RSI, rs2);
+                a.Call(helper);
+                a.StoreGR(rd, A::RAX);
+                break;
+            }
+
+            case OP_LUI:
+                a.MovImm(A::RAX, imm);
+                a.StoreGR(rd, A::RAX);
+                break;
+
+            case OP_AUIPC:
+                a.MovImm(A::RAX, imm + pc);
+                a.StoreGR(rd, A::RAX);
+                break;
+
+            case OP_FENCE:
+                break;
+
+            case OP_LD: case OP_LW: case OP_LH: case OP_LB: case OP_LWU: case OP_LHU: case OP_LBU:
+            case OP_SD: case OP_SW: case OP_SH: case OP_SB:
+                EmitMemory(insn, op, pc, count);
+                break;
+
+            // control transfers, ending the block
+            case OP_JAL:
+                a.MovImm(A::RAX, pc + 4);
+                a.StoreGR(rd, A::RAX);
+                a.Exit(pc + imm, count + 1);
+                return true;
+
+            case OP_JALR:
+                a.LoadGR(A::RCX, rs1);
+                a.Bytes({ 0x48, 0x81, 0xC1 }); a.Imm32(imm);                            // add rcx, imm
+                a.Bytes({ 0x48, 0x83, 0xE1, 0xFE });                                    // and rcx, -2
+                a.Store(__RVJIT_OFFSET(PC), A::RCX);
+                a.MovImm(A::RAX, pc + 4);
+                a.StoreGR(rd, A::RAX);
+                a.ExitPC(count + 1);
+                return true;
+
+            case OP_BEQ: case OP_BNE: case OP_BLT: case OP_BLTU: case OP_BGE: case OP_BGEU:
+            {
+                int cc;
+
+                switch (op)
+                {
+                    case OP_BEQ:    cc = A::CC_E;   break;
+                    case OP_BNE:    cc = A::CC_NE;  break;
+                    case OP_BLT:    cc = A::CC_L;   break;
+                    case OP_BLTU:   cc = A::CC_B;   break;
+                    case OP_BGE:    cc = A::CC_GE;  break;
+                    default:        cc = A::CC_AE;  break;
+                }
+
+                a.LoadGR(A::RAX, rs1);
+                a.LoadGR(A::RCX, rs2);
+                a.Bytes({ 0x48, 0x39, 0xC8 });
+
+                size_t taken = a.Jcc(cc);
+
+                a.Exit(pc + 4, count + 1);
+
+                a.Bind(taken);
+                a.Exit(pc + imm, count + 1);
+                return true;
+            }
+
+            [[unlikely]] default:
+                break;
+        }
+
+        return false;
+    }
+
+    void RVJIT::EmitMemory(const RVInstruction& insn, Op op, addr_t pc, uint32_t count) noexcept
+    {
+        using A = RVJITAssembler;
+
+        RVJITAssembler& a = assembler;
+
+        const bool      store = op == OP_SD || op == OP_SW || op == OP_SH || op == OP_SB;
+        const uint32_t  length = (op == OP_LD || op == OP_SD) ? 8
+                               : (op == OP_LW || op == OP_LWU || op == OP_SW) ? 4
+                               : (op == OP_LH || op == OP_LHU || op == OP_SH) ? 2 : 1;
+
+        // rax = address, rdx = store data
+        a.LoadGR(A::RAX, insn.GetRS1());
+        a.Bytes({ 0x48, 0x05 }); a.Imm32(SEXT_W(insn.GetImmediate()));
+
+        if (store)
+            a.LoadGR(A::RDX, insn.GetRS2());
+
+        size_t done = 0;
+
+        // fast path: rcx = host address, if guest address falls in the mapped window
+        if (ctx.mem_host && !verify)
+        {
+            a.Bytes({ 0x48, 0x89, 0xC1 });                                              // mov rcx, rax
+            a.Bytes({ 0x48, 0x2B, 0x8B }); a.Imm32(__RVJIT_OFFSET(mem_base));          // sub rcx, [rbx + mem_base]
+            a.Bytes({ 0x48, 0x3B, 0x8B }); a.Imm32(__RVJIT_OFFSET(mem_limit));         // cmp rcx, [rbx + mem_limit]
+
+            size_t slow = a.Jcc(A::CC_A);
+
+            a.Bytes({ 0x48, 0x03, 0x8B }); a.Imm32(__RVJIT_OFFSET(mem_host));          // add rcx, [rbx + mem_host]
+
+            if (store)
+            {
+                switch (length)
+                {
+                    case 8:     a.Bytes({ 0x48, 0x89, 0x11 });  break;                  // mov [rcx], rdx
+                    case 4:     a.Bytes({ 0x89, 0x11 });        break;                  // mov [rcx], edx
+                    case 2:     a.Bytes({ 0x66, 0x89, 0x11 });  break;                  // mov [rcx], dx
+                    default:    a.Bytes({ 0x88, 0x11 });        break;                  // mov [rcx], dl
+                }
+            }
+            else
+                a.Bytes({ 0x48, 0x8B, 0x01 });                                          // mov rax, [rcx]
+
+            done = a.Jmp();
+
+            a.Bind(slow);
+        }
+
+        // slow path through memory interface, exits ahead of this instruction on failure
+        a.Bytes({ 0x48, 0x89, 0xDF });                                                  // mov rdi, rbx
+        a.Bytes({ 0x48, 0x89, 0xC6 });                                                  // mov rsi, rax
+
+        if (store)
+        {
+            a.Byte(0xB9); a.Imm32(length);                                              // mov ecx, length
+            a.Call((const void*) &__RVJIT_Store);
+        }
+        else
+        {
+            a.Byte(0xBA); a.Imm32(length);                                              // mov edx, length
+            a.Call((const void*) &__RVJIT_Load);
+        }
+
+        a.Bytes({ 0x48, 0x83, 0xBB }); a.Imm32(__RVJIT_OFFSET(fault)); a.Byte(0x00);   // cmp qword [rbx + fault], 0
+
+        size_t success = a.Jcc(A::CC_E);
+
+        a.Bytes({ 0x48, 0xC7, 0x83 }); a.Imm32(__RVJIT_OFFSET(fault)); a.Imm32(0);     // mov qword [rbx + fault], 0
+        a.Exit(pc, count);
+
+        a.Bind(success);
+
+        if (done)
+            a.Bind(done);
+
+        // extension of loaded data
+        if (!store)
+        {
+            switch (op)
+            {
+                case OP_LW:     a.Bytes({ 0x48, 0x63, 0xC0 });          break;          // movsxd rax, eax
+                case OP_LWU:    a.Bytes({ 0x89, 0xC0 });                break;          // mov eax, eax
+                case OP_LH:     a.Bytes({ 0x48, 0x0F, 0xBF, 0xC0 });    break;          // movsx rax, ax
+                case OP_LHU:    a.Bytes({ 0x0F, 0xB7, 0xC0 });          break;          // movzx eax, ax
+                case OP_LB:     a.Bytes({ 0x48, 0x0F, 0xBE, 0xC0 });    break;          // movsx rax, al
+                case OP_LBU:    a.Bytes({ 0x0F, 0xB6, 0xC0 });          break;          // movzx eax, al
+                default:                                                break;
+            }
+
+            a.StoreGR(insn.GetRD(), A::RAX);
+        }
+    }
+
+    uint32_t RVJIT::RunVerified(addr_t pc, RVJITBlock block) noexcept
+    {
+        // translated block run first, rolled back, then replayed by the interpreter as reference
+        SyncIn();
+
+        store_log.clear();
+
+        uint32_t count = block(&ctx);
+
+        if (!count)
+            return 0;
+
+        std::map<addr_t, uint8_t> stored;
+
+        for (const StoreRecord& record : store_log)
+            for (uint32_t i = 0; i < record.length; i++)
+                stored[record.address + i] = (uint8_t)(record.value >> (i * 8));
+
+        for (auto iter = store_log.rbegin(); iter != store_log.rend(); iter++)
+            ctx.MI->WriteData(iter->address, __RVJIT_Width(iter->length), { iter->previous });
+
+        //
+        stats.verified_blocks++;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            RVExecStatus status = instance->Eval();
+
+            if (status != EXEC_SEQUENTIAL && status != EXEC_PC_JUMP)
+            {
+                mismatch = { pc, count, RV_JIT_MISMATCH_STATUS, 0, EXEC_SEQUENTIAL, (uint64_t) status };
+                stats.mismatches++;
+                Reject(pc);
+
+                return i + 1;
+            }
+        }
+
+        const RVArchitectural& arch = instance->GetArch();
+
+        bool matched = true;
+
+        for (int i = 1; i < RV_ARCH_REG_COUNT && matched; i++)
+            if (arch.GetGRx64Zext(i) != ctx.GR[i])
+            {
+                mismatch = { pc, count, i, 0, ctx.GR[i], arch.GetGRx64Zext(i) };
+                matched  = false;
+            }
+
+        if (matched && arch.PC().pc64 != ctx.PC)
+        {
+            mismatch = { pc, count, RV_JIT_MISMATCH_PC, 0, ctx.PC, arch.PC().pc64 };
+            matched  = false;
+        }
+
+        for (auto iter = stored.begin(); iter != stored.end() && matched; iter++)
+        {
+            data_t data = { 0 };
+
+            ctx.MI->ReadData(iter->first, MOPW_BYTE, &data);
+
+            if (data.data8 != iter->second)
+            {
+                mismatch = { pc, count, RV_JIT_MISMATCH_MEMORY, iter->first, iter->second, data.data8 };
+                matched  = false;
+            }
+        }
+
+        if (!matched)
+        {
+            stats.mismatches++;
+            Reject(pc);
+        }
+
+        return count;
+    }
+
+    RVExecStatus RVJIT::Run(uint64_t max_insns, uint64_t* executed) noexcept
+    {
+        RVExecStatus status = EXEC_SEQUENTIAL;
+
+        uint64_t    count  = 0;
+        bool        in_ctx = false; // whether live register state held in JIT context
+        bool        head   = true;  // whether PC is a block head candidate
+
+        const bool  enabled = RV_JIT_HOST_SUPPORTED
+                           && instance->GetArch().XLEN() == XLEN64
+                           && !instance->GetExecObserver()
+                           && !instance->GetExecEEI()
+                           && !instance->GetBlockObserver()
+                           && !instance->GetSampleObserver();
+
+        RVCSRCounters& counters = instance->GetCSRs().GetCounters();
+
+        ctx.MI = instance->GetMI();
+
+        while (count < max_insns)
+        {
+            if (enabled)
+            {
+                addr_t      pc    = in_ctx ? ctx.PC : instance->GetArch().PC().pc64;
+                RVJITBlock  block = Find(pc);
+
+                if (!block && head && blocks.find(pc) == blocks.end() && ++heat[pc] >= hot_threshold)
+                {
+                    heat.erase(pc);
+
+                    if (!(block = Translate(pc)))
+                        Reject(pc);
+                    else
+                        blocks[pc] = block;
+                }
+
+                if (block)
+                {
+                    uint32_t retired;
+
+                    if (verify) // retired by interpreter replay
+                        retired = RunVerified(pc, block);
+                    else
+                    {
+                        if (!in_ctx)
+                        {
+                            SyncIn();
+                            in_ctx = true;
+                        }
+
+                        retired = block(&ctx);
+
+                        counters.Retire(retired);
+
+                        stats.jit_insns += retired;
+                    }
+
+                    count += retired;
+                    head   = true;
+
+                    if (retired)
+                        continue;
+                }
+            }
+
+            //
+            if (in_ctx)
+            {
+                SyncOut();
+                in_ctx = false;
+            }
+
+            insnraw_t fetched = 0;
+            {
+                data_t data;
+                if (instance->GetMI()->ReadInsn(instance->GetArch().PC().pc64, MOPW_WORD, &data) == MOP_SUCCESS)
+                    fetched = data.data32;
+            }
+
+            status = instance->Eval();
+
+            count++;
+            stats.interpreted_insns++;
+
+            // FENCE.I, translated code possibly stale
+            if (GET_STD_OPERAND(fetched, RV_OPCODE) == 0b0001111 && ((fetched >> 12) & 0x7) == 0b001)
+                Flush();
+
+            switch (status)
+            {
+                case EXEC_SEQUENTIAL:
+                    head = false;
+                    break;
+
+                case EXEC_PC_JUMP:
+                case EXEC_PC_HOLD:
+                case EXEC_TRAP_ENTER:
+                case EXEC_TRAP_RETURN:
+                    head = true;
+                    break;
+
+                default: // reported to the caller
+                    if (executed)
+                        *executed = count;
+
+                    return status;
+            }
+        }
+
+        if (in_ctx)
+            SyncOut();
+
+        if (executed)
+            *executed = count;
+
+        return status;
+    }
+}
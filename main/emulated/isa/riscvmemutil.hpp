@@ -7,6 +7,11 @@
 
 #include "base/riscvmem.hpp"
 
+#if defined(__unix__)
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
 
 namespace Jasse {
 
@@ -98,6 +103,40 @@ namespace Jasse {
         virtual RVMOPStatus WriteInsn(addr_t address, RVMOPWidth width, data_t  src) override;
         virtual RVMOPStatus WriteData(addr_t address, RVMOPWidth width, data_t  src) override;
     };
+
+    // Mapped Linear Memory, host memory mapping based at a guest address
+    // *NOTICE: Backed by lazily committed anonymous pages on unix hosts, with file pages mappable
+    //          (copy-on-write) for zero-copy loading. Falls back to heap allocation elsewhere,
+    //          where MapFile() always fails.
+    class MappedLinearMemory : public RVMemoryInterface {
+    private:
+        const addr_t    base;
+        const size_t    capacity;
+        uint8_t*        host;
+
+    public:
+        MappedLinearMemory(addr_t base, size_t capacity);
+        MappedLinearMemory(const MappedLinearMemory& obj) = delete;
+        ~MappedLinearMemory();
+
+        addr_t              GetBase() const;
+        size_t              GetCapacity() const;
+        static size_t       GetPageSize();
+
+        uint8_t*            GetHost();
+        const uint8_t*      GetHost() const;
+        uint8_t*            GetHost(addr_t address, size_t length);
+
+        bool                MapFile(addr_t address, int fd, uint64_t offset, size_t length);
+        void                Zero(addr_t address, size_t length);
+
+        virtual RVMOPStatus ReadInsn (addr_t address, RVMOPWidth width, data_t* dst) override;
+        virtual RVMOPStatus ReadData (addr_t address, RVMOPWidth width, data_t* dst) override;
+        virtual RVMOPStatus WriteInsn(addr_t address, RVMOPWidth width, data_t  src) override;
+        virtual RVMOPStatus WriteData(addr_t address, RVMOPWidth width, data_t  src) override;
+
+        void                operator=(const MappedLinearMemory& obj) = delete;
+    };
 }
 
 
@@ -266,7 +305,7 @@ namespace Jasse {
     {
         // !! little-endian system only !!
 
-        if (address + width.length > GetCapacity()) // address out of range
+        if (address >= GetCapacity() || width.length > GetCapacity() - address) // address out of range (wrap-around safe)
             return MOP_ACCESS_FAULT;
 
         if (width.length > 8) // unsupported access length
@@ -286,7 +325,7 @@ namespace Jasse {
     {
         // !! little-endian system only !!
 
-        if (address + width.length > GetCapacity()) // address out of range
+        if (address >= GetCapacity() || width.length > GetCapacity() - address) // address out of range (wrap-around safe)
             return MOP_ACCESS_FAULT;
 
         if (width.length > 8) // unsupported access length
@@ -359,3 +398,158 @@ namespace Jasse {
         return memory->WriteData(address % cycle, width, src);
     }
 }
+
+
+// Implementation of: class MappedLinearMemory
+namespace Jasse {
+    /*
+    const addr_t    base;
+    const size_t    capacity;
+    uint8_t*        host;
+    */
+
+    MappedLinearMemory::MappedLinearMemory(addr_t base, size_t capacity)
+        : base      (base)
+        , capacity  (capacity)
+        , host      (nullptr)
+    {
+#if defined(__unix__)
+        void* mapped = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        host = mapped == MAP_FAILED ? nullptr : (uint8_t*) mapped;
+#else
+        host = new uint8_t[capacity]();
+#endif
+    }
+
+    MappedLinearMemory::~MappedLinearMemory()
+    {
+#if defined(__unix__)
+        if (host)
+            munmap(host, capacity);
+#else
+        delete[] host;
+#endif
+    }
+
+    inline addr_t MappedLinearMemory::GetBase() const
+    {
+        return base;
+    }
+
+    inline size_t MappedLinearMemory::GetCapacity() const
+    {
+        return host ? capacity : 0;
+    }
+
+    inline size_t MappedLinearMemory::GetPageSize()
+    {
+#if defined(__unix__)
+        static const size_t page = sysconf(_SC_PAGESIZE);
+        return page;
+#else
+        return 4096;
+#endif
+    }
+
+    inline uint8_t* MappedLinearMemory::GetHost()
+    {
+        return host;
+    }
+
+    inline const uint8_t* MappedLinearMemory::GetHost() const
+    {
+        return host;
+    }
+
+    inline uint8_t* MappedLinearMemory::GetHost(addr_t address, size_t length)
+    {
+        // wrap-around safe range check
+        if (address < base || address - base > GetCapacity() || length > GetCapacity() - (address - base))
+            return nullptr;
+
+        return host + (address - base);
+    }
+
+    bool MappedLinearMemory::MapFile(addr_t address, int fd, uint64_t offset, size_t length)
+    {
+        // page-aligned ranges only, mapped private (copy-on-write) over anonymous pages
+#if defined(__unix__)
+        uint8_t* target = GetHost(address, length);
+
+        size_t page = GetPageSize();
+
+        if (!target || ((uintptr_t) target % page) || (offset % page) || (length % page))
+            return false;
+
+        return mmap(target, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, offset) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    void MappedLinearMemory::Zero(addr_t address, size_t length)
+    {
+        uint8_t* target = GetHost(address, length);
+
+        if (!target)
+            return;
+
+#if defined(__unix__)
+        // whole pages re-mapped to fresh anonymous pages, committed on touch only
+        size_t page = GetPageSize();
+
+        uint8_t* first = (uint8_t*)(((uintptr_t) target + page - 1) / page * page);
+        uint8_t* last  = (uint8_t*)(((uintptr_t) target + length) / page * page);
+
+        if (first < last
+         && mmap(first, last - first, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) != MAP_FAILED)
+        {
+            memset(target, 0, first - target);
+            memset(last, 0, target + length - last);
+            return;
+        }
+#endif
+        memset(target, 0, length);
+    }
+
+    inline RVMOPStatus MappedLinearMemory::ReadInsn(addr_t address, RVMOPWidth width, data_t* dst)
+    {
+        return ReadData(address, width, dst);
+    }
+
+    RVMOPStatus MappedLinearMemory::ReadData(addr_t address, RVMOPWidth width, data_t* dst)
+    {
+        // !! little-endian system only !!
+
+        uint8_t* src = GetHost(address, width.length);
+
+        if (!src || width.length > 8) // address out of range or unsupported access length
+            return MOP_ACCESS_FAULT;
+
+        memcpy(dst, src, width.length);
+
+        return MOP_SUCCESS;
+    }
+
+    inline RVMOPStatus MappedLinearMemory::WriteInsn(addr_t address, RVMOPWidth width, data_t src)
+    {
+        return WriteData(address, width, src);
+    }
+
+    RVMOPStatus MappedLinearMemory::WriteData(addr_t address, RVMOPWidth width, data_t src)
+    {
+        // !! little-endian system only !!
+
+        uint8_t* dst = GetHost(address, width.length);
+
+        if (!dst || width.length > 8) // address out of range or unsupported access length
+            return MOP_ACCESS_FAULT;
+
+        memcpy(dst, &src, width.length);
+
+        return MOP_SUCCESS;
+    }
+}
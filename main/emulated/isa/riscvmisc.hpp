@@ -116,13 +116,13 @@ namespace Jasse {
     class RVEncoderTypeIZeroOperand;
 
     // RISC-V Normal Instruction Form Encoder Allocator templates
-    template<int opcode, int funct3, int funct7>    RVEncoder* AllocRVEncoderTypeR() noexcept;
-    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeI() noexcept;
-    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeS() noexcept;
-    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeB() noexcept;
-    template<int opcode>                            RVEncoder* AllocRVEncoderTypeU() noexcept;
-    template<int opcode>                            RVEncoder* AllocRVEncoderTypeJ() noexcept;
-    template<int opcode, int funct3, int funct12>   RVEncoder* AllocRVEncoderTypeIZeroOperand() noexcept;
+    template<int opcode, int funct3, int funct7>    RVEncoder* AllocRVEncoderTypeR(RVEncoderStorage* storage) noexcept;
+    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeI(RVEncoderStorage* storage) noexcept;
+    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeS(RVEncoderStorage* storage) noexcept;
+    template<int opcode, int funct3>                RVEncoder* AllocRVEncoderTypeB(RVEncoderStorage* storage) noexcept;
+    template<int opcode>                            RVEncoder* AllocRVEncoderTypeU(RVEncoderStorage* storage) noexcept;
+    template<int opcode>                            RVEncoder* AllocRVEncoderTypeJ(RVEncoderStorage* storage) noexcept;
+    template<int opcode, int funct3, int funct12>   RVEncoder* AllocRVEncoderTypeIZeroOperand(RVEncoderStorage* storage) noexcept;
 
 
 #define __RV_ENCODER_DECLARATIONS \
@@ -706,38 +706,38 @@ namespace Jasse {
 // Implementation of Normal Form Encoder Allocator templates
 namespace Jasse {
 
-    template<int opcode, int funct3, int funct7> RVEncoder* AllocRVEncoderTypeR() noexcept
+    template<int opcode, int funct3, int funct7> RVEncoder* AllocRVEncoderTypeR(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeR(opcode, funct3, funct7);
+        return EmplaceRVEncoder<RVEncoderTypeR>(storage, opcode, funct3, funct7);
     }
 
-    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeI() noexcept
+    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeI(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeI(opcode, funct3);
+        return EmplaceRVEncoder<RVEncoderTypeI>(storage, opcode, funct3);
     }
 
-    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeS() noexcept
+    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeS(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeS(opcode, funct3);
+        return EmplaceRVEncoder<RVEncoderTypeS>(storage, opcode, funct3);
     }
 
-    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeB() noexcept
+    template<int opcode, int funct3> RVEncoder* AllocRVEncoderTypeB(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeB(opcode, funct3);
+        return EmplaceRVEncoder<RVEncoderTypeB>(storage, opcode, funct3);
     }
 
-    template<int opcode> RVEncoder* AllocRVEncoderTypeU() noexcept
+    template<int opcode> RVEncoder* AllocRVEncoderTypeU(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeU(opcode);
+        return EmplaceRVEncoder<RVEncoderTypeU>(storage, opcode);
     }
 
-    template<int opcode> RVEncoder* AllocRVEncoderTypeJ() noexcept
+    template<int opcode> RVEncoder* AllocRVEncoderTypeJ(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeJ(opcode);
+        return EmplaceRVEncoder<RVEncoderTypeJ>(storage, opcode);
     }
 
-    template<int opcode, int funct3, int funct12> RVEncoder* AllocRVEncoderTypeIZeroOperand() noexcept
+    template<int opcode, int funct3, int funct12> RVEncoder* AllocRVEncoderTypeIZeroOperand(RVEncoderStorage* storage) noexcept
     {
-        return new RVEncoderTypeIZeroOperand(opcode, funct3, funct12);
+        return EmplaceRVEncoder<RVEncoderTypeIZeroOperand>(storage, opcode, funct3, funct12);
     }
 }
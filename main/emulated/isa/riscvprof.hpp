@@ -0,0 +1,475 @@
+#pragma once
+//
+// RISC-V Instruction Set Architecture Emulator (Jasse)
+//
+// Guest hot-spot profiler: periodic PC sampling over a shadow call stack, flat and collapsed-stack output
+//
+// *NOTICE: Calls and returns are recognized from JAL/JALR link register hints (x1 'ra' and
+//          x5 't0' as link registers, as of the RAS hints in the unprivileged specification).
+//          Trap entries and returns are not tracked as calls, samples in trap handlers are
+//          attributed under the interrupted stack.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "riscv.hpp"
+#include "riscvelf.hpp"
+
+
+//
+#define RV_PROFILER_DEFAULT_PERIOD              997         // prime, to not alias with loop bodies
+
+#define RV_PROFILER_DEFAULT_CAPACITY            65536       // samples buffered before folded
+
+#define RV_PROFILER_DEFAULT_MAX_DEPTH           1024
+
+#define RV_PROFILER_ROOT                        0
+
+
+namespace Jasse {
+
+    // RISC-V Guest Profiler
+    // *NOTICE: Attached as the sampling observer of RVInstance, so it is only called on samples
+    //          and on JAL/JALR. Samples are recorded into a preallocated buffer as (PC, call stack
+    //          node) pairs, and folded into counts when the buffer fills up, so memory stays
+    //          bounded in long runs.
+    //          Call stacks are interned in a call tree, a call costs one cached child lookup.
+    class RVProfiler : public RVExecSampleObserver {
+    public:
+        typedef struct {
+            addr_t      pc;
+            uint32_t    node;
+        } Sample;
+
+        typedef struct {
+            addr_t      target;         // callee entry (first executed PC for root)
+            uint32_t    parent;
+            uint32_t    depth;
+
+            addr_t      cached_target;  // last entered child
+            uint32_t    cached_child;
+        } Node;
+
+    private:
+        struct SampleHash {
+            size_t operator()(const std::pair<addr_t, uint32_t>& key) const noexcept
+            { return std::hash<addr_t>()(key.first * 0x9E3779B97F4A7C15ULL ^ key.second); }
+        };
+
+        uint64_t                period;
+
+        std::vector<Sample>     buffer;
+        size_t                  buffered;
+
+        std::vector<Node>       nodes;
+        std::unordered_map<std::pair<addr_t, uint32_t>, uint32_t, SampleHash>   children;
+
+        uint32_t                current;
+        uint32_t                max_depth;
+        uint64_t                overflow;
+
+        bool                    started;
+
+        std::unordered_map<std::pair<addr_t, uint32_t>, uint64_t, SampleHash>   folded;
+
+        uint64_t                samples;
+        uint64_t                calls;
+        uint64_t                returns;
+
+        const RVELFSymbolIndex* symbols;
+
+        void                    Call(addr_t target) noexcept;
+        void                    Return() noexcept;
+        void                    Record(const RVArchitecturalOOC* arch) noexcept;
+
+        std::vector<std::pair<Sample, uint64_t>>    Collect() const noexcept;
+
+    public:
+        RVProfiler(uint64_t period      = RV_PROFILER_DEFAULT_PERIOD,
+                   size_t   capacity    = RV_PROFILER_DEFAULT_CAPACITY,
+                   uint32_t max_depth   = RV_PROFILER_DEFAULT_MAX_DEPTH) noexcept;
+        RVProfiler(const RVProfiler& obj) = delete;
+        ~RVProfiler() noexcept;
+
+        uint64_t                GetPeriod() const noexcept;
+        void                    SetPeriod(uint64_t period) noexcept;
+
+        void                    Attach(RVInstance* instance) noexcept;
+
+        const RVELFSymbolIndex* GetSymbols() const noexcept;
+        void                    SetSymbols(const RVELFSymbolIndex* symbols) noexcept;
+
+        uint64_t                GetSampleCount() const noexcept;
+        uint64_t                GetCallCount() const noexcept;
+        uint64_t                GetReturnCount() const noexcept;
+
+        uint32_t                GetDepth() const noexcept;
+        size_t                  GetNodeCount() const noexcept;
+        const Node&             GetNode(uint32_t index) const noexcept;
+
+        virtual uint64_t        PreSample(const RVInstruction& insn, const RVExecContext& ctx) noexcept override;
+        virtual void            PostJump(const RVInstruction& insn, const RVExecContext& ctx) noexcept override;
+
+        void                    Fold() noexcept;
+        void                    Reset() noexcept;
+
+        std::string             Symbolize(addr_t address) const noexcept;
+
+        void                    PrintFlat(std::ostream& os, size_t limit = SIZE_MAX) const;
+        void                    PrintCollapsed(std::ostream& os) const;
+
+        void                    operator=(const RVProfiler& obj) = delete;
+    };
+}
+
+
+// Implementation of: class RVProfiler
+namespace Jasse {
+    /*
+    uint64_t                period;
+
+    std::vector<Sample>     buffer;
+    size_t                  buffered;
+
+    std::vector<Node>       nodes;
+    std::unordered_map<std::pair<addr_t, uint32_t>, uint32_t, SampleHash>   children;
+
+    uint32_t                current;
+    uint32_t                max_depth;
+    uint64_t                overflow;
+
+    bool                    started;
+
+    std::unordered_map<std::pair<addr_t, uint32_t>, uint64_t, SampleHash>   folded;
+
+    uint64_t                samples;
+    uint64_t                calls;
+    uint64_t                returns;
+
+    const RVELFSymbolIndex* symbols;
+    */
+
+    RVProfiler::RVProfiler(uint64_t period, size_t capacity, uint32_t max_depth) noexcept
+        : period    (period ? period : 1)
+        , buffer    (capacity ? capacity : 1)
+        , buffered  (0)
+        , nodes     ()
+        , children  ()
+        , current   (RV_PROFILER_ROOT)
+        , max_depth (max_depth)
+        , overflow  (0)
+        , started   (false)
+        , folded    ()
+        , samples   (0)
+        , calls     (0)
+        , returns   (0)
+        , symbols   (nullptr)
+    {
+        nodes.push_back(Node { 0, RV_PROFILER_ROOT, 0, 0, RV_PROFILER_ROOT });
+    }
+
+    RVProfiler::~RVProfiler() noexcept
+    { }
+
+    inline uint64_t RVProfiler::GetPeriod() const noexcept
+    {
+        return period;
+    }
+
+    inline void RVProfiler::SetPeriod(uint64_t period) noexcept
+    {
+        // takes effect from the next sample
+        this->period = period ? period : 1;
+    }
+
+    void RVProfiler::Attach(RVInstance* instance) noexcept
+    {
+        if (!started)
+        {
+            const RVArchitecturalOOC& arch = instance->GetArch();
+
+            nodes[RV_PROFILER_ROOT].target = arch.XLEN() == XLEN32 ? arch.PC().pc32 : arch.PC().pc64;
+            started = true;
+        }
+
+        instance->SetSampleObserver(this, period);
+    }
+
+    inline const RVELFSymbolIndex* RVProfiler::GetSymbols() const noexcept
+    {
+        return symbols;
+    }
+
+    inline void RVProfiler::SetSymbols(const RVELFSymbolIndex* symbols) noexcept
+    {
+        this->symbols = symbols;
+    }
+
+    inline uint64_t RVProfiler::GetSampleCount() const noexcept
+    {
+        return samples;
+    }
+
+    inline uint64_t RVProfiler::GetCallCount() const noexcept
+    {
+        return calls;
+    }
+
+    inline uint64_t RVProfiler::GetReturnCount() const noexcept
+    {
+        return returns;
+    }
+
+    inline uint32_t RVProfiler::GetDepth() const noexcept
+    {
+        return nodes[current].depth + overflow;
+    }
+
+    inline size_t RVProfiler::GetNodeCount() const noexcept
+    {
+        return nodes.size();
+    }
+
+    inline const RVProfiler::Node& RVProfiler::GetNode(uint32_t index) const noexcept
+    {
+        return nodes[index];
+    }
+
+    inline void RVProfiler::Call(addr_t target) noexcept
+    {
+        calls++;
+
+        Node& node = nodes[current];
+
+        if (node.cached_child != RV_PROFILER_ROOT && node.cached_target == target)
+        {
+            current = node.cached_child;
+            return;
+        }
+
+        // frames beyond the depth limit only counted, to be unwound on return
+        if (node.depth >= max_depth)
+        {
+            overflow++;
+            return;
+        }
+
+        auto iter = children.find({ target, current });
+
+        uint32_t child;
+
+        if (iter != children.end())
+            child = iter->second;
+        else
+        {
+            child = nodes.size();
+
+            children.emplace(std::make_pair(target, current), child);
+            nodes.push_back(Node { target, current, node.depth + 1, 0, RV_PROFILER_ROOT });
+        }
+
+        nodes[current].cached_target = target;
+        nodes[current].cached_child  = child;
+
+        current = child;
+    }
+
+    inline void RVProfiler::Return() noexcept
+    {
+        returns++;
+
+        if (overflow)
+            overflow--;
+        else
+            current = nodes[current].parent;
+    }
+
+    inline void RVProfiler::Record(const RVArchitecturalOOC* arch) noexcept
+    {
+        addr_t pc = arch->XLEN() == XLEN32 ? arch->PC().pc32 : arch->PC().pc64;
+
+        buffer[buffered++] = Sample { pc, current };
+        samples++;
+
+        if (buffered == buffer.size())
+            Fold();
+    }
+
+    uint64_t RVProfiler::PreSample(const RVInstruction& insn, const RVExecContext& ctx) noexcept
+    {
+        // sampled ahead of the instruction, a call or return attributed to its caller
+        Record(ctx.arch);
+
+        return period;
+    }
+
+    void RVProfiler::PostJump(const RVInstruction& insn, const RVExecContext& ctx) noexcept
+    {
+        // link register hints: push on link RD, pop on link RS1 (of JALR) unless RD = RS1
+        int  rd       = insn.GetRD();
+        int  rs1      = insn.GetRS1();
+
+        bool link_rd  = rd == RV_GR_X1 || rd == RV_GR_X5;
+        bool link_rs1 = GET_STD_OPERAND(insn.GetRaw(), RV_OPCODE) == RV_OPCODE_JALR
+                     && (rs1 == RV_GR_X1 || rs1 == RV_GR_X5);
+
+        if (link_rs1 && rd != rs1)
+            Return();
+
+        // PC already at the target
+        if (link_rd)
+            Call(ctx.arch->XLEN() == XLEN32 ? ctx.arch->PC().pc32 : ctx.arch->PC().pc64);
+    }
+
+    void RVProfiler::Fold() noexcept
+    {
+        for (size_t i = 0; i < buffered; i++)
+            folded[{ buffer[i].pc, buffer[i].node }]++;
+
+        buffered = 0;
+    }
+
+    void RVProfiler::Reset() noexcept
+    {
+        buffered  = 0;
+
+        nodes.resize(1);
+        nodes[RV_PROFILER_ROOT] = Node { 0, RV_PROFILER_ROOT, 0, 0, RV_PROFILER_ROOT };
+        children.clear();
+
+        current   = RV_PROFILER_ROOT;
+        overflow  = 0;
+        started   = false;
+
+        folded.clear();
+
+        samples   = 0;
+        calls     = 0;
+        returns   = 0;
+    }
+
+    std::vector<std::pair<RVProfiler::Sample, uint64_t>> RVProfiler::Collect() const noexcept
+    {
+        std::unordered_map<std::pair<addr_t, uint32_t>, uint64_t, SampleHash> merged = folded;
+
+        for (size_t i = 0; i < buffered; i++)
+            merged[{ buffer[i].pc, buffer[i].node }]++;
+
+        std::vector<std::pair<Sample, uint64_t>> collected;
+        collected.reserve(merged.size());
+
+        for (const auto& entry : merged)
+            collected.push_back({ Sample { entry.first.first, entry.first.second }, entry.second });
+
+        return collected;
+    }
+
+    std::string RVProfiler::Symbolize(addr_t address) const noexcept
+    {
+        if (symbols)
+        {
+            const RVELFSymbol* symbol = symbols->Find(address);
+
+            if (symbol)
+                return symbol->name;
+        }
+
+        char buffer[24];
+        snprintf(buffer, sizeof(buffer), "0x%lx", (unsigned long) address);
+
+        return buffer;
+    }
+
+    void RVProfiler::PrintFlat(std::ostream& os, size_t limit) const
+    {
+        // self counts by the symbol of sampled PC, total counts by each symbol on the stack once
+        std::map<std::string, std::pair<uint64_t, uint64_t>> counts;
+
+        std::vector<std::string> frames;
+
+        for (const auto& [sample, count] : Collect())
+        {
+            std::string leaf = Symbolize(sample.pc);
+
+            counts[leaf].first += count;
+
+            frames.clear();
+            frames.push_back(std::move(leaf));
+
+            for (uint32_t node = sample.node; node != RV_PROFILER_ROOT; node = nodes[node].parent)
+                frames.push_back(Symbolize(nodes[nodes[node].parent].target));
+
+            std::sort(frames.begin(), frames.end());
+            frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+
+            for (const std::string& frame : frames)
+                counts[frame].second += count;
+        }
+
+        std::vector<std::pair<std::string, std::pair<uint64_t, uint64_t>>> sorted(counts.begin(), counts.end());
+
+        std::stable_sort(sorted.begin(), sorted.end(), [] (const auto& a, const auto& b) {
+            return a.second.first != b.second.first ? a.second.first > b.second.first : a.second.second > b.second.second;
+        });
+
+        const double total = samples ? samples : 1;
+
+        os << "  Self%        Self  Total%       Total  Symbol" << std::endl;
+
+        for (size_t i = 0; i < sorted.size() && i < limit; i++)
+        {
+            const auto& [name, count] = sorted[i];
+
+            os << std::fixed << std::setprecision(2)
+               << std::right << std::setw(7)  << count.first  * 100 / total
+               << std::right << std::setw(12) << count.first
+               << std::right << std::setw(8)  << count.second * 100 / total
+               << std::right << std::setw(12) << count.second
+               << "  " << name << std::endl;
+        }
+
+        os << samples << " sample(s) every " << period << " instruction(s), "
+           << calls << " call(s), " << returns << " return(s), "
+           << nodes.size() << " call stack node(s)" << std::endl;
+    }
+
+    void RVProfiler::PrintCollapsed(std::ostream& os) const
+    {
+        // one line per distinct stack: root frame first, sampled PC symbol last
+        std::unordered_map<uint32_t, std::string> prefixes;
+
+        auto prefix = [&] (uint32_t node, auto& self) -> const std::string& {
+            auto iter = prefixes.find(node);
+
+            if (iter != prefixes.end())
+                return iter->second;
+
+            std::string frames;
+
+            if (node != RV_PROFILER_ROOT)
+            {
+                frames  = self(nodes[node].parent, self);
+                frames += Symbolize(nodes[nodes[node].parent].target);
+                frames += ';';
+            }
+
+            return prefixes.emplace(node, std::move(frames)).first->second;
+        };
+
+        std::map<std::string, uint64_t> stacks;
+
+        for (const auto& [sample, count] : Collect())
+            stacks[prefix(sample.node, prefix) + Symbolize(sample.pc)] += count;
+
+        for (const auto& [stack, count] : stacks)
+            os << stack << " " << count << std::endl;
+    }
+}
@@ -90,9 +90,9 @@ namespace Jasse {
     };
 
     //
-    template<int opcode, int funct3, int funct6> RVEncoder* AllocRVEncoderSHx() noexcept
+    template<int opcode, int funct3, int funct6> RVEncoder* AllocRVEncoderSHx(RVEncoderStorage* storage) noexcept
     {
-        return new RV64IEncoderSHx(opcode, funct3, funct6);
+        return EmplaceRVEncoder<RV64IEncoderSHx>(storage, opcode, funct3, funct6);
     }
 
     //
@@ -119,9 +119,9 @@ namespace Jasse {
     };
 
     // 
-    template<int opcode, int funct3, int funct7> RVEncoder* AllocRVEncoderSHx32() noexcept
+    template<int opcode, int funct3, int funct7> RVEncoder* AllocRVEncoderSHx32(RVEncoderStorage* storage) noexcept
     {
-        return new RV64IEncoderSHx32(opcode, funct3, funct7);
+        return EmplaceRVEncoder<RV64IEncoderSHx32>(storage, opcode, funct3, funct7);
     }
 
     //
@@ -147,9 +147,9 @@ namespace Jasse {
     };
 
     //
-    RVEncoder* AllocRVEncoderFence() noexcept
+    RVEncoder* AllocRVEncoderFence(RVEncoderStorage* storage) noexcept
     {
-        return new RV64IEncoderFence();
+        return EmplaceRVEncoder<RV64IEncoderFence>(storage);
     }
 
     //
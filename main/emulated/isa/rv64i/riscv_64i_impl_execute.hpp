@@ -302,11 +302,13 @@ namespace Jasse {
     // JALR
     RVExecStatus RV64IExecutor_JALR(RV64I_EXECUTOR_PARAMS)
     {
+        // target read ahead of link, in case of RD = RS1
+        arch64_t target = (ctx.arch->GR64()->Get(insn.GetRS1()) + SEXT_W(insn.GetImmediate())) & 0xFFFFFFFFFFFFFFFELU;
+
         ctx.arch->GR64()->Set(insn.GetRD(),
             ctx.arch->PC().pc64 + 4);
 
-        ctx.arch->SetPC64(
-            (ctx.arch->GR64()->Get(insn.GetRS1()) + SEXT_W(insn.GetImmediate())) & 0xFFFFFFFFFFFFFFFELU);
+        ctx.arch->SetPC64(target);
 
         return EXEC_PC_JUMP;
     }
@@ -393,7 +395,7 @@ namespace Jasse {
         //          behaviour, not necessary according to privileged specification.
         //          If this action is not included in your processor or implementation, you
         //          could disable this action by "commenting" this part of code.
-        RVCSR* mtval = ctx.CSRs->GetCSR(CSR_mtval);
+        RVCSR* mtval = ctx.CSRs->GetMachineTrapCSRs().mtval;
 
         if (mtval)
             mtval->SetValue(address);
@@ -38,7 +38,7 @@ namespace Jasse {
         mpz_set_si(mpz_s, multiplicand);
         mpz_mul_si(mpz_i, mpz_s, multiplier); // mul
         
-        mpz_tdiv_q_2exp(mpz_r, mpz_i, 64);    // shift
+        mpz_fdiv_q_2exp(mpz_r, mpz_i, 64);    // arithmetic shift (floor)
 
         ASSERTM(mpz_fits_slong_p(mpz_r), "mpz mulh overflow");
 
@@ -98,7 +98,7 @@ namespace Jasse {
         mpz_set_si(mpz_s, multiplicand);
         mpz_mul_ui(mpz_i, mpz_s, multiplier); // mul
         
-        mpz_tdiv_q_2exp(mpz_r, mpz_i, 64);    // shift
+        mpz_fdiv_q_2exp(mpz_r, mpz_i, 64);    // arithmetic shift (floor)
 
         ASSERT(mpz_fits_slong_p(mpz_r));
 
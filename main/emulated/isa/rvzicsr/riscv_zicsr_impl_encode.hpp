@@ -24,64 +24,58 @@
 // RV Zicsr CodeGen
 namespace Jasse {
 
-    inline void __RandCSR(RVEncoder* encoder, const RVCodeGenConstraints* constraints)
+    inline void __RandCSR(RVEncoder* encoder, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints)
     {
         const RVCodeGenConstraintCSRList* candidate 
             = constraints->Get(RV_CODEGEN_CSR_CANDIDATE);
 
         if (candidate)
-            encoder->SetImmediate(candidate->GetList().Get(Rand32(0, candidate->GetSize() - 1)).address);
+            encoder->SetImmediate(candidate->GetList().Get(Rand32(rand, 0, candidate->GetSize() - 1)).address);
         else
-            encoder->SetImmediate(Rand32(0, CSR_ADDRESS_MASK));
+            encoder->SetImmediate(Rand32(rand, 0, CSR_ADDRESS_MASK));
     }
 
-    insnraw_t GenRVZicsrCodeCSRx(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints)
+    insnraw_t GenRVZicsrCodeCSRx(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints)
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            __RandCSR(encoder, constraints);
-
-        if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            __RandCSR(encoder, rand, constraints);
 
         if (encoder->IsRS1Required())
-            encoder->SetRS1(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            encoder->SetRS1(RandRS(rand, constraints));
 
-        insn = encoder->Get();
-        delete encoder;
+        if (encoder->IsRDRequired())
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZicsrCSRx(const RVCodeGenConstraints* constraints)
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZicsrCSRx(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints)
     {
-        return GenRVZicsrCodeCSRx(alloc, constraints);
+        return GenRVZicsrCodeCSRx(alloc, rand, constraints);
     }
 
-    insnraw_t GenRVZicsrCodeCSRxI(RVEncoderAllocator encoderAlloc, const RVCodeGenConstraints* constraints)
+    insnraw_t GenRVZicsrCodeCSRxI(RVEncoderAllocator encoderAlloc, RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints)
     {
-        RVEncoder* encoder = encoderAlloc();
-        insnraw_t  insn;
+        RVEncoderStorage    storage;
+        RVEncoder*          encoder = encoderAlloc(&storage);
 
         if (encoder->IsImmediateRequired())
-            __RandCSR(encoder,constraints);
-
-        if (encoder->IsRDRequired())
-            encoder->SetRD(Rand32(constraints, RV_CODEGEN_GRx_RANGE));
+            __RandCSR(encoder, rand, constraints);
 
         if (encoder->IsRS1Required()) // uimm-5 generation
-            encoder->SetRS1(Rand32(0, 0x1F));
+            encoder->SetRS1(Rand32(rand, 0, 0x1F));
 
-        insn = encoder->Get();
-        delete encoder;
+        if (encoder->IsRDRequired())
+            encoder->SetRD(RandRD(rand, constraints));
 
-        return insn;
+        return encoder->Get();
     }
 
-    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZicsrCSRxI(const RVCodeGenConstraints* constraints)
+    template<RVEncoderAllocator alloc> insnraw_t CodeGenRVZicsrCSRxI(RVCodeGenRandom& rand, const RVCodeGenConstraints* constraints)
     {
-        return GenRVZicsrCodeCSRxI(alloc, constraints);
+        return GenRVZicsrCodeCSRxI(alloc, rand, constraints);
     }
 }
\ No newline at end of file
@@ -11,8 +11,9 @@
 // executors
 namespace Jasse {
 
+// *NOTICE: CSR resolved once and bound to the decoded instruction, @see RVCSRBinding
 #define __RVZICSR_ACQUIRE_CSR(csr, insn) \
-    RVCSR* csr = ctx.CSRs->GetCSR(GET_STD_OPERAND(insn.GetRaw(), RV_OPERAND_CSR)); \
+    RVCSR* csr = ctx.CSRs->GetCSR(GET_STD_OPERAND(insn.GetRaw(), RV_OPERAND_CSR), insn.GetCSRBinding()); \
     if (!csr) \
     { \
         ctx.trap.TrapEnter(ctx.arch, ctx.CSRs, TRAP_EXCEPTION, EXCEPTION_ILLEGAL_INSTRUCTION); \
@@ -43,9 +44,9 @@ namespace Jasse {
 
         ctx.arch->SetGRx64(insn.GetRD(), csrval);
 
-        csrval = SET_CSR_BITS(csrval, csrmask);
-
-        csr->Write(ctx.CSRs, csrval);
+        // no write with x0, nor side effects of it (e.g. counters)
+        if (insn.GetRS1())
+            csr->Write(ctx.CSRs, SET_CSR_BITS(csrval, csrmask));
 
         return EXEC_SEQUENTIAL;
     }
@@ -60,9 +61,8 @@ namespace Jasse {
 
         ctx.arch->SetGRx64(insn.GetRD(), csrval);
 
-        csrval = CLEAR_CSR_BITS(csrval, csrmask);
-
-        csr->Write(ctx.CSRs, csrval);
+        if (insn.GetRS1())
+            csr->Write(ctx.CSRs, CLEAR_CSR_BITS(csrval, csrmask));
 
         return EXEC_SEQUENTIAL;
     }
@@ -75,7 +75,7 @@ namespace Jasse {
         if (insn.GetRD())
             ctx.arch->SetGRx64(insn.GetRD(), csr->Read(ctx.CSRs));
 
-        csr->Write(ctx.CSRs, ctx.arch->GetGRx64Zext(insn.GetRS1()));
+        csr->Write(ctx.CSRs, GET_STD_OPERAND(insn.GetRaw(), RV_OPERAND_CSR_UIMM));
 
         return EXEC_SEQUENTIAL;
     }
@@ -90,9 +90,8 @@ namespace Jasse {
 
         ctx.arch->SetGRx64(insn.GetRD(), csrval);
 
-        csrval = SET_CSR_BITS(csrval, csrmask);
-
-        csr->Write(ctx.CSRs, csrval);
+        if (csrmask)
+            csr->Write(ctx.CSRs, SET_CSR_BITS(csrval, csrmask));
 
         return EXEC_SEQUENTIAL;   
     }
@@ -107,9 +106,8 @@ namespace Jasse {
 
         ctx.arch->SetGRx64(insn.GetRD(), csrval);
 
-        csrval = CLEAR_CSR_BITS(csrval, csrmask);
-
-        csr->Write(ctx.CSRs, csrval);
+        if (csrmask)
+            csr->Write(ctx.CSRs, CLEAR_CSR_BITS(csrval, csrmask));
 
         return EXEC_SEQUENTIAL;
     }
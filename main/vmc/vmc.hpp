@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
@@ -86,7 +87,8 @@ namespace VMC {
 
         std::string                 name        = std::string("VMC");
 
-        std::vector<CommandHandler> handlers    = std::vector<CommandHandler>();
+        std::unordered_map<std::string, CommandExecutor>
+                                    handlers    = std::unordered_map<std::string, CommandExecutor>();
 
         //
         bool                        last_mute   = false;
@@ -97,11 +99,27 @@ namespace VMC {
         std::map<std::string, IntVariable>  mapIntVars      = std::map<std::string, IntVariable>();
 
         bool                                bWarnOnFalse    = true;
+
+        int                                 failures        = 0;
+
+        //
+        void*                               context         = nullptr;
     } VMCEntity, *VMCHandle;
 
-    inline void RegisterCommand(VMCHandle handle, const CommandHandler&& command)
+    inline bool RegisterCommand(VMCHandle handle, const CommandHandler&& command)
     {
-        handle->handlers.push_back(command);
+        // Commands are matched after lowercasing, the first registration of a name wins
+        std::string cmd = command.cmd;
+
+        std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::tolower);
+
+        if (!handle->handlers.emplace(cmd, command.executor).second)
+        {
+            std::cout << "Duplicated registration of command \'" << cmd << "\' ignored." << std::endl;
+            return false;
+        }
+
+        return true;
     }
 
     inline bool GetLastReturnBool(VMCHandle handle)
@@ -156,85 +174,84 @@ namespace VMC {
     }
     
     //
-    bool Next(VMCHandle handle, std::istream& is, bool continuous = false)
+    inline bool ParseCommandLine(const std::string& cmdline, std::string& cmd,
+                                                             std::string& paramline,
+                                                             std::vector<std::string>& params)
     {
-        std::string cmdline;
-
-        if (!continuous)
-            std::cout << "#" << handle->name << "> ";
-        std::getline(is, cmdline);
-
-        //
-        std::istringstream iss(cmdline);
-
-        if (!iss.good())
-            return false;
-
-        std::string cmd;
-        std::getline(iss, cmd, ' ');
+        size_t spindex = cmdline.find(' ');
 
-        bool rawEmpty = cmd.empty();
+        cmd.assign(cmdline, 0, spindex);
 
-        if (!rawEmpty)
-            EraseLineSplitters(cmd);
-        else
+        if (cmd.empty())
             return false;
 
-        if (cmd.empty())
-            return true;
+        EraseLineSplitters(cmd);
 
         std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::tolower);
 
         //
-        CommandExecutor* executor = nullptr;
-        std::vector<CommandHandler>::iterator iter = handle->handlers.begin();
-        while (iter != handle->handlers.end())
-        {
-            if (cmd.compare(iter->cmd) == 0)
-            {
-                executor = &(iter->executor);
-                break;
-            }
-            
-            iter++;
-        }
+        params.clear();
 
-        if (!executor)
+        if (spindex == std::string::npos)
         {
-            std::cout << "Unknown command \'" << cmd << "\', type \'?\' for help." << std::endl;
-            return false;
+            paramline.clear();
+            return true;
         }
-        
-        //
-        std::vector<std::string> params;
 
-        std::string param;
-        while (iss.good())
+        paramline.assign(cmdline, spindex + 1, std::string::npos);
+
+        for (size_t begin = spindex + 1, end; begin <= cmdline.size(); begin = end + 1)
         {
-            std::getline(iss, param, ' ');
+            if ((end = cmdline.find(' ', begin)) == std::string::npos)
+                end = cmdline.size();
+
+            std::string param(cmdline, begin, end - begin);
 
             // erase line-splits
             EraseLineSplitters(param);
 
             if (!param.empty())
-                params.push_back(param);
+                params.push_back(std::move(param));
         }
 
-        size_t spindex = cmdline.find(' ');
-        std::string paramline;
-        if (spindex == std::string::npos)
-            paramline = "";
-        else
-            paramline = cmdline.substr(spindex + 1);
+        return true;
+    }
+
+    inline CommandExecutor FindCommand(VMCHandle handle, const std::string& cmd)
+    {
+        std::unordered_map<std::string, CommandExecutor>::iterator iter = handle->handlers.find(cmd);
+
+        if (iter == handle->handlers.end())
+            return nullptr;
+
+        return iter->second;
+    }
 
-        bool success = (*executor)(handle, cmd, paramline, params);
+    inline bool Execute(VMCHandle handle, CommandExecutor executor, const std::string& cmd,
+                                                                    const std::string& paramline,
+                                                                    const std::vector<std::string>& params)
+    {
+        if (!executor)
+        {
+            std::cout << "Unknown command \'" << cmd << "\', type \'?\' for help." << std::endl;
+
+            handle->failures++;
+            return false;
+        }
+
+        bool success = executor(handle, cmd, paramline, params);
 
         if (!handle->last_mute)
         {
             SetLastReturnBool(handle, success);
 
+            // Warned failures count into the exit status of non-interactive runs
             if (handle->bWarnOnFalse && !success)
+            {
                 std::cout << "Command \'" << cmd << "\' exited abnormally maybe." << std::endl;
+
+                handle->failures++;
+            }
         }
         else
             handle->last_mute = false;
@@ -242,6 +259,29 @@ namespace VMC {
         return true;
     }
 
+    //
+    bool Next(VMCHandle handle, std::istream& is, bool continuous = false)
+    {
+        std::string cmdline;
+
+        if (!continuous)
+            std::cout << "#" << handle->name << "> ";
+        std::getline(is, cmdline);
+
+        //
+        std::string                 cmd;
+        std::string                 paramline;
+        std::vector<std::string>    params;
+
+        if (!ParseCommandLine(cmdline, cmd, paramline, params))
+            return false;
+
+        if (cmd.empty())
+            return true;
+
+        return Execute(handle, FindCommand(handle, cmd), cmd, paramline, params);
+    }
+
     //
     inline void ShouldNotReachHere(const char* msg = nullptr)
     {
@@ -259,13 +299,308 @@ namespace VMC {
 
 }
 
+namespace VMC::Script {
+
+    // Script files are compiled once into a flat op list with pre-split parameters.
+    // Besides plain commands, the following constructs are executed natively:
+    //
+    //   repeat <count|$ivar> {         ...  }
+    //   while [!]<$var> {              ...  }
+    //   <label>:
+    //   goto <label> [if [!]<$var>]
+    //
+    // Conditions accept boolean variables, or integer variables (true if non-zero).
+
+    static constexpr int    SCRIPT_OP_COMMAND       = 0;
+
+    static constexpr int    SCRIPT_OP_REPEAT        = 1;
+
+    static constexpr int    SCRIPT_OP_WHILE         = 2;
+
+    static constexpr int    SCRIPT_OP_END           = 3;
+
+    static constexpr int    SCRIPT_OP_GOTO          = 4;
+
+    typedef struct {
+
+        int                         op;
+
+        int                         line;
+
+        CommandExecutor             executor;   // nullptr for unknown command
+
+        std::string                 cmd;
+
+        std::string                 paramline;
+
+        std::vector<std::string>    params;
+
+        std::string                 operand;    // repeat count, or condition variable
+
+        bool                        negate;
+
+        int                         target;     // matching block op, or jump target, -1 if none
+    } ScriptOp;
+
+    typedef std::vector<ScriptOp>   CompiledScript;
+
+
+    inline bool GetCondition(VMCHandle handle, const std::string& name, bool* value)
+    {
+        // '$' prefix is optional, unless the variable itself is named so (e.g. $0)
+        for (const std::string& key : { name, name[0] == '$' ? name.substr(1) : name })
+        {
+            std::map<std::string, BoolVariable>::iterator biter = handle->mapBoolVars.find(key);
+            if (biter != handle->mapBoolVars.end())
+            {
+                *value = biter->second.Get();
+                return true;
+            }
+
+            std::map<std::string, IntVariable>::iterator iiter = handle->mapIntVars.find(key);
+            if (iiter != handle->mapIntVars.end())
+            {
+                *value = iiter->second.Get() != 0;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline bool GetCount(VMCHandle handle, const std::string& operand, int64_t* value)
+    {
+        if (operand[0] != '$')
+        {
+            std::istringstream iss(operand);
+
+            return (bool)(iss >> *value) && iss.eof();
+        }
+
+        for (const std::string& key : { operand, operand.substr(1) })
+        {
+            std::map<std::string, IntVariable>::iterator iter = handle->mapIntVars.find(key);
+            if (iter != handle->mapIntVars.end())
+            {
+                *value = (int64_t) iter->second.Get();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline void ParseCondition(const std::string& operand, ScriptOp& op)
+    {
+        op.negate  = operand[0] == '!';
+        op.operand = op.negate ? operand.substr(1) : operand;
+    }
+
+    bool Compile(VMCHandle handle, std::istream& is, CompiledScript& script, const std::string& name = "")
+    {
+        std::map<std::string, int>                  labels;
+        std::vector<std::pair<int, std::string>>    jumps;
+        std::vector<int>                            blocks;
+
+        std::string cmdline;
+
+        script.clear();
+
+        for (int line = 1; std::getline(is, cmdline); line++)
+        {
+            // Indentation is allowed in scripts
+            size_t begin = cmdline.find_first_not_of(" \t");
+
+            if (begin == std::string::npos)
+                continue;
+
+            ScriptOp op = { SCRIPT_OP_COMMAND, line, nullptr };
+
+            if (begin)
+                cmdline.erase(0, begin);
+
+            if (!ParseCommandLine(cmdline, op.cmd, op.paramline, op.params) || op.cmd.empty())
+                continue;
+
+            op.target = -1;
+
+            //
+            if (op.cmd.compare("repeat") == 0 || op.cmd.compare("while") == 0)
+            {
+                if (op.params.size() != 2 || op.params[1].compare("{") != 0)
+                {
+                    std::cout << name << ":" << line << ": expected \'" << op.cmd << " <operand> {\'." << std::endl;
+                    return false;
+                }
+
+                if (op.cmd.compare("repeat") == 0)
+                {
+                    op.op      = SCRIPT_OP_REPEAT;
+                    op.operand = op.params[0];
+                }
+                else
+                {
+                    op.op      = SCRIPT_OP_WHILE;
+                    ParseCondition(op.params[0], op);
+                }
+
+                blocks.push_back(script.size());
+            }
+            else if (op.cmd.compare("}") == 0)
+            {
+                if (blocks.empty())
+                {
+                    std::cout << name << ":" << line << ": unmatched \'}\'." << std::endl;
+                    return false;
+                }
+
+                op.op     = SCRIPT_OP_END;
+                op.target = blocks.back();
+
+                script[blocks.back()].target = script.size();
+
+                blocks.pop_back();
+            }
+            else if (op.cmd.back() == ':' && op.params.empty())
+            {
+                std::string label = op.cmd.substr(0, op.cmd.size() - 1);
+
+                if (!labels.emplace(label, script.size()).second)
+                {
+                    std::cout << name << ":" << line << ": duplicated label \'" << label << "\'." << std::endl;
+                    return false;
+                }
+
+                continue;
+            }
+            else if (op.cmd.compare("goto") == 0)
+            {
+                if (op.params.size() == 3 && op.params[1].compare("if") == 0)
+                    ParseCondition(op.params[2], op);
+                else if (op.params.size() != 1)
+                {
+                    std::cout << name << ":" << line << ": expected \'goto <label> [if [!]<$var>]\'." << std::endl;
+                    return false;
+                }
+
+                op.op = SCRIPT_OP_GOTO;
+
+                // Label definitions are lowercased along with the command name
+                std::string label = op.params[0];
+
+                std::transform(label.begin(), label.end(), label.begin(), ::tolower);
+
+                jumps.push_back(std::make_pair(script.size(), label));
+            }
+            else
+                op.executor = FindCommand(handle, op.cmd);
+
+            script.push_back(std::move(op));
+        }
+
+        if (!blocks.empty())
+        {
+            std::cout << name << ":" << script[blocks.back()].line << ": unclosed \'{\'." << std::endl;
+            return false;
+        }
+
+        for (const std::pair<int, std::string>& jump : jumps)
+        {
+            std::map<std::string, int>::iterator iter = labels.find(jump.second);
+
+            if (iter == labels.end())
+            {
+                std::cout << name << ":" << script[jump.first].line << ": undefined label \'" << jump.second << "\'." << std::endl;
+                return false;
+            }
+
+            script[jump.first].target = iter->second;
+        }
+
+        return true;
+    }
+
+    bool Run(VMCHandle handle, const CompiledScript& script, const std::string& name = "")
+    {
+        // Remaining iterations of each repeat block, indexed by op
+        std::vector<int64_t> counters(script.size());
+
+        bool cond;
+
+        for (size_t pc = 0; pc < script.size(); )
+        {
+            const ScriptOp& op = script[pc];
+
+            switch (op.op)
+            {
+                case SCRIPT_OP_COMMAND:
+                    // Unknown command terminates the script, as line-by-line execution did
+                    if (!Execute(handle, op.executor, op.cmd, op.paramline, op.params))
+                        return false;
+
+                    pc++;
+                    break;
+
+                case SCRIPT_OP_REPEAT:
+                    if (!GetCount(handle, op.operand, &counters[pc]))
+                    {
+                        std::cout << name << ":" << op.line << ": invalid repeat count \'" << op.operand << "\'." << std::endl;
+                        return false;
+                    }
+
+                    pc = counters[pc] > 0 ? pc + 1 : op.target + 1;
+                    break;
+
+                case SCRIPT_OP_WHILE:
+                    if (!GetCondition(handle, op.operand, &cond))
+                    {
+                        std::cout << name << ":" << op.line << ": no such variable \'" << op.operand << "\'." << std::endl;
+                        return false;
+                    }
+
+                    pc = (cond != op.negate) ? pc + 1 : op.target + 1;
+                    break;
+
+                case SCRIPT_OP_END:
+                    if (script[op.target].op == SCRIPT_OP_WHILE)
+                        pc = op.target;
+                    else
+                        pc = --counters[op.target] > 0 ? op.target + 1 : pc + 1;
+
+                    break;
+
+                case SCRIPT_OP_GOTO:
+                    if (op.operand.empty())
+                        cond = true;
+                    else if (!GetCondition(handle, op.operand, &cond))
+                    {
+                        std::cout << name << ":" << op.line << ": no such variable \'" << op.operand << "\'." << std::endl;
+                        return false;
+                    }
+                    else
+                        cond = cond != op.negate;
+
+                    pc = cond ? op.target : pc + 1;
+                    break;
+
+                default:
+                    ShouldNotReachHere(" VMC::Script::Run ILLEGAL_STATE #ScriptOp");
+            }
+        }
+
+        return true;
+    }
+}
+
 namespace VMC::Basic {
 
 #define ECHO_COUT_VMC_BASIC_HELP \
     std::cout << "Basic command usages:" << std::endl; \
     std::cout << "- version                           Display version of VMC console " << std::endl; \
-    std::cout << "- exit                              Exit VMC console               " << std::endl; \
+    std::cout << "- exit [status]                     Exit VMC console, with 1 if any command failed by default" << std::endl; \
+    std::cout << "- flush                             Flush buffered console output  " << std::endl; \
     std::cout << "- exec <filename>                   Execute VMC script file        " << std::endl; \
+    std::cout << "                                    (with repeat/while blocks and goto labels)" << std::endl; \
     std::cout << "- echo <content...>                 Display information on console " << std::endl; \
     std::cout << "- setbool [name] [value] [-N]       Set or list boolean variables  " << std::endl; \
     std::cout << "- movbool <dst> <src> [-N]          Get boolean variable           " << std::endl; \
@@ -301,7 +636,26 @@ namespace VMC::Basic {
                             const std::string& paramline, 
                             const std::vector<std::string>& params)
     {
-        exit(EXIT_SUCCESS);
+        int status = ((VMCHandle) handle)->failures ? EXIT_FAILURE : EXIT_SUCCESS;
+
+        if (!params.empty())
+            std::istringstream(params[0]) >> status;
+
+        // Buffered console output flushed by exit()
+        exit(status);
+        return true;
+    }
+
+    //
+    bool Flush(void* handle, const std::string& cmd, 
+                             const std::string& paramline, 
+                             const std::vector<std::string>& params)
+    {
+        ((VMCHandle) handle)->last_mute = true;
+
+        std::cout.flush();
+        fflush(stdout);
+
         return true;
     }
 
@@ -317,10 +671,15 @@ namespace VMC::Basic {
             return false;
         }
 
-        while (Next((VMCHandle) handle, ifs, true));
+        Script::CompiledScript script;
+
+        if (!Script::Compile((VMCHandle) handle, ifs, script, paramline))
+            return false;
 
         ifs.close();
 
+        Script::Run((VMCHandle) handle, script, paramline);
+
         return true;
     }
 
@@ -685,6 +1044,7 @@ namespace VMC::Basic {
         VMC_COMMAND(handle, "rem"    , Nop);
         VMC_COMMAND(handle, "version", Version);
         VMC_COMMAND(handle, "exit"   , Exit);
+        VMC_COMMAND(handle, "flush"  , Flush);
         VMC_COMMAND(handle, "exec"   , Exec);
         VMC_COMMAND(handle, "echo"   , Echo); 
         VMC_COMMAND(handle, "setbool", SetBool);
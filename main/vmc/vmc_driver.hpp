@@ -0,0 +1,234 @@
+#pragma once
+//
+// Shared VMC console driver, for both interactive and scripted (non-interactive) sessions
+//
+//
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "vmc.hpp"
+
+
+namespace VMC::Driver {
+
+#define VMC_DRIVER_EXIT_USAGE                                   2
+
+#define VMC_DRIVER_BUFFER_SIZE                                  (1024 * 1024)
+
+#define ECHO_COUT_VMC_DRIVER_USAGE(name) \
+    std::cout << "Usage: " << name << " [-e <script>]... [-c \"<cmd>; <cmd>...\"]... [-i]" << std::endl; \
+    std::cout << "- -e <script>                       Execute VMC script file, then exit" << std::endl; \
+    std::cout << "- -c \"<cmd>; <cmd>...\"              Execute semicolon-separated commands, then exit" << std::endl; \
+    std::cout << "- -i                                Stay interactive after -e/-c" << std::endl; \
+    std::cout << "Exits with 0 if no command failed, 1 otherwise." << std::endl;
+
+    // std::cout sink writing through C stdio, without flushing on std::endl
+    class ConsoleSink : public std::streambuf
+    {
+    protected:
+        virtual int_type        overflow(int_type ch) override;
+        virtual std::streamsize xsputn(const char* s, std::streamsize count) override;
+        virtual int             sync() override;
+
+    public:
+        ConsoleSink();
+        ~ConsoleSink();
+
+        void                    Flush();
+    };
+
+    typedef struct {
+
+        bool                    script;     // -e, otherwise -c
+
+        std::string             value;
+    } Action;
+
+    typedef struct {
+
+        std::vector<Action>     actions     = std::vector<Action>();
+
+        bool                    interactive = true;
+
+        bool                    tty_in      = false;
+
+        bool                    tty_out     = false;
+    } Options;
+
+    bool    ParseOptions(int argc, char** argv, Options* options);
+    void    Attach(const Options& options);
+    void    Flush();
+    bool    RunCommands(VMCHandle handle, const std::string& cmdlines);
+    bool    RunScript(VMCHandle handle, const std::string& filename);
+    int     Run(VMCHandle handle, const Options& options);
+}
+
+
+// class VMC::Driver::ConsoleSink
+namespace VMC::Driver {
+
+    ConsoleSink::ConsoleSink()
+    { }
+
+    ConsoleSink::~ConsoleSink()
+    { }
+
+    ConsoleSink::int_type ConsoleSink::overflow(int_type ch)
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+
+        return putc(ch, stdout) == EOF ? traits_type::eof() : ch;
+    }
+
+    std::streamsize ConsoleSink::xsputn(const char* s, std::streamsize count)
+    {
+        return fwrite(s, 1, count, stdout);
+    }
+
+    int ConsoleSink::sync()
+    {
+        // *NOTICE: Flushed only at command boundaries or on demand, see Flush()
+        return 0;
+    }
+
+    inline void ConsoleSink::Flush()
+    {
+        fflush(stdout);
+    }
+}
+
+
+// Driver components
+namespace VMC::Driver {
+
+    static ConsoleSink      CONSOLE_SINK;
+
+    bool ParseOptions(int argc, char** argv, Options* options)
+    {
+        options->tty_in  = isatty(STDIN_FILENO);
+        options->tty_out = isatty(STDOUT_FILENO);
+
+        bool stay = false;
+
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg(argv[i]);
+
+            if (arg.compare("-i") == 0)
+                stay = true;
+            else if ((arg.compare("-e") == 0 || arg.compare("-c") == 0) && i + 1 < argc)
+                options->actions.push_back(Action { arg.compare("-e") == 0, std::string(argv[++i]) });
+            else
+            {
+                ECHO_COUT_VMC_DRIVER_USAGE(argv[0])
+                return false;
+            }
+        }
+
+        options->interactive = stay || options->actions.empty();
+
+        return true;
+    }
+
+    void Attach(const Options& options)
+    {
+        // Must be called before any console output
+        if (!options.tty_out)
+            setvbuf(stdout, nullptr, _IOFBF, VMC_DRIVER_BUFFER_SIZE);
+
+        std::cout.rdbuf(&CONSOLE_SINK);
+    }
+
+    inline void Flush()
+    {
+        CONSOLE_SINK.Flush();
+    }
+
+    bool RunCommands(VMCHandle handle, const std::string& cmdlines)
+    {
+        bool success = true;
+
+        std::string                 cmd;
+        std::string                 paramline;
+        std::vector<std::string>    params;
+
+        for (size_t begin = 0, end; begin <= cmdlines.size(); begin = end + 1)
+        {
+            if ((end = cmdlines.find(';', begin)) == std::string::npos)
+                end = cmdlines.size();
+
+            size_t first = cmdlines.find_first_not_of(" \t", begin);
+
+            if (first == std::string::npos || first >= end)
+                continue;
+
+            size_t last = cmdlines.find_last_not_of(" \t", end - 1);
+
+            if (!ParseCommandLine(cmdlines.substr(first, last - first + 1), cmd, paramline, params))
+                continue;
+
+            if (!Execute(handle, FindCommand(handle, cmd), cmd, paramline, params))
+                success = false;
+        }
+
+        return success;
+    }
+
+    bool RunScript(VMCHandle handle, const std::string& filename)
+    {
+        std::ifstream ifs(filename);
+
+        if (!ifs)
+        {
+            std::cout << "Failed to open script file \'" << filename << "\'." << std::endl;
+            return false;
+        }
+
+        Script::CompiledScript script;
+
+        if (!Script::Compile(handle, ifs, script, filename))
+            return false;
+
+        ifs.close();
+
+        return Script::Run(handle, script, filename);
+    }
+
+    int Run(VMCHandle handle, const Options& options)
+    {
+        for (const Action& action : options.actions)
+        {
+            bool success = action.script ? RunScript  (handle, action.value)
+                                         : RunCommands(handle, action.value);
+
+            if (!success)
+                handle->failures++;
+
+            if (options.tty_out)
+                Flush();
+        }
+
+        if (options.interactive)
+        {
+            // No prompt when commands are piped in
+            while (!std::cin.eof())
+            {
+                VMC::Next(handle, std::cin, !options.tty_in);
+
+                if (options.tty_out)
+                    Flush();
+            }
+        }
+
+        Flush();
+
+        return handle->failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+}
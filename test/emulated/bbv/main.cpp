@@ -0,0 +1,259 @@
+// Jasse basic-block vector driver, two-phase workload against per-instruction reference counting (linked with -lgmp)
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscvbbv.hpp"
+#include "riscvjit.hpp"
+#include "riscvmemutil.hpp"
+#include "../rvencode.hpp"
+
+
+using namespace Jasse;
+
+
+#define     BBV_DEFAULT_INTERVAL            100000
+
+#define     BBV_DEFAULT_OUTER               50
+
+#define     BBV_PHASE_A                     200
+#define     BBV_PHASE_B                     5000
+
+#define     BBV_MEMORY_SIZE                 (64 * 1024)
+
+#define     BBV_SUM_BASE                    0x100
+#define     BBV_DATA_BASE                   0x2000
+
+
+// alternating phases: array sum calls, then xorshift rounds
+std::vector<std::pair<addr_t, std::vector<uint32_t>>> Program(uint32_t outer)
+{
+    return {
+        { 0, {
+            /* 0x00 */  I(outer, 0, 0, S0, 0x13),                   // li     s0, outer
+            /* 0x04 */  I(1, 0, 0, A1, 0x13),                       // li     a1, 1
+            /* 0x08 */  I(BBV_PHASE_A, 0, 0, S1, 0x13),             // outer: li s1, phase A
+            /* 0x0C */  J(BBV_SUM_BASE - 0x0C, RA),                 // a: call sum
+            /* 0x10 */  I(-1, S1, 0, S1, 0x13),                     // addi   s1, s1, -1
+            /* 0x14 */  B(-0x08, 0, S1, 1),                         // bnez   s1, a
+            /* 0x18 */  U((BBV_PHASE_B + 0x800) >> 12, S1, 0x37),   // li     s1, phase B
+            /* 0x1C */  I(BBV_PHASE_B & 0xFFF, S1, 0, S1, 0x1B),
+            /* 0x20 */  I(13, A1, 1, T0, 0x13),                     // b: slli t0, a1, 13
+            /* 0x24 */  R(0, T0, A1, 4, A1, 0x33),                  // xor    a1, a1, t0
+            /* 0x28 */  I(7, A1, 5, T0, 0x13),                      // srli   t0, a1, 7
+            /* 0x2C */  R(0, T0, A1, 4, A1, 0x33),                  // xor    a1, a1, t0
+            /* 0x30 */  I(17, A1, 1, T0, 0x13),                     // slli   t0, a1, 17
+            /* 0x34 */  R(0, T0, A1, 4, A1, 0x33),                  // xor    a1, a1, t0
+            /* 0x38 */  I(-1, S1, 0, S1, 0x13),                     // addi   s1, s1, -1
+            /* 0x3C */  B(-0x1C, 0, S1, 1),                         // bnez   s1, b
+            /* 0x40 */  I(-1, S0, 0, S0, 0x13),                     // addi   s0, s0, -1
+            /* 0x44 */  B(-0x3C, 0, S0, 1),                         // bnez   s0, outer
+            /* 0x48 */  WFI
+        }},
+        { BBV_SUM_BASE, {
+            /* 0x00 */  U(BBV_DATA_BASE >> 12, T0, 0x37),           // lui    t0, data
+            /* 0x04 */  I(32, 0, 0, T1, 0x13),                      // li     t1, 32
+            /* 0x08 */  I(0, T0, 3, T2, 0x03),                      // loop: ld t2, 0(t0)
+            /* 0x0C */  R(0, T2, A0, 0, A0, 0x33),                  // add    a0, a0, t2
+            /* 0x10 */  I(8, T0, 0, T0, 0x13),                      // addi   t0, t0, 8
+            /* 0x14 */  I(-1, T1, 0, T1, 0x13),                     // addi   t1, t1, -1
+            /* 0x18 */  B(-0x10, 0, T1, 1),                         // bnez   t1, loop
+            /* 0x1C */  I(0, RA, 0, 0, 0x67)                        // ret
+        }}
+    };
+}
+
+
+// reference, block start tracked and counted on every instruction
+class ReferenceCounter : public RVExecObserver {
+public:
+    addr_t                                  start = 0;
+    addr_t                                  next  = ~0ULL;
+    std::unordered_map<addr_t, uint64_t>    counts;
+
+    virtual void PreExecute(const RVInstruction& insn, const RVExecContext& ctx) noexcept override
+    {
+        addr_t pc = ctx.arch->PC().pc64;
+
+        if (pc != next)
+            start = pc;
+
+        counts[start]++;
+        next = pc + 4;
+    }
+};
+
+typedef struct {
+    uint64_t        insns;
+    uint64_t        result;
+    double          seconds;
+} BBVResult;
+
+BBVResult Run(const std::vector<std::pair<addr_t, std::vector<uint32_t>>>& program,
+              RVExecBlockObserver* block_observer, RVExecObserver* exec_observer, bool jit = false)
+{
+    RV64IDecoder decoderI;
+
+    SimpleLinearMemory memory(BBV_MEMORY_SIZE >> 3);
+
+    for (const auto& [base, code] : program)
+        for (size_t i = 0; i < code.size(); i++)
+            memory.WriteInsn(base + i * 4, MOPW_WORD, { code[i] });
+
+    for (int i = 0; i < 32; i++)
+        memory.WriteData(BBV_DATA_BASE + i * 8, MOPW_DOUBLE_WORD, { (uint64_t) i * 0x9E3779B97F4A7C15ULL });
+
+    RVInstance* instance = RVInstance::Builder()
+        .XLEN(XLEN64)
+        .Decoder({ &decoderI })
+        .MI(&memory)
+        .TrapProcedures(TRAP_PROCEDURES_M_MODE)
+        .StartupPC64(0)
+        .Build();
+
+    instance->SetBlockObserver(block_observer);
+    instance->SetExecObserver(exec_observer);
+
+    //
+    BBVResult result = BBVResult();
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (jit)
+        RVJIT(instance).Run(UINT64_MAX, &result.insns);
+    else
+    {
+        while (instance->Eval() != EXEC_WAIT_FOR_INTERRUPT)
+            result.insns++;
+
+        result.insns++;
+    }
+
+    instance->FlushBlock();
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.result  = instance->GetArch().GetGRx64Zext(A0) ^ instance->GetArch().GetGRx64Zext(A1);
+
+    delete instance;
+
+    return result;
+}
+
+void Print(const char* name, const BBVResult& result)
+{
+    printf("%-12s  %-12lu  %016lx      %-9.3f  %-8.2f\n",
+        name, result.insns, result.result, result.seconds, result.insns / result.seconds / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t interval = argc > 1 ? strtoull(argv[1], nullptr, 10) : BBV_DEFAULT_INTERVAL;
+    uint32_t outer    = argc > 2 ? strtoul(argv[2], nullptr, 10) : BBV_DEFAULT_OUTER;
+
+    const char* bb_path = argc > 3 ? argv[3] : nullptr;
+
+    auto program = Program(outer);
+
+    std::ostringstream bb, jit_bb;
+
+    RVBBVCollector   collector(&bb, interval);
+    RVBBVCollector   jit_collector(&jit_bb, interval);
+    ReferenceCounter reference;
+
+    printf("Two-phase workload of %u round(s), interval of %lu instruction(s).\n", outer, interval);
+    printf("Mode          Instructions  Result                Seconds    MIPS\n");
+    printf("------------  ------------  --------------------  ---------  --------\n");
+
+    BBVResult plain = Run(program, nullptr, nullptr);
+    Print("plain", plain);
+
+    BBVResult bbv = Run(program, &collector, nullptr);
+    collector.Flush();
+    Print("bbv", bbv);
+
+    BBVResult ref = Run(program, nullptr, &reference);
+    Print("reference", ref);
+
+    // translation bypassed with the collector attached, every block still observed
+    BBVResult jit = Run(program, &jit_collector, nullptr, true);
+    jit_collector.Flush();
+    Print("bbv-jit", jit);
+
+    printf("Overhead: bbv %.2f%%, per-instruction reference %.2f%%\n",
+        (bbv.seconds / plain.seconds - 1) * 100, (ref.seconds / plain.seconds - 1) * 100);
+
+    if (bb_path)
+        std::ofstream(bb_path) << bb.str();
+
+    // parsed back, per-block totals against reference
+    std::map<uint32_t, uint64_t> totals;
+    std::vector<uint64_t>        sums;
+
+    std::istringstream lines(bb.str());
+    std::string        line;
+
+    bool well_formed = true;
+
+    while (std::getline(lines, line))
+    {
+        well_formed &= line.size() > 1 && line[0] == 'T' && line[1] == ':';
+
+        uint64_t sum = 0;
+
+        for (const char* p = line.c_str() + 1; *p == ':'; )
+        {
+            char* end;
+            uint32_t id    = strtoul(p + 1, &end, 10);
+            uint64_t count = strtoull(end + 1, &end, 10);
+
+            totals[id] += count;
+            sum        += count;
+
+            p = end + 1;
+        }
+
+        sums.push_back(sum);
+    }
+
+    bool matched = totals.size() == reference.counts.size();
+
+    for (const auto& [id, count] : totals)
+        matched &= reference.counts[collector.GetBlockStart(id)] == count;
+
+    // every complete interval covers at least its length, attributed at block end
+    bool intervals = sums.size() == collector.GetIntervalCount();
+
+    uint64_t covered = 0;
+    for (size_t i = 0; i + 1 < sums.size(); i++)
+        intervals &= (covered += sums[i]) >= (i + 1) * interval;
+
+    printf("%lu interval(s), %zu block(s)\n", collector.GetIntervalCount(), collector.GetBlockCount());
+
+    std::istringstream head(bb.str());
+    for (int i = 0; i < 4 && std::getline(head, line); i++)
+        printf("  %s\n", line.substr(0, 96).c_str());
+
+    bool passed = plain.result == bbv.result
+               && plain.insns  == bbv.insns
+               && collector.GetInstructionCount() == plain.insns
+               && jit_collector.GetInstructionCount() == plain.insns
+               && jit_bb.str() == bb.str()
+               && plain.result == jit.result
+               && well_formed
+               && matched
+               && intervals;
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+
+    return passed ? 0 : 1;
+}
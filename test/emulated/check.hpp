@@ -0,0 +1,22 @@
+#pragma once
+//
+// Check macro and result of emulated unit tests
+//
+//
+
+#include <cstdio>
+
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { if (!(cond)) { printf("  FAILED: %s (line %d)\n", #cond, __LINE__); failures++; } } while (0)
+
+
+// PASSED or FAILED on all checks so far, as the exit code of the test
+inline int CheckResult()
+{
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+// Jasse coverage-directed random generation driver (RV64I + RV64M + Zicsr), linked with -lgmp
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_64m.hpp"
+#include "riscv_zicsr.hpp"
+#include "riscvgenutil.hpp"
+#include "riscvmemutil.hpp"
+#include "csr/riscvcsrs_mimic.hpp"
+
+
+using namespace Jasse;
+
+
+#define     COVERAGE_DEFAULT_COUNT          200000
+
+#define     COVERAGE_DIRECT_INTERVAL        1000
+
+#define     COVERAGE_MEMORY_SIZE            (64 * 1024)
+
+#define     COVERAGE_IMM_ZERO_BUCKET        0
+#define     COVERAGE_IMM_ZERO_BOOST         64
+
+
+// no-op trap procedures, every instruction executed standalone at PC 0
+void TrapEnterNop(RVArchitecturalOOC* arch, RVCSRSpace* CSRs, RVTrapType type, RVTrapCause cause)
+{ }
+
+void TrapReturnNop(RVArchitecturalOOC* arch, RVCSRSpace* CSRs)
+{ }
+
+
+// boundary-biased register values, re-seeded periodically
+void SeedRegisters(RVInstance* instance, RVCodeGenRandom& rand)
+{
+    static constexpr uint64_t values[] = {
+        0, 1, ~0ULL, 0x8000000000000000ULL, 0x7FFFFFFFFFFFFFFFULL
+    };
+
+    for (int i = 1; i < 32; i++)
+    {
+        uint32_t pick = rand.NextRange32(0, 7);
+
+        instance->GetArch().SetGRx64(i, pick < 5 ? values[pick] : rand.Next());
+    }
+}
+
+int Run(const char* name, uint64_t count, bool directed, uint64_t seed, bool verbose)
+{
+    RV64IDecoder    decoderI;
+    RV64MDecoder    decoderM;
+    RVZicsrDecoder  decoderZicsr;
+
+    RVCodepointCollection codeset {
+        decoderI.GetAllCodepoints(), decoderM.GetAllCodepoints(), decoderZicsr.GetAllCodepoints()
+    };
+
+    SimpleLinearMemory memory(COVERAGE_MEMORY_SIZE);
+
+    RVInstance* instance = RVInstance::Builder()
+        .XLEN(XLEN64)
+        .Decoder({ &decoderI, &decoderM, &decoderZicsr })
+        .MI(&memory)
+        .CSR(CSR::DEBUG_CODEGEN_CANDIDATE_OF_MIMIC)
+        .TrapProcedures({ &TrapEnterNop, &TrapReturnNop })
+        .Build();
+
+    //
+    RVCodeGenConstraints constraints;
+    constraints.Emplace(RV_CODEGEN_GRx_RANGE, 0, 31);
+    constraints.Emplace(RV_CODEGEN_IMM_DISTRIBUTION);
+    constraints.Emplace(RV_CODEGEN_CSR_CANDIDATE, CSR::DEBUG_CODEGEN_CANDIDATE_OF_MIMIC);
+    constraints.Emplace(RV_CODEGEN_MIX_WEIGHT);
+
+    RVCodeGenConstraintCSRList* csrs = constraints.Get(RV_CODEGEN_CSR_CANDIDATE);
+    RVCodeGenConstraintMix*     mix  = constraints.Get(RV_CODEGEN_MIX_WEIGHT);
+
+    RVCodeGenConstraintDistributionI* imm = constraints.Get(RV_CODEGEN_IMM_DISTRIBUTION);
+
+    // zero in its own bucket, uniform over the 12-bit field until directed
+    imm->Add(0, 0,    1);
+    imm->Add(1, 4095, 4095);
+
+    RVCodeGenerator generator(codeset, &constraints, seed);
+
+    RVCodeGenCoverage coverage(codeset);
+
+    instance->SetExecObserver(&coverage);
+
+    //
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (!(i % COVERAGE_DIRECT_INTERVAL))
+        {
+            SeedRegisters(instance, generator.GetRandom());
+
+            if (directed)
+            {
+                coverage.Direct(mix);
+                coverage.Direct(imm, COVERAGE_IMM_ZERO_BUCKET, RV_COVERAGE_BIN_IMM_ZERO, 1, COVERAGE_IMM_ZERO_BOOST);
+                coverage.Direct(csrs, CSR::DEBUG_CODEGEN_CANDIDATE_OF_MIMIC);
+            }
+        }
+
+        insnraw_t insn;
+        generator.Next(&insn);
+
+        memory.WriteInsn(0, MOPW_WORD, { insn });
+
+        instance->GetArch().SetPC64(0);
+        instance->Eval();
+    }
+
+    //
+    if (verbose)
+        coverage.Print(std::cout);
+
+    printf("%-10s  %-10lu  %6d/%-6d  %8.3f%%  %4d/%-4d\n",
+        name,
+        count,
+        coverage.GetCoveredCount(),
+        coverage.GetBinCount(),
+        coverage.GetCoveredCount() * 100.0 / coverage.GetBinCount(),
+        coverage.GetCSRCoveredCount(),
+        CSR::DEBUG_CODEGEN_CANDIDATE_OF_MIMIC.GetSize());
+
+    delete instance;
+
+    return coverage.GetCoveredCount();
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t count   = COVERAGE_DEFAULT_COUNT;
+    uint64_t seed    = 0;
+    bool     verbose = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-v"))
+            verbose = true;
+        else if (!strcmp(argv[i], "-seed") && i + 1 < argc)
+            seed = strtoull(argv[++i], nullptr, 10);
+        else
+            count = strtoull(argv[i], nullptr, 10);
+    }
+
+    printf("Collecting functional coverage of random instruction stream, seed %lu.\n", seed);
+    printf("Generator   Count       Bins           Covered    CSRs\n");
+    printf("----------  ----------  -------------  ---------  ---------\n");
+
+    int uniform  = 0;
+    int directed = 0;
+
+    for (uint64_t n = count / 16; n <= count; n *= 4)
+    {
+        uniform  = Run("uniform",  n, false, seed, false);
+        directed = Run("directed", n, true,  seed, verbose && n * 4 > count);
+    }
+
+    // deterministic for the seed, directed must close more bins at the full count
+    if (directed <= uniform)
+    {
+        printf("FAILED: directed %d bin(s), uniform %d bin(s)\n", directed, uniform);
+        return 1;
+    }
+
+    printf("PASSED\n");
+
+    return 0;
+}
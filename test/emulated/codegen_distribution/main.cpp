@@ -0,0 +1,251 @@
+// Jasse code generator distribution checks, instruction mix, dependency distance and immediate buckets (linked with -lgmp)
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "riscv_64i.hpp"
+#include "riscvgenutil.hpp"
+#include "../check.hpp"
+
+
+using namespace Jasse;
+
+
+#define     DISTRIBUTION_SAMPLES            200000
+
+// tolerance in standard deviations of a binomial count
+#define     DISTRIBUTION_SIGMAS             5.0
+
+
+// observed count against expected probability, within the tolerance
+bool Within(const char* name, uint64_t observed, double p, uint64_t samples)
+{
+    double expected = p * samples;
+    double sigma    = std::sqrt(samples * p * (1 - p));
+    bool   within   = std::fabs(observed - expected) <= DISTRIBUTION_SIGMAS * sigma;
+
+    printf("  %-12s  %8lu  expected %10.1f  %s\n", name, observed, expected, within ? "" : "(out of tolerance)");
+
+    return within;
+}
+
+
+void TestMix()
+{
+    printf("Instruction mix by codepoint, type and default weight\n");
+
+    RVCodepointCollection codeset { &RV64I_ADD, &RV64I_SUB, &RV64I_ADDI, &RV64I_ANDI, &RV64I_LUI };
+
+    RVCodeGenConstraints constraints;
+    constraints.Emplace(RV_CODEGEN_GRx_RANGE, 0, 31);
+    constraints.Emplace(RV_CODEGEN_IMM_RANGE, 0, 4095);
+
+    RVCodeGenConstraintMix* mix = constraints.Emplace(RV_CODEGEN_MIX_WEIGHT);
+
+    // codepoint over type over default
+    mix->SetWeight(RVTYPE_I, 3);
+    mix->SetWeight(&RV64I_ADD, 6);
+    mix->SetWeight(&RV64I_ANDI, 0);
+
+    const std::map<const RVCodepoint*, uint32_t> weights {
+        { &RV64I_ADD, 6 }, { &RV64I_SUB, 1 }, { &RV64I_ADDI, 3 }, { &RV64I_ANDI, 0 }, { &RV64I_LUI, 1 }
+    };
+
+    RVCodeGenerator generator(codeset, &constraints, 0);
+
+    std::map<const RVCodepoint*, uint64_t> counts;
+
+    for (int i = 0; i < DISTRIBUTION_SAMPLES; i++)
+    {
+        insnraw_t insn;
+        counts[generator.Next(&insn)]++;
+    }
+
+    for (auto& weight : weights)
+        CHECK(Within(weight.first->GetName().c_str(), counts[weight.first], weight.second / 11.0, DISTRIBUTION_SAMPLES));
+
+    CHECK(!counts[&RV64I_ANDI]);
+
+    // any weight kept as set, including the full range
+    mix->SetWeight(RVTYPE_U, UINT32_MAX);
+
+    CHECK(mix->GetWeight(&RV64I_LUI) == UINT32_MAX);
+
+    mix->SetWeight(RVTYPE_U, 0);
+
+    CHECK(mix->GetWeight(&RV64I_LUI) == 0);
+
+    mix->ResetWeight(RVTYPE_U);
+
+    CHECK(mix->GetWeight(&RV64I_LUI) == mix->GetDefaultWeight());
+
+    // copies keep type weights
+    RVCodeGenConstraintMix copy(*mix);
+
+    CHECK(copy.GetWeight(&RV64I_ADDI) == 3);
+
+    mix->Reset();
+
+    CHECK(mix->GetWeight(&RV64I_ADDI) == mix->GetDefaultWeight());
+    CHECK(mix->GetWeight(&RV64I_ADD)  == mix->GetDefaultWeight());
+}
+
+void TestDependency()
+{
+    printf("Source register dependency distance\n");
+
+    const std::vector<uint32_t> weights { 2, 4, 2, 1, 1 };
+
+    RVCodeGenConstraintDependency dependency(RV_CODEGEN_CODE_DEPENDENCY_GRx, { 2, 4, 2, 1, 1 });
+
+    RVCodeGenRandom rand(0);
+
+    // d-th previous destination being 100 - d, independent as -1
+    for (int i = RV_CODEGEN_DEPENDENCY_WINDOW; i > 0; i--)
+        dependency.PushDestination(100 - i);
+
+    std::map<int, uint64_t> counts;
+
+    for (int i = 0; i < DISTRIBUTION_SAMPLES; i++)
+        counts[dependency.SampleSource(rand)]++;
+
+    CHECK(Within("independent", counts[-1], 2 / 10.0, DISTRIBUTION_SAMPLES));
+
+    for (int d = 1; d < (int) weights.size(); d++)
+    {
+        std::string name = "distance " + std::to_string(d);
+
+        CHECK(Within(name.c_str(), counts[100 - d], weights[d] / 10.0, DISTRIBUTION_SAMPLES));
+    }
+
+    CHECK(counts.size() == weights.size());
+
+    // distances beyond the history are independent
+    dependency.ResetHistory();
+    dependency.PushDestination(98);
+    dependency.PushDestination(99);
+
+    counts.clear();
+
+    for (int i = 0; i < DISTRIBUTION_SAMPLES; i++)
+        counts[dependency.SampleSource(rand)]++;
+
+    CHECK(Within("independent", counts[-1], 4 / 10.0, DISTRIBUTION_SAMPLES));
+    CHECK(Within("distance 1", counts[99], 4 / 10.0, DISTRIBUTION_SAMPLES));
+    CHECK(Within("distance 2", counts[98], 2 / 10.0, DISTRIBUTION_SAMPLES));
+
+    // through the generator, every source reading the previous destination
+    RVCodeGenConstraints constraints;
+    constraints.Emplace(RV_CODEGEN_GRx_RANGE, 0, 31);
+    constraints.Emplace(RV_CODEGEN_GRx_DEPENDENCY, std::initializer_list<uint32_t> { 0, 1 });
+
+    RVCodeGenerator generator(RVCodepointCollection { &RV64I_ADD }, &constraints, 0);
+
+    int previous = -1;
+    int mismatch = 0;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        insnraw_t insn;
+        generator.Next(&insn);
+
+        int rd  = GET_STD_OPERAND(insn, RV_OPERAND_RD);
+        int rs1 = GET_STD_OPERAND(insn, RV_OPERAND_RS1);
+        int rs2 = GET_STD_OPERAND(insn, RV_OPERAND_RS2);
+
+        if (previous != -1 && (rs1 != previous || rs2 != previous))
+            mismatch++;
+
+        previous = rd;
+    }
+
+    CHECK(!mismatch);
+}
+
+void TestImmediate()
+{
+    printf("Immediate buckets\n");
+
+    RVCodeGenConstraints constraints;
+    constraints.Emplace(RV_CODEGEN_GRx_RANGE, 0, 31);
+    constraints.Emplace(RV_CODEGEN_IMM_RANGE, 0, 4095);
+
+    RVCodeGenConstraintDistributionI* distribution = constraints.Emplace(RV_CODEGEN_IMM_DISTRIBUTION);
+
+    distribution->Add(0,    0,    1);
+    distribution->Add(1,    15,   3);
+    distribution->Add(2048, 4095, 4);
+
+    RVCodeGenRandom rand(0);
+
+    uint64_t counts[3] = { 0, 0, 0 };
+    uint64_t outside   = 0;
+    uint64_t low       = 0;
+
+    for (int i = 0; i < DISTRIBUTION_SAMPLES; i++)
+    {
+        uint32_t imm = RandImm(rand, &constraints);
+
+        if (!imm)
+            counts[0]++;
+        else if (imm <= 15)
+            counts[1]++;
+        else if (imm >= 2048 && imm <= 4095)
+            counts[2]++;
+        else
+            outside++;
+
+        // uniform within a bucket, lower half of the negative one
+        if (imm >= 2048 && imm < 3072)
+            low++;
+    }
+
+    CHECK(Within("zero", counts[0], 1 / 8.0, DISTRIBUTION_SAMPLES));
+    CHECK(Within("[1, 15]", counts[1], 3 / 8.0, DISTRIBUTION_SAMPLES));
+    CHECK(Within("[2048, 4095]", counts[2], 4 / 8.0, DISTRIBUTION_SAMPLES));
+    CHECK(Within("lower half", low, 1 / 2.0, counts[2]));
+    CHECK(!outside);
+
+    // re-weighted, and through the generator
+    distribution->SetWeight(1, 0);
+
+    RVCodeGenerator generator(RVCodepointCollection { &RV64I_ADDI }, &constraints, 0);
+
+    uint64_t zero = 0;
+    outside = 0;
+
+    for (int i = 0; i < DISTRIBUTION_SAMPLES; i++)
+    {
+        insnraw_t insn;
+        generator.Next(&insn);
+
+        uint32_t imm = insn >> 20;
+
+        if (!imm)
+            zero++;
+        else if (imm < 2048)
+            outside++;
+    }
+
+    CHECK(Within("zero", zero, 1 / 5.0, DISTRIBUTION_SAMPLES));
+    CHECK(!outside);
+
+    // empty distribution falls back to the range
+    distribution->Clear();
+
+    CHECK(distribution->IsEmpty());
+    CHECK(RandImm(rand, &constraints) <= 4095);
+}
+
+int main(int argc, char** argv)
+{
+    TestMix();
+    TestDependency();
+    TestImmediate();
+
+    return CheckResult();
+}
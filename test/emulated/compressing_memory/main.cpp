@@ -9,6 +9,7 @@
 #include <cstdlib>
 
 #include "main.hpp"
+#include "vmc_driver.hpp"
 
 
 VMC::VMCEntity con;
@@ -37,8 +38,15 @@ inline void InitBasicCommands(VMC::VMCHandle handle)
     VMC::Basic::SetupCommands(handle);
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    VMC::Driver::Options options;
+
+    if (!VMC::Driver::ParseOptions(argc, argv, &options))
+        return VMC_DRIVER_EXIT_USAGE;
+
+    VMC::Driver::Attach(options);
+
     //
     InitBasicCommands(&con);
     VMC::Setup(&con);
@@ -46,15 +54,15 @@ int main()
     OnSetup(&con);
 
     //
-    ECHO_COUT_VMC_VERSION
+    if (options.interactive && options.tty_in)
+    {
+        ECHO_COUT_VMC_VERSION
 
-    OnHello(&con);
+        OnHello(&con);
 
-    std::cout << std::endl;
+        std::cout << std::endl;
+    }
 
     //
-    while (1)
-        VMC::Next(&con, std::cin);
-
-    return 0;
+    return VMC::Driver::Run(&con, options);
 }
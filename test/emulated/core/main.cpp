@@ -10,6 +10,7 @@
 
 #include "vmc.hpp"
 #include "vmc_core.hpp"
+#include "vmc_driver.hpp"
 
 
 VMC::VMCEntity con;
@@ -29,24 +30,32 @@ bool Help(void* handle, const std::string& cmd,
 
 void InitBasicCommands(VMC::VMCHandle handle)
 {
-    handle->handlers.push_back(VMC::CommandHandler { std::string("?")      , &Help });
-    handle->handlers.push_back(VMC::CommandHandler { std::string("help")   , &Help });
+    VMC_COMMAND(handle, "?"   , Help);
+    VMC_COMMAND(handle, "help", Help);
 
     VMC::Basic::SetupCommands(handle);
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    VMC::Driver::Options options;
+
+    if (!VMC::Driver::ParseOptions(argc, argv, &options))
+        return VMC_DRIVER_EXIT_USAGE;
+
+    VMC::Driver::Attach(options);
+
+    //
     InitBasicCommands(&con);
     
     VMC::Setup(&con);
     VMC::Core::Setup(&con);
 
-    ECHO_COUT_VMC_VERSION
-    std::cout << std::endl;
-
-    while (1)
-        VMC::Next(&con, std::cin);
+    if (options.interactive && options.tty_in)
+    {
+        ECHO_COUT_VMC_VERSION
+        std::cout << std::endl;
+    }
 
-    return 0;
+    return VMC::Driver::Run(&con, options);
 }
@@ -11,14 +11,26 @@
 #include <string>
 #include <list>
 #include <vector>
+#include <chrono>
 
 #include "vmc.hpp"
 
 #include "core_dispatch.hpp"
+#include "common/random.hpp"
 
 
 using namespace MEMU::Core::Issue;
 
+using MEMU::Core::CoreGeometry;
+
+
+// Headless build with all by-step info branches compiled out
+#ifndef SIM_HEADLESS
+#   define SIM_HEADLESS                     0
+#endif
+
+#define SIM_INFO(info)                      (!SIM_HEADLESS && (info))
+
 namespace VMC::Core {
     static constexpr int INSN_CODE_NOP      = 0;
 
@@ -123,6 +135,95 @@ namespace VMC::Core {
         void                    SetROBStatus(const SimStageStatus* status);
     };
 
+    //
+    static constexpr int SIM_O3_STAGE_FETCH                 = 0;
+
+    static constexpr int SIM_O3_STAGE_ISSUE                 = 1;
+
+    static constexpr int SIM_O3_STAGE_WRITEBACK             = 2;
+
+    static constexpr int SIM_O3_STAGE_COMMIT                = 3;
+
+    static constexpr int SIM_O3_STAGE_COUNT                 = 4;
+
+    static constexpr int SIM_O3_STALL_NONE                  = 0; // stage made progress
+
+    static constexpr int SIM_O3_STALL_IDLE                  = 1; // nothing to do
+
+    static constexpr int SIM_O3_STALL_FETCH                 = 2; // fetch stall asserted
+
+    static constexpr int SIM_O3_STALL_RAT_FULL              = 3; // no free PRF to rename
+
+    static constexpr int SIM_O3_STALL_ROB_FULL              = 4;
+
+    static constexpr int SIM_O3_STALL_SCOREBOARD            = 5; // no ready instruction in reservation
+
+    static constexpr int SIM_O3_STALL_EXECUTION             = 6; // execution latency
+
+    static constexpr int SIM_O3_STALL_COMMIT                = 7; // ROB head not written back
+
+    static constexpr int SIM_O3_STALL_COUNT                 = 8;
+
+    static constexpr int SIM_DEFAULT_STATS_WINDOW           = 1024;
+
+    class SimO3Statistics {
+    private:
+        int                     window;
+
+        uint64_t                cycles;
+        uint64_t                commits;
+
+        uint64_t                stage_cycles[SIM_O3_STAGE_COUNT][SIM_O3_STALL_COUNT];
+
+        std::vector<uint64_t>   rob_histogram;          // [rob_size + 1]
+        std::vector<uint64_t>   reservation_histogram;  // [rob_size + 1]
+        std::vector<uint64_t>   freelist_histogram;     // [prf_size + 1]
+
+        std::vector<uint8_t>    window_commits;         // [window], ring of per-cycle commit count
+        uint64_t                window_cycles;          // cycles since the window was set
+        int                     window_sum;
+        int                     cycle_commits;
+
+        double                  window_ipc_min;
+        double                  window_ipc_max;
+        std::vector<double>     window_ipc;             // IPC of every completed window
+
+        static void             Sample(std::vector<uint64_t>& histogram, int value);
+
+    public:
+        SimO3Statistics(const CoreGeometry& geometry = CoreGeometry(), int window = SIM_DEFAULT_STATS_WINDOW);
+        ~SimO3Statistics();
+
+        static const char*      GetStageName(int stage);
+        static const char*      GetStallName(int reason);
+
+        int                     GetWindow() const;
+        void                    SetWindow(int window);
+
+        uint64_t                GetCycles() const;
+        uint64_t                GetCommits() const;
+        double                  GetIPC() const;
+        double                  GetWindowIPCMin() const;
+        double                  GetWindowIPCMax() const;
+
+        uint64_t                GetStageCycles(int stage, int reason) const;
+
+        const std::vector<uint64_t>&    GetROBHistogram() const;
+        const std::vector<uint64_t>&    GetReservationHistogram() const;
+        const std::vector<uint64_t>&    GetFreeListHistogram() const;
+        const std::vector<double>&      GetWindowIPC() const;
+
+        void                    Stage(int stage, int reason);
+        void                    Commit();
+        void                    Cycle(int rob_count, int reservation_count, int freelist_count);
+
+        void                    Reset();
+
+        void                    Print(std::ostream& os) const;
+        void                    WriteCSV(std::ostream& os) const;
+        void                    WriteJSON(std::ostream& os) const;
+    };
+
     //
     class SimMachineStatus {
         // reserved
@@ -220,12 +321,39 @@ namespace VMC::Core {
         void        SetSrc2PRF(int src2);
     };
 
+    // Compact instruction record for instruction memory and program files
+    typedef struct {
+
+        uint64_t    imm;
+        int32_t     FID;
+        uint32_t    delay;
+        uint16_t    insncode;
+        uint16_t    ARFs;           // [4:0] dstARF, [9:5] src1ARF, [14:10] src2ARF
+    } SimInstructionRecord;
+
     class SimInstructionMemory {
+    public:
+        static constexpr int    chunk_bits  = 16;
+        static constexpr int    chunk_size  = 1 << chunk_bits;
+
+        static SimInstructionRecord     Pack(const SimInstruction& insn);
+        static SimInstruction           Unpack(const SimInstructionRecord& record);
+
     private:
-        int                 capacity;
-        SimInstruction*     memory;
+        int                             capacity;
+        std::vector<SimInstructionRecord*>  chunks;
 
-        int                 position;
+        int                             position;
+
+        FILE*                           stream;
+        int                             stream_base;    // first streamed address
+
+        int                             released;       // count of released chunks
+        SimInstructionRecord*           spare;          // released chunk kept for re-use
+
+        SimInstructionRecord*           NewChunk();
+        SimInstructionRecord*           GetRecord(int address);
+        bool                            Fetch(int address);
 
     public:
         SimInstructionMemory(int capacity);
@@ -234,17 +362,73 @@ namespace VMC::Core {
         ~SimInstructionMemory();
 
         int                     GetCapacity() const;
-        bool                    CheckBound(bool address) const;
+        int                     GetChunkCount() const;
+        bool                    CheckBound(int address) const;
+        bool                    HasInsn(int address);
 
-        const SimInstruction&   GetInsn(int address) const;
-        SimInstruction&         GetInsn(int address);
+        SimInstruction          GetInsn(int address);
         void                    SetInsn(int address, const SimInstruction& insn);
 
         int                     GetPosition() const;
         void                    SetPosition(int pos);
         bool                    PushInsn(const SimInstruction& insn);
+        void                    Release(int address);
+
+        bool                    Save(const char* filename) const;
+        bool                    OpenStream(const char* filename);
+        void                    CloseStream();
+        bool                    IsStreaming() const;
 
         void                    Reset();
+
+        void                    operator=(const SimInstructionMemory& obj) = delete;
+    };
+
+
+    // Compact renamed instruction record for spilled history
+    typedef struct {
+
+        SimInstructionRecord    insn;
+        int32_t                 FGR;
+        int32_t                 pc;
+        int16_t                 dstPRF;
+        int16_t                 src1PRF;
+        int16_t                 src2PRF;
+    } SimFetchedInstructionRecord;
+
+    template<class T>
+    class SimHistory {
+    private:
+        int                 capacity;
+        T*                  ring;           // [capacity]
+
+        uint64_t            total;
+
+        FILE*               spill;
+
+    public:
+        SimHistory(int capacity);
+        SimHistory(const SimHistory<T>& obj);
+        ~SimHistory();
+
+        int                 GetCapacity() const;
+        int                 GetCount() const;
+        uint64_t            GetTotal() const;
+        uint64_t            GetBegin() const;
+
+        bool                Contains(uint64_t index) const;
+        const T&            Get(uint64_t index) const;
+
+        void                Push(const T& obj);
+
+        void                Resize(int capacity);
+        void                Clear();
+
+        bool                OpenSpill(const char* filename);
+        void                CloseSpill();
+        bool                IsSpilling() const;
+
+        void                operator=(const SimHistory<T>& obj) = delete;
     };
 
 
@@ -252,6 +436,8 @@ namespace VMC::Core {
 
     static constexpr int SCOREBOARD_STATUS_IN_ARF           = 0;
 
+    static constexpr int SCOREBOARD_STATUS_IN_ROB           = 1;
+
     static constexpr int SCOREBOARD_STATUS_FORWARD          = 2; // unused
 
     class SimScoreboard // Only support ARF0-conv mode
@@ -390,7 +576,8 @@ namespace VMC::Core {
     private:
         const TScoreboard*      const scoreboard;
         std::list<Entry>              entries;
-        std::list<Entry>::iterator    next;
+        typename std::list<Entry>::iterator
+                                      next;
 
     public:
         SimReservation(const TScoreboard* scoreboard);
@@ -552,18 +739,26 @@ namespace VMC::Core {
 
     static constexpr int            SIM_DEFAULT_RAND_MAX_INSN_DELAY = 32;
 
+    static constexpr unsigned int   SIM_DEFAULT_RAND_SEED           = 1;
+
+    static constexpr int            SIM_RAND_BULK_SIZE              = 1024;
+
+    static constexpr int            SIM_DEFAULT_HISTORY_CAPACITY    = 1024 * 64;
+
     //
     static constexpr int            SIM_INSN_MEMORY_CAPACITY        = 1024 * 1024 * 32;
 
     typedef struct {
 
+        CoreGeometry                Geometry                    = CoreGeometry();
+
         SimInstructionMemory        InsnMemory                  = SimInstructionMemory(SIM_INSN_MEMORY_CAPACITY);
 
-        Scoreboard                  O3Scoreboard                = Scoreboard();
+        Scoreboard                  O3RATScoreboard             = Scoreboard(Geometry);
 
-        RegisterAliasTable          O3RAT                       = RegisterAliasTable(&O3Scoreboard);
+        RegisterAliasTable          O3RAT                       = RegisterAliasTable(&O3RATScoreboard, Geometry);
 
-        PhysicalRegisterFile        O3PRF                       = PhysicalRegisterFile();
+        PhysicalRegisterFile        O3PRF                       = PhysicalRegisterFile(Geometry);
 
         int                         O3PC                        = 0;
 
@@ -573,9 +768,18 @@ namespace VMC::Core {
 
         bool                        O3IssueStall                = false;
 
-        SimScoreboard               O3Scoreboard                = SimScoreboard(EMULATED_PRF_SIZE);
+        SimScoreboard               O3Scoreboard                = SimScoreboard(Geometry.GetPRFSize());
 
-        SimReservation<Scoreboard>  O3Reservation               = SimReservation(&O3Scoreboard);
+        // *NOTICE: Sized by ROB, every entry holding a ROB entry, so never full behind the ROB-full stall of fetch.
+        //          Instructions are kept by slot beside the queue, and selected ones picked out on each cycle,
+        //          before a selected slot could be allocated again by fetch.
+        IssueQueue                  O3Reservation               = IssueQueue(Geometry.GetROBSize(), 1, 1, Geometry);
+
+        std::vector<SimFetchedInstruction>
+                                    O3ReservationInsn           = std::vector<SimFetchedInstruction>(Geometry.GetROBSize());
+
+        std::list<SimFetchedInstruction>
+                                    O3ReservationSelected       = std::list<SimFetchedInstruction>();
 
         SimExecution                O3Execution                 = SimExecution(&O3PRF);
 
@@ -583,6 +787,8 @@ namespace VMC::Core {
 
         SimO3PipeStatus             O3Status                    = SimO3PipeStatus();
 
+        SimO3Statistics             O3Stats                     = SimO3Statistics(Geometry);
+
         uint64_t                    RefARF[EMULATED_ARF_SIZE]   = { 0 };
 
         int                         RefPC                       = 0;
@@ -610,11 +816,13 @@ namespace VMC::Core {
 
         unsigned int                RandMaxInsnDelay            = SIM_DEFAULT_RAND_MAX_INSN_DELAY;
 
+        MEMU::Common::Random        Rand                        = MEMU::Common::Random(SIM_DEFAULT_RAND_SEED);
+
         //
-        std::vector<SimInstruction> FetchHistory                = std::vector<SimInstruction>();
+        SimHistory<SimInstruction>  FetchHistory                = SimHistory<SimInstruction>(SIM_DEFAULT_HISTORY_CAPACITY);
 
-        std::vector<SimFetchedInstruction> 
-                                    RenamedHistory              = std::vector<SimFetchedInstruction>();
+        SimHistory<SimFetchedInstruction> 
+                                    RenamedHistory              = SimHistory<SimFetchedInstruction>(SIM_DEFAULT_HISTORY_CAPACITY);
 
         int                         O3FetchCount                = 0;
 
@@ -635,13 +843,11 @@ namespace VMC::Core {
 // Global components
 namespace VMC::Core {
 
-    static SimHandle CURRENT_HANDLE = nullptr;
-
     void SetupCommands(VMCHandle handle);
 
-    inline SimHandle NewHandle()
+    inline SimHandle NewHandle(const CoreGeometry& geometry = CoreGeometry())
     {
-        return new SimContext;
+        return new SimContext { geometry };
     }
 
     inline void DeleteHandle(SimHandle handle)
@@ -649,59 +855,60 @@ namespace VMC::Core {
         delete handle;
     }
 
+    inline void SetCurrentHandle(VMCHandle handle, SimHandle csim)
+    {
+        handle->context = csim;
+    }
+
+    inline SimHandle GetCurrentHandle(void* handle)
+    {
+        return (SimHandle) ((VMCHandle) handle)->context;
+    }
+
     void Setup(VMCHandle handle)
     {
         printf("Initializating VMC simulation memory...\n");
 
-        CURRENT_HANDLE = NewHandle();
+        SetCurrentHandle(handle, NewHandle());
 
         printf("\033[1A");
 
         SetupCommands(handle);
     }
-    
-    inline void SetCurrentHandle(SimHandle handle)
+
+    inline uint64_t SimRand(SimHandle handle)
     {
-        CURRENT_HANDLE = handle;
+        return handle->Rand.Next();
     }
 
-    inline SimHandle GetCurrentHandle()
+    inline void SimSrand(SimHandle handle, uint64_t seed)
     {
-        return CURRENT_HANDLE;
+        handle->Rand.Seed(seed);
     }
 
-    uint64_t RandRegValue(SimHandle handle)
+    inline uint64_t RandRegValue(SimHandle handle)
     {
-        uint64_t val =  (uint64_t)rand() 
-                     ^ ((uint64_t)rand() << 16) 
-                     ^ ((uint64_t)rand() << 32) 
-                     ^ ((uint64_t)rand() << 48);
+        return handle->Rand.NextBounded(handle->RandMaxRegValue);
+    }
 
-        uint64_t orb = rand();
-        uint64_t orc =  (orb & 0x0000000F)
-                     | ((orb & 0x000000F0) << 12)
-                     | ((orb & 0x00000F00) << 24)
-                     | ((orb & 0x00007000) << 36);
-        
-        if (handle->RandMaxRegValue)
-            return (val ^ orc) % handle->RandMaxRegValue;
-        else
-            return val ^ orc;
+    inline void RandRegValues(SimHandle handle, uint64_t* dst, int count)
+    {
+        handle->Rand.FillBounded(dst, count, handle->RandMaxRegValue);
     }
 
     inline int RandRegIndex(SimHandle handle)
     {
-        return rand() % handle->RandMaxRegIndex;
+        return handle->Rand.NextBounded32(handle->RandMaxRegIndex);
     }
 
     inline int RandInsnDelay(SimHandle handle)
     {
-        return rand() % handle->RandMaxInsnDelay;
+        return handle->Rand.NextBounded32(handle->RandMaxInsnDelay);
     }
 
     inline int RandInsn(SimHandle handle)
     {
-        return rand() % INSN_COUNT;
+        return handle->Rand.NextBounded32(INSN_COUNT);
     }
 
     inline int NextFID(SimHandle handle)
@@ -709,6 +916,45 @@ namespace VMC::Core {
         return handle->GlobalFID++;
     }
 
+    SimInstruction NewRandomInsn(SimHandle handle)
+    {
+        int FID = NextFID(handle);
+
+        int      insncode = RandInsn(handle);
+        int      delay    = RandInsnDelay(handle);
+        int      dstARF   = RandRegIndex(handle);
+        int      srcARF1  = RandRegIndex(handle);
+        int      srcARF2  = RandRegIndex(handle);
+        uint64_t imm      = RandRegValue(handle); // stub
+
+        return SimInstruction(FID, delay, insncode, dstARF, srcARF1, srcARF2, imm);
+    }
+
+    void PushRandomInsns(SimHandle handle, int count)
+    {
+        // Operands generated in bulk, SIM_RAND_BULK_SIZE instructions at a time
+        int      insncodes[SIM_RAND_BULK_SIZE];
+        int      delays   [SIM_RAND_BULK_SIZE];
+        int      ARFs     [SIM_RAND_BULK_SIZE * 3];
+        uint64_t imms     [SIM_RAND_BULK_SIZE];
+
+        while (count > 0)
+        {
+            int n = count < SIM_RAND_BULK_SIZE ? count : SIM_RAND_BULK_SIZE;
+
+            handle->Rand.FillBounded(insncodes, n    , INSN_COUNT);
+            handle->Rand.FillBounded(delays   , n    , handle->RandMaxInsnDelay);
+            handle->Rand.FillBounded(ARFs     , n * 3, handle->RandMaxRegIndex);
+            RandRegValues(handle, imms, n);
+
+            for (int i = 0; i < n; i++)
+                handle->InsnMemory.PushInsn(SimInstruction(NextFID(handle), delays[i], insncodes[i],
+                    ARFs[i * 3], ARFs[i * 3 + 1], ARFs[i * 3 + 2], imms[i]));
+
+            count -= n;
+        }
+    }
+
     inline uint64_t GetRefARF(SimHandle handle, int arf)
     {
         if (handle->FlagARF0Conv && !arf)
@@ -777,7 +1023,7 @@ namespace VMC::Core {
         {
             csim->RefStatus.SetFetchStatus(&STAGE_STATUS_WAIT);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefFetch: Fetch stall.\n", step);
 
             return true;
@@ -790,18 +1036,28 @@ namespace VMC::Core {
             return false;
         }
 
+        if (!csim->InsnMemory.HasInsn(csim->RefPC))
+        {
+            csim->RefStatus.SetFetchStatus(&STAGE_STATUS_IDLE);
+
+            if (SIM_INFO(info))
+                printf("[ %8d ] RefFetch: End of instruction memory.\n", step);
+
+            return true;
+        }
+
         if (!csim->RefReservation.IsEmpty())
         {
             csim->RefStatus.SetFetchStatus(&STAGE_STATUS_WAIT);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefFetch: Fetch queue wait for reserved issue.\n", step);
 
             return true;
         }
 
         //
-        const SimInstruction& insn = csim->InsnMemory.GetInsn(csim->RefPC);
+        SimInstruction insn = csim->InsnMemory.GetInsn(csim->RefPC);
 
         //
         csim->RefReservation.PushInsn(SimFetchedInstruction(insn, 0, csim->RefPC));
@@ -813,13 +1069,13 @@ namespace VMC::Core {
             csim->RefFetchStall = true;
 
         //
-        csim->FetchHistory.push_back(insn);
+        csim->FetchHistory.Push(insn);
 
         csim->RefFetchCount++;
 
         csim->RefStatus.SetFetchStatus(&STAGE_STATUS_BUSY);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] RefFetch: Instruction fetched, passed to issue. FID: %d.\n", step, insn.GetFID());
 
         return true;
@@ -831,7 +1087,7 @@ namespace VMC::Core {
         {
             csim->RefStatus.SetReservationStatus(&STAGE_STATUS_IDLE);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefIssue: Issue queue empty.\n", step);
 
             return true;
@@ -844,7 +1100,7 @@ namespace VMC::Core {
         {
             csim->RefStatus.SetReservationStatus(&STAGE_STATUS_WAIT);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefIssue: Issue pause on scoreboard. ARF not ready.\n", step);
 
             return true;
@@ -864,7 +1120,7 @@ namespace VMC::Core {
 
         csim->RefStatus.SetReservationStatus(&STAGE_STATUS_BUSY);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] RefIssue: Instruction issued. FID: %d.\n", step, insn.GetFID());
 
         return true;
@@ -876,7 +1132,7 @@ namespace VMC::Core {
         {
             csim->RefStatus.SetExecutionStatus(&STAGE_STATUS_IDLE);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefWriteback: Execution unit empty.\n", step);
 
             return true;
@@ -889,7 +1145,7 @@ namespace VMC::Core {
         {
             csim->RefStatus.SetExecutionStatus(&STAGE_STATUS_BUSY);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] RefWriteback: Instruction writeback not ready.\n", step);
 
             return true;
@@ -915,7 +1171,7 @@ namespace VMC::Core {
 
         csim->RefStatus.SetExecutionStatus(&STAGE_STATUS_BUSY);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] RefWriteback: FID #%d written-back. DstARF #%d.\n", step, insn.GetFID(), insn.GetDstARF());
 
         return true;
@@ -959,8 +1215,9 @@ namespace VMC::Core {
         if (csim->O3FetchStall)
         {
             csim->O3Status.SetFetchStatus(&STAGE_STATUS_WAIT);
+            csim->O3Stats.Stage(SIM_O3_STAGE_FETCH, SIM_O3_STALL_FETCH);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Fetch: Fetch stall.\n", step);
 
             return true;
@@ -973,14 +1230,39 @@ namespace VMC::Core {
             return false;
         }
 
+        if (!csim->InsnMemory.HasInsn(csim->O3PC))
+        {
+            csim->O3Status.SetFetchStatus(&STAGE_STATUS_IDLE);
+            csim->O3Stats.Stage(SIM_O3_STAGE_FETCH, SIM_O3_STALL_IDLE);
+
+            if (SIM_INFO(info))
+                printf("[ %8d ] O3Fetch: End of instruction memory.\n", step);
+
+            return true;
+        }
+
+        // *NOTICE: SimReOrderBuffer is a list without capacity of its own, so fetch would only stall
+        //          on RAT free list otherwise. Bounded here by the geometry, for ROB size to matter
+        //          in timing, and for ROB-full cycles to be accounted at all.
+        if (csim->O3ROB.GetCount() >= csim->Geometry.GetROBSize())
+        {
+            csim->O3Status.SetFetchStatus(&STAGE_STATUS_WAIT);
+            csim->O3Stats.Stage(SIM_O3_STAGE_FETCH, SIM_O3_STALL_ROB_FULL);
+
+            if (SIM_INFO(info))
+                printf("[ %8d ] O3Fetch: ROB full.\n", step);
+
+            return true;
+        }
+
         //
-        SimInstruction& insn = csim->InsnMemory.GetInsn(csim->O3PC);
+        SimInstruction insn = csim->InsnMemory.GetInsn(csim->O3PC);
 
         // Get src PRFs
         int src1prf = csim->O3RAT.GetAliasPRF(insn.GetSrc1ARF());
         int src2prf = csim->O3RAT.GetAliasPRF(insn.GetSrc2ARF());
 
-        if (info)
+        if (SIM_INFO(info))
         {
             printf("[ %8d ] O3Fetch: ARF converted. Src1 ARF #%d -> PRF #%d.\n", step, insn.GetSrc1ARF(), src1prf);
             printf("[ %8d ] O3Fetch: ARF converted. Src2 ARF #%d -> PRF #%d.\n", step, insn.GetSrc2ARF(), src2prf);
@@ -992,37 +1274,56 @@ namespace VMC::Core {
         if (!csim->O3RAT.Touch(insn.GetFID(), insn.GetDstARF(), &dstprf))
         {
             csim->O3Status.SetFetchStatus(&STAGE_STATUS_WAIT);
+            csim->O3Stats.Stage(SIM_O3_STAGE_FETCH, SIM_O3_STALL_RAT_FULL);
 
-            if (info)
-                printf("[ %8d ] O3Fetch: Wait on FID #%d. Core not available.\n", info, insn.GetFID());
+            if (SIM_INFO(info))
+                printf("[ %8d ] O3Fetch: Wait on FID #%d. Core not available.\n", step, insn.GetFID());
 
             return true;
         }
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Fetch: Dst ARF renamed. Dst ARF #%d -> PRF #%d.\n", step, insn.GetDstARF(), dstprf);
 
         // Re-write/modify instruction after Core
         SimFetchedInstruction renamed_insn(insn, csim->O3FGR, csim->O3PC, dstprf, src1prf, src2prf);
 
+        // PC operation
+        csim->O3PC++;
+
         // FGR increment (Current design: Post-branch)
         if (insn.IsBranch())
             csim->O3FGR++;
 
         // Rename history
-        csim->RenamedHistory.push_back(renamed_insn);
+        csim->RenamedHistory.Push(renamed_insn);
 
         // Push to issue queue and broadcast to ROB
-        csim->O3Reservation.PushInsn(renamed_insn);
+        int slot = csim->O3Reservation.Allocate(renamed_insn.GetFID(), dstprf,
+            src1prf, !csim->O3Scoreboard.IsBusy(src1prf),
+            src2prf, !csim->O3Scoreboard.IsBusy(src2prf));
+
+        if (slot < 0)
+        {
+            ShouldNotReachHere(" Core::EvalO3Fetch ILLEGAL_STATE #ReservationAllocateFail");
+            return false;
+        }
+
+        csim->O3ReservationInsn[slot] = renamed_insn;
         csim->O3ROB.TouchInsn(renamed_insn);
 
-        csim->O3Scoreboard.SetStatus(dstprf, SCOREBOARD_STATUS_BUSY, renamed_insn.GetFID());
+        if (dstprf >= 0)
+        {
+            csim->O3Scoreboard.SetStatus(dstprf, SCOREBOARD_STATUS_BUSY, -1, renamed_insn.GetFID());
+            csim->O3RATScoreboard.TakeOff(dstprf);
+        }
 
         csim->O3FetchCount++;
 
         csim->O3Status.SetFetchStatus(&STAGE_STATUS_BUSY);
+        csim->O3Stats.Stage(SIM_O3_STAGE_FETCH, SIM_O3_STALL_NONE);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Fetch: Instruction fetched and renamed, passed to reseravtion. FID #%d.\n", step, renamed_insn.GetFID());
 
         return true;
@@ -1030,33 +1331,33 @@ namespace VMC::Core {
 
     bool EvalO3Issue(SimHandle csim, bool info, int step)
     {
-        if (csim->O3Reservation.IsEmpty())
+        if (csim->O3Reservation.IsEmpty() && csim->O3ReservationSelected.empty())
         {
             csim->O3Status.SetReservationStatus(&STAGE_STATUS_IDLE);
+            csim->O3Stats.Stage(SIM_O3_STAGE_ISSUE, SIM_O3_STALL_IDLE);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Issue: Issue queue empty.\n", step);
 
             return true;
         }
 
         //
-        SimFetchedInstruction insn;
-
-        if (!csim->O3Reservation.NextInsn(&insn))
+        if (csim->O3ReservationSelected.empty())
         {
             csim->O3Status.SetReservationStatus(&STAGE_STATUS_WAIT);
+            csim->O3Stats.Stage(SIM_O3_STAGE_ISSUE, SIM_O3_STALL_SCOREBOARD);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Issue: Issue pause on scoreboard. PRF not ready or reservation delay.\n", step);
 
-            if (info)
+            if (SIM_INFO(info))
             {
                 int count = 0;
 
                 printf("[ %8d ] O3Issue: Not ready PRFs:", step);
 
-                for (int i = 0; i < EMULATED_PRF_SIZE; i++)
+                for (int i = 0; i < csim->O3Scoreboard.GetSize(); i++)
                 {
                     if (!csim->O3Scoreboard.IsBusy(i))
                         continue;
@@ -1073,6 +1374,8 @@ namespace VMC::Core {
         }
 
         //
+        SimFetchedInstruction insn = csim->O3ReservationSelected.front();
+
         uint64_t src1val;
         uint64_t src2val;
 
@@ -1084,7 +1387,7 @@ namespace VMC::Core {
             case SCOREBOARD_STATUS_IN_ARF:
                 src1val = SimO3ARF(&(csim->O3PRF))[insn.GetSrc1PRF()];
 
-                if (info)
+                if (SIM_INFO(info))
                     printf("[ %8d ] O3Issue: Read src1 PRF #%d value: %ld (0x%016lx).\n", step, insn.GetSrc1PRF(), src1val, src1val);
 
                 break;
@@ -1096,7 +1399,7 @@ namespace VMC::Core {
                     return false;
                 }
 
-                if (info)
+                if (SIM_INFO(info))
                     printf("[ %8d ] O3Issue: Read src1 PRF #%d value: %ld (0x%016lx) from ROB.\n", step, insn.GetSrc1PRF(), src1val, src1val);
 
                 break;
@@ -1111,7 +1414,7 @@ namespace VMC::Core {
             case SCOREBOARD_STATUS_IN_ARF:
                 src2val = SimO3ARF(&(csim->O3PRF))[insn.GetSrc2PRF()];
 
-                if (info)
+                if (SIM_INFO(info))
                     printf("[ %8d ] O3Issue: Read src2 PRF #%d value: %ld (0x%016lx).\n", step, insn.GetSrc2PRF(), src2val, src2val);
 
                 break;
@@ -1123,7 +1426,7 @@ namespace VMC::Core {
                     return false;
                 }
 
-                if (info)
+                if (SIM_INFO(info))
                     printf("[ %8d ] O3Issue: Read src2 PRF #%d value: %ld (0x%016lx) from ROB.\n", step, insn.GetSrc2PRF(), src2val, src2val);
 
                 break;
@@ -1135,15 +1438,12 @@ namespace VMC::Core {
 
         csim->O3Execution.PushInsnEx(insn, src1val, src2val);
 
-        if (!csim->O3Reservation.PopInsn())
-        {
-            ShouldNotReachHere(" Core::EvalO3Issue ILLEGAL_STATE #ReservationPopFail");
-            return false;
-        }
+        csim->O3ReservationSelected.pop_front();
 
         csim->O3Status.SetReservationStatus(&STAGE_STATUS_BUSY);
+        csim->O3Stats.Stage(SIM_O3_STAGE_ISSUE, SIM_O3_STALL_NONE);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Issue: Instruction issued. FID: %d.\n", step, insn.GetFID());
 
         return true;
@@ -1154,8 +1454,9 @@ namespace VMC::Core {
         if (csim->O3Execution.IsEmpty())
         {
             csim->O3Status.SetExecutionStatus(&STAGE_STATUS_IDLE);
+            csim->O3Stats.Stage(SIM_O3_STAGE_WRITEBACK, SIM_O3_STALL_IDLE);
             
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Writeback: Execution unit empty.\n", step);
 
             return true;
@@ -1167,8 +1468,9 @@ namespace VMC::Core {
         if (!csim->O3Execution.NextInsn(&entry))
         {
             csim->O3Status.SetExecutionStatus(&STAGE_STATUS_BUSY);
+            csim->O3Stats.Stage(SIM_O3_STAGE_WRITEBACK, SIM_O3_STALL_EXECUTION);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Writeback: Instruction writeback not ready.\n", step);
 
             return true;
@@ -1183,7 +1485,16 @@ namespace VMC::Core {
             return false;
         }
 
-        csim->O3Scoreboard.SetStatus(insn.GetDstPRF(), SCOREBOARD_STATUS_IN_ROB);
+        if (insn.GetDstPRF() >= 0)
+        {
+            csim->O3Scoreboard.SetStatus(insn.GetDstPRF(), SCOREBOARD_STATUS_IN_ROB);
+
+            if (!csim->O3Reservation.Wakeup(insn.GetDstPRF()))
+            {
+                ShouldNotReachHere(" Core::EvalO3Writeback ILLEGAL_STATE #ReservationWakeupFail");
+                return false;
+            }
+        }
 
         if (!csim->O3Execution.PopInsn())
         {
@@ -1192,8 +1503,9 @@ namespace VMC::Core {
         }
 
         csim->O3Status.SetExecutionStatus(&STAGE_STATUS_BUSY);
+        csim->O3Stats.Stage(SIM_O3_STAGE_WRITEBACK, SIM_O3_STALL_NONE);
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Writeback: FID #%d written-back to ROB. DstPRF #%d.\n", step, insn.GetFID(), insn.GetDstPRF());
 
         return true;
@@ -1204,8 +1516,9 @@ namespace VMC::Core {
         if (csim->O3ROB.IsEmpty())
         {
             csim->O3Status.SetROBStatus(&STAGE_STATUS_IDLE);
+            csim->O3Stats.Stage(SIM_O3_STAGE_COMMIT, SIM_O3_STALL_IDLE);
 
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Commit: ROB empty.\n", step);
 
             return true;
@@ -1217,8 +1530,9 @@ namespace VMC::Core {
         if (!csim->O3ROB.NextInsn(&entry))
         {
             csim->O3Status.SetROBStatus(&STAGE_STATUS_WAIT);
+            csim->O3Stats.Stage(SIM_O3_STAGE_COMMIT, SIM_O3_STALL_COMMIT);
             
-            if (info)
+            if (SIM_INFO(info))
                 printf("[ %8d ] O3Commit: ROB wait for further writeback.\n", step);
 
             return true;
@@ -1230,7 +1544,7 @@ namespace VMC::Core {
         if (insn.GetDstPRF() >= 0)
             csim->O3PRF.Set(insn.GetDstPRF(), entry.GetDstValue());
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Commit: Written back to PRF #%d: %ld (0x%016lx).\n", step, insn.GetDstPRF(), entry.GetDstValue(), entry.GetDstValue());
 
         // assert
@@ -1240,17 +1554,23 @@ namespace VMC::Core {
             return false;
         }
 
-        csim->O3Scoreboard.SetStatus(insn.GetDstPRF(), SCOREBOARD_STATUS_IN_ARF);
+        if (insn.GetDstPRF() >= 0)
+            csim->O3Scoreboard.SetStatus(insn.GetDstPRF(), SCOREBOARD_STATUS_IN_ARF);
 
         // assert
-        if (insn.GetDstPRF() >= 0 && csim->O3RAT.GetEntry(insn.GetDstPRF()).GetFID() != insn.GetFID())
+        if (insn.GetDstPRF() >= 0 && csim->O3RAT.GetEntry(insn.GetDstPRF()).GetARF() != insn.GetDstARF())
         {
-            printf("[ \033[1;31mASSERT\033[0m   ] O3Commit: Core commit FID not identical.\n");
+            printf("[ \033[1;31mASSERT\033[0m   ] O3Commit: Core commit ARF not identical.\n");
             return false;
         }
 
+        // *NOTICE: RAT scoreboard keeps PRF busy from rename to commit, so that
+        //          only committed mappings of the same ARF are released here
         if (insn.GetDstPRF() >= 0)
+        {
             csim->O3RAT.Commit(insn.GetDstPRF());
+            csim->O3RATScoreboard.Land(insn.GetDstPRF());
+        }
 
         if (!csim->O3ROB.PopInsn())
         {
@@ -1261,8 +1581,10 @@ namespace VMC::Core {
         csim->O3CommitCount++;
 
         csim->O3Status.SetROBStatus(&STAGE_STATUS_BUSY);
+        csim->O3Stats.Stage(SIM_O3_STAGE_COMMIT, SIM_O3_STALL_NONE);
+        csim->O3Stats.Commit();
 
-        if (info)
+        if (SIM_INFO(info))
             printf("[ %8d ] O3Commit: Instruction committed. FID: %d.\n", step, insn.GetFID());
 
         return true;
@@ -1271,13 +1593,20 @@ namespace VMC::Core {
     void EvalO3Cycle(SimHandle csim)
     {
         csim->O3Reservation.Eval();
+
+        for (int i = 0; i < csim->O3Reservation.GetSelectCount(); i++)
+            csim->O3ReservationSelected.push_back(csim->O3ReservationInsn[csim->O3Reservation.GetSelected(i)]);
+
         csim->O3Scoreboard.Eval();
+        csim->O3RATScoreboard.Eval();
         csim->O3Execution.Eval();
         csim->O3RAT.Eval();
         csim->O3PRF.Eval();
 
         csim->O3ReservationCountMax = max(csim->O3ReservationCountMax, csim->O3Reservation.GetCount());
         csim->O3ROBCountMax = max(csim->O3ROBCountMax, csim->O3ROB.GetCount());
+
+        csim->O3Stats.Cycle(csim->O3ROB.GetCount(), csim->O3Reservation.GetCount(), csim->O3RAT.GetFreeCount());
     }
 
     bool EvalO3(SimHandle csim, bool info, int step)
@@ -1346,6 +1675,128 @@ namespace VMC::Core {
 }
 
 
+// Headless batch run
+namespace VMC::Core {
+
+    typedef struct {
+
+        unsigned int                Seed;
+
+        int                         InsnCount;
+
+        unsigned int                MaxInsnDelay;
+
+        int                         MaxSteps;
+
+    } SimBatchConfig;
+
+    typedef struct {
+
+        bool                        Passed;
+
+        int                         Steps;
+
+        int                         O3CommitCount;
+
+        int                         O3ROBCountMax;
+
+        int                         O3ReservationCountMax;
+
+        int                         MismatchStep;           // -1 for no mismatch
+
+        int                         MismatchARF;            // -1 for no mismatch
+
+        uint64_t                    MismatchO3Value;
+
+        uint64_t                    MismatchRefValue;
+
+        double                      Seconds;
+
+    } SimBatchResult;
+
+    // Run random O3-vs-Ref differential simulation without console
+    SimBatchResult RunBatch(SimHandle csim, const SimBatchConfig& config)
+    {
+        SimBatchResult result = { false, 0, 0, 0, 0, -1, -1, 0, 0, 0 };
+
+        SimSrand(csim, config.Seed);
+
+        csim->RandMaxInsnDelay = config.MaxInsnDelay;
+
+        // Random initial architectural state
+        std::vector<uint64_t> values(csim->Geometry.GetARFSize());
+
+        RandRegValues(csim, values.data(), values.size());
+
+        for (int i = 0; i < csim->Geometry.GetARFSize(); i++)
+        {
+            SetRefARF(csim, i, values[i]);
+            SetO3ARFAndEval(csim, i, values[i]);
+        }
+
+        PushRandomInsns(csim, config.InsnCount);
+
+        //
+        auto start = std::chrono::steady_clock::now();
+
+        bool evaluated = true;
+
+        do
+        {
+            result.Steps++;
+
+            if (!EvalO3(csim, false, result.Steps) || !EvalRef(csim, false, result.Steps))
+            {
+                evaluated = false;
+                break;
+            }
+
+            csim->InsnMemory.Release(min(csim->O3PC, csim->RefPC));
+
+            if (config.MaxSteps && result.Steps >= config.MaxSteps)
+            {
+                evaluated = false;
+                break;
+            }
+        }
+        while (!IsRefAllIdle(csim) || !IsO3AllIdle(csim));
+
+        result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        result.O3CommitCount            = csim->O3CommitCount;
+        result.O3ROBCountMax            = csim->O3ROBCountMax;
+        result.O3ReservationCountMax    = csim->O3ReservationCountMax;
+
+        if (!evaluated)
+        {
+            result.MismatchStep = result.Steps;
+            return result;
+        }
+
+        // Compare architectural state
+        for (int i = 0; i < csim->Geometry.GetARFSize(); i++)
+        {
+            uint64_t o3  = GetO3ARF(csim, i);
+            uint64_t ref = GetRefARF(csim, i);
+
+            if (o3 != ref)
+            {
+                result.MismatchStep     = result.Steps;
+                result.MismatchARF      = i;
+                result.MismatchO3Value  = o3;
+                result.MismatchRefValue = ref;
+
+                return result;
+            }
+        }
+
+        result.Passed = true;
+
+        return result;
+    }
+}
+
+
 // VMC Core commands
 namespace VMC::Core {
 
@@ -1355,6 +1806,7 @@ namespace VMC::Core {
     std::cout << "- rat0.arf0conv [true|false]        Toggle ARF0-zero conversion (\'true\' by default)" << std::endl; \
     std::cout << "- rat0.rand.reg.value [(uint)max_value|@DEFAULT]" << std::endl; \
     std::cout << "                                    Get/set the maximum value of random register value" << std::endl; \
+    std::cout << "- rat0.rand.seed <seed|$time>       Set random seed of current simulation context" << std::endl; \
     std::cout << "- rat0.rand.reg.index [(uint)max_value|@DEFAULT]" << std::endl; \
     std::cout << "                                    Get/set the maximum value of random register index" << std::endl; \
     std::cout << "- rat0.prf.ls [-V|+V|-NRA|+NRA|-FV|+FV|-Z|+Z] " << std::endl; \
@@ -1374,6 +1826,8 @@ namespace VMC::Core {
     std::cout << "                                    Push a specified instruction" << std::endl; \
     std::cout << "- rat0.diffsim.insn.push.random <count>" << std::endl; \
     std::cout << "                                    Push specified count of random instructions" << std::endl; \
+    std::cout << "- rat0.diffsim.insn.save <filename> Save pushed instructions to program file" << std::endl; \
+    std::cout << "- rat0.diffsim.insn.load <filename> Stream instructions from program file on fetch" << std::endl; \
     std::cout << "- rat0.diffsim.insn.eval.step       Differential evaluate Core by one step" << std::endl; \
     std::cout << "- rat0.diffsim.insn.eval.stepout [-SF|-WWDG|-T <count>]" << std::endl; \
     std::cout << "                                    Differential evaluate Core with all instructions or specified steps" << std::endl; \
@@ -1381,9 +1835,18 @@ namespace VMC::Core {
     std::cout << "                                    Dump history instructions." << std::endl; \
     std::cout << "- rat0.diffsim.insn.dumpfile <filename> [-R|-range <startFID> <endFID>]" << std::endl; \
     std::cout << "                                    Dump history instructions to file." << std::endl; \
+    std::cout << "- rat0.diffsim.history.capacity [(uint)count|@DEFAULT]" << std::endl; \
+    std::cout << "                                    Get/set the count of history instructions kept for dump" << std::endl; \
+    std::cout << "- rat0.diffsim.history.spill <prefix|@OFF>" << std::endl; \
+    std::cout << "                                    Spill history instructions out of capacity to log files" << std::endl; \
     std::cout << "- rat0.diffsim.o3.scoreboard.dump   Dump all current O3Scoreboard entries." << std::endl; \
     std::cout << "- rat0.diffsim.o3.reservation.dump  Dump all current O3Reservation entries." << std::endl; \
     std::cout << "- rat0.diffsim.o3.rob.dump          Dump all current O3ReOrderBuffer entries." << std::endl; \
+    std::cout << "- rat0.diffsim.stats [-csv|-json] [filename]" << std::endl; \
+    std::cout << "                                    Print/export O3 stall, occupancy and IPC statistics" << std::endl; \
+    std::cout << "- rat0.diffsim.stats.window [(uint)cycles|@DEFAULT]" << std::endl; \
+    std::cout << "                                    Get/set the sliding window of O3 IPC statistics" << std::endl; \
+    std::cout << "- rat0.diffsim.stats.reset          Reset O3 statistics." << std::endl; \
 
 
     // rat0.infobystep [true|false]
@@ -1399,12 +1862,12 @@ namespace VMC::Core {
 
         if (!params.empty())
         {
-            std::istringstream(params[0]) >> std::boolalpha >> GetCurrentHandle()->FlagStepInfo;
+            std::istringstream(params[0]) >> std::boolalpha >> GetCurrentHandle(handle)->FlagStepInfo;
             std::cout << "Set: ";
         }
 
         std::cout << "RAT0.flag.stepinfo = ";
-        std::cout << GetCurrentHandle()->FlagStepInfo << std::endl;
+        std::cout << GetCurrentHandle(handle)->FlagStepInfo << std::endl;
 
         return true;
     }
@@ -1422,12 +1885,12 @@ namespace VMC::Core {
 
         if (!params.empty())
         {
-            std::istringstream(params[0]) >> std::boolalpha >> GetCurrentHandle()->FlagARF0Conv;
+            std::istringstream(params[0]) >> std::boolalpha >> GetCurrentHandle(handle)->FlagARF0Conv;
             std::cout << "Set: ";
         }
 
         std::cout << "RAT0.flag.arf0conv = ";
-        std::cout << GetCurrentHandle()->FlagARF0Conv << std::endl;
+        std::cout << GetCurrentHandle(handle)->FlagARF0Conv << std::endl;
 
         return true;
     }
@@ -1459,19 +1922,45 @@ namespace VMC::Core {
                 return false;
             }
 
-            GetCurrentHandle()->RandMaxRegValue = val;
+            GetCurrentHandle(handle)->RandMaxRegValue = val;
 
             std::cout << "Set: ";
         }
 
         std::cout << "RAT0.rand.max.regvalue = ";
-        printf("%lu (0x%016lx) ", GetCurrentHandle()->RandMaxRegValue, GetCurrentHandle()->RandMaxRegValue);
+        printf("%lu (0x%016lx) ", GetCurrentHandle(handle)->RandMaxRegValue, GetCurrentHandle(handle)->RandMaxRegValue);
         printf(" [Max %lu (0x%016lx)]\n", RAND_MAX_REG_VALUE_MAX, RAND_MAX_REG_VALUE_MAX);
 
         return true;
     }
 
 
+    // rat0.rand.seed <seed|$time>
+    bool _RAT0_RAND_SEED(void* handle, const std::string& cmd,
+                                       const std::string& paramline,
+                                       const std::vector<std::string>& params)
+    {
+        if (params.size() != 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.rand.seed\'." << std::endl;
+            return false;
+        }
+
+        uint64_t seed;
+
+        if (params[0].compare("$time") == 0)
+            seed = time(NULL);
+        else
+            std::istringstream(params[0]) >> seed;
+
+        SimSrand(GetCurrentHandle(handle), seed);
+
+        printf("RAT0 random seed set: %lu (0x%016lx)\n", seed, seed);
+
+        return true;
+    }
+
+
     // rat0.rand.reg.index [max_value|@DEFAULT]
     bool _RAT0_RAND_REG_INDEX(void* handle, const std::string& cmd,
                                             const std::string& paramline,
@@ -1507,13 +1996,13 @@ namespace VMC::Core {
                 return false;
             }
 
-            GetCurrentHandle()->RandMaxRegIndex = uval;
+            GetCurrentHandle(handle)->RandMaxRegIndex = uval;
 
             std::cout << "Set: ";
         }
 
         std::cout << "RAT0.rand.max.regindex = ";
-        printf("%u (0x%08x) ", GetCurrentHandle()->RandMaxRegIndex, GetCurrentHandle()->RandMaxRegIndex);
+        printf("%u (0x%08x) ", GetCurrentHandle(handle)->RandMaxRegIndex, GetCurrentHandle(handle)->RandMaxRegIndex);
         printf(" [Max %u (0x%08x)]\n", RAND_MAX_REG_INDEX_MAX, RAND_MAX_REG_INDEX_MAX);
 
         return true;
@@ -1558,13 +2047,13 @@ namespace VMC::Core {
         for (int i = 0; i < EMULATED_ARF_SIZE; i++)
         {
             if (nonzero)
-                if (!GetRefARF(GetCurrentHandle(), i))
+                if (!GetRefARF(GetCurrentHandle(handle), i))
                     continue;
 
             std::cout << "rARF         ";
             printf("%3d", i);
             std::cout << "           ";
-            printf("0x%016lx\n", GetRefARF(GetCurrentHandle(), i));
+            printf("0x%016lx\n", GetRefARF(GetCurrentHandle(handle), i));
         }
 
         return true;
@@ -1579,7 +2068,7 @@ namespace VMC::Core {
         bool filterZ = false;
         bool filterU = false;
 
-        for (int i = 0; i < params.size(); i++)
+        for (size_t i = 0; i < params.size(); i++)
         {
             std::string param = params[i];
 
@@ -1594,7 +2083,7 @@ namespace VMC::Core {
             }
         }
 
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         if (filterZ)
             std::cout << "('-Z': Listing all non-zero ARFs)" << std::endl;
@@ -1607,8 +2096,8 @@ namespace VMC::Core {
 
         for (int i = 0; i < EMULATED_ARF_SIZE; i++)
         {
-            bool mapped;
-            int  mappedPRF;
+            bool mapped    = false;
+            int  mappedPRF = -1;
 
             uint64_t val = GetO3ARF(csim, i, &mapped, &mappedPRF);
             uint64_t ref = GetRefARF(csim, i);
@@ -1652,7 +2141,7 @@ namespace VMC::Core {
                         bool flagS, bool flagNEQ)
     {
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(vmc);
 
         int prf = -1;
 
@@ -1700,7 +2189,7 @@ namespace VMC::Core {
         bool flagS   = false;
         bool flagNEQ = false;
 
-        for (int i = param_offset; i < params.size(); i++)
+        for (size_t i = param_offset; i < params.size(); i++)
         {
             std::string param = params[i];
 
@@ -1759,7 +2248,7 @@ namespace VMC::Core {
         uint64_t value;
 
         std::istringstream(params[0]) >> index;
-        value = RandRegValue(GetCurrentHandle());
+        value = RandRegValue(GetCurrentHandle(handle));
 
         //
         return _common_RAT0_ARF_SET_EX((VMCHandle) handle, index, value, params, 1);
@@ -1775,8 +2264,8 @@ namespace VMC::Core {
         int      index;
         uint64_t value;
 
-        index = RandRegIndex(GetCurrentHandle());
-        value = RandRegValue(GetCurrentHandle());
+        index = RandRegIndex(GetCurrentHandle(handle));
+        value = RandRegValue(GetCurrentHandle(handle));
 
         //
         return _common_RAT0_ARF_SET_EX((VMCHandle) handle, index, value, params, 0);
@@ -1791,7 +2280,7 @@ namespace VMC::Core {
         for (int i = 0; i < EMULATED_ARF_SIZE; i++)
         {
             int      index = i;
-            uint64_t value = RandRegValue(GetCurrentHandle());
+            uint64_t value = RandRegValue(GetCurrentHandle(handle));
 
             if (!_common_RAT0_ARF_SET_EX((VMCHandle) handle, index, value, params, 0))
                 return false;
@@ -1821,7 +2310,7 @@ namespace VMC::Core {
         int index;
         std::istringstream(params[0]) >> index;
 
-        for (int i = 1; i < params.size(); i++)
+        for (size_t i = 1; i < params.size(); i++)
         {
             std::string param = params[i];
 
@@ -1839,13 +2328,13 @@ namespace VMC::Core {
         }
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         uint64_t ref;
         uint64_t val;
 
-        bool mapped;
-        int  mappedPRF;
+        bool mapped    = false;
+        int  mappedPRF = -1;
 
         ref = GetRefARF(csim, index);
         val = GetO3ARF(csim, index, &mapped, &mappedPRF);
@@ -1885,11 +2374,11 @@ namespace VMC::Core {
                                     const std::string& paramline,
                                     const std::vector<std::string>& params)
     {
-        bool enFilterV   = false, filterV;
-        bool enFilterNRA = false, filterNRA;
+        bool enFilterV   = false, filterV   = false;
+        bool enFilterNRA = false, filterNRA = false;
         bool enFilterZ   = false, filterZ;
 
-        for (int i = 0; i < params.size(); i++)
+        for (size_t i = 0; i < params.size(); i++)
         {
             std::string param = params[i];
 
@@ -1964,7 +2453,7 @@ namespace VMC::Core {
         std::cout << "PRF        ARF        V        NRA        FV        FID         Value" << std::endl;
         std::cout << "-----      -----      ---      -----      ----      ------      ------------------" << std::endl;
 
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
         for (int i = 0; i < csim->O3RAT.GetSize(); i++)
         {
             const RegisterAliasTable::Entry& entry = csim->O3RAT.GetEntry(i);
@@ -1982,8 +2471,8 @@ namespace VMC::Core {
             printf("%-5d      ", entry.GetARF());
             printf("%-3d      ", entry.GetValid());
             printf("%-5d      ", entry.GetNRA());
-            printf("%-4d      ", entry.GetFV());
-            printf("%-6d      ", entry.GetFID());
+            printf("%-4d      ", csim->O3RATScoreboard.IsBusy(i));
+            printf("%-6d      ", csim->O3Scoreboard.GetFID(i));
             printf("0x%016lx\n"  , entry.GetValue(csim->O3PRF));
         }
 
@@ -2006,7 +2495,7 @@ namespace VMC::Core {
         std::istringstream(params[0]) >> count;
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         int i = 0;
         for (; i < count; i++)
@@ -2167,7 +2656,7 @@ namespace VMC::Core {
             ;
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
         int FID = NextFID(csim);
 
         SimInstruction insn(FID, delay, insncode, dstARF, srcARF1, srcARF2, imm);
@@ -2188,44 +2677,25 @@ namespace VMC::Core {
             return false;
         }
 
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         int count;
         std::istringstream(params[0]) >> count;
 
-        for (int i = 0; i < count; i++)
+        if (!csim->FlagStepInfo)
         {
-            int FID = NextFID(csim);
-
-            int      insncode = INSN_CODE_NOP;
-            int      delay    = 0;
-            int      dstARF   = 0;
-            int      srcARF1  = 0;
-            int      srcARF2  = 0;
-            uint64_t imm      = 0;
-
-            //
-            insncode = RandInsn(csim);
-            
-            //
-            delay = RandInsnDelay(csim);
-
-            //
-            dstARF = RandRegIndex(csim);
-
-            // 
-            srcARF1 = RandRegIndex(csim);
-            srcARF2 = RandRegIndex(csim);
-
-            //
-            imm = RandRegValue(csim); // stub
+            PushRandomInsns(csim, count);
+            return true;
+        }
 
-            //
-            SimInstruction insn(FID, delay, insncode, dstARF, srcARF1, srcARF2, imm);
+        for (int i = 0; i < count; i++)
+        {
+            SimInstruction insn = NewRandomInsn(csim);
 
             if (csim->FlagStepInfo)
                 printf("[ %8d ] FID: %d, Delay: %d, Insncode: 0x%08x, DstARF: %d, SrcARF1: %d, SrcARF2: %d, Imm: %lu (0x%016lx)\n",
-                    i, FID, delay, insncode, dstARF, srcARF1, srcARF2, imm, imm);
+                    i, insn.GetFID(), insn.GetDelay(), insn.GetInsnCode(), 
+                    insn.GetDstARF(), insn.GetSrc1ARF(), insn.GetSrc2ARF(), insn.GetImmediate(), insn.GetImmediate());
 
             csim->InsnMemory.PushInsn(insn);
         }
@@ -2234,17 +2704,66 @@ namespace VMC::Core {
     }
 
 
-    //
-    bool __common_RAT0_DIFFSIM_INSN_EVAL(bool info, int step = 0)
+    // rat0.diffsim.insn.save <filename>
+    bool _RAT0_DIFFSIM_INSN_SAVE(void* handle, const std::string& cmd,
+                                               const std::string& paramline,
+                                               const std::vector<std::string>& params)
+    {
+        if (params.size() != 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.insn.save\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        if (!csim->InsnMemory.Save(params[0].c_str()))
+        {
+            std::cout << "Failed to open or write file, or streamed instructions already released." << std::endl;
+            return false;
+        }
+
+        std::cout << csim->InsnMemory.GetPosition() << " instruction(s) saved." << std::endl;
+
+        return true;
+    }
+
+    // rat0.diffsim.insn.load <filename>
+    bool _RAT0_DIFFSIM_INSN_LOAD(void* handle, const std::string& cmd,
+                                               const std::string& paramline,
+                                               const std::vector<std::string>& params)
+    {
+        if (params.size() != 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.insn.load\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        // *NOTICE: Instructions are appended after the pushed ones while fetching
+        if (!csim->InsnMemory.OpenStream(params[0].c_str()))
+        {
+            std::cout << "Failed to open file." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+
+    //
+    bool __common_RAT0_DIFFSIM_INSN_EVAL(SimHandle csim, bool info, int step = 0)
     {
-        SimHandle csim = GetCurrentHandle();
-
         // O3 (out-of-order) datapath
         bool O3 = EvalO3(csim, info, step);
 
         // Ref (in-order) datapath
         bool Ref = EvalRef(csim, info, step);
 
+        // Both datapaths fetched past, never read again
+        csim->InsnMemory.Release(min(csim->O3PC, csim->RefPC));
+
         return O3 && Ref;
     }
 
@@ -2323,15 +2842,32 @@ namespace VMC::Core {
     }
 
     //
-    inline void __common_RAT0_DIFFSIM_RESERVATION_DUMP(const SimReservation::Entry& entry,
+    inline void __common_RAT0_DIFFSIM_RESERVATION_DUMP(SimHandle csim,
+                                                       int index,
                                                        std::ostream& os)
     {
-        os << "DST_READY(" << entry.IsDstReady()  << ") ";
-        os << "S1_READY("  << entry.IsSrc1Ready() << ") ";
-        os << "S2_READY("  << entry.IsSrc2Ready() << ") ";
-        __common_RAT0_DIFFSIM_INSN_DUMP(entry.GetInsn(), os);
+        os << "SLOT(" << std::setw(3) << std::setfill(' ') << index << ") ";
+        os << "S1_READY(" << csim->O3Reservation.IsSrc1Ready(index) << ") ";
+        os << "S2_READY(" << csim->O3Reservation.IsSrc2Ready(index) << ") ";
+        __common_RAT0_DIFFSIM_INSN_DUMP(csim->O3ReservationInsn[index], os);
     } 
 
+    // valid O3Reservation slots, oldest first
+    inline std::vector<int> __common_RAT0_DIFFSIM_RESERVATION_SLOTS(SimHandle csim)
+    {
+        std::vector<int> slots;
+
+        for (int i = 0; i < csim->O3Reservation.GetSize(); i++)
+            if (csim->O3Reservation.IsValid(i))
+                slots.push_back(i);
+
+        std::sort(slots.begin(), slots.end(), [csim] (int a, int b) {
+            return csim->O3Reservation.GetFID(a) < csim->O3Reservation.GetFID(b);
+        });
+
+        return slots;
+    }
+
     // 
     inline void __common_RAT0_DIFFSIM_SCOREBOARD_DUMP(SimHandle csim,
                                                       int index)
@@ -2347,7 +2883,7 @@ namespace VMC::Core {
                                                     const std::string& paramline,
                                                     const std::vector<std::string>& params)
     {
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         if (!csim->FlagARF0Conv)
         {
@@ -2361,7 +2897,7 @@ namespace VMC::Core {
             return false;
         }
 
-        if (!__common_RAT0_DIFFSIM_INSN_EVAL(csim->FlagStepInfo))
+        if (!__common_RAT0_DIFFSIM_INSN_EVAL(csim, csim->FlagStepInfo))
         {
             std::cout << "Eval failure." << std::endl;
             return false;
@@ -2381,7 +2917,7 @@ namespace VMC::Core {
     {
         // TODO: implement flag -SF if further debug required
 
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         if (!csim->FlagARF0Conv)
         {
@@ -2394,7 +2930,7 @@ namespace VMC::Core {
 
         int varT = 0;
 
-        for (int i = 0; i < params.size(); i++)
+        for (size_t i = 0; i < params.size(); i++)
         {
             std::string param = params[i];
 
@@ -2450,22 +2986,22 @@ namespace VMC::Core {
         else
         {
             //
-            insncnt = csim->RefFetch.GetCount();
+            insncnt = csim->InsnMemory.GetPosition() - csim->RefPC;
 
             while (insncnt /= 10)
                 insncnt_digit++;
 
             //
-            insncnt = csim->RefFetch.GetCount();
+            insncnt = csim->InsnMemory.GetPosition() - csim->RefPC;
 
-            std::cout << "Instruction count " << insncnt << " in total in fetch queue." << std::endl;
+            std::cout << "Instruction count " << insncnt << " in total in instruction memory." << std::endl;
         }
 
         do 
         {
             step++;
 
-            if (!__common_RAT0_DIFFSIM_INSN_EVAL(csim->FlagStepInfo, step))
+            if (!__common_RAT0_DIFFSIM_INSN_EVAL(csim, csim->FlagStepInfo, step))
             {
                 std::cout << "Eval failure at step " << step << "." << std::endl;
                 return false;
@@ -2494,20 +3030,18 @@ namespace VMC::Core {
                 std::cout << "[ \033[1;33mWARN\033[0m     ] EvalO3 might be in dead loop. Stopped step-out process." << std::endl;
 
                 //
-                std::cout << "[ \033[1;33mWARN\033[0m     ] Dump O3Fetch entries." << std::endl;
+                std::cout << "[ \033[1;33mWARN\033[0m     ] Dump O3Fetch entry." << std::endl;
 
-                std::list<SimInstruction> o3fetch = csim->O3Fetch.Get();
-                std::list<SimInstruction>::const_iterator o3fetch_iter = o3fetch.begin();
-                for (; o3fetch_iter != o3fetch.end(); o3fetch_iter++)
+                if (csim->InsnMemory.HasInsn(csim->O3PC))
                 {
                     std::cout << "[ \033[1;33mWARN\033[0m     ] - ";
-                    __common_RAT0_DIFFSIM_INSN_DUMP(SimFetchedInstruction(*o3fetch_iter), std::cout);
+                    __common_RAT0_DIFFSIM_INSN_DUMP(SimFetchedInstruction(csim->InsnMemory.GetInsn(csim->O3PC)), std::cout);
                 }
 
                 //
                 std::cout << "[ \033[1;33mWARN\033[0m     ] Dump O3Scoreboard entries." << std::endl;
 
-                for (int i = 0; i < EMULATED_PRF_SIZE; i++)
+                for (int i = 0; i < csim->O3Scoreboard.GetSize(); i++)
                 {
                     if (csim->O3Scoreboard.IsBusy(i))
                     {
@@ -2519,12 +3053,10 @@ namespace VMC::Core {
                 //
                 std::cout << "[ \033[1;33mWARN\033[0m     ] Dump O3Reservation entries." << std::endl;
 
-                std::list<SimReservation::Entry> o3reservation = csim->O3Reservation.Get();
-                std::list<SimReservation::Entry>::const_iterator o3reservation_iter = o3reservation.begin();
-                for (; o3reservation_iter != o3reservation.end(); o3reservation_iter++)
+                for (int slot : __common_RAT0_DIFFSIM_RESERVATION_SLOTS(csim))
                 {
                     std::cout << "[ \033[1;33mWARN\033[0m     ] - ";
-                    __common_RAT0_DIFFSIM_RESERVATION_DUMP(*o3reservation_iter, std::cout);
+                    __common_RAT0_DIFFSIM_RESERVATION_DUMP(csim, slot, std::cout);
                 }
 
                 //
@@ -2623,7 +3155,8 @@ namespace VMC::Core {
 
 
     //
-    bool __common_RAT0_DIFFSIM_INSN_DUMP_EX(int offset, 
+    bool __common_RAT0_DIFFSIM_INSN_DUMP_EX(SimHandle csim,
+                                            int offset, 
                                             const std::vector<std::string>& params,
                                             std::ostream& os)
     {
@@ -2633,7 +3166,7 @@ namespace VMC::Core {
         int startFID = 0;
         int endFID   = 0;
         
-        for (int i = offset; i < params.size(); i++)
+        for (size_t i = offset; i < params.size(); i++)
         {
             std::string param = params[i];
             
@@ -2663,24 +3196,22 @@ namespace VMC::Core {
             }
         }
 
-        //
-        SimHandle csim = GetCurrentHandle();
-
+        // *NOTICE: Only the last instructions kept in history ring are available
         if (flagR)
         {
-            const std::vector<SimFetchedInstruction>& history 
+            const SimHistory<SimFetchedInstruction>& history 
                 = csim->RenamedHistory;
 
-            for (int i = startFID; (i < history.size()) && (!flagRange || i <= endFID); i++)
-                __common_RAT0_DIFFSIM_INSN_DUMP(history[i], os);
+            for (uint64_t i = max<uint64_t>(startFID, history.GetBegin()); (i < history.GetTotal()) && (!flagRange || i <= (uint64_t) endFID); i++)
+                __common_RAT0_DIFFSIM_INSN_DUMP(history.Get(i), os);
         }
         else
         {
-            const std::vector<SimInstruction>& history
+            const SimHistory<SimInstruction>& history
                 = csim->FetchHistory;
 
-            for (int i = startFID; (i < history.size()) && (!flagRange || i <= endFID); i++)
-                __common_RAT0_DIFFSIM_INSN_DUMP(SimFetchedInstruction(history[i]), os);
+            for (uint64_t i = max<uint64_t>(startFID, history.GetBegin()); (i < history.GetTotal()) && (!flagRange || i <= (uint64_t) endFID); i++)
+                __common_RAT0_DIFFSIM_INSN_DUMP(SimFetchedInstruction(history.Get(i)), os);
         }
 
         return true;
@@ -2692,7 +3223,7 @@ namespace VMC::Core {
                                                const std::string& paramline,
                                                const std::vector<std::string>& params)
     {
-        return __common_RAT0_DIFFSIM_INSN_DUMP_EX(0, params, std::cout);
+        return __common_RAT0_DIFFSIM_INSN_DUMP_EX(GetCurrentHandle(handle), 0, params, std::cout);
     }
 
 
@@ -2715,7 +3246,7 @@ namespace VMC::Core {
             return false;
         }
 
-        bool result = __common_RAT0_DIFFSIM_INSN_DUMP_EX(0, params, fos);
+        bool result = __common_RAT0_DIFFSIM_INSN_DUMP_EX(GetCurrentHandle(handle), 1, params, fos);
 
         fos.close();
 
@@ -2723,6 +3254,194 @@ namespace VMC::Core {
     }
 
 
+    // rat0.diffsim.history.capacity [(uint)count|@DEFAULT]
+    bool _RAT0_DIFFSIM_HISTORY_CAPACITY(void* handle, const std::string& cmd,
+                                                      const std::string& paramline,
+                                                      const std::vector<std::string>& params)
+    {
+        if (params.size() > 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.history.capacity\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        if (!params.empty())
+        {
+            int val = -1;
+
+            if (params[0].compare("@DEFAULT") == 0)
+                val = SIM_DEFAULT_HISTORY_CAPACITY;
+            else
+                std::istringstream(params[0]) >> val;
+
+            if (val <= 0)
+            {
+                std::cout << "Param 0 \'" << params[0] << "\' is not a positive integer." << std::endl;
+                return false;
+            }
+
+            // *NOTICE: Resizing drops all history instructions
+            csim->FetchHistory  .Resize(val);
+            csim->RenamedHistory.Resize(val);
+
+            std::cout << "Set: ";
+        }
+
+        std::cout << "RAT0.diffsim.history.capacity = " << csim->FetchHistory.GetCapacity() << std::endl;
+
+        return true;
+    }
+
+    // rat0.diffsim.history.spill <prefix|@OFF>
+    bool _RAT0_DIFFSIM_HISTORY_SPILL(void* handle, const std::string& cmd,
+                                                   const std::string& paramline,
+                                                   const std::vector<std::string>& params)
+    {
+        if (params.size() != 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.history.spill\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        if (params[0].compare("@OFF") == 0)
+        {
+            csim->FetchHistory  .CloseSpill();
+            csim->RenamedHistory.CloseSpill();
+
+            return true;
+        }
+
+        if (!csim->FetchHistory  .OpenSpill((params[0] + ".fetch.log"  ).c_str())
+         || !csim->RenamedHistory.OpenSpill((params[0] + ".renamed.log").c_str()))
+        {
+            csim->FetchHistory  .CloseSpill();
+            csim->RenamedHistory.CloseSpill();
+
+            std::cout << "Failed to open or create spill log file." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+
+    // rat0.diffsim.stats [-csv|-json] [filename]
+    bool _RAT0_DIFFSIM_STATS(void* handle, const std::string& cmd,
+                                           const std::string& paramline,
+                                           const std::vector<std::string>& params)
+    {
+        if (params.size() > 2)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.stats\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        if (params.empty())
+        {
+            csim->O3Stats.Print(std::cout);
+            return true;
+        }
+
+        bool json;
+
+        if (params[0].compare("-csv") == 0)
+            json = false;
+        else if (params[0].compare("-json") == 0)
+            json = true;
+        else
+        {
+            std::cout << "Unknown format \'" << params[0] << "\' for \'rat0.diffsim.stats\'." << std::endl;
+            return false;
+        }
+
+        if (params.size() == 1)
+        {
+            if (json)
+                csim->O3Stats.WriteJSON(std::cout);
+            else
+                csim->O3Stats.WriteCSV(std::cout);
+
+            return true;
+        }
+
+        std::ofstream fout(params[1]);
+
+        if (!fout)
+        {
+            std::cout << "Failed to open or create file \'" << params[1] << "\'." << std::endl;
+            return false;
+        }
+
+        if (json)
+            csim->O3Stats.WriteJSON(fout);
+        else
+            csim->O3Stats.WriteCSV(fout);
+
+        return true;
+    }
+
+    // rat0.diffsim.stats.window [(uint)cycles|@DEFAULT]
+    bool _RAT0_DIFFSIM_STATS_WINDOW(void* handle, const std::string& cmd,
+                                                  const std::string& paramline,
+                                                  const std::vector<std::string>& params)
+    {
+        if (params.size() > 1)
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.stats.window\'." << std::endl;
+            return false;
+        }
+
+        SimHandle csim = GetCurrentHandle(handle);
+
+        if (!params.empty())
+        {
+            int val = -1;
+
+            if (params[0].compare("@DEFAULT") == 0)
+                val = SIM_DEFAULT_STATS_WINDOW;
+            else
+                std::istringstream(params[0]) >> val;
+
+            if (val <= 0)
+            {
+                std::cout << "Param 0 \'" << params[0] << "\' is not a positive integer." << std::endl;
+                return false;
+            }
+
+            // *NOTICE: Resizing drops all window samples
+            csim->O3Stats.SetWindow(val);
+
+            std::cout << "Set: ";
+        }
+
+        std::cout << "RAT0.diffsim.stats.window = " << csim->O3Stats.GetWindow() << std::endl;
+
+        return true;
+    }
+
+    // rat0.diffsim.stats.reset
+    bool _RAT0_DIFFSIM_STATS_RESET(void* handle, const std::string& cmd,
+                                                 const std::string& paramline,
+                                                 const std::vector<std::string>& params)
+    {
+        if (!params.empty())
+        {
+            std::cout << "Too much or too less parameter(s) for \'rat0.diffsim.stats.reset\'." << std::endl;
+            return false;
+        }
+
+        GetCurrentHandle(handle)->O3Stats.Reset();
+
+        return true;
+    }
+
+
     // rat0.diffsim.o3.rob.dump
     bool _RAT0_DIFFSIM_O3_ROB_DUMP(void* handle, const std::string& cmd,
                                                  const std::string& paramline,
@@ -2735,9 +3454,8 @@ namespace VMC::Core {
         }
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
-        //
         const std::list<SimReOrderBuffer::Entry>& entries = csim->O3ROB.Get();
 
         std::list<SimReOrderBuffer::Entry>::const_iterator iter = entries.begin();
@@ -2760,14 +3478,11 @@ namespace VMC::Core {
         }
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         //
-        const std::list<SimReservation::Entry>& entries = csim->O3Reservation.Get();
-
-        std::list<SimReservation::Entry>::const_iterator iter = entries.begin();
-        for (; iter != entries.end(); iter++)
-            __common_RAT0_DIFFSIM_RESERVATION_DUMP(*iter, std::cout);
+        for (int slot : __common_RAT0_DIFFSIM_RESERVATION_SLOTS(csim))
+            __common_RAT0_DIFFSIM_RESERVATION_DUMP(csim, slot, std::cout);
 
         return true;
     }
@@ -2785,10 +3500,10 @@ namespace VMC::Core {
         }
 
         //
-        SimHandle csim = GetCurrentHandle();
+        SimHandle csim = GetCurrentHandle(handle);
 
         //
-        for (int i = 0; i < EMULATED_PRF_SIZE; i++)
+        for (int i = 0; i < csim->O3Scoreboard.GetSize(); i++)
         {
             if (csim->O3Scoreboard.IsBusy(i))
                 __common_RAT0_DIFFSIM_SCOREBOARD_DUMP(csim, i);
@@ -2804,6 +3519,7 @@ namespace VMC::Core {
         RegisterCommand(handle, CommandHandler{ std::string("rat0.infobystep")                  , &_RAT0_INFOBYSTEP });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.arf0conv")                    , &_RAT0_ARF0CONV });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.rand.reg.value")              , &_RAT0_RAND_REG_VALUE });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.rand.seed")                   , &_RAT0_RAND_SEED });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.rand.reg.index")              , &_RAT0_RAND_REG_INDEX });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.prf.ls")                      , &_RAT0_PRF_LS });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.arf.ls.ref")                  , &_RAT0_ARF_LS_REF });
@@ -2816,10 +3532,17 @@ namespace VMC::Core {
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.arf.set.random")      , &_RAT0_DIFFSIM_ARF_SET_RANDOM });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.push")           , &_RAT0_DIFFSIM_INSN_PUSH });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.push.random")    , &_RAT0_DIFFSIM_INSN_PUSH_RANDOM });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.save")           , &_RAT0_DIFFSIM_INSN_SAVE });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.load")           , &_RAT0_DIFFSIM_INSN_LOAD });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.eval.step")      , &_RAT0_DIFFSIM_INSN_EVAL_STEP });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.eval.stepout")   , &_RAT0_DIFFSIM_INSN_EVAL_STEPOUT });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.dump")           , &_RAT0_DIFFSIM_INSN_DUMP });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.insn.dumpfile")       , &_RAT0_DIFFSIM_INSN_DUMPFILE });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.history.capacity")    , &_RAT0_DIFFSIM_HISTORY_CAPACITY });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.history.spill")       , &_RAT0_DIFFSIM_HISTORY_SPILL });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.stats")               , &_RAT0_DIFFSIM_STATS });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.stats.window")        , &_RAT0_DIFFSIM_STATS_WINDOW });
+        RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.stats.reset")         , &_RAT0_DIFFSIM_STATS_RESET });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.o3.rob.dump")         , &_RAT0_DIFFSIM_O3_ROB_DUMP });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.o3.reservation.dump") , &_RAT0_DIFFSIM_O3_RESERVATION_DUMP });
         RegisterCommand(handle, CommandHandler{ std::string("rat0.diffsim.o3.scoreboard.dump")  , &_RAT0_DIFFSIM_O3_SCOREBOARD_DUMP });
@@ -2961,6 +3684,328 @@ namespace VMC::Core {
 };
 
 
+// class VMC::Core::SimO3Statistics
+namespace VMC::Core {
+    /*
+    int                     window;
+
+    uint64_t                cycles;
+    uint64_t                commits;
+
+    uint64_t                stage_cycles[SIM_O3_STAGE_COUNT][SIM_O3_STALL_COUNT];
+
+    std::vector<uint64_t>   rob_histogram;
+    std::vector<uint64_t>   reservation_histogram;
+    std::vector<uint64_t>   freelist_histogram;
+
+    std::vector<uint8_t>    window_commits;
+    uint64_t                window_cycles;
+    int                     window_sum;
+    int                     cycle_commits;
+
+    double                  window_ipc_min;
+    double                  window_ipc_max;
+    std::vector<double>     window_ipc;
+    */
+
+    static const char* const SIM_O3_STAGE_NAMES[SIM_O3_STAGE_COUNT] = {
+        "fetch", "issue", "writeback", "commit"
+    };
+
+    static const char* const SIM_O3_STALL_NAMES[SIM_O3_STALL_COUNT] = {
+        "busy", "idle", "fetch_stall", "rat_full", "rob_full", "scoreboard", "execution", "commit_wait"
+    };
+
+    SimO3Statistics::SimO3Statistics(const CoreGeometry& geometry, int window)
+        : window                (window)
+        , rob_histogram         (geometry.GetROBSize() + 1)
+        , reservation_histogram (geometry.GetROBSize() + 1)
+        , freelist_histogram    (geometry.GetPRFSize() + 1)
+        , window_commits        (window)
+    {
+        Reset();
+    }
+
+    SimO3Statistics::~SimO3Statistics()
+    { }
+
+    inline void SimO3Statistics::Sample(std::vector<uint64_t>& histogram, int value)
+    {
+        // Out-of-range occupancy falls into the last bucket
+        if (value < 0)
+            value = 0;
+        else if (value >= (int) histogram.size())
+            value = histogram.size() - 1;
+
+        histogram[value]++;
+    }
+
+    inline const char* SimO3Statistics::GetStageName(int stage)
+    {
+        return SIM_O3_STAGE_NAMES[stage];
+    }
+
+    inline const char* SimO3Statistics::GetStallName(int reason)
+    {
+        return SIM_O3_STALL_NAMES[reason];
+    }
+
+    inline int SimO3Statistics::GetWindow() const
+    {
+        return window;
+    }
+
+    void SimO3Statistics::SetWindow(int window)
+    {
+        // *NOTICE: Resizing drops all window samples
+        this->window = window;
+
+        window_commits.assign(window, 0);
+        window_cycles = 0;
+        window_sum = 0;
+
+        window_ipc_min = 0;
+        window_ipc_max = 0;
+        window_ipc.clear();
+    }
+
+    inline uint64_t SimO3Statistics::GetCycles() const
+    {
+        return cycles;
+    }
+
+    inline uint64_t SimO3Statistics::GetCommits() const
+    {
+        return commits;
+    }
+
+    inline double SimO3Statistics::GetIPC() const
+    {
+        return cycles ? (double) commits / cycles : 0;
+    }
+
+    inline double SimO3Statistics::GetWindowIPCMin() const
+    {
+        return window_ipc_min;
+    }
+
+    inline double SimO3Statistics::GetWindowIPCMax() const
+    {
+        return window_ipc_max;
+    }
+
+    inline uint64_t SimO3Statistics::GetStageCycles(int stage, int reason) const
+    {
+        return stage_cycles[stage][reason];
+    }
+
+    inline const std::vector<uint64_t>& SimO3Statistics::GetROBHistogram() const
+    {
+        return rob_histogram;
+    }
+
+    inline const std::vector<uint64_t>& SimO3Statistics::GetReservationHistogram() const
+    {
+        return reservation_histogram;
+    }
+
+    inline const std::vector<uint64_t>& SimO3Statistics::GetFreeListHistogram() const
+    {
+        return freelist_histogram;
+    }
+
+    inline const std::vector<double>& SimO3Statistics::GetWindowIPC() const
+    {
+        return window_ipc;
+    }
+
+    inline void SimO3Statistics::Stage(int stage, int reason)
+    {
+        stage_cycles[stage][reason]++;
+    }
+
+    inline void SimO3Statistics::Commit()
+    {
+        cycle_commits++;
+    }
+
+    void SimO3Statistics::Cycle(int rob_count, int reservation_count, int freelist_count)
+    {
+        Sample(rob_histogram        , rob_count);
+        Sample(reservation_histogram, reservation_count);
+        Sample(freelist_histogram   , freelist_count);
+
+        // Sliding window over the latest 'window' cycles, counted from SetWindow()
+        int slot = window_cycles % window;
+
+        window_sum += cycle_commits - window_commits[slot];
+        window_commits[slot] = cycle_commits;
+
+        commits += cycle_commits;
+        cycles++;
+        window_cycles++;
+
+        cycle_commits = 0;
+
+        if (window_cycles >= (uint64_t) window)
+        {
+            double ipc = (double) window_sum / window;
+
+            if (window_cycles == (uint64_t) window)
+                window_ipc_min = window_ipc_max = ipc;
+            else if (ipc < window_ipc_min)
+                window_ipc_min = ipc;
+            else if (ipc > window_ipc_max)
+                window_ipc_max = ipc;
+
+            if (!(window_cycles % window))
+                window_ipc.push_back(ipc);
+        }
+    }
+
+    void SimO3Statistics::Reset()
+    {
+        cycles  = 0;
+        commits = 0;
+
+        memset(stage_cycles, 0, sizeof(stage_cycles));
+
+        std::fill(rob_histogram        .begin(), rob_histogram        .end(), 0);
+        std::fill(reservation_histogram.begin(), reservation_histogram.end(), 0);
+        std::fill(freelist_histogram   .begin(), freelist_histogram   .end(), 0);
+
+        cycle_commits = 0;
+
+        SetWindow(window);
+    }
+
+    void SimO3Statistics::Print(std::ostream& os) const
+    {
+        char buffer[128];
+
+        snprintf(buffer, sizeof(buffer), "Cycles: %lu, Committed: %lu, IPC: %.3f, Window IPC (%d cycles): %.3f ~ %.3f\n",
+            cycles, commits, GetIPC(), window, window_ipc_min, window_ipc_max);
+
+        os << buffer;
+
+        // Stage cycle breakdown, in percentage of total cycles
+        os << "Stage     ";
+
+        for (int j = 0; j < SIM_O3_STALL_COUNT; j++)
+        {
+            snprintf(buffer, sizeof(buffer), "  %12s", GetStallName(j));
+            os << buffer;
+        }
+
+        os << std::endl;
+
+        for (int i = 0; i < SIM_O3_STAGE_COUNT; i++)
+        {
+            snprintf(buffer, sizeof(buffer), "%-10s", GetStageName(i));
+            os << buffer;
+
+            for (int j = 0; j < SIM_O3_STALL_COUNT; j++)
+            {
+                snprintf(buffer, sizeof(buffer), "  %11.2f%%", cycles ? 100.0 * stage_cycles[i][j] / cycles : 0.0);
+                os << buffer;
+            }
+
+            os << std::endl;
+        }
+
+        // Mean occupancy
+        const std::vector<uint64_t>* histograms[] = { &rob_histogram, &reservation_histogram, &freelist_histogram };
+        const char*                  names[]      = { "ROB", "Reservation", "PRF free list" };
+
+        for (int i = 0; i < 3; i++)
+        {
+            double sum = 0;
+
+            for (size_t j = 0; j < histograms[i]->size(); j++)
+                sum += (double) j * (*histograms[i])[j];
+
+            snprintf(buffer, sizeof(buffer), "%-14s mean occupancy: %.2f / %d\n",
+                names[i], cycles ? sum / cycles : 0.0, (int) histograms[i]->size() - 1);
+
+            os << buffer;
+        }
+    }
+
+    void SimO3Statistics::WriteCSV(std::ostream& os) const
+    {
+        // Long format: section,key,field,value
+        os << "section,key,field,value" << std::endl;
+
+        os << "summary,cycles,," << cycles << std::endl;
+        os << "summary,commits,," << commits << std::endl;
+        os << "summary,ipc,," << GetIPC() << std::endl;
+        os << "summary,window,," << window << std::endl;
+        os << "summary,window_ipc_min,," << window_ipc_min << std::endl;
+        os << "summary,window_ipc_max,," << window_ipc_max << std::endl;
+
+        for (int i = 0; i < SIM_O3_STAGE_COUNT; i++)
+            for (int j = 0; j < SIM_O3_STALL_COUNT; j++)
+                os << "stage," << GetStageName(i) << "," << GetStallName(j) << "," << stage_cycles[i][j] << std::endl;
+
+        for (size_t i = 0; i < rob_histogram.size(); i++)
+            os << "occupancy,rob," << i << "," << rob_histogram[i] << std::endl;
+
+        for (size_t i = 0; i < reservation_histogram.size(); i++)
+            os << "occupancy,reservation," << i << "," << reservation_histogram[i] << std::endl;
+
+        for (size_t i = 0; i < freelist_histogram.size(); i++)
+            os << "occupancy,freelist," << i << "," << freelist_histogram[i] << std::endl;
+
+        for (size_t i = 0; i < window_ipc.size(); i++)
+            os << "window_ipc,," << i << "," << window_ipc[i] << std::endl;
+    }
+
+    void SimO3Statistics::WriteJSON(std::ostream& os) const
+    {
+        auto array = [&os] (const auto& values) {
+
+            os << "[";
+
+            for (size_t i = 0; i < values.size(); i++)
+                os << (i ? ", " : "") << values[i];
+
+            os << "]";
+        };
+
+        os << "{" << std::endl;
+        os << "  \"cycles\": " << cycles << "," << std::endl;
+        os << "  \"commits\": " << commits << "," << std::endl;
+        os << "  \"ipc\": " << GetIPC() << "," << std::endl;
+        os << "  \"window\": " << window << "," << std::endl;
+        os << "  \"window_ipc_min\": " << window_ipc_min << "," << std::endl;
+        os << "  \"window_ipc_max\": " << window_ipc_max << "," << std::endl;
+
+        os << "  \"stages\": {" << std::endl;
+
+        for (int i = 0; i < SIM_O3_STAGE_COUNT; i++)
+        {
+            os << "    \"" << GetStageName(i) << "\": {";
+
+            for (int j = 0; j < SIM_O3_STALL_COUNT; j++)
+                os << (j ? ", " : " ") << "\"" << GetStallName(j) << "\": " << stage_cycles[i][j];
+
+            os << " }" << (i + 1 < SIM_O3_STAGE_COUNT ? "," : "") << std::endl;
+        }
+
+        os << "  }," << std::endl;
+
+        os << "  \"occupancy\": {" << std::endl;
+        os << "    \"rob\": ";          array(rob_histogram);           os << "," << std::endl;
+        os << "    \"reservation\": ";  array(reservation_histogram);   os << "," << std::endl;
+        os << "    \"freelist\": ";     array(freelist_histogram);      os << std::endl;
+        os << "  }," << std::endl;
+
+        os << "  \"window_ipc\": ";     array(window_ipc);              os << std::endl;
+        os << "}" << std::endl;
+    }
+}
+
+
 // class VMC::Core::SimRefARF
 namespace VMC::Core {
     /*
@@ -3255,39 +4300,138 @@ namespace VMC::Core {
 
 // class VMC::Core::SimInstructionMemory
 namespace VMC::Core {
+    /*
+    int                             capacity;
+    std::vector<SimInstructionRecord*>  chunks;
+
+    int                             position;
+
+    FILE*                           stream;
+    int                             stream_base;
+
+    int                             released;
+    SimInstructionRecord*           spare;
+    */
+
+    SimInstructionRecord SimInstructionMemory::Pack(const SimInstruction& insn)
+    {
+        SimInstructionRecord record;
+
+        record.imm      = insn.GetImmediate();
+        record.FID      = insn.GetFID();
+        record.delay    = insn.GetDelay();
+        record.insncode = insn.GetInsnCode();
+        record.ARFs     = (insn.GetDstARF()  & 0x1F)
+                        | (insn.GetSrc1ARF() & 0x1F) << 5
+                        | (insn.GetSrc2ARF() & 0x1F) << 10;
+
+        return record;
+    }
+
+    SimInstruction SimInstructionMemory::Unpack(const SimInstructionRecord& record)
+    {
+        return SimInstruction(record.FID, record.delay, record.insncode, 
+            record.ARFs & 0x1F, (record.ARFs >> 5) & 0x1F, (record.ARFs >> 10) & 0x1F, record.imm);
+    }
+
     SimInstructionMemory::SimInstructionMemory(int capacity)
-        : capacity  (capacity)
-        , memory    (new SimInstruction[capacity]())
-        , position  (0)
+        : capacity      (capacity)
+        , chunks        ()
+        , position      (0)
+        , stream        (nullptr)
+        , stream_base   (capacity)
+        , released      (0)
+        , spare         (nullptr)
     { }
 
     SimInstructionMemory::SimInstructionMemory(const SimInstructionMemory& obj)
-        : capacity  (obj.capacity)
-        , memory    (new SimInstruction[obj.capacity])
-        , position  (obj.position)
-    { 
-        // Cause WARNING
-        // memcpy(memory, obj.memory, sizeof(SimInstruction) * capacity);
+        : SimInstructionMemory(obj, obj.capacity)
+    { }
 
-        for (int i = 0; i < capacity; i++)
-            this->memory[i] = obj.memory[i];
+    SimInstructionMemory::SimInstructionMemory(const SimInstructionMemory& obj, int new_capacity)
+        : capacity      (new_capacity)
+        , chunks        ()
+        , position      (min(new_capacity, obj.position))
+        , stream        (nullptr)
+        , stream_base   (min(new_capacity, obj.stream_base))
+        , released      (0)
+        , spare         (nullptr)
+    {
+        // *NOTICE: Streaming state is not copied, only the instructions already fetched
+        //          and not released yet
+        for (int i = 0; i < (int) obj.chunks.size() && i * chunk_size < new_capacity; i++)
+        {
+            if (!obj.chunks[i])
+            {
+                chunks.push_back(nullptr);
+                released++;
+
+                continue;
+            }
+
+            SimInstructionRecord* chunk = new SimInstructionRecord[chunk_size];
+
+            memcpy(chunk, obj.chunks[i], sizeof(SimInstructionRecord) * chunk_size);
+
+            chunks.push_back(chunk);
+        }
     }
 
-    SimInstructionMemory::SimInstructionMemory(const SimInstructionMemory& obj, int new_capacity)
-        : capacity  (new_capacity)
-        , memory    (new SimInstruction[new_capacity])
-        , position  (min(new_capacity, obj.position))
+    SimInstructionMemory::~SimInstructionMemory()
     {
-        // Cause WARNING
-        // memcpy(memory, obj.memory, sizeof(SimInstruction) * min(new_capacity, obj.capacity));
+        CloseStream();
+
+        for (SimInstructionRecord* chunk : chunks)
+            delete[] chunk;
 
-        for (int i = 0; i < obj.capacity && i < new_capacity; i++)
-            memory[i] = obj.memory[i];
+        delete[] spare;
     }
 
-    SimInstructionMemory::~SimInstructionMemory()
+    SimInstructionRecord* SimInstructionMemory::NewChunk()
     {
-        delete[] memory;
+        SimInstructionRecord* chunk = spare ? spare : new SimInstructionRecord[chunk_size];
+
+        spare = nullptr;
+
+        for (int i = 0; i < chunk_size; i++)
+            chunk[i] = Pack(SimInstruction());
+
+        return chunk;
+    }
+
+    SimInstructionRecord* SimInstructionMemory::GetRecord(int address)
+    {
+        // Grow on demand, unwritten records read as NOP
+        while ((int) chunks.size() <= (address >> chunk_bits))
+            chunks.push_back(NewChunk());
+
+        SimInstructionRecord*& chunk = chunks[address >> chunk_bits];
+
+        // Released chunk written again
+        if (!chunk)
+        {
+            chunk = NewChunk();
+            released--;
+        }
+
+        return &chunk[address & (chunk_size - 1)];
+    }
+
+    bool SimInstructionMemory::Fetch(int address)
+    {
+        // Streaming from program file until the address was reached
+        while (stream && position <= address && position < capacity)
+        {
+            if (fread(GetRecord(position), sizeof(SimInstructionRecord), 1, stream) != 1)
+            {
+                CloseStream();
+                return false;
+            }
+
+            position++;
+        }
+
+        return true;
     }
 
     inline int SimInstructionMemory::GetCapacity() const
@@ -3295,24 +4439,36 @@ namespace VMC::Core {
         return capacity;
     }
 
-    inline bool SimInstructionMemory::CheckBound(bool address) const
+    inline int SimInstructionMemory::GetChunkCount() const
+    {
+        return (int) chunks.size() - released;
+    }
+
+    inline bool SimInstructionMemory::CheckBound(int address) const
     {
         return address >= 0 && address < capacity;
     }
 
-    inline const SimInstruction& SimInstructionMemory::GetInsn(int address) const
+    bool SimInstructionMemory::HasInsn(int address)
     {
-        return memory[address];
+        Fetch(address);
+
+        return address < position;
     }
 
-    inline SimInstruction& SimInstructionMemory::GetInsn(int address)
+    SimInstruction SimInstructionMemory::GetInsn(int address)
     {
-        return memory[address];
+        Fetch(address);
+
+        if ((address >> chunk_bits) >= (int) chunks.size() || !chunks[address >> chunk_bits])
+            return SimInstruction();
+
+        return Unpack(chunks[address >> chunk_bits][address & (chunk_size - 1)]);
     }
 
     inline void SimInstructionMemory::SetInsn(int address, const SimInstruction& insn)
     {
-        memory[address] = insn;
+        *GetRecord(address) = Pack(insn);
     }
 
     inline int SimInstructionMemory::GetPosition() const
@@ -3329,17 +4485,253 @@ namespace VMC::Core {
     {
         if (position < capacity)
         {
-            memory[position++] = insn;
+            *GetRecord(position++) = Pack(insn);
             return true;
         }
 
         return false;
     }
 
+    void SimInstructionMemory::Release(int address)
+    {
+        // *NOTICE: Only streamed chunks entirely below the address are released, pushed
+        //          instructions are kept for saving. One released chunk is kept for re-use by
+        //          the chunk streamed next, so that streaming runs in constant memory.
+        int first = (stream_base + chunk_size - 1) >> chunk_bits;
+        int last  = min(min(address, position) >> chunk_bits, (int) chunks.size());
+
+        // Walked down to the last released chunk
+        for (int i = last - 1; i >= first && chunks[i]; i--)
+        {
+            if (spare)
+                delete[] chunks[i];
+            else
+                spare = chunks[i];
+
+            chunks[i] = nullptr;
+            released++;
+        }
+    }
+
+    bool SimInstructionMemory::Save(const char* filename) const
+    {
+        // Released instructions could not be saved
+        if (released)
+            return false;
+
+        FILE* file = fopen(filename, "wb");
+
+        if (!file)
+            return false;
+
+        for (int i = 0; i < position; i += chunk_size)
+        {
+            size_t count = min(chunk_size, position - i);
+
+            if (fwrite(chunks[i >> chunk_bits], sizeof(SimInstructionRecord), count, file) != count)
+            {
+                fclose(file);
+                return false;
+            }
+        }
+
+        fclose(file);
+
+        return true;
+    }
+
+    bool SimInstructionMemory::OpenStream(const char* filename)
+    {
+        CloseStream();
+
+        stream = fopen(filename, "rb");
+
+        if (stream)
+            stream_base = min(stream_base, position);
+
+        return stream != nullptr;
+    }
+
+    void SimInstructionMemory::CloseStream()
+    {
+        if (stream)
+        {
+            fclose(stream);
+            stream = nullptr;
+        }
+    }
+
+    inline bool SimInstructionMemory::IsStreaming() const
+    {
+        return stream != nullptr;
+    }
+
     void SimInstructionMemory::Reset()
+    {
+        CloseStream();
+
+        for (SimInstructionRecord* chunk : chunks)
+            delete[] chunk;
+
+        chunks.clear();
+
+        position    = 0;
+        stream_base = capacity;
+        released    = 0;
+    }
+}
+
+
+// class VMC::Core::SimHistory
+namespace VMC::Core {
+    /*
+    int                 capacity;
+    T*                  ring;
+
+    uint64_t            total;
+
+    FILE*               spill;
+    */
+
+    inline void WriteHistoryRecord(FILE* file, const SimInstruction& insn)
+    {
+        SimInstructionRecord record = SimInstructionMemory::Pack(insn);
+
+        fwrite(&record, sizeof(SimInstructionRecord), 1, file);
+    }
+
+    inline void WriteHistoryRecord(FILE* file, const SimFetchedInstruction& insn)
+    {
+        SimFetchedInstructionRecord record;
+
+        record.insn     = SimInstructionMemory::Pack(insn);
+        record.FGR      = insn.GetFGR();
+        record.pc       = insn.GetPC();
+        record.dstPRF   = insn.GetDstPRF();
+        record.src1PRF  = insn.GetSrc1PRF();
+        record.src2PRF  = insn.GetSrc2PRF();
+
+        fwrite(&record, sizeof(SimFetchedInstructionRecord), 1, file);
+    }
+
+    template<class T>
+    SimHistory<T>::SimHistory(int capacity)
+        : capacity  (capacity)
+        , ring      (new T[capacity])
+        , total     (0)
+        , spill     (nullptr)
+    { }
+
+    template<class T>
+    SimHistory<T>::SimHistory(const SimHistory<T>& obj)
+        : capacity  (obj.capacity)
+        , ring      (new T[obj.capacity])
+        , total     (obj.total)
+        , spill     (nullptr)
     {
         for (int i = 0; i < capacity; i++)
-            memory[i] = SimInstruction();
+            ring[i] = obj.ring[i];
+    }
+
+    template<class T>
+    SimHistory<T>::~SimHistory()
+    {
+        CloseSpill();
+
+        delete[] ring;
+    }
+
+    template<class T>
+    inline int SimHistory<T>::GetCapacity() const
+    {
+        return capacity;
+    }
+
+    template<class T>
+    inline int SimHistory<T>::GetCount() const
+    {
+        return total < (uint64_t) capacity ? (int) total : capacity;
+    }
+
+    template<class T>
+    inline uint64_t SimHistory<T>::GetTotal() const
+    {
+        return total;
+    }
+
+    template<class T>
+    inline uint64_t SimHistory<T>::GetBegin() const
+    {
+        return total - GetCount();
+    }
+
+    template<class T>
+    inline bool SimHistory<T>::Contains(uint64_t index) const
+    {
+        return index >= GetBegin() && index < total;
+    }
+
+    template<class T>
+    inline const T& SimHistory<T>::Get(uint64_t index) const
+    {
+        return ring[index % capacity];
+    }
+
+    template<class T>
+    void SimHistory<T>::Push(const T& obj)
+    {
+        T& slot = ring[total % capacity];
+
+        // Spill the oldest one out of capacity
+        if (spill && total >= (uint64_t) capacity)
+            WriteHistoryRecord(spill, slot);
+
+        slot = obj;
+
+        total++;
+    }
+
+    template<class T>
+    void SimHistory<T>::Resize(int capacity)
+    {
+        delete[] ring;
+
+        this->capacity = capacity;
+        this->ring     = new T[capacity];
+
+        total = 0;
+    }
+
+    template<class T>
+    inline void SimHistory<T>::Clear()
+    {
+        total = 0;
+    }
+
+    template<class T>
+    bool SimHistory<T>::OpenSpill(const char* filename)
+    {
+        CloseSpill();
+
+        spill = fopen(filename, "wb");
+
+        return spill != nullptr;
+    }
+
+    template<class T>
+    void SimHistory<T>::CloseSpill()
+    {
+        if (spill)
+        {
+            fclose(spill);
+            spill = nullptr;
+        }
+    }
+
+    template<class T>
+    inline bool SimHistory<T>::IsSpilling() const
+    {
+        return spill != nullptr;
     }
 }
 
@@ -3599,11 +4991,15 @@ namespace VMC::Core {
 
     inline bool SimScoreboard::IsBusy(int index) const
     {
-        return entries[index].GetStatus() == SCOREBOARD_STATUS_BUSY;
+        return GetStatus(index) == SCOREBOARD_STATUS_BUSY;
     }
 
     inline int SimScoreboard::GetStatus(int index) const
     {
+        // *NOTICE: Unmapped source (index -1) always reads from ARF (ARF0-conv)
+        if (!CheckBound(index))
+            return SCOREBOARD_STATUS_IN_ARF;
+
         return entries[index].GetStatus();
     }
 
@@ -3810,7 +5206,7 @@ namespace VMC::Core {
     { }
 
     template<class TScoreboard>
-    inline const std::list<SimReservation<TScoreboard>::Entry>& SimReservation<TScoreboard>::Get() const
+    inline const std::list<typename SimReservation<TScoreboard>::Entry>& SimReservation<TScoreboard>::Get() const
     {
         return entries;
     }
@@ -3857,7 +5253,7 @@ namespace VMC::Core {
             return true;
         }
 
-        std::list<Entry>::iterator iter = entries.begin();
+        typename std::list<Entry>::iterator iter = entries.begin();
         while (iter != entries.end())
         {
             if (iter->IsReady())
@@ -3897,7 +5293,7 @@ namespace VMC::Core {
     template<class TScoreboard>
     void SimReservation<TScoreboard>::Eval()
     {
-        std::list<Entry>::iterator iter = entries.begin();
+        typename std::list<Entry>::iterator iter = entries.begin();
         while (iter != entries.end())
         {
             if (iter->IsReady())
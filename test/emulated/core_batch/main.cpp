@@ -0,0 +1,226 @@
+// Headless batch driver of O3-vs-Ref differential simulation (rat0.diffsim)
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <thread>
+
+#define SIM_HEADLESS        1
+
+#include "vmc.hpp"
+#include "../core/vmc_core.hpp"
+
+
+#define     BATCH_DEFAULT_SEED              0
+
+#define     BATCH_DEFAULT_INSN_COUNT        1000000
+
+
+using namespace VMC::Core;
+
+
+void Usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [options]" << std::endl;
+    std::cout << "- -seed <uint>        Random seed (" << BATCH_DEFAULT_SEED << " by default)" << std::endl;
+    std::cout << "- -count <int>        Count of random instructions (" << BATCH_DEFAULT_INSN_COUNT << " by default)" << std::endl;
+    std::cout << "- -delay <uint>       Maximum random instruction delay (" << SIM_DEFAULT_RAND_MAX_INSN_DELAY << " by default)" << std::endl;
+    std::cout << "- -steps <int>        Maximum steps before giving up (unlimited by default)" << std::endl;
+    std::cout << "- -gc <int>           Global checkpoint count (" << EMULATED_GC_COUNT << " by default)" << std::endl;
+    std::cout << "- -prf <int>          PRF size (" << EMULATED_PRF_SIZE << " by default)" << std::endl;
+    std::cout << "- -rob <int>          ROB size (" << EMULATED_ROB_SIZE << " by default)" << std::endl;
+    std::cout << "- -j <int>            Count of parallel simulation contexts, with seeds counting up from -seed" << std::endl;
+    std::cout << "                      (hardware thread count by default)" << std::endl;
+    std::cout << "- -sweep              Sweep PRF and ROB sizes across parallel contexts" << std::endl;
+    std::cout << "- -recheck            Re-run each context alone and check it against the parallel run" << std::endl;
+    std::cout << "- -stats <prefix>     Export O3 statistics of each context to <prefix>.<index>.json" << std::endl;
+}
+
+CoreGeometry SweepGeometry(const CoreGeometry& base, int index)
+{
+    static constexpr int prf_sizes[] = { 64, 96, 128, 192 };
+    static constexpr int rob_sizes[] = { 32, 64 };
+
+    CoreGeometry geometry = base;
+
+    geometry.SetPRFSize(prf_sizes[index % 4]);
+    geometry.SetROBSize(rob_sizes[(index / 4) % 2]);
+
+    return geometry;
+}
+
+void PrintResult(int index, const SimBatchConfig& config, const CoreGeometry& geometry, const SimBatchResult& result)
+{
+    printf("%-5d  %-10u  %-4d  %-4d  %-4d  %-10d  %-10d  %-9.3f  %-6d  %-6d  ",
+        index,
+        config.Seed,
+        geometry.GetGCCount(),
+        geometry.GetPRFSize(),
+        geometry.GetROBSize(),
+        result.O3CommitCount,
+        result.Steps,
+        result.O3CommitCount / result.Seconds / 1000000.0,
+        result.O3ROBCountMax,
+        result.O3ReservationCountMax);
+
+    if (result.Passed)
+        printf("\033[1;32mPASSED\033[0m\n");
+    else if (result.MismatchARF != -1)
+        printf("\033[1;31mMISMATCH\033[0m at step %d, ARF #%d: O3 0x%016lx, Ref 0x%016lx\n",
+            result.MismatchStep, result.MismatchARF, result.MismatchO3Value, result.MismatchRefValue);
+    else
+        printf("\033[1;31mFAILED\033[0m at step %d\n", result.MismatchStep);
+}
+
+int main(int argc, char** argv)
+{
+    SimBatchConfig  config   = { BATCH_DEFAULT_SEED, BATCH_DEFAULT_INSN_COUNT, SIM_DEFAULT_RAND_MAX_INSN_DELAY, 0 };
+    CoreGeometry    geometry = CoreGeometry();
+
+    int  jobs    = std::thread::hardware_concurrency();
+    bool sweep   = false;
+    bool recheck = false;
+
+    std::string stats;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-sweep"))
+        {
+            sweep = true;
+            continue;
+        }
+
+        if (!strcmp(argv[i], "-recheck"))
+        {
+            recheck = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+        {
+            Usage(argv[0]);
+            return 2;
+        }
+
+        if (!strcmp(argv[i], "-seed"))
+            config.Seed = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "-count"))
+            config.InsnCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-delay"))
+            config.MaxInsnDelay = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "-steps"))
+            config.MaxSteps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-gc"))
+            geometry.SetGCCount(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-prf"))
+            geometry.SetPRFSize(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-rob"))
+            geometry.SetROBSize(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-j"))
+            jobs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-stats"))
+            stats = argv[++i];
+        else
+        {
+            Usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (jobs <= 0)
+        jobs = 1;
+
+    if (!config.MaxInsnDelay || config.InsnCount <= 0)
+    {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    // One self-contained simulation context per thread
+    std::vector<SimBatchConfig>     configs(jobs, config);
+    std::vector<CoreGeometry>       geometries(jobs, geometry);
+    std::vector<SimBatchResult>     results(jobs);
+    std::vector<std::thread>        threads;
+
+    for (int i = 0; i < jobs; i++)
+    {
+        configs[i].Seed = config.Seed + i;
+
+        if (sweep)
+            geometries[i] = SweepGeometry(geometry, i);
+
+        threads.push_back(std::thread([&configs, &geometries, &results, &stats, i] {
+
+            SimHandle csim = NewHandle(geometries[i]);
+
+            results[i] = RunBatch(csim, configs[i]);
+
+            if (!stats.empty())
+            {
+                std::ofstream fout(stats + "." + std::to_string(i) + ".json");
+
+                csim->O3Stats.WriteJSON(fout);
+            }
+
+            DeleteHandle(csim);
+        }));
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    //
+    printf("Index  Seed        GC    PRF   ROB   Committed   Steps       Minsn/s    ROBMax  ResMax  Result\n");
+    printf("-----  ----------  ----  ----  ----  ----------  ----------  ---------  ------  ------  ------\n");
+
+    int    passed  = 0;
+    double seconds = 0;
+    long   total   = 0;
+
+    for (int i = 0; i < jobs; i++)
+    {
+        PrintResult(i, configs[i], geometries[i], results[i]);
+
+        passed  += results[i].Passed;
+        total   += results[i].O3CommitCount;
+        seconds  = max(seconds, results[i].Seconds);
+    }
+
+    printf("%d/%d context(s) passed, %ld instruction(s) verified, %.3f Minsn/s in total.\n",
+        passed, jobs, total, total / seconds / 1000000.0);
+
+    // Contexts share nothing, so a context alone must walk exactly as it did in parallel
+    int deterministic = jobs;
+
+    if (recheck)
+    {
+        for (int i = 0; i < jobs; i++)
+        {
+            SimHandle csim = NewHandle(geometries[i]);
+
+            SimBatchResult result = RunBatch(csim, configs[i]);
+
+            DeleteHandle(csim);
+
+            if (result.Passed        != results[i].Passed
+             || result.Steps         != results[i].Steps
+             || result.O3CommitCount != results[i].O3CommitCount
+             || result.MismatchARF   != results[i].MismatchARF)
+            {
+                printf("Context %d diverged on re-run: %d step(s), %d committed.\n",
+                    i, result.Steps, result.O3CommitCount);
+
+                deterministic--;
+            }
+        }
+
+        printf("%d/%d context(s) reproduced on re-run.\n", deterministic, jobs);
+    }
+
+    return passed == jobs && deterministic == jobs ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+
+// Core geometry sweep driver for Issue Stage structures
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core_dispatch.hpp"
+#include "common/random.hpp"
+
+
+using namespace MEMU::Core;
+using namespace MEMU::Common;
+using namespace MEMU::Core::Issue;
+
+
+#define     SWEEP_DEFAULT_CYCLES            200000
+
+#define     SWEEP_CHECKPOINT_INTERVAL       8
+
+#define     SWEEP_MAX_DELAY                 64
+
+
+typedef struct {
+
+    int         PRF;
+    uint64_t    land;
+} SweepInFlight;
+
+typedef struct {
+
+    uint64_t    renamed;
+    uint64_t    stalled;
+    double      seconds;
+} SweepResult;
+
+
+SweepResult RunGeometry(const CoreGeometry& geometry, uint64_t cycles)
+{
+    Scoreboard                  scoreboard(geometry);
+    RegisterAliasTable          rat(&scoreboard, geometry);
+    PhysicalRegisterFile        prf(geometry);
+
+    std::deque<SweepInFlight>   inflight;
+    std::deque<int>             committing;
+
+    Random                      rng;
+
+    SweepResult result = { 0, 0, 0 };
+
+    int checkpoint = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t cycle = 0; cycle < cycles; cycle++)
+    {
+        // In-order commit of PRFs landed in last cycle
+        while (!committing.empty())
+        {
+            rat.Commit(committing.front());
+            committing.pop_front();
+        }
+
+        // In-order land
+        if (!inflight.empty() && inflight.front().land <= cycle)
+        {
+            scoreboard.Land(inflight.front().PRF);
+            prf.Set(inflight.front().PRF, cycle);
+
+            committing.push_back(inflight.front().PRF);
+            inflight.pop_front();
+        }
+
+        // Rename
+        if ((int) inflight.size() < geometry.GetROBSize())
+        {
+            int ARF = 1 + rng.NextBounded32(geometry.GetARFSize() - 1);
+            int PRF;
+
+            if (rat.Touch((int) result.renamed, ARF, &PRF))
+            {
+                scoreboard.TakeOff(PRF);
+
+                inflight.push_back(SweepInFlight { PRF, cycle + 1 + rng.NextBounded32(SWEEP_MAX_DELAY) });
+
+                if (!(++result.renamed % SWEEP_CHECKPOINT_INTERVAL))
+                {
+                    scoreboard.AllocateCheckpoint(checkpoint);
+                    rat.AllocateCheckpoint(checkpoint);
+
+                    if (++checkpoint == geometry.GetGCCount())
+                        checkpoint = 0;
+                }
+            }
+            else
+                result.stalled++;
+        }
+        else
+            result.stalled++;
+
+        scoreboard.Eval();
+        rat.Eval();
+        prf.Eval();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t cycles = argc > 1 ? strtoull(argv[1], nullptr, 10) : SWEEP_DEFAULT_CYCLES;
+
+    std::vector<CoreGeometry> geometries;
+
+    for (int gc : { 4, 8, 16 })
+        for (int prf : { 64, 96, 128, 192, 256 })
+            for (int rob : { 32, 64, 128 })
+                geometries.push_back(CoreGeometry(gc, EMULATED_ARF_SIZE, prf, rob));
+
+    printf("Sweeping %d geometries, %lu cycles each.\n", (int) geometries.size(), cycles);
+    printf("GC     ARF    PRF    ROB    Renamed      Stall%%     Mcycle/s\n");
+    printf("-----  -----  -----  -----  -----------  ---------  ---------\n");
+
+    for (const CoreGeometry& geometry : geometries)
+    {
+        SweepResult result = RunGeometry(geometry, cycles);
+
+        printf("%-5d  %-5d  %-5d  %-5d  %-11lu  %-9.2f  %-9.3f\n",
+            geometry.GetGCCount(),
+            geometry.GetARFSize(),
+            geometry.GetPRFSize(),
+            geometry.GetROBSize(),
+            result.renamed,
+            100.0 * result.stalled / cycles,
+            cycles / result.seconds / 1000000.0);
+    }
+
+    return 0;
+}
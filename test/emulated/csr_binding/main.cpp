@@ -0,0 +1,100 @@
+// Jasse CSR binding invalidation checks (linked with -lgmp)
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+#include "riscv.hpp"
+#include "csr/riscvcsrs.hpp"
+#include "../check.hpp"
+
+
+using namespace Jasse;
+
+
+void TestSetCSR()
+{
+    printf("Binding across CSR re-allocation\n");
+
+    RVCSRSpace space({ CSR::mepc, CSR::mtval });
+
+    RVCSRBinding binding = { 0, nullptr };
+
+    RVCSR* mepc = space.GetCSR(CSR_mepc, binding);
+
+    CHECK(mepc && mepc == space.GetCSR(CSR_mepc));
+    CHECK(space.GetCSR(CSR_mepc, binding) == mepc);
+
+    // re-allocated in place, old instance freed
+    RVCSR* renewed = space.SetCSR(CSR::mepc);
+
+    CHECK(space.GetCSR(CSR_mepc, binding) == renewed);
+
+    // allocation of another CSR invalidates too, resolved again to the same instance
+    uint64_t revision = binding.revision;
+
+    space.SetCSR(CSR::mcause);
+
+    CHECK(space.GetCSR(CSR_mepc, binding) == renewed);
+    CHECK(binding.revision != revision);
+}
+
+void TestNewSpace()
+{
+    printf("Binding across destroyed and re-built CSR spaces\n");
+
+    RVCSRBinding binding = { 0, nullptr };
+
+    RVCSRSpace* space = new RVCSRSpace({ CSR::mepc });
+    const void* first = space;
+
+    CHECK(space->GetCSR(CSR_mepc, binding) == space->GetCSR(CSR_mepc));
+
+    delete space;
+
+    // usually at the same address, revision of a new space is never the one bound
+    space = new RVCSRSpace({ CSR::mepc });
+
+    printf("  re-built at %s address\n", (const void*) space == first ? "the same" : "another");
+
+    CHECK(space->GetCSR(CSR_mepc, binding) == space->GetCSR(CSR_mepc));
+
+    RVCSRSpace other({ CSR::mepc });
+
+    CHECK(other.GetCSR(CSR_mepc, binding) == other.GetCSR(CSR_mepc));
+    CHECK(space->GetCSR(CSR_mepc, binding) == space->GetCSR(CSR_mepc));
+
+    delete space;
+}
+
+void TestSetRaw()
+{
+    printf("Binding of a decoded instruction across SetRaw\n");
+
+    RVCSRSpace space({ CSR::mepc, CSR::mtval });
+
+    RVInstruction insn;
+
+    CHECK(space.GetCSR(CSR_mepc, insn.GetCSRBinding()) == space.GetCSR(CSR_mepc));
+
+    // instruction re-used for another CSR
+    insn.SetRaw(0);
+
+    CHECK(insn.GetCSRBinding().revision == 0);
+    CHECK(space.GetCSR(CSR_mtval, insn.GetCSRBinding()) == space.GetCSR(CSR_mtval));
+
+    // copies keep the binding
+    RVInstruction copy(insn);
+
+    CHECK(copy.GetCSRBinding().revision == space.GetRevision());
+    CHECK(copy.GetCSRBinding().csr == space.GetCSR(CSR_mtval));
+}
+
+int main(int argc, char** argv)
+{
+    TestSetCSR();
+    TestNewSpace();
+    TestSetRaw();
+
+    return CheckResult();
+}
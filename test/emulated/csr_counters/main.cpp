@@ -0,0 +1,204 @@
+// Jasse counter CSR checks, reads and writes by CSR instructions against retirement (linked with -lgmp)
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_zicsr.hpp"
+#include "riscvmemutil.hpp"
+#include "csr/riscvcsrs.hpp"
+#include "csr/riscvcsrs_counter.hpp"
+#include "../rvencode.hpp"
+#include "../check.hpp"
+
+
+using namespace Jasse;
+
+
+#define     COUNTERS_MEMORY_SIZE            4096
+
+
+#define     NOP             I(0, 0, 0, 0, 0x13)
+
+#define     CSRW(csr, rs1)  CSRR(csr, rs1, 1, 0)            // csrrw x0, csr, rs1
+#define     CSRRD(rd, csr)  CSRR(csr, 0, 2, rd)             // csrrs rd, csr, x0
+#define     CSRWI(csr, imm) CSRR(csr, imm, 5, 0)            // csrrwi x0, csr, imm
+
+
+class Machine {
+public:
+    RV64IDecoder        decoderI;
+    RVZicsrDecoder      decoderZicsr;
+
+    SimpleLinearMemory  memory;
+
+    RVInstance*         instance;
+
+    Machine(const std::vector<uint32_t>& program)
+        : memory    (COUNTERS_MEMORY_SIZE)
+    {
+        for (size_t i = 0; i < program.size(); i++)
+            memory.WriteInsn(i * 4, MOPW_WORD, { program[i] });
+
+        instance = RVInstance::Builder()
+            .XLEN(XLEN64)
+            .Decoder({ &decoderI, &decoderZicsr })
+            .MI(&memory)
+            .CSR({ CSR::mstatus, CSR::mtvec, CSR::mepc, CSR::mcause, CSR::mtval })
+            .CSR(CSR::COUNTERS)
+            .TrapProcedures(TRAP_PROCEDURES_M_MODE)
+            .StartupPC64(0)
+            .Build();
+    }
+
+    ~Machine()
+    {
+        delete instance;
+    }
+
+    RVCSRCounters& Counters()
+    {
+        return instance->GetCSRs().GetCounters();
+    }
+
+    uint64_t GR(int index) const
+    {
+        return instance->GetArch().GetGRx64Zext(index);
+    }
+
+    void Run(int count)
+    {
+        for (int i = 0; i < count; i++)
+            instance->Eval();
+    }
+};
+
+
+void TestRead()
+{
+    printf("Reads by CSR instructions against retirement\n");
+
+    Machine m({
+        NOP,
+        NOP,
+        CSRRD(A0, CSR_minstret),
+        CSRRD(A1, CSR_mcycle),
+        CSRRD(A2, CSR_instret),
+        CSRRD(A3, CSR_cycle),
+        CSRRD(A4, CSR_time)
+    });
+
+    m.Run(7);
+
+    // count of instructions retired before the reading one
+    CHECK(m.GR(A0) == 2);
+    CHECK(m.GR(A1) == 3);
+    CHECK(m.GR(A2) == 4);
+    CHECK(m.GR(A3) == 5);
+    CHECK(m.GR(A4) == 6);
+
+    CHECK(m.Counters().GetRetired() == 7);
+    CHECK(m.Counters().GetInstret() == 7);
+    CHECK(m.Counters().GetCycle() == 7);
+}
+
+void TestWrite(uint32_t numerator, uint32_t denominator)
+{
+    printf("Writes by CSR instructions, CPI %u/%u\n", numerator, denominator);
+
+    Machine m({
+        I(1000, 0, 0, A0, 0x13),                    // li   a0, 1000
+        I(2000, 0, 0, A1, 0x13),                    // li   a1, 2000
+        CSRW(CSR_minstret, A0),
+        CSRRD(A2, CSR_minstret),
+        CSRW(CSR_mcycle, A1),
+        CSRRD(A3, CSR_mcycle),
+        CSRRD(A4, CSR_instret),
+        CSRRD(A5, CSR_cycle),
+        CSRWI(CSR_minstret, 7)
+    });
+
+    m.Counters().SetCPI(numerator, denominator);
+
+    m.Run(9);
+
+    // written value seen by the next instruction, writing instruction itself not counted
+    CHECK(m.GR(A2) == 1000);
+    CHECK(m.GR(A3) == 2000);
+
+    CHECK(m.GR(A4) == 1000 + 3);
+    CHECK(m.GR(A5) == 2000 + (uint64_t) 2 * numerator / denominator);
+
+    // immediate form, after its own retirement
+    CHECK(m.Counters().GetInstret() == 7);
+
+    // backdoor writes take effect immediately
+    m.Counters().SetInstret(5000);
+    m.Counters().SetCycle(6000);
+
+    CHECK(m.Counters().GetInstret() == 5000);
+    CHECK(m.Counters().GetCycle() == 6000);
+}
+
+void TestReconfigure()
+{
+    printf("Counter continuity across CPI and time base re-configuration\n");
+
+    Machine m(std::vector<uint32_t>(64, NOP));
+
+    m.Counters().SetCyclesPerTick(4);
+
+    m.Run(10);
+
+    CHECK(m.Counters().GetCycle() == 10);
+    CHECK(m.Counters().GetTime() == 2);
+
+    // CPI 3/2, no jump of the visible values
+    m.Counters().SetCPI(3, 2);
+
+    CHECK(m.Counters().GetCycle() == 10);
+    CHECK(m.Counters().GetTime() == 2);
+    CHECK(m.Counters().GetInstret() == 10);
+
+    m.Run(4);
+
+    CHECK(m.Counters().GetCycle() == 16);
+    CHECK(m.Counters().GetTime() == 4);         // raw cycles 15 ~ 21 across 2 ticks
+    CHECK(m.Counters().GetInstret() == 14);
+
+    // time base halved, cycle untouched
+    m.Counters().SetCyclesPerTick(2);
+
+    CHECK(m.Counters().GetCycle() == 16);
+    CHECK(m.Counters().GetTime() == 4);
+
+    m.Run(4);
+
+    CHECK(m.Counters().GetCycle() == 22);
+    CHECK(m.Counters().GetTime() == 7);         // raw cycles 21 ~ 27
+
+    // back to CPI 1, after a write
+    m.Counters().SetCycle(100);
+    m.Counters().SetCPI(1);
+
+    CHECK(m.Counters().GetCycle() == 100);
+
+    m.Run(2);
+
+    CHECK(m.Counters().GetCycle() == 102);
+    CHECK(m.Counters().GetInstret() == 20);
+}
+
+int main(int argc, char** argv)
+{
+    TestRead();
+    TestWrite(1, 1);
+    TestWrite(3, 2);
+    TestWrite(5, 2);
+    TestReconfigure();
+
+    return CheckResult();
+}
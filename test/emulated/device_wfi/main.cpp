@@ -0,0 +1,182 @@
+// Jasse device bus driver, CLINT timer ticks with idle WFI firmware, fast-forward against spinning (linked with -lgmp)
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_64m.hpp"
+#include "riscv_zicsr.hpp"
+#include "riscvdevice.hpp"
+#include "riscvmemutil.hpp"
+#include "csr/riscvcsrs.hpp"
+#include "csr/riscvcsrs_counter.hpp"
+#include "../rvencode.hpp"
+
+
+using namespace Jasse;
+
+
+#define     DEVICE_DEFAULT_TICKS            200
+
+#define     DEVICE_DEFAULT_PERIOD           100000
+
+#define     DEVICE_MEMORY_SIZE              (64 * 1024)
+
+
+typedef struct {
+    uint64_t        steps;
+    uint64_t        now;
+    uint64_t        ticks;
+    uint64_t        mcycle;
+    uint64_t        minstret;
+    uint64_t        wfi;
+    bool            stalled;
+    double          seconds;
+    std::string     output;
+} DeviceResult;
+
+
+// timer tick firmware, idle in WFI between ticks, a digit printed to console on each tick
+std::vector<uint32_t> Firmware(uint32_t ticks, uint32_t period)
+{
+    return {
+        /* 0x00 */  U(0, T0, 0x17),                                 // auipc  t0, 0
+        /* 0x04 */  I(0x60, T0, 0, T0, 0x13),                       // addi   t0, t0, handler
+        /* 0x08 */  CSRR(0x305, T0, 1, 0),                          // csrw   mtvec, t0
+        /* 0x0C */  U(RV_CLINT_DEFAULT_BASE >> 12, S0, 0x37),       // lui    s0, CLINT
+        /* 0x10 */  U(RV_CONSOLE_DEFAULT_BASE >> 12, S1, 0x37),     // lui    s1, console
+        /* 0x14 */  I(0, 0, 0, S2, 0x13),                           // li     s2, 0
+        /* 0x18 */  U((ticks + 0x800) >> 12, S3, 0x37),             // li     s3, ticks
+        /* 0x1C */  I(ticks & 0xFFF, S3, 0, S3, 0x1B),
+        /* 0x20 */  U((period + 0x800) >> 12, S4, 0x37),            // li     s4, period
+        /* 0x24 */  I(period & 0xFFF, S4, 0, S4, 0x1B),
+        /* 0x28 */  U((RV_CLINT_MTIME + 0x800) >> 12, T1, 0x37),
+        /* 0x2C */  R(0, S0, T1, 0, T1, 0x33),
+        /* 0x30 */  I(RV_CLINT_MTIME & 0xFFF, T1, 3, T2, 0x03),     // ld     t2, mtime
+        /* 0x34 */  R(0, S4, T2, 0, T2, 0x33),                      // add    t2, t2, s4
+        /* 0x38 */  U(RV_CLINT_MTIMECMP >> 12, S5, 0x37),
+        /* 0x3C */  R(0, S0, S5, 0, S5, 0x33),                      // s5 = &mtimecmp
+        /* 0x40 */  S(0, T2, S5, 3),                                // sd     t2, 0(s5)
+        /* 0x44 */  CSRR(0x300, 8, 6, 0),                           // csrsi  mstatus, MIE
+        /* 0x48 */  WFI,                                            // loop:
+        /* 0x4C */  B(-4, S3, S2, 1),                               // bne    s2, s3, loop
+        /* 0x50 */  CSRR(0x300, 8, 7, 0),                           // csrci  mstatus, MIE
+        /* 0x54 */  I(-1, 0, 0, T0, 0x13),                          // li     t0, -1
+        /* 0x58 */  S(0, T0, S5, 3),                                // sd     t0, 0(s5), timer disarmed
+        /* 0x5C */  WFI,                                            // halt, no pending event
+        /* 0x60 */  I(0, S5, 3, T0, 0x03),                          // handler: ld t0, 0(s5)
+        /* 0x64 */  R(0, S4, T0, 0, T0, 0x33),                      // add    t0, t0, s4
+        /* 0x68 */  S(0, T0, S5, 3),                                // sd     t0, 0(s5)
+        /* 0x6C */  I(1, S2, 0, S2, 0x13),                          // addi   s2, s2, 1
+        /* 0x70 */  I(7, S2, 7, T1, 0x13),                          // andi   t1, s2, 7
+        /* 0x74 */  I('0', T1, 0, T1, 0x13),                        // addi   t1, t1, '0'
+        /* 0x78 */  S(0, T1, S1, 0),                                // sb     t1, 0(s1)
+        /* 0x7C */  MRET
+    };
+}
+
+DeviceResult Run(const std::vector<uint32_t>& firmware, bool fast_forward, uint64_t max_steps)
+{
+    RV64IDecoder    decoderI;
+    RV64MDecoder    decoderM;
+    RVZicsrDecoder  decoderZicsr;
+
+    SimpleLinearMemory memory(DEVICE_MEMORY_SIZE);
+
+    for (size_t i = 0; i < firmware.size(); i++)
+        memory.WriteInsn(i * 4, MOPW_WORD, { firmware[i] });
+
+    RVPlatform platform(&memory);
+
+    RVCLINT   clint  (&platform.GetQueue(), &platform);
+    RVConsole console(&platform.GetQueue());
+
+    platform.GetBus().Map(RV_CLINT_DEFAULT_BASE,   &clint);
+    platform.GetBus().Map(RV_CONSOLE_DEFAULT_BASE, &console);
+
+    platform.SetFastForward(fast_forward);
+
+    RVInstance* instance = RVInstance::Builder()
+        .XLEN(XLEN64)
+        .Decoder({ &decoderI, &decoderM, &decoderZicsr })
+        .MI(&platform.GetBus())
+        .CSR({ CSR::mstatus, CSR::mtvec, CSR::mepc, CSR::mcause, CSR::mtval })
+        .CSR(CSR::COUNTERS)
+        .TrapProcedures(TRAP_PROCEDURES_M_MODE)
+        .StartupPC64(0)
+        .Build();
+
+    platform.SetInstance(instance);
+
+    //
+    DeviceResult result = DeviceResult();
+
+    auto start = std::chrono::steady_clock::now();
+
+    platform.Run(max_steps, &result.steps);
+
+    result.seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.now      = platform.GetQueue().GetNow();
+    result.ticks    = instance->GetArch().GetGRx64Zext(S2);
+    result.mcycle   = instance->GetCSRs().GetCounters().GetCycle();
+    result.minstret = instance->GetCSRs().GetCounters().GetInstret();
+    result.wfi      = platform.GetWFICount();
+    result.stalled  = platform.IsStalled();
+    result.output   = console.GetTransmitted();
+
+    delete instance;
+
+    return result;
+}
+
+void Print(const char* name, const DeviceResult& result)
+{
+    printf("%-12s  %-12lu  %-12lu  %-8lu  %-12lu  %-12lu  %-8s  %-9.3f\n",
+        name,
+        result.steps,
+        result.now,
+        result.ticks,
+        result.mcycle,
+        result.minstret,
+        result.stalled ? "yes" : "no",
+        result.seconds);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t ticks  = argc > 1 ? strtoul(argv[1], nullptr, 10) : DEVICE_DEFAULT_TICKS;
+    uint32_t period = argc > 2 ? strtoul(argv[2], nullptr, 10) : DEVICE_DEFAULT_PERIOD;
+
+    std::vector<uint32_t> firmware = Firmware(ticks, period);
+
+    printf("Timer tick firmware, %u tick(s) of %u instruction slot(s).\n", ticks, period);
+    printf("Mode          Steps         Time          Ticks     mcycle        minstret      Stalled   Seconds\n");
+    printf("------------  ------------  ------------  --------  ------------  ------------  --------  ---------\n");
+
+    DeviceResult fast = Run(firmware, true, UINT64_MAX);
+    Print("fast-forward", fast);
+
+    // spinning run bounded to the simulated time of fast-forward
+    DeviceResult spin = Run(firmware, false, fast.now);
+    Print("spinning", spin);
+
+    bool passed = fast.stalled
+               && fast.ticks  == ticks
+               && spin.ticks  == ticks
+               && fast.mcycle == spin.mcycle
+               && fast.output == spin.output
+               && fast.output.size() == ticks
+               && fast.minstret == spin.minstret - (spin.wfi - fast.wfi);
+
+    printf("Console: %s\n", fast.output.substr(0, 64).c_str());
+    printf("%s, %.1fx fewer steps with fast-forward.\n",
+        passed ? "PASSED" : "FAILED", (double) spin.steps / fast.steps);
+
+    return passed ? 0 : 1;
+}
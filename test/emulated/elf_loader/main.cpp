@@ -0,0 +1,342 @@
+// Jasse ELF loader driver, zero-copy segment mapping against generic copy, and symbol index lookups (linked with -lgmp)
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_zicsr.hpp"
+#include "riscvelf.hpp"
+#include "riscvmemutil.hpp"
+#include "csr/riscvcsrs.hpp"
+#include "common/random.hpp"
+#include "../rvencode.hpp"
+
+
+using namespace Jasse;
+
+
+#define     ELF_DEFAULT_PATH                "/tmp/jasse_elf_loader.elf"
+
+#define     ELF_DEFAULT_LARGE_MIB           64
+
+#define     ELF_DEFAULT_SYMBOLS             65536
+
+#define     ELF_DEFAULT_QUERIES             100000
+
+#define     ELF_TEXT_BASE                   0x1000
+#define     ELF_DATA_BASE                   0x2000
+#define     ELF_DATA_WORDS                  16
+#define     ELF_BSS_SIZE                    0x2000
+#define     ELF_RESULT_ADDRESS              0x3000
+#define     ELF_LARGE_BASE                  0x100000
+
+#define     ELF_SYMBOL_STRIDE               64
+
+
+// sum of the data segment words, stored into bss
+std::vector<uint32_t> Program()
+{
+    return {
+        /* 0x00 */  U(ELF_DATA_BASE >> 12, T0, 0x37),               // lui    t0, data
+        /* 0x04 */  I(ELF_DATA_WORDS, 0, 0, T1, 0x13),              // li     t1, words
+        /* 0x08 */  I(0, 0, 0, A0, 0x13),                           // li     a0, 0
+        /* 0x0C */  I(0, T0, 3, T2, 0x03),                          // loop: ld t2, 0(t0)
+        /* 0x10 */  R(0, T2, A0, 0, A0, 0x33),                      // add    a0, a0, t2
+        /* 0x14 */  I(8, T0, 0, T0, 0x13),                          // addi   t0, t0, 8
+        /* 0x18 */  I(-1, T1, 0, T1, 0x13),                         // addi   t1, t1, -1
+        /* 0x1C */  B(-16, 0, T1, 1),                               // bnez   t1, loop
+        /* 0x20 */  U(ELF_RESULT_ADDRESS >> 12, T0, 0x37),          // lui    t0, result
+        /* 0x24 */  S(0, A0, T0, 3),                                // sd     a0, 0(t0)
+        /* 0x28 */  WFI
+    };
+}
+
+// ELF64 RISC-V executable of text, data + bss and a large segment, with a symbol table
+bool Synthesize(const char* path, uint64_t large, uint32_t symbol_count, uint64_t* expected)
+{
+    std::vector<uint32_t> program = Program();
+
+    MEMU::Common::Random rng(0x5EED);
+
+    uint64_t words[ELF_DATA_WORDS];
+
+    *expected = 0;
+    for (int i = 0; i < ELF_DATA_WORDS; i++)
+        *expected += (words[i] = rng.Next());
+
+    // file layout
+    const uint64_t text_offset  = 0x1000;
+    const uint64_t data_offset  = 0x2000;
+    const uint64_t large_offset = 0x3000;
+    const uint64_t sym_offset   = large_offset + large;
+
+    std::vector<RVELF64Symbol> symbols;
+    std::string                strings(1, '\0');
+
+    auto symbol = [&] (const std::string& name, uint64_t value, uint64_t size, uint8_t type) {
+        symbols.push_back(RVELF64Symbol { (uint32_t) strings.size(), (uint8_t)((1 << 4) | type), 0, 1, value, size });
+        strings += name;
+        strings += '\0';
+    };
+
+    symbols.push_back(RVELF64Symbol());
+
+    symbol("_start", ELF_TEXT_BASE, program.size() * 4, RV_ELF_STT_FUNC);
+    symbol("data",   ELF_DATA_BASE, ELF_DATA_WORDS * 8, RV_ELF_STT_OBJECT);
+    symbol("result", ELF_RESULT_ADDRESS, 8, RV_ELF_STT_OBJECT);
+
+    for (uint32_t i = 0; i < symbol_count; i++)
+        symbol("func_" + std::to_string(i), ELF_LARGE_BASE + (uint64_t) i * ELF_SYMBOL_STRIDE,
+            ELF_SYMBOL_STRIDE / 2, RV_ELF_STT_FUNC);
+
+    const uint64_t str_offset = sym_offset + symbols.size() * sizeof(RVELF64Symbol);
+    const uint64_t sh_offset  = (str_offset + strings.size() + 7) & ~7UL;
+
+    //
+    RVELF64Header header = RVELF64Header();
+    memcpy(header.ident, "\x7F" "ELF", 4);
+    header.ident[4]     = RV_ELF_CLASS_64;
+    header.ident[5]     = RV_ELF_DATA_LSB;
+    header.ident[6]     = 1;
+    header.type         = 2;
+    header.machine      = RV_ELF_MACHINE_RISCV;
+    header.version      = 1;
+    header.entry        = ELF_TEXT_BASE;
+    header.phoff        = sizeof(RVELF64Header);
+    header.shoff        = sh_offset;
+    header.ehsize       = sizeof(RVELF64Header);
+    header.phentsize    = sizeof(RVELF64ProgramHeader);
+    header.phnum        = 3;
+    header.shentsize    = sizeof(RVELF64SectionHeader);
+    header.shnum        = 3;
+
+    RVELF64ProgramHeader phdrs[3] = {
+        { RV_ELF_PT_LOAD, 5, text_offset,  ELF_TEXT_BASE,  ELF_TEXT_BASE,  program.size() * 4, program.size() * 4, 0x1000 },
+        { RV_ELF_PT_LOAD, 6, data_offset,  ELF_DATA_BASE,  ELF_DATA_BASE,  sizeof(words), ELF_BSS_SIZE, 0x1000 },
+        { RV_ELF_PT_LOAD, 4, large_offset, ELF_LARGE_BASE, ELF_LARGE_BASE, large, large, 0x1000 }
+    };
+
+    RVELF64SectionHeader shdrs[3] = {
+        { },
+        { 0, RV_ELF_SHT_SYMTAB, 0, 0, sym_offset, symbols.size() * sizeof(RVELF64Symbol), 2, 1, 8, sizeof(RVELF64Symbol) },
+        { 0, 3, 0, 0, str_offset, strings.size(), 0, 0, 1, 0 }
+    };
+
+    //
+    FILE* file = fopen(path, "wb");
+
+    if (!file)
+        return false;
+
+    auto put = [file] (uint64_t offset, const void* src, size_t length) {
+        fseek(file, offset, SEEK_SET);
+        fwrite(src, 1, length, file);
+    };
+
+    put(0, &header, sizeof(header));
+    put(header.phoff, phdrs, sizeof(phdrs));
+    put(text_offset, program.data(), program.size() * 4);
+    put(data_offset, words, sizeof(words));
+
+    std::vector<uint64_t> chunk(1024 * 1024 / 8);
+
+    for (uint64_t offset = 0; offset < large; offset += chunk.size() * 8)
+    {
+        for (auto& word : chunk)
+            word = rng.Next();
+
+        put(large_offset + offset, chunk.data(), std::min<uint64_t>(chunk.size() * 8, large - offset));
+    }
+
+    put(sym_offset, symbols.data(), symbols.size() * sizeof(RVELF64Symbol));
+    put(str_offset, strings.data(), strings.size());
+    put(sh_offset, shdrs, sizeof(shdrs));
+
+    fclose(file);
+
+    return true;
+}
+
+uint64_t Checksum(RVMemoryInterface* memory, addr_t address, uint64_t length)
+{
+    uint64_t sum = 0;
+
+    for (uint64_t i = 0; i < length; i += 8)
+    {
+        data_t data;
+        memory->ReadData(address + i, MOPW_DOUBLE_WORD, &data);
+
+        sum = sum * 31 + data.data64;
+    }
+
+    return sum;
+}
+
+uint64_t Execute(const RVELFImage& image, RVMemoryInterface* memory)
+{
+    RV64IDecoder    decoderI;
+    RVZicsrDecoder  decoderZicsr;
+
+    RVInstance::Builder builder;
+
+    image.Setup(builder)
+        .Decoder({ &decoderI, &decoderZicsr })
+        .MI(memory)
+        .CSR({ CSR::mstatus, CSR::mtvec, CSR::mepc, CSR::mcause, CSR::mtval })
+        .TrapProcedures(TRAP_PROCEDURES_M_MODE);
+
+    RVInstance* instance = builder.Build();
+
+    for (int i = 0; i < 1024 && instance->Eval() != EXEC_WAIT_FOR_INTERRUPT; i++);
+
+    data_t result;
+    memory->ReadData(ELF_RESULT_ADDRESS, MOPW_DOUBLE_WORD, &result);
+
+    delete instance;
+
+    return result.data64;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t large   = (argc > 1 ? strtoull(argv[1], nullptr, 10) : ELF_DEFAULT_LARGE_MIB) << 20;
+    uint32_t count   =  argc > 2 ? strtoul(argv[2], nullptr, 10) : ELF_DEFAULT_SYMBOLS;
+    uint32_t queries =  argc > 3 ? strtoul(argv[3], nullptr, 10) : ELF_DEFAULT_QUERIES;
+
+    if (count * (uint64_t) ELF_SYMBOL_STRIDE > large)
+        count = large / ELF_SYMBOL_STRIDE;
+
+    uint64_t expected;
+
+    if (!Synthesize(ELF_DEFAULT_PATH, large, count, &expected))
+    {
+        printf("Failed to write %s.\n", ELF_DEFAULT_PATH);
+        return 1;
+    }
+
+    //
+    RVELFImage image;
+
+    auto start = std::chrono::steady_clock::now();
+
+    RVELFStatus status = image.Open(ELF_DEFAULT_PATH);
+
+    double open_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (status != ELF_SUCCESS)
+    {
+        printf("Failed to open %s, status %d.\n", ELF_DEFAULT_PATH, status);
+        return 1;
+    }
+
+    printf("ELF%d image of %zu byte(s), %zu segment(s), %zu symbol(s), opened in %.3f ms.\n",
+        image.GetXLEN() == XLEN64 ? 64 : 32, image.GetSize(),
+        image.GetSegments().size(), image.GetSymbols().GetCount(), open_seconds * 1000);
+
+    // loading
+    const size_t capacity = ELF_LARGE_BASE + large;
+
+    printf("Memory                Load (ms)     Mapped        Checksum            Result\n");
+    printf("--------------------  ------------  ------------  ------------------  ------------------\n");
+
+    uint64_t checksums[2], results[2];
+
+    {
+        SimpleLinearMemory memory((capacity + 7) >> 3);
+
+        start = std::chrono::steady_clock::now();
+        status = image.Load(&memory);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        checksums[0] = Checksum(&memory, ELF_LARGE_BASE, large);
+        results[0]   = Execute(image, &memory);
+
+        printf("%-20s  %-12.3f  %-12s  %016lx    %016lx\n", "SimpleLinearMemory", seconds * 1000, "-", checksums[0], results[0]);
+    }
+
+    uint64_t mapped = 0;
+
+    {
+        MappedLinearMemory memory(0, capacity);
+
+        start = std::chrono::steady_clock::now();
+        status = status == ELF_SUCCESS ? image.Load(&memory, &mapped) : status;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        checksums[1] = Checksum(&memory, ELF_LARGE_BASE, large);
+        results[1]   = Execute(image, &memory);
+
+        printf("%-20s  %-12.3f  %-12lu  %016lx    %016lx\n", "MappedLinearMemory", seconds * 1000, mapped, checksums[1], results[1]);
+    }
+
+    // symbol queries
+    MEMU::Common::Random rng(0xC0FFEE);
+
+    std::vector<addr_t> addresses(queries);
+
+    for (auto& address : addresses)
+        address = ELF_LARGE_BASE + rng.NextBounded32(count * ELF_SYMBOL_STRIDE);
+
+    const RVELFSymbolIndex& symbols = image.GetSymbols();
+
+    uint64_t found_index = 0, found_linear = 0;
+
+    start = std::chrono::steady_clock::now();
+
+    for (addr_t address : addresses)
+        found_index += symbols.Find(address) != nullptr;
+
+    double index_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // linear scan over a slice of the queries, extrapolated
+    const uint32_t linear_queries = std::min<uint32_t>(queries, 1000);
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < linear_queries; i++)
+        for (auto iter = symbols.Begin(); iter != symbols.End(); ++iter)
+            if (addresses[i] - iter->address < iter->size)
+            {
+                found_linear++;
+                break;
+            }
+
+    double linear_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                          * queries / std::max<uint32_t>(linear_queries, 1);
+
+    uint64_t expected_index = 0, expected_linear = 0;
+    for (uint32_t i = 0; i < queries; i++)
+    {
+        bool inside = (addresses[i] - ELF_LARGE_BASE) % ELF_SYMBOL_STRIDE < ELF_SYMBOL_STRIDE / 2;
+
+        expected_index += inside;
+        if (i < linear_queries)
+            expected_linear += inside;
+    }
+
+    const RVELFSymbol* start_symbol = symbols.Lookup("_start");
+
+    printf("Symbol queries: %u, index %.3f ms, linear scan %.3f ms (estimated), %.1fx.\n",
+        queries, index_seconds * 1000, linear_seconds * 1000, linear_seconds / index_seconds);
+
+    bool passed = status == ELF_SUCCESS
+               && checksums[0] == checksums[1]
+               && results[0] == expected
+               && results[1] == expected
+               && found_index  == expected_index
+               && found_linear == expected_linear
+               && start_symbol && start_symbol->address == image.GetEntry()
+               && symbols.Find(ELF_TEXT_BASE + 8) == start_symbol;
+
+    printf("%s, %.1f MiB mapped without copy.\n", passed ? "PASSED" : "FAILED", mapped / 1048576.0);
+
+    remove(ELF_DEFAULT_PATH);
+
+    return passed ? 0 : 1;
+}
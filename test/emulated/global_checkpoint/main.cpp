@@ -0,0 +1,169 @@
+// GlobalCheckpointTable FGR index and restore checks
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core_global.hpp"
+#include "../check.hpp"
+
+
+using namespace MEMU::Core;
+
+
+#define     GCT_SIZE                        4
+
+
+CoreGeometry Geometry()
+{
+    CoreGeometry geometry;
+
+    geometry.SetGCCount(GCT_SIZE);
+
+    return geometry;
+}
+
+void Push(GlobalCheckpointTable& table, fgr_t FGR, int GCA)
+{
+    table.PushFGR(FGR, GCA);
+    table.Eval();
+}
+
+bool Restore(GlobalCheckpointTable& table, fgr_t FGR, int* GCA, GlobalCheckpointWALK* WALK = nullptr)
+{
+    bool restored = table.RestoreFGR(FGR, GCA, WALK);
+
+    table.Eval();
+
+    if (WALK)
+        WALK->Eval();
+
+    return restored;
+}
+
+void TestFullYoungest()
+{
+    printf("Restore of the youngest checkpoint in a full table\n");
+
+    GlobalCheckpointTable table(Geometry());
+    GlobalCheckpointWALK  WALK (Geometry());
+
+    for (int i = 0; i < GCT_SIZE; i++)
+        Push(table, 100 + i, i);
+
+    CHECK(table.IsFull());
+
+    int GCA = -1;
+
+    // nothing younger than 103, no slot may lose its V bit
+    CHECK(Restore(table, 103, &GCA, &WALK));
+    CHECK(GCA == 3);
+    CHECK(WALK.GetCount() == GCT_SIZE);
+
+    for (int i = 0; i < GCT_SIZE; i++)
+        CHECK(table.GetPayload(i).GetValid());
+
+    CHECK(Restore(table, 101, &GCA));
+    CHECK(GCA == 1);
+
+    CHECK( table.GetPayload(0).GetValid());
+    CHECK( table.GetPayload(1).GetValid());
+    CHECK(!table.GetPayload(2).GetValid());
+    CHECK(!table.GetPayload(3).GetValid());
+
+    CHECK(!Restore(table, 102, &GCA));
+    CHECK(!Restore(table, 103, &GCA));
+}
+
+void TestPartialAndWrap()
+{
+    printf("Restore in a partially filled and a wrapped table\n");
+
+    GlobalCheckpointTable table(Geometry());
+
+    for (int i = 0; i < 3; i++)
+        Push(table, 200 + i, i);
+
+    int GCA = -1;
+
+    CHECK(Restore(table, 200, &GCA));
+    CHECK(GCA == 0);
+    CHECK(!Restore(table, 201, &GCA));
+    CHECK(!Restore(table, 202, &GCA));
+
+    // wrap: slots 0 and 1 popped, 300 and 301 written to slots 3 and 0
+    table.Clear();
+
+    for (int i = 0; i < 3; i++)
+        Push(table, 290 + i, i);
+
+    table.PopFGR();
+    table.PopFGR();
+    table.Eval();
+
+    Push(table, 300, 3);
+    Push(table, 301, 0);
+
+    CHECK(!Restore(table, 290, &GCA));
+    CHECK(!Restore(table, 291, &GCA));
+
+    CHECK(Restore(table, 300, &GCA));
+    CHECK(GCA == 3);
+    CHECK(!Restore(table, 301, &GCA));
+    CHECK(Restore(table, 292, &GCA));
+    CHECK(GCA == 2);
+}
+
+void TestIndexLifetime()
+{
+    printf("FGR index across pop, overwrite, clear and copy\n");
+
+    GlobalCheckpointTable table(Geometry());
+
+    int GCA = -1;
+
+    for (int i = 0; i < GCT_SIZE; i++)
+        Push(table, 400 + i, i);
+
+    // slot 0 recycled with another FGR
+    table.PopFGR();
+    table.Eval();
+
+    CHECK(!Restore(table, 400, &GCA));
+
+    Push(table, 500, 7);
+
+    CHECK(!Restore(table, 400, &GCA));
+
+    // copy keeps live slots only
+    GlobalCheckpointTable copy(table);
+
+    CHECK(Restore(copy, 500, &GCA));
+    CHECK(GCA == 7);
+    CHECK(!Restore(copy, 400, &GCA));
+
+    // 500 is younger than 403
+    CHECK(Restore(table, 403, &GCA));
+    CHECK(GCA == 3);
+    CHECK(!Restore(table, 500, &GCA));
+
+    // clear drops every slot, table is usable again
+    table.Clear();
+
+    for (fgr_t FGR : { 401, 402, 403, 500 })
+        CHECK(!Restore(table, FGR, &GCA));
+
+    Push(table, 401, 5);
+
+    CHECK(Restore(table, 401, &GCA));
+    CHECK(GCA == 5);
+}
+
+int main(int argc, char** argv)
+{
+    TestFullYoungest();
+    TestPartialAndWrap();
+    TestIndexLifetime();
+
+    return CheckResult();
+}
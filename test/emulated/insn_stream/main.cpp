@@ -0,0 +1,150 @@
+// SimInstructionMemory streaming and chunk release checks
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#define SIM_HEADLESS        1
+
+#include "vmc.hpp"
+#include "../core/vmc_core.hpp"
+#include "../check.hpp"
+
+
+using namespace VMC::Core;
+
+
+#define     STREAM_CAPACITY                 (SimInstructionMemory::chunk_size * 16)
+
+#define     STREAM_INSN_COUNT               (SimInstructionMemory::chunk_size * 5 + 100)
+
+#define     STREAM_PUSHED_COUNT             10
+
+#define     STREAM_WINDOW                   1000
+
+
+SimInstruction Insn(int index)
+{
+    return SimInstruction(index, 1, INSN_CODE_ADDI, index & 0x1F, (index >> 5) & 0x1F, 0, (uint64_t) index * 3);
+}
+
+bool IsInsn(const SimInstruction& insn, int index)
+{
+    return insn.GetFID() == index && insn.GetImmediate() == (uint64_t) index * 3;
+}
+
+void TestStreamRelease(const char* path)
+{
+    printf("Streamed chunks released behind the fetch window\n");
+
+    SimInstructionMemory memory(STREAM_CAPACITY);
+
+    CHECK(memory.OpenStream(path));
+
+    int max_chunks = 0;
+    int address    = 0;
+
+    for (; memory.HasInsn(address); address++)
+    {
+        if (!IsInsn(memory.GetInsn(address), address))
+        {
+            printf("  FAILED: record %d\n", address);
+            failures++;
+            break;
+        }
+
+        memory.Release(address - STREAM_WINDOW);
+
+        max_chunks = max(max_chunks, memory.GetChunkCount());
+    }
+
+    printf("  %d instruction(s) streamed, at most %d chunk(s) held\n", address, max_chunks);
+
+    CHECK(address == STREAM_INSN_COUNT);
+    CHECK(max_chunks <= 2);
+
+    // released instructions are gone, not saved partially
+    CHECK(memory.GetInsn(0).GetInsnCode() == INSN_CODE_NOP);
+    CHECK(!memory.Save(path));
+
+    // copy keeps released chunks released
+    SimInstructionMemory copy(memory);
+
+    CHECK(copy.GetChunkCount() == memory.GetChunkCount());
+    CHECK(IsInsn(copy.GetInsn(STREAM_INSN_COUNT - 1), STREAM_INSN_COUNT - 1));
+
+    // re-usable after reset
+    memory.Reset();
+
+    CHECK(memory.GetChunkCount() == 0);
+    CHECK(memory.PushInsn(Insn(7)));
+    CHECK(IsInsn(memory.GetInsn(0), 7));
+    CHECK(memory.Save(path));
+}
+
+void TestPushedKept(const char* path)
+{
+    printf("Pushed instructions kept ahead of a stream\n");
+
+    SimInstructionMemory memory(STREAM_CAPACITY);
+
+    for (int i = 0; i < STREAM_PUSHED_COUNT; i++)
+        memory.PushInsn(Insn(i));
+
+    CHECK(memory.OpenStream(path));
+
+    // streamed instructions appended after the pushed ones
+    CHECK(memory.HasInsn(STREAM_PUSHED_COUNT + STREAM_INSN_COUNT - 1));
+    CHECK(!memory.HasInsn(STREAM_PUSHED_COUNT + STREAM_INSN_COUNT));
+
+    memory.Release(memory.GetPosition());
+
+    // first chunk shared with pushed instructions, never released
+    CHECK(memory.GetChunkCount() == 2);
+    CHECK(IsInsn(memory.GetInsn(STREAM_PUSHED_COUNT - 1), STREAM_PUSHED_COUNT - 1));
+    CHECK(IsInsn(memory.GetInsn(STREAM_PUSHED_COUNT), 0));
+
+    // no stream, nothing released
+    SimInstructionMemory pushed(STREAM_CAPACITY);
+
+    for (int i = 0; i < STREAM_INSN_COUNT; i++)
+        pushed.PushInsn(Insn(i));
+
+    pushed.Release(pushed.GetPosition());
+
+    CHECK(pushed.GetChunkCount() == 6);
+    CHECK(IsInsn(pushed.GetInsn(0), 0));
+}
+
+bool WriteProgram(const char* path)
+{
+    SimInstructionMemory memory(STREAM_CAPACITY);
+
+    for (int i = 0; i < STREAM_INSN_COUNT; i++)
+        memory.PushInsn(Insn(i));
+
+    return memory.Save(path);
+}
+
+int main(int argc, char** argv)
+{
+    std::string path = std::string(argc > 1 ? argv[1] : "/tmp") + "/insn_stream.bin";
+
+    if (!WriteProgram(path.c_str()))
+    {
+        printf("Failed to write %s.\n", path.c_str());
+        return 2;
+    }
+
+    TestStreamRelease(path.c_str());
+
+    // overwritten by the reset check
+    WriteProgram(path.c_str());
+
+    TestPushedKept(path.c_str());
+
+    remove(path.c_str());
+
+    return CheckResult();
+}
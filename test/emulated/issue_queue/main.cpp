@@ -0,0 +1,215 @@
+// IssueQueue select, wakeup and flush checks
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core_issue.hpp"
+#include "../check.hpp"
+
+
+using namespace MEMU::Core;
+using namespace MEMU::Core::Issue;
+
+
+#define     IQ_SIZE                         8
+
+#define     NO_PRF                          -1
+
+
+// FIDs selected in the last Eval, in select order
+std::vector<int> Selected(const IssueQueue& iq)
+{
+    std::vector<int> FIDs;
+
+    for (int i = 0; i < iq.GetSelectCount(); i++)
+        FIDs.push_back(iq.GetFID(iq.GetSelected(i)));
+
+    return FIDs;
+}
+
+int AllocateReady(IssueQueue& iq, int FID)
+{
+    return iq.Allocate(FID, FID, NO_PRF, true, NO_PRF, true);
+}
+
+int AllocateWaiting(IssueQueue& iq, int FID, int src1PRF, int src2PRF)
+{
+    return iq.Allocate(FID, FID, src1PRF, src1PRF == NO_PRF, src2PRF, src2PRF == NO_PRF);
+}
+
+
+void TestSelect()
+{
+    printf("Oldest-first select, regardless of slot index\n");
+
+    IssueQueue iq(IQ_SIZE, 2, 2);
+
+    CHECK(AllocateReady(iq, 10) == 0);
+    CHECK(AllocateReady(iq, 11) == 1);
+    CHECK(AllocateReady(iq, 99) == -1);     // allocation width
+
+    iq.Eval();
+
+    CHECK(iq.GetCount() == 2);
+    CHECK(iq.GetSelectCount() == 0);        // allocated entries not visible to select yet
+
+    // 12 waiting in slot 2, while 10 and 11 are selected
+    CHECK(AllocateWaiting(iq, 12, 5, NO_PRF) == 2);
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 10, 11 }));
+
+    // younger 13 and 14 re-using lower slots, 12 woken in the same cycle
+    CHECK(AllocateReady(iq, 13) == 0);
+    CHECK(AllocateReady(iq, 14) == 1);
+    CHECK(iq.Wakeup(5));
+
+    iq.Eval();
+
+    CHECK(iq.GetSelectCount() == 0);
+    CHECK(iq.IsReady(2));
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 12, 13 }));
+    CHECK(iq.GetSelected(0) == 2);
+    CHECK(iq.GetSelected(1) == 0);
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 14 }));
+    CHECK(iq.IsEmpty());
+}
+
+void TestWakeup()
+{
+    printf("Tag broadcast wakeup of both operands\n");
+
+    IssueQueue iq(IQ_SIZE, 4, 2);
+
+    AllocateWaiting(iq, 20, 7, NO_PRF);
+    AllocateWaiting(iq, 21, NO_PRF, 7);
+    AllocateWaiting(iq, 22, 7, 8);
+    AllocateWaiting(iq, 23, 9, NO_PRF);
+
+    iq.Eval();
+
+    for (int i = 0; i < 4; i++)
+        CHECK(!iq.IsReady(i));
+
+    // allocated in the same cycle as the broadcast, woken as well
+    AllocateWaiting(iq, 24, 7, NO_PRF);
+
+    CHECK(iq.Wakeup(7));
+
+    iq.Eval();
+
+    CHECK(iq.IsReady(0) && iq.IsReady(1) && iq.IsReady(4));
+    CHECK(!iq.IsReady(2) && !iq.IsReady(3));
+
+    // broadcast width
+    CHECK(iq.Wakeup(8));
+    CHECK(iq.Wakeup(9));
+    CHECK(!iq.Wakeup(10));
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 20, 21, 24 }));
+    CHECK(iq.IsReady(2) && iq.IsReady(3));
+
+    // tag consumed, no repeated wakeup of a re-used slot
+    AllocateWaiting(iq, 25, 7, NO_PRF);
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 22, 23 }));
+    CHECK(!iq.IsReady(0));
+}
+
+void TestFlush()
+{
+    printf("Flush of entries younger than FID\n");
+
+    IssueQueue iq(IQ_SIZE, 2, 1);
+
+    // 30 ~ 35, with 34 waiting on PRF 9
+    AllocateReady(iq, 30);
+    AllocateReady(iq, 31);
+    iq.Eval();
+
+    AllocateReady(iq, 32);
+    AllocateReady(iq, 33);
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 30, 31 }));
+
+    AllocateWaiting(iq, 34, 9, NO_PRF);
+    AllocateReady(iq, 35);
+
+    // selected and allocated in the flushing cycle, younger ones dropped
+    iq.Flush(32);
+    iq.Flush(34);
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 32 }));
+    CHECK(iq.IsEmpty());
+
+    // flushed waiting entry no longer woken, slot re-used by an entry waiting on another tag
+    CHECK(AllocateWaiting(iq, 36, 10, NO_PRF) == 0);
+    iq.Eval();
+
+    CHECK(iq.Wakeup(9));
+    iq.Eval();
+
+    CHECK(!iq.IsReady(0));
+
+    CHECK(iq.Wakeup(10));
+    iq.Eval();
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 36 }));
+
+    // older entries kept, each selected once ready
+    AllocateReady(iq, 40);
+    AllocateWaiting(iq, 41, 11, NO_PRF);
+    iq.Eval();
+
+    AllocateReady(iq, 42);
+    AllocateReady(iq, 43);
+    iq.Flush(42);
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 40 }));
+    CHECK(iq.GetCount() == 2);
+
+    iq.Wakeup(11);
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 42 }));
+
+    iq.Eval();
+
+    CHECK(Selected(iq) == std::vector<int>({ 41 }));
+
+    // full flush
+    AllocateReady(iq, 50);
+    iq.Eval();
+
+    iq.Flush();
+    iq.Eval();
+
+    CHECK(iq.GetSelectCount() == 0);
+    CHECK(iq.IsEmpty());
+}
+
+int main(int argc, char** argv)
+{
+    TestSelect();
+    TestWakeup();
+    TestFlush();
+
+    return CheckResult();
+}
@@ -0,0 +1,343 @@
+// Jasse x86-64 JIT benchmark and differential check against the interpreter (RV64I + RV64M), linked with -lgmp
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_64m.hpp"
+#include "riscvjit.hpp"
+#include "riscvmemutil.hpp"
+#include "common/random.hpp"
+#include "../rvencode.hpp"
+
+
+using namespace Jasse;
+
+
+#define     BENCH_DEFAULT_ITERATIONS        200000
+
+#define     BENCH_RANDOM_PROGRAMS           16
+
+#define     BENCH_RANDOM_BODY_SIZE          48
+
+#define     BENCH_MEMORY_SIZE               (1024 * 1024)
+
+#define     BENCH_DATA_BASE                 0x10000
+
+#define     BENCH_REG_COUNTER               30
+#define     BENCH_REG_BASE                  31
+
+
+typedef enum {
+    MODE_INTERPRETER = 0,
+    MODE_JIT,
+    MODE_JIT_VERIFY,
+    MODE_JIT_EEI
+} BenchMode;
+
+typedef struct {
+    uint64_t        insns;
+    double          seconds;
+    uint64_t        GR[32];
+    uint64_t        PC;
+    uint64_t        checksum;
+    uint64_t        eei_calls;
+    RVJITStatistics stats;
+} BenchResult;
+
+
+// counts every instruction reported, JIT must fall back to the interpreter while installed
+static uint64_t eei_calls = 0;
+
+RVEEIStatus CountingEEI(RVInstance& instance, RVExecStatus status, RVInstruction* insn)
+{
+    eei_calls++;
+    return EEI_BYPASS;
+}
+
+
+// loop kernel of loads, stores, multiplication and division
+std::vector<uint32_t> KernelProgram()
+{
+    return {
+        /* loop: */
+        I(3, BENCH_REG_COUNTER, 1, 5, 0x13),        // slli   x5, x30, 3
+        I(0x7F8, 5, 7, 5, 0x13),                    // andi   x5, x5, 0x7f8
+        R(0, BENCH_REG_BASE, 5, 0, 5, 0x33),        // add    x5, x5, x31
+        I(0, 5, 3, 6, 0x03),                        // ld     x6, 0(x5)
+        R(1, BENCH_REG_COUNTER, 6, 0, 7, 0x33),     // mul    x7, x6, x30
+        R(0, 7, 1, 0, 1, 0x33),                     // add    x1, x1, x7
+        R(0, 1, 2, 4, 2, 0x33),                     // xor    x2, x2, x1
+        I(7, 2, 5, 8, 0x13),                        // srli   x8, x2, 7
+        R(0, 8, 3, 0, 3, 0x3B),                     // addw   x3, x3, x8
+        S(0, 1, 5, 3),                              // sd     x1, 0(x5)
+        R(1, BENCH_REG_COUNTER, 1, 5, 9, 0x33),     // divu   x9, x1, x30
+        R(0, 9, 4, 0, 4, 0x33),                     // add    x4, x4, x9
+        I(-1, BENCH_REG_COUNTER, 0, BENCH_REG_COUNTER, 0x13),
+        B(-13 * 4, 0, BENCH_REG_COUNTER, 1),        // bnez   x30, loop
+        WFI
+    };
+}
+
+// random straight-line RV64I/RV64M loop body, with forward skips
+std::vector<uint32_t> RandomProgram(MEMU::Common::Random& rng)
+{
+    std::vector<uint32_t> program;
+
+    auto reg = [&rng] { return (int) rng.NextBounded32(32); };
+    auto dst = [&rng] { return (int) rng.NextBounded32(30); };   // never loop counter or base
+
+    for (int i = 0; i < BENCH_RANDOM_BODY_SIZE; i++)
+    {
+        int32_t imm = (int32_t) rng.NextBounded32(4096) - 2048;
+
+        switch (rng.NextBounded32(12))
+        {
+            case 0: case 1: // OP-IMM
+            {
+                static constexpr uint32_t f3s[] = { 0, 2, 3, 4, 6, 7 };
+                program.push_back(I(imm, reg(), f3s[rng.NextBounded32(6)], dst(), 0x13));
+                break;
+            }
+
+            case 2: // shifts by immediate
+            {
+                uint32_t kind = rng.NextBounded32(3);
+                uint32_t f3   = kind ? 5 : 1;
+                uint32_t hi   = kind == 2 ? 0x400 : 0;
+
+                if (rng.NextBounded32(2))
+                    program.push_back(I(hi | rng.NextBounded32(64), reg(), f3, dst(), 0x13));
+                else
+                    program.push_back(I(hi | rng.NextBounded32(32), reg(), f3, dst(), 0x1B));
+                break;
+            }
+
+            case 3: // ADDIW
+                program.push_back(I(imm, reg(), 0, dst(), 0x1B));
+                break;
+
+            case 4: case 5: // OP
+            {
+                static constexpr uint32_t f3f7s[][2] = {
+                    { 0, 0 }, { 0, 0x20 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 5, 0x20 }, { 6, 0 }, { 7, 0 }
+                };
+                auto& pick = f3f7s[rng.NextBounded32(10)];
+                program.push_back(R(pick[1], reg(), reg(), pick[0], dst(), 0x33));
+                break;
+            }
+
+            case 6: // OP-32
+            {
+                static constexpr uint32_t f3f7s[][2] = {
+                    { 0, 0 }, { 0, 0x20 }, { 1, 0 }, { 5, 0 }, { 5, 0x20 }
+                };
+                auto& pick = f3f7s[rng.NextBounded32(5)];
+                program.push_back(R(pick[1], reg(), reg(), pick[0], dst(), 0x3B));
+                break;
+            }
+
+            case 7: // M extension
+                if (rng.NextBounded32(3))
+                    program.push_back(R(1, reg(), reg(), rng.NextBounded32(8), dst(), 0x33));
+                else
+                {
+                    static constexpr uint32_t f3s[] = { 0, 4, 5, 6, 7 };
+                    program.push_back(R(1, reg(), reg(), f3s[rng.NextBounded32(5)], dst(), 0x3B));
+                }
+                break;
+
+            case 8: // loads, based on data window
+            {
+                static constexpr uint32_t f3s[] = { 0, 1, 2, 3, 4, 5, 6 };
+                program.push_back(I(imm & 0x7FF, BENCH_REG_BASE, f3s[rng.NextBounded32(7)], dst(), 0x03));
+                break;
+            }
+
+            case 9: // stores, based on data window
+                program.push_back(S(imm & 0x7FF, reg(), BENCH_REG_BASE, rng.NextBounded32(4)));
+                break;
+
+            case 10: // LUI & AUIPC
+                program.push_back(U(rng.NextBounded32(1 << 20), dst(), rng.NextBounded32(2) ? 0x37 : 0x17));
+                break;
+
+            default: // forward skip
+            {
+                static constexpr uint32_t f3s[] = { 0, 1, 4, 5, 6, 7 };
+
+                if (rng.NextBounded32(4))
+                    program.push_back(B(8, reg(), reg(), f3s[rng.NextBounded32(6)]));
+                else
+                    program.push_back(J(8, dst()));
+                break;
+            }
+        }
+    }
+
+    int32_t back = -(int32_t)(program.size() + 1) * 4;
+
+    program.push_back(I(-1, BENCH_REG_COUNTER, 0, BENCH_REG_COUNTER, 0x13));
+    program.push_back(B(back, 0, BENCH_REG_COUNTER, 1));
+    program.push_back(WFI);
+
+    return program;
+}
+
+
+// no-op trap procedures, no trap expected from bench programs
+void TrapEnterNop(RVArchitecturalOOC* arch, RVCSRSpace* CSRs, RVTrapType type, RVTrapCause cause)
+{ }
+
+void TrapReturnNop(RVArchitecturalOOC* arch, RVCSRSpace* CSRs)
+{ }
+
+
+BenchResult Run(const std::vector<uint32_t>& program, uint64_t iterations, uint64_t seed, BenchMode mode)
+{
+    RV64IDecoder    decoderI;
+    RV64MDecoder    decoderM;
+
+    SimpleLinearMemory memory(BENCH_MEMORY_SIZE);
+
+    for (size_t i = 0; i < program.size(); i++)
+        memory.WriteInsn(i * 4, MOPW_WORD, { program[i] });
+
+    MEMU::Common::Random rng(seed);
+
+    for (addr_t address = BENCH_DATA_BASE; address < BENCH_DATA_BASE + 4096; address += 8)
+        memory.WriteData(address, MOPW_DOUBLE_WORD, { rng.Next() });
+
+    RVInstance* instance = RVInstance::Builder()
+        .XLEN(XLEN64)
+        .Decoder({ &decoderI, &decoderM })
+        .MI(&memory)
+        .TrapProcedures({ &TrapEnterNop, &TrapReturnNop })
+        .StartupPC64(0)
+        .Build();
+
+    for (int i = 1; i < 30; i++)
+        instance->GetArch().SetGRx64(i, rng.Next() >> rng.NextBounded32(64));
+
+    instance->GetArch().SetGRx64(BENCH_REG_COUNTER, iterations);
+    instance->GetArch().SetGRx64(BENCH_REG_BASE,    BENCH_DATA_BASE);
+
+    //
+    BenchResult result = BenchResult();
+
+    RVJIT jit(instance);
+
+    if (mode == MODE_JIT)
+        jit.SetFastMemory(0, memory.GetHeap(), memory.GetCapacity());
+    else if (mode == MODE_JIT_VERIFY)
+        jit.SetVerify(true);
+    else if (mode == MODE_JIT_EEI)
+        instance->SetExecEEI(&CountingEEI);
+
+    eei_calls = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (mode == MODE_INTERPRETER)
+    {
+        while (instance->Eval() != EXEC_WAIT_FOR_INTERRUPT)
+            result.insns++;
+
+        result.insns++;
+    }
+    else
+        jit.Run(UINT64_MAX, &result.insns);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.stats   = jit.GetStatistics();
+
+    result.eei_calls = eei_calls;
+
+    //
+    for (int i = 0; i < 32; i++)
+        result.GR[i] = instance->GetArch().GetGRx64Zext(i);
+
+    result.PC = instance->GetArch().PC().pc64;
+
+    for (size_t i = 0; i < memory.GetCapacity() / sizeof(uint64_t); i++)
+        result.checksum = result.checksum * 31 + memory.GetHeap()[i];
+
+    delete instance;
+
+    return result;
+}
+
+bool Compare(const BenchResult& ref, const BenchResult& dut)
+{
+    return !memcmp(ref.GR, dut.GR, sizeof(ref.GR))
+        && ref.PC       == dut.PC
+        && ref.checksum == dut.checksum
+        && ref.insns    == dut.insns
+        && !dut.stats.mismatches;
+}
+
+void Print(const char* name, const BenchResult& result, const BenchResult& ref)
+{
+    printf("%-12s  %-10lu  %-9.3f  %-9.3f  %-8lu  %-8lu  %-10lu  %-10s\n",
+        name,
+        result.insns,
+        result.seconds,
+        result.insns / result.seconds / 1000000.0,
+        result.stats.translated_blocks,
+        result.stats.mismatches,
+        result.stats.jit_insns,
+        &result == &ref ? "-" : Compare(ref, result) ? "\033[1;32mMATCH\033[0m" : "\033[1;31mDIFFER\033[0m");
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t iterations = argc > 1 ? strtoull(argv[1], nullptr, 10) : BENCH_DEFAULT_ITERATIONS;
+
+    if (!RVJIT::IsHostSupported())
+        printf("JIT not supported on this host, interpreting only.\n");
+
+    printf("Program       Mode          Insns       Seconds    Minsn/s    Blocks    Mismatch  JIT insns   Result\n");
+    printf("------------  ------------  ----------  ---------  ---------  --------  --------  ----------  ------\n");
+
+    int failures = 0;
+
+    auto bench = [&failures, iterations] (const char* name, const std::vector<uint32_t>& program, uint64_t seed) {
+
+        BenchResult ref    = Run(program, iterations, seed, MODE_INTERPRETER);
+        BenchResult jit    = Run(program, iterations, seed, MODE_JIT);
+        BenchResult verify = Run(program, iterations / 16 + 1, seed, MODE_JIT_VERIFY);
+        BenchResult vref   = Run(program, iterations / 16 + 1, seed, MODE_INTERPRETER);
+        BenchResult eei    = Run(program, iterations / 16 + 1, seed, MODE_JIT_EEI);
+
+        printf("%-12s  ", name); Print("interpreter", ref, ref);
+        printf("%-12s  ", name); Print("jit",         jit, ref);
+        printf("%-12s  ", name); Print("jit-verify",  verify, vref);
+        printf("%-12s  ", name); Print("jit-eei",     eei, vref);
+
+        failures += !Compare(ref, jit) + !Compare(vref, verify);
+
+        // every instruction reported to the EEI handler, none translated
+        failures += !Compare(vref, eei) || eei.eei_calls != eei.insns || eei.stats.jit_insns;
+    };
+
+    bench("kernel", KernelProgram(), 0);
+
+    MEMU::Common::Random rng(0);
+
+    for (int i = 0; i < BENCH_RANDOM_PROGRAMS; i++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "random-%d", i);
+
+        bench(name, RandomProgram(rng), i + 1);
+    }
+
+    printf("%d failure(s).\n", failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+// SimO3Statistics window and IPC checks on synthetic commit traces
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#define SIM_HEADLESS        1
+
+#include "vmc.hpp"
+#include "../core/vmc_core.hpp"
+#include "../check.hpp"
+
+
+using namespace VMC::Core;
+
+
+#define CHECK_NEAR(a, b) \
+    CHECK(std::fabs((double)(a) - (double)(b)) < 1e-9)
+
+
+// one Cycle() per trace element, with that many Commit() calls before it
+void Feed(SimO3Statistics& stats, const std::vector<int>& trace)
+{
+    for (int commits : trace)
+    {
+        for (int i = 0; i < commits; i++)
+            stats.Commit();
+
+        stats.Cycle(0, 0, 0);
+    }
+}
+
+void TestWindow()
+{
+    printf("Sliding window IPC over a commit trace\n");
+
+    SimO3Statistics stats(CoreGeometry(), 4);
+
+    // windows ending at cycle 4, 8 and 12 of 4/4, 0/4 and 8/4
+    Feed(stats, { 1, 0, 2, 1,   0, 0, 0, 0,   2, 2, 2, 2 });
+
+    CHECK(stats.GetCycles() == 12);
+    CHECK(stats.GetCommits() == 12);
+    CHECK_NEAR(stats.GetIPC(), 1.0);
+
+    CHECK(stats.GetWindowIPC().size() == 3);
+    CHECK_NEAR(stats.GetWindowIPC()[0], 1.0);
+    CHECK_NEAR(stats.GetWindowIPC()[1], 0.0);
+    CHECK_NEAR(stats.GetWindowIPC()[2], 2.0);
+
+    // sliding extremes, including windows across the sampled boundaries
+    CHECK_NEAR(stats.GetWindowIPCMin(), 0.0);
+    CHECK_NEAR(stats.GetWindowIPCMax(), 2.0);
+
+    // partial window not sampled
+    Feed(stats, { 3, 3 });
+
+    CHECK(stats.GetWindowIPC().size() == 3);
+    CHECK_NEAR(stats.GetWindowIPCMax(), 2.5);
+}
+
+void TestFirstWindow()
+{
+    printf("Extremes taken from complete windows only\n");
+
+    SimO3Statistics stats(CoreGeometry(), 4);
+
+    Feed(stats, { 4, 4, 4 });
+
+    CHECK(stats.GetWindowIPC().empty());
+    CHECK_NEAR(stats.GetWindowIPCMin(), 0.0);
+    CHECK_NEAR(stats.GetWindowIPCMax(), 0.0);
+
+    // first complete window sets both, a rising trace never lowers min
+    Feed(stats, { 0, 4, 8 });
+
+    CHECK_NEAR(stats.GetWindowIPCMin(), 3.0);
+    CHECK_NEAR(stats.GetWindowIPCMax(), 4.0);
+}
+
+void TestSetWindow()
+{
+    printf("Window resized in the middle of a run\n");
+
+    SimO3Statistics stats(CoreGeometry(), 4);
+
+    Feed(stats, { 1, 1, 1, 1,   1, 1 });
+
+    stats.SetWindow(2);
+
+    // totals kept, window samples restarted from the resize
+    CHECK(stats.GetCycles() == 6);
+    CHECK(stats.GetWindowIPC().empty());
+
+    Feed(stats, { 2 });
+
+    CHECK(stats.GetWindowIPC().empty());
+    CHECK_NEAR(stats.GetWindowIPCMin(), 0.0);
+
+    Feed(stats, { 2,   3, 3 });
+
+    CHECK(stats.GetWindowIPC().size() == 2);
+    CHECK_NEAR(stats.GetWindowIPC()[0], 2.0);
+    CHECK_NEAR(stats.GetWindowIPC()[1], 3.0);
+    CHECK_NEAR(stats.GetWindowIPCMin(), 2.0);
+    CHECK_NEAR(stats.GetWindowIPCMax(), 3.0);
+
+    CHECK(stats.GetCycles() == 10);
+    CHECK(stats.GetCommits() == 16);
+
+    // reset drops everything
+    stats.Reset();
+
+    CHECK(stats.GetCycles() == 0);
+    CHECK(stats.GetCommits() == 0);
+    CHECK(stats.GetWindow() == 2);
+    CHECK(stats.GetWindowIPC().empty());
+}
+
+int main(int argc, char** argv)
+{
+    TestWindow();
+    TestFirstWindow();
+    TestSetWindow();
+
+    return CheckResult();
+}
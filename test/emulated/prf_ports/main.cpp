@@ -0,0 +1,105 @@
+// PhysicalRegisterFile read/write port arbitration and bypass forwarding checks
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "core_issue.hpp"
+#include "../check.hpp"
+
+
+using namespace MEMU::Core;
+using namespace MEMU::Core::Issue;
+
+
+void TestPorts()
+{
+    printf("Read and write port arbitration, 4 read ports and 2 write ports\n");
+
+    PhysicalRegisterFile prf(CoreGeometry(), 4, 2);
+
+    CHECK(prf.GetReadPorts() == 4);
+    CHECK(prf.GetWritePorts() == 2);
+    CHECK(!prf.IsBypassEnabled());
+
+    arch_t value = 0;
+
+    for (int i = 0; i < 4; i++)
+        CHECK(prf.Read(i, &value));
+
+    CHECK(!prf.Read(4, &value));            // read ports exhausted
+    CHECK(prf.GetReadCount() == 4);
+
+    CHECK(prf.Set(1, 0x11));
+    CHECK(prf.Set(2, 0x22));
+    CHECK(!prf.Set(3, 0x33));               // write ports exhausted
+    CHECK(prf.GetWriteCount() == 2);
+
+    CHECK(prf.Get(1) == 0);                 // not visible before Eval
+
+    prf.Eval();
+
+    CHECK(prf.GetReadCount() == 0);
+    CHECK(prf.GetWriteCount() == 0);
+
+    CHECK(prf.Get(1) == 0x11);
+    CHECK(prf.Get(2) == 0x22);
+    CHECK(prf.Get(3) == 0);                 // rejected write dropped
+
+    // ports available again in the next cycle
+    CHECK(prf.Read(2, &value) && value == 0x22);
+    CHECK(prf.Set(3, 0x33));
+
+    prf.ResetInput();
+    prf.Eval();
+
+    CHECK(prf.Get(3) == 0);                 // input reset before Eval
+}
+
+void TestBypass()
+{
+    printf("Same-cycle forwarding from write ports\n");
+
+    // without bypass, read-after-write in the same cycle sees the old value
+    PhysicalRegisterFile dff(CoreGeometry(), 2, 2, false);
+
+    arch_t value = 0;
+
+    dff.Set(5, 0x50);
+    dff.Eval();
+
+    CHECK(dff.Set(5, 0x51));
+    CHECK(dff.Read(5, &value) && value == 0x50);
+
+    dff.Eval();
+
+    CHECK(dff.Get(5) == 0x51);
+
+    // with bypass, writes of the same cycle are forwarded, higher port first
+    PhysicalRegisterFile prf(CoreGeometry(), 3, 3, true);
+
+    prf.Set(5, 0x50);
+    prf.Set(6, 0x60);
+    prf.Eval();
+
+    CHECK(prf.Set(5, 0x51));
+    CHECK(prf.Set(7, 0x71));
+    CHECK(prf.Set(5, 0x52));
+
+    CHECK(prf.Read(5, &value) && value == 0x52);
+    CHECK(prf.Read(7, &value) && value == 0x71);
+    CHECK(prf.Read(6, &value) && value == 0x60);    // no write in flight
+    CHECK(!prf.Read(5, &value));                    // forwarding still takes a read port
+
+    prf.Eval();
+
+    CHECK(prf.Get(5) == 0x52);              // last write port wins on commit too
+    CHECK(prf.Get(7) == 0x71);
+}
+
+int main(int argc, char** argv)
+{
+    TestPorts();
+    TestBypass();
+
+    return CheckResult();
+}
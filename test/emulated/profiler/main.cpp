@@ -0,0 +1,227 @@
+// Jasse guest profiler driver, recursive workload profiled against plain interpretation (linked with -lgmp)
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscvelf.hpp"
+#include "riscvprof.hpp"
+#include "riscvmemutil.hpp"
+#include "../rvencode.hpp"
+
+
+using namespace Jasse;
+
+
+#define     PROFILE_DEFAULT_FIB             18
+
+#define     PROFILE_DEFAULT_REPEAT          20
+
+#define     PROFILE_DEFAULT_PERIOD          RV_PROFILER_DEFAULT_PERIOD
+
+#define     PROFILE_SPIN                    20000
+
+#define     PROFILE_ROUNDS                  21
+
+#define     PROFILE_MAX_OVERHEAD            6.0         // percent, of thread CPU time
+
+#define     PROFILE_MEMORY_SIZE             (64 * 1024)
+
+#define     PROFILE_MAIN                    0x000
+#define     PROFILE_FIB                     0x100
+#define     PROFILE_SPIN_BASE               0x200
+
+
+// main calling recursive fib and a spinning leaf in rounds
+std::vector<std::pair<addr_t, std::vector<uint32_t>>> Program(uint32_t n, uint32_t repeat)
+{
+    return {
+        { PROFILE_MAIN, {
+            /* 0x00 */  U(0x10, SP, 0x37),                          // lui    sp, 0x10
+            /* 0x04 */  I(repeat, 0, 0, S0, 0x13),                  // li     s0, repeat
+            /* 0x08 */  I(0, 0, 0, S1, 0x13),                       // li     s1, 0
+            /* 0x0C */  I(n, 0, 0, A0, 0x13),                       // loop: li a0, n
+            /* 0x10 */  J(PROFILE_FIB - 0x10, RA),                  // call   fib
+            /* 0x14 */  R(0, A0, S1, 0, S1, 0x33),                  // add    s1, s1, a0
+            /* 0x18 */  J(PROFILE_SPIN_BASE - 0x18, RA),            // call   spin
+            /* 0x1C */  I(-1, S0, 0, S0, 0x13),                     // addi   s0, s0, -1
+            /* 0x20 */  B(-0x14, 0, S0, 1),                         // bnez   s0, loop
+            /* 0x24 */  WFI
+        }},
+        { PROFILE_FIB, {
+            /* 0x00 */  I(2, 0, 0, T0, 0x13),                       // li     t0, 2
+            /* 0x04 */  B(0x38, T0, A0, 4),                         // blt    a0, t0, base
+            /* 0x08 */  I(-24, SP, 0, SP, 0x13),                    // addi   sp, sp, -24
+            /* 0x0C */  S(0, RA, SP, 3),                            // sd     ra, 0(sp)
+            /* 0x10 */  S(8, A0, SP, 3),                            // sd     a0, 8(sp)
+            /* 0x14 */  I(-1, A0, 0, A0, 0x13),                     // addi   a0, a0, -1
+            /* 0x18 */  J(-0x18, RA),                               // call   fib
+            /* 0x1C */  S(16, A0, SP, 3),                           // sd     a0, 16(sp)
+            /* 0x20 */  I(8, SP, 3, A0, 0x03),                      // ld     a0, 8(sp)
+            /* 0x24 */  I(-2, A0, 0, A0, 0x13),                     // addi   a0, a0, -2
+            /* 0x28 */  J(-0x28, RA),                               // call   fib
+            /* 0x2C */  I(16, SP, 3, T1, 0x03),                     // ld     t1, 16(sp)
+            /* 0x30 */  R(0, T1, A0, 0, A0, 0x33),                  // add    a0, a0, t1
+            /* 0x34 */  I(0, SP, 3, RA, 0x03),                      // ld     ra, 0(sp)
+            /* 0x38 */  I(24, SP, 0, SP, 0x13),                     // addi   sp, sp, 24
+            /* 0x3C */  I(0, RA, 0, 0, 0x67)                        // base: ret
+        }},
+        { PROFILE_SPIN_BASE, {
+            /* 0x00 */  U((PROFILE_SPIN + 0x800) >> 12, T0, 0x37),  // li     t0, spin
+            /* 0x04 */  I(PROFILE_SPIN & 0xFFF, T0, 0, T0, 0x1B),
+            /* 0x08 */  I(-1, T0, 0, T0, 0x13),                     // loop: addi t0, t0, -1
+            /* 0x0C */  B(-4, 0, T0, 1),                            // bnez   t0, loop
+            /* 0x10 */  I(0, RA, 0, 0, 0x67)                        // ret
+        }}
+    };
+}
+
+uint64_t Fib(uint32_t n)
+{
+    uint64_t a = 0, b = 1;
+
+    for (uint32_t i = 0; i < n; i++)
+        b = a + b, a = b - a;
+
+    return a;
+}
+
+typedef struct {
+    uint64_t        insns;
+    uint64_t        result;
+    double          seconds;
+} ProfileResult;
+
+ProfileResult Run(const std::vector<std::pair<addr_t, std::vector<uint32_t>>>& program, RVProfiler* profiler)
+{
+    RV64IDecoder decoderI;
+
+    SimpleLinearMemory memory(PROFILE_MEMORY_SIZE >> 3);
+
+    for (const auto& [base, code] : program)
+        for (size_t i = 0; i < code.size(); i++)
+            memory.WriteInsn(base + i * 4, MOPW_WORD, { code[i] });
+
+    RVInstance* instance = RVInstance::Builder()
+        .XLEN(XLEN64)
+        .Decoder({ &decoderI })
+        .MI(&memory)
+        .TrapProcedures(TRAP_PROCEDURES_M_MODE)
+        .StartupPC64(PROFILE_MAIN)
+        .Build();
+
+    if (profiler)
+        profiler->Attach(instance);
+
+    //
+    ProfileResult result = ProfileResult();
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t0);
+
+    while (instance->Eval() != EXEC_WAIT_FOR_INTERRUPT)
+        result.insns++;
+
+    result.insns++;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+    result.seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    result.result  = instance->GetArch().GetGRx64Zext(S1);
+
+    delete instance;
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t n      = argc > 1 ? strtoul(argv[1], nullptr, 10) : PROFILE_DEFAULT_FIB;
+    uint32_t repeat = argc > 2 ? strtoul(argv[2], nullptr, 10) : PROFILE_DEFAULT_REPEAT;
+    uint64_t period = argc > 3 ? strtoull(argv[3], nullptr, 10) : PROFILE_DEFAULT_PERIOD;
+
+    const char* collapsed_path = argc > 4 ? argv[4] : nullptr;
+
+    auto program = Program(n, repeat);
+
+    RVELFSymbolIndex symbols;
+    symbols.Add(RVELFSymbol { PROFILE_MAIN,      0x28, "main", RV_ELF_STT_FUNC, 1 });
+    symbols.Add(RVELFSymbol { PROFILE_FIB,       0x40, "fib",  RV_ELF_STT_FUNC, 1 });
+    symbols.Add(RVELFSymbol { PROFILE_SPIN_BASE, 0x14, "spin", RV_ELF_STT_FUNC, 1 });
+    symbols.Build();
+
+    // best of rounds, plain and profiled interleaved, overhead as median of paired rounds
+    ProfileResult plain    = { 0, 0, 1e9 };
+    ProfileResult profiled = { 0, 0, 1e9 };
+
+    std::vector<double> ratios;
+
+    RVProfiler profiler(period);
+    profiler.SetSymbols(&symbols);
+
+    for (int round = 0; round < PROFILE_ROUNDS; round++)
+    {
+        ProfileResult base = Run(program, nullptr);
+
+        if (base.seconds < plain.seconds)
+            plain = base;
+
+        profiler.Reset();
+        ProfileResult result = Run(program, &profiler);
+
+        if (result.seconds < profiled.seconds)
+            profiled = result;
+
+        ratios.push_back(result.seconds / base.seconds);
+    }
+
+    std::sort(ratios.begin(), ratios.end());
+
+    printf("fib(%u) x %u with spin(%u), %lu instruction(s), sampled every %lu.\n",
+        n, repeat, PROFILE_SPIN, plain.insns, profiler.GetPeriod());
+    printf("Mode          Instructions  Result                Seconds    MIPS\n");
+    printf("------------  ------------  --------------------  ---------  --------\n");
+    printf("%-12s  %-12lu  %-20lu  %-9.3f  %-8.2f\n", "plain",    plain.insns,    plain.result,    plain.seconds,    plain.insns    / plain.seconds    / 1e6);
+    printf("%-12s  %-12lu  %-20lu  %-9.3f  %-8.2f\n", "profiled", profiled.insns, profiled.result, profiled.seconds, profiled.insns / profiled.seconds / 1e6);
+
+    double overhead = (ratios[ratios.size() / 2] - 1) * 100;
+
+    printf("Overhead: %.2f%%, median of %d round(s) (at most %.2f%%)\n\n", overhead, PROFILE_ROUNDS, PROFILE_MAX_OVERHEAD);
+
+    profiler.PrintFlat(std::cout, 10);
+
+    //
+    std::ostringstream collapsed;
+    profiler.PrintCollapsed(collapsed);
+
+    if (collapsed_path)
+        std::ofstream(collapsed_path) << collapsed.str();
+
+    std::string stacks = collapsed.str();
+
+    printf("\nCollapsed stacks: %lu line(s)%s%s\n",
+        (uint64_t) std::count(stacks.begin(), stacks.end(), '\n'),
+        collapsed_path ? ", written to " : "", collapsed_path ? collapsed_path : "");
+
+    bool passed = plain.result == Fib(n) * repeat
+               && overhead <= PROFILE_MAX_OVERHEAD
+               && profiled.result == plain.result
+               && profiled.insns  == plain.insns
+               && profiler.GetSampleCount() == plain.insns / profiler.GetPeriod()
+               && profiler.GetCallCount()   == profiler.GetReturnCount()
+               && profiler.GetDepth() == 0
+               && stacks.find("main;spin ") != std::string::npos
+               && (n < 3 || stacks.find("main;fib;fib;fib") != std::string::npos)
+               && stacks.find("0x") == std::string::npos;
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+
+    return passed ? 0 : 1;
+}
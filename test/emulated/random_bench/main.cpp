@@ -0,0 +1,167 @@
+// Stimulus random generator benchmark, MEMU::Common::Random against rand() composition
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "common/random.hpp"
+
+
+using namespace MEMU::Common;
+
+
+#define     BENCH_DEFAULT_COUNT             20000000
+
+#define     BENCH_BULK_SIZE                 4096
+
+#define     BENCH_BOUND                     32
+
+
+typedef struct {
+
+    uint64_t    checksum;
+    double      seconds;
+} BenchResult;
+
+
+// 64-bit register value composed of rand() calls, as formerly generated in the diff-sim console
+inline uint64_t RandComposed()
+{
+    uint64_t val =  (uint64_t)rand()
+                 ^ ((uint64_t)rand() << 16)
+                 ^ ((uint64_t)rand() << 32)
+                 ^ ((uint64_t)rand() << 48);
+
+    uint64_t orb = rand();
+    uint64_t orc =  (orb & 0x0000000F)
+                 | ((orb & 0x000000F0) << 12)
+                 | ((orb & 0x00000F00) << 24)
+                 | ((orb & 0x00007000) << 36);
+
+    return val ^ orc;
+}
+
+template<class T>
+BenchResult Run(uint64_t count, T func)
+{
+    BenchResult result = { 0, 0 };
+
+    auto start = std::chrono::steady_clock::now();
+
+    result.checksum = func(count);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+void Print(const char* name, uint64_t count, const BenchResult& result)
+{
+    printf("%-28s  %-9.3f  %-10.3f  %016lx\n",
+        name,
+        result.seconds,
+        count / result.seconds / 1000000.0,
+        result.checksum);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : BENCH_DEFAULT_COUNT;
+
+    printf("Benchmarking stimulus random generators, %lu values each.\n", count);
+    printf("Generator                     Seconds    Mvalue/s    Checksum\n");
+    printf("----------------------------  ---------  ----------  ----------------\n");
+
+    //
+    Print("rand() composed 64-bit", count, Run(count, [] (uint64_t n) {
+
+        srand(0);
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i++)
+            sum += RandComposed();
+
+        return sum;
+    }));
+
+    Print("Random::Next", count, Run(count, [] (uint64_t n) {
+
+        Random rng;
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i++)
+            sum += rng.Next();
+
+        return sum;
+    }));
+
+    Print("Random::Fill", count, Run(count, [] (uint64_t n) {
+
+        Random rng;
+
+        std::vector<uint64_t> buffer(BENCH_BULK_SIZE);
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i += BENCH_BULK_SIZE)
+        {
+            rng.Fill(buffer.data(), buffer.size());
+
+            for (uint64_t value : buffer)
+                sum += value;
+        }
+
+        return sum;
+    }));
+
+    //
+    Print("rand() % bound", count, Run(count, [] (uint64_t n) {
+
+        srand(0);
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i++)
+            sum += rand() % BENCH_BOUND;
+
+        return sum;
+    }));
+
+    Print("Random::NextBounded32", count, Run(count, [] (uint64_t n) {
+
+        Random rng;
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i++)
+            sum += rng.NextBounded32(BENCH_BOUND);
+
+        return sum;
+    }));
+
+    Print("Random::FillBounded", count, Run(count, [] (uint64_t n) {
+
+        Random rng;
+
+        std::vector<int> buffer(BENCH_BULK_SIZE);
+
+        uint64_t sum = 0;
+
+        for (uint64_t i = 0; i < n; i += BENCH_BULK_SIZE)
+        {
+            rng.FillBounded(buffer.data(), buffer.size(), BENCH_BOUND);
+
+            for (int value : buffer)
+                sum += value;
+        }
+
+        return sum;
+    }));
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+// ReorderBuffer batched commit benchmark
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core_issue.hpp"
+#include "common/random.hpp"
+
+
+using namespace MEMU::Core;
+using namespace MEMU::Common;
+using namespace MEMU::Core::Issue;
+
+
+#define     BENCH_DEFAULT_CYCLES            2000000
+
+#define     BENCH_CHECKPOINT_INTERVAL       8
+
+#define     BENCH_MISPREDICT_INTERVAL       61
+
+#define     BENCH_MAX_DELAY                 32
+
+
+typedef struct {
+
+    uint64_t    allocated;
+    uint64_t    committed;
+    uint64_t    flushed;
+    double      seconds;
+} BenchResult;
+
+
+BenchResult RunWidth(const CoreGeometry& geometry, int width, uint64_t cycles)
+{
+    ReorderBuffer       rob(geometry, width);
+
+    Random              rng;
+
+    // Timing wheel of pending writebacks, indexed by (cycle % BENCH_MAX_DELAY)
+    std::vector<std::vector<int>>   wheel(BENCH_MAX_DELAY);
+
+    BenchResult result = { 0, 0, 0, 0 };
+
+    int checkpoint = 0;
+    int last_checkpoint = -1;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t cycle = 0; cycle < cycles; cycle++)
+    {
+        result.committed += rob.GetCommitCount();
+
+        // Writeback, overflowing entries are retried in next cycle
+        std::vector<int>& slot = wheel[cycle % BENCH_MAX_DELAY];
+
+        while (!slot.empty() && rob.Writeback(slot.back()))
+            slot.pop_back();
+
+        if (!slot.empty())
+        {
+            wheel[(cycle + 1) % BENCH_MAX_DELAY].insert(wheel[(cycle + 1) % BENCH_MAX_DELAY].end(), slot.begin(), slot.end());
+            slot.clear();
+        }
+
+        // Mispredicted branch, squashing younger entries back to last checkpoint
+        if (last_checkpoint != -1 && !(cycle % BENCH_MISPREDICT_INTERVAL))
+        {
+            int before = rob.GetCount();
+
+            rob.RestoreCheckpoint(last_checkpoint);
+            rob.Eval();
+
+            result.flushed += before - rob.GetCount();
+            result.committed += rob.GetCommitCount();
+
+            // Drop pending writebacks of squashed entries
+            for (std::vector<int>& pending : wheel)
+                pending.clear();
+
+            for (int i = 0; i < rob.GetCount(); i++)
+            {
+                int index = (rob.GetHead() + i) % rob.GetSize();
+
+                if (!rob.IsDone(index))
+                    wheel[(cycle + 1 + rng.NextBounded32(BENCH_MAX_DELAY - 1)) % BENCH_MAX_DELAY].push_back(index);
+            }
+
+            last_checkpoint = -1;
+
+            continue;
+        }
+
+        // Allocate
+        for (int i = 0; i < width; i++)
+        {
+            int index = rob.Allocate((int) result.allocated, (int) (result.allocated % geometry.GetPRFSize()), 0);
+
+            if (index == -1)
+                break;
+
+            wheel[(cycle + 1 + rng.NextBounded32(BENCH_MAX_DELAY - 1)) % BENCH_MAX_DELAY].push_back(index);
+
+            if (!(++result.allocated % BENCH_CHECKPOINT_INTERVAL))
+            {
+                rob.AllocateCheckpoint(checkpoint);
+
+                last_checkpoint = checkpoint;
+
+                if (++checkpoint == geometry.GetGCCount())
+                    checkpoint = 0;
+            }
+        }
+
+        rob.Eval();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t cycles = argc > 1 ? strtoull(argv[1], nullptr, 10) : BENCH_DEFAULT_CYCLES;
+
+    printf("Benchmarking ReorderBuffer, %lu cycles each.\n", cycles);
+    printf("ROB    Width  Committed    Flushed      IPC      Mcommit/s\n");
+    printf("-----  -----  -----------  -----------  -------  ---------\n");
+
+    for (int rob : { 64, 128, 256 })
+        for (int width : { 1, 4, 8 })
+        {
+            CoreGeometry geometry(EMULATED_GC_COUNT, EMULATED_ARF_SIZE, EMULATED_PRF_SIZE, rob);
+
+            BenchResult result = RunWidth(geometry, width, cycles);
+
+            printf("%-5d  %-5d  %-11lu  %-11lu  %-7.3f  %-9.3f\n",
+                rob,
+                width,
+                result.committed,
+                result.flushed,
+                (double) result.committed / cycles,
+                result.committed / result.seconds / 1000000.0);
+        }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Jasse RV64I/RV64M interpreter regression checks (linked with -lgmp)
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "riscv.hpp"
+#include "riscv_64i.hpp"
+#include "riscv_64m.hpp"
+#include "riscvmemutil.hpp"
+#include "../rvencode.hpp"
+#include "../check.hpp"
+
+
+using namespace Jasse;
+
+
+#define     REGRESSION_MEMORY_SIZE          4096
+
+
+class Machine {
+public:
+    RV64IDecoder        decoderI;
+    RV64MDecoder        decoderM;
+
+    SimpleLinearMemory  memory;
+
+    RVInstance*         instance;
+
+    Machine(const std::vector<uint32_t>& program)
+        : memory    (REGRESSION_MEMORY_SIZE)
+    {
+        for (size_t i = 0; i < program.size(); i++)
+            memory.WriteInsn(i * 4, MOPW_WORD, { program[i] });
+
+        instance = RVInstance::Builder()
+            .XLEN(XLEN64)
+            .Decoder({ &decoderI, &decoderM })
+            .MI(&memory)
+            .TrapProcedures(TRAP_PROCEDURES_M_MODE)
+            .StartupPC64(0)
+            .Build();
+    }
+
+    ~Machine()
+    {
+        delete instance;
+    }
+
+    uint64_t GR(int index) const
+    {
+        return instance->GetArch().GetGRx64Zext(index);
+    }
+};
+
+
+void TestJALR()
+{
+    printf("JALR with RD = RS1\n");
+
+    Machine m({
+        /* 0x00 */  I(0x10, 0, 0, T0, 0x13),            // li     t0, 0x10
+        /* 0x04 */  I(4, T0, 0, T0, 0x67)               // jalr   t0, 4(t0)
+    });
+
+    m.instance->Eval();
+
+    CHECK(m.instance->Eval() == EXEC_PC_JUMP);
+
+    // target from the old t0, link written after
+    CHECK(m.instance->GetArch().PC().pc64 == 0x14);
+    CHECK(m.GR(T0) == 0x08);
+}
+
+void TestMULH()
+{
+    printf("MULH/MULHSU/MULHU of negative and positive products\n");
+
+    typedef struct {
+        uint32_t    funct3;
+        int64_t     multiplicand;
+        int64_t     multiplier;
+        uint64_t    expected;
+    } Case;
+
+    const Case cases[] = {
+        { 1,  -1,                   1,                  ~0ULL },    // mulh,   -1 >> 64 floors to -1
+        { 1,  -3,                   5,                  ~0ULL },
+        { 1,  INT64_MIN,            INT64_MIN,          1ULL << 62 },
+        { 1,  1LL << 62,            8,                  2 },
+        { 1,  -(1LL << 62),         8,                  ~1ULL },    // exact, no rounding
+        { 2,  -1,                   1,                  ~0ULL },    // mulhsu
+        { 2,  -1,                   -1,                 ~0ULL },    // -1 * (2^64 - 1)
+        { 2,  3,                    -1,                 2 },
+        { 3,  -1,                   -1,                 ~1ULL }     // mulhu, unaffected
+    };
+
+    for (const Case& c : cases)
+    {
+        Machine m({ R(1, A1, A0, c.funct3, A2, 0x33) });
+
+        m.instance->GetArch().SetGRx64(A0, c.multiplicand);
+        m.instance->GetArch().SetGRx64(A1, c.multiplier);
+
+        CHECK(m.instance->Eval() == EXEC_SEQUENTIAL);
+
+        if (m.GR(A2) != c.expected)
+        {
+            printf("  funct3=%u %016lx * %016lx: %016lx, expected %016lx\n",
+                c.funct3, (uint64_t) c.multiplicand, (uint64_t) c.multiplier, m.GR(A2), c.expected);
+
+            failures++;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    TestJALR();
+    TestMULH();
+
+    return CheckResult();
+}
@@ -0,0 +1,56 @@
+#pragma once
+//
+// Instruction encoding shorthands of Jasse test programs, on Jasse normal form encoders
+//
+//
+
+#include <cstdint>
+
+#include "riscvmisc.hpp"
+
+
+// operands in assembly order of fields, from funct7 down to opcode
+inline uint32_t R(uint32_t f7, int rs2, int rs1, uint32_t f3, int rd, uint32_t op)
+{ return Jasse::RVEncoderTypeR(op, f3, f7).RD(rd).RS1(rs1).RS2(rs2).Get(); }
+
+inline uint32_t I(int32_t imm, int rs1, uint32_t f3, int rd, uint32_t op)
+{ return Jasse::RVEncoderTypeI(op, f3).Imm(imm).RD(rd).RS1(rs1).Get(); }
+
+inline uint32_t S(int32_t imm, int rs2, int rs1, uint32_t f3)
+{ return Jasse::RVEncoderTypeS(0x23, f3).Imm(imm).RS1(rs1).RS2(rs2).Get(); }
+
+inline uint32_t B(int32_t imm, int rs2, int rs1, uint32_t f3)
+{ return Jasse::RVEncoderTypeB(0x63, f3).Imm(imm).RS1(rs1).RS2(rs2).Get(); }
+
+inline uint32_t J(int32_t imm, int rd)
+{ return Jasse::RVEncoderTypeJ(0x6F).Imm(imm).RD(rd).Get(); }
+
+inline uint32_t U(uint32_t imm20, int rd, uint32_t op)
+{ return Jasse::RVEncoderTypeU(op).Imm(imm20 << 12).RD(rd).Get(); }
+
+inline uint32_t CSRR(uint32_t csr, int rs1, uint32_t f3, int rd)
+{ return Jasse::RVEncoderTypeI(0x73, f3).Imm(csr).RD(rd).RS1(rs1).Get(); }
+
+
+#define     WFI     0x10500073U
+#define     MRET    0x30200073U
+
+
+// ABI names of general registers
+#define     RA      1
+#define     SP      2
+#define     T0      5
+#define     T1      6
+#define     T2      7
+#define     S0      8
+#define     S1      9
+#define     A0      10
+#define     A1      11
+#define     A2      12
+#define     A3      13
+#define     A4      14
+#define     A5      15
+#define     S2      18
+#define     S3      19
+#define     S4      20
+#define     S5      21
@@ -0,0 +1,195 @@
+// VMC script compiler and control flow checks
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "vmc.hpp"
+#include "../check.hpp"
+
+
+static std::string trace;
+
+bool Trace(void* handle, const std::string& cmd,
+                         const std::string& paramline,
+                         const std::vector<std::string>& params)
+{
+    trace += paramline;
+    return true;
+}
+
+bool Dec(void* handle, const std::string& cmd,
+                       const std::string& paramline,
+                       const std::vector<std::string>& params)
+{
+    VMC::VMCHandle vmc = (VMC::VMCHandle) handle;
+
+    VMC_PARAMLIST_COUNT_EQUALS(params, 1, cmd);
+
+    vmc->mapIntVars[params[0]] = (uint64_t) (vmc->mapIntVars[params[0]].Get() - 1);
+
+    return true;
+}
+
+
+void Setup(VMC::VMCEntity& vmc)
+{
+    VMC::Setup(&vmc);
+    VMC::Basic::SetupCommands(&vmc);
+
+    VMC_COMMAND(&vmc, "trace", Trace);
+    VMC_COMMAND(&vmc, "dec"  , Dec);
+}
+
+bool Compile(VMC::VMCEntity& vmc, const std::string& source, VMC::Script::CompiledScript& script)
+{
+    std::istringstream iss(source);
+
+    return VMC::Script::Compile(&vmc, iss, script, "script");
+}
+
+// compiled and run on a fresh console, trace of the run returned
+std::string Run(const std::string& source, bool* compiled = nullptr)
+{
+    VMC::VMCEntity vmc;
+    Setup(vmc);
+
+    VMC::Script::CompiledScript script;
+
+    trace.clear();
+
+    bool success = Compile(vmc, source, script);
+
+    if (compiled)
+        *compiled = success;
+
+    if (success)
+        VMC::Script::Run(&vmc, script, "script");
+
+    return trace;
+}
+
+
+void TestRepeat()
+{
+    printf("Nested repeat blocks\n");
+
+    CHECK(Run(
+        "repeat 3 {\n"
+        "    repeat 2 {\n"
+        "        trace a\n"
+        "    }\n"
+        "    trace b\n"
+        "}\n") == "aabaabaab");
+
+    // count from variable, and empty count skipping the block
+    CHECK(Run(
+        "setivar n 2\n"
+        "repeat $n {\n"
+        "    repeat 0 {\n"
+        "        trace x\n"
+        "    }\n"
+        "    trace c\n"
+        "}\n"
+        "trace d\n") == "ccd");
+}
+
+void TestWhile()
+{
+    printf("While blocks nested with repeat\n");
+
+    CHECK(Run(
+        "setivar n 3\n"
+        "while $n {\n"
+        "    repeat 2 {\n"
+        "        trace a\n"
+        "    }\n"
+        "    dec n\n"
+        "}\n"
+        "trace b\n") == "aaaaaab");
+
+    // negated boolean condition
+    CHECK(Run(
+        "setbool done false\n"
+        "while !$done {\n"
+        "    trace w\n"
+        "    setbool done true\n"
+        "}\n") == "w");
+}
+
+void TestGoto()
+{
+    printf("Labels and conditional goto\n");
+
+    // backward loop, label case differing between definition and jump
+    CHECK(Run(
+        "setivar n 3\n"
+        "Loop:\n"
+        "    trace l\n"
+        "    dec n\n"
+        "    goto LOOP if $n\n"
+        "trace e\n") == "llle");
+
+    // forward skip, negated condition
+    CHECK(Run(
+        "setbool skip true\n"
+        "goto Over if $skip\n"
+        "trace x\n"
+        "over:\n"
+        "goto end if !$skip\n"
+        "trace y\n"
+        "End:\n") == "y");
+
+    // jump out of nested blocks
+    CHECK(Run(
+        "setivar n 0\n"
+        "repeat 5 {\n"
+        "    while !$n {\n"
+        "        trace i\n"
+        "        goto out\n"
+        "    }\n"
+        "}\n"
+        "out:\n"
+        "trace o\n") == "io");
+}
+
+void TestCompileErrors()
+{
+    printf("Compile errors\n");
+
+    bool compiled;
+
+    const char* sources[] = {
+        "}\n",                                      // unmatched '}'
+        "repeat 2 {\n    trace a\n",               // unclosed '{'
+        "repeat 2\n}\n",                            // missing '{'
+        "while {\n}\n",                             // missing condition
+        "a:\nA:\n",                                 // duplicated label, case-insensitive
+        "goto nowhere\n",                           // undefined label
+        "goto\n",                                   // missing label
+        "x:\ngoto x when $n\n"                      // malformed condition
+    };
+
+    for (const char* source : sources)
+    {
+        CHECK(Run(source, &compiled).empty());
+        CHECK(!compiled);
+    }
+
+    // nothing runs if compilation fails
+    CHECK(Run("trace a\ngoto missing\n", &compiled).empty());
+    CHECK(!compiled);
+}
+
+int main(int argc, char** argv)
+{
+    TestRepeat();
+    TestWhile();
+    TestGoto();
+    TestCompileErrors();
+
+    return CheckResult();
+}
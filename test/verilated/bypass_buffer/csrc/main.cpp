@@ -21,6 +21,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 
 Vsim_common_bypass_buffer* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -110,8 +112,6 @@ void testbench_1(int &t)
     list<int> records;
     vector<int> delays;
 
-    srand(time(0));
-
     int gen = GEN(0);
     int nready = -1;
 
@@ -133,7 +133,7 @@ void testbench_1(int &t)
 
         if (nready < 0)
         {
-            nready = rand() % 8;
+            nready = rng.NextBounded32(8);
 
             delays.push_back(nready);
         }
@@ -231,8 +231,8 @@ void testbench_2(int& t)
     {
         int g = GEN(i & 0xFF);
 
-        int w_valid = rand() % 2;
-        int r_ready = rand() % 2;
+        int w_valid = rng.NextBounded32(2);
+        int r_ready = rng.NextBounded32(2);
 
         dut_ptr->prev_i_data  = g;
         dut_ptr->prev_i_valid = w_valid;
@@ -288,11 +288,20 @@ void testbench_2(int& t)
 // Overall payload
 void test() 
 {
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
+
     int time = 0;
 
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module \'common_bypass_buffer\'.\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
@@ -23,6 +23,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_bypass_bufferf.h"
 static Vsim_bypass_bufferf* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -124,9 +126,9 @@ int testbench_1(int& t)
     {
         int gen = GEN(i & 0xFF);
 
-        int w_valid =   rand() % 2;
-        int r_ready =   rand() % 2;
-        int flush   = !(rand() % 8);
+        int w_valid =   rng.NextBounded32(2);
+        int r_ready =   rng.NextBounded32(2);
+        int flush   = rng.NextChance(8);
 
         dut_ptr->prev_i_data    = gen;
         dut_ptr->prev_i_valid   = w_valid;
@@ -186,7 +188,13 @@ int testbench_1(int& t)
 
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -194,6 +202,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33mcommon_bypass_bufferf\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
@@ -23,6 +23,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_dffcam_1qa.h"
 static Vsim_dffcam_1qa* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -153,12 +155,12 @@ int testbench_1(int& t)
     //
     for (int i = 0; i < c; i++)
     {
-        int qdata  = DGEN8(rand() & 0x00FF);
+        int qdata  = DGEN8(rng.Next32() & 0x00FF);
 
-        int wdata  = DGEN8(rand() & 0x00FF);
-        int waddr  =   rand() % CAM_DEPTH;
-        int wvalid = !(rand() % 8);
-        int wen    = !(rand() % 4);
+        int wdata  = DGEN8(rng.Next32() & 0x00FF);
+        int waddr  =   rng.NextBounded32(CAM_DEPTH);
+        int wvalid = rng.NextChance(8);
+        int wen    = rng.NextChance(4);
 
         //
         dut_ptr->addr       = waddr;
@@ -222,7 +224,13 @@ int testbench_1(int& t)
 //
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -230,6 +238,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33mcommon_dffcam_1a1w1r1qa\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
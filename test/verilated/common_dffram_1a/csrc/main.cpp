@@ -19,6 +19,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_dffram_1a.h"
 static Vsim_dffram_1a* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -141,9 +143,9 @@ int testbench_1(int& t)
 
     for (int i = 0; i < c; i++)
     {
-        int wen   = rand() % 2;
-        int waddr = rand() % 32;
-        int wdata = rand() | (rand() << 16);
+        int wen   = rng.NextBounded32(2);
+        int waddr = rng.NextBounded32(32);
+        int wdata = rng.Next32();
 
         dut_ptr->addr = waddr;
         dut_ptr->en   = 1;
@@ -249,7 +251,13 @@ int testbench_1(int& t)
 //
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -257,6 +265,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33mcommon_dffram_1a1w1r\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
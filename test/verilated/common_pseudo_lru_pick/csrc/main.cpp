@@ -21,6 +21,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_common_pseudo_lru_pick.h"
 static Vsim_common_pseudo_lru_pick* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -127,11 +129,11 @@ int testbench_1(int &t)
     for (int i = 0; i < c; i++)
     {
         //
-        int update = rand() & 0x1F;
-        int valid  = rand();
+        int update = rng.Next32() & 0x1F;
+        int valid  = rng.Next32();
 
         for (int j = 1; j < 4; j++)
-            valid ^= rand() << (j << 3);
+            valid ^= rng.Next32() << (j << 3);
 
         dut_ptr->waddr  = update;
         dut_ptr->wen    = 1;
@@ -194,7 +196,13 @@ int testbench_1(int &t)
 
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -202,6 +210,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33mcommon_pseudo_lru_pick_binwr\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
@@ -21,6 +21,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_common_pseudo_lru_swap.h"
 static Vsim_common_pseudo_lru_swap* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -119,7 +121,7 @@ int testbench_1(int &t)
     for (int i = 0; i < c; i++)
     {
         //
-        int update = rand() & 0x3F;
+        int update = rng.Next32() & 0x3F;
 
         dut_ptr->waddr  = update;
         dut_ptr->wen    = 1;
@@ -162,7 +164,13 @@ int testbench_1(int &t)
 
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -170,6 +178,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33mcommon_pseudo_lru_swap_binwr\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core_issue.hpp"
+#include "common/random.hpp"
 
 using namespace std;
 
@@ -21,6 +22,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_issue_prf.h"
 static Vsim_issue_prf* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -123,12 +126,12 @@ int testbench_1(int &t)
     for (int i = 0; i < c; i++)
     {
         //
-        int     w_en    = rand() % 2;
-        int64_t w_value = rand();
-        int     w_addr  = rand() & 0x3F;
+        int     w_en    = rng.NextBounded32(2);
+        int64_t w_value = rng.Next();
+        int     w_addr  = rng.Next32() & 0x3F;
 
-        int     r_addr0 = rand() & 0x3F;
-        int     r_addr1 = rand() & 0x3F;
+        int     r_addr0 = rng.Next32() & 0x3F;
+        int     r_addr1 = rng.Next32() & 0x3F;
 
         dut_ptr->wea    = w_en;
         dut_ptr->dina   = w_value;
@@ -185,7 +188,13 @@ int testbench_1(int &t)
 //
 void test()
 {
-    srand(time(0));
+#ifndef RANDOM_SEQUENCE_SEED
+    unsigned long int seed = time(0);
+#else
+    unsigned long int seed = RANDOM_SEQUENCE_SEED;
+#endif
+
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;
@@ -193,6 +202,7 @@ void test()
     printf("[--] ----------------------------------------\n");
 
     printf("[##] Testing on module '\033[1;33missue_prf\033[0m'\n");
+    printf("[##] \033[1;30mRandom sequence seed: %lu\033[0m\n", seed);
 
     printf("[--] ----------------------------------------\n");
 
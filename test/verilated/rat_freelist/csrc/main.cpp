@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core_issue.hpp"
+#include "common/random.hpp"
 
 using namespace std;
 
@@ -21,6 +22,8 @@ static VerilatedVcdC* fp;      //to form *.vcd file
 #include "Vsim_rat_freelist.h"
 static Vsim_rat_freelist* dut_ptr;
 
+static MEMU::Common::Random rng;
+
 void clkp_dumpgen(int& time)
 {
     dut_ptr->clk = 1;
@@ -162,8 +165,8 @@ int testbench_1(int& t)
 
             fgr = (fgr + 1) & 0x0F;
 
-            fgr_lifecycle   = rand() % 17;
-            fgr_speculative = rand() % 2;
+            fgr_lifecycle   = rng.NextBounded32(17);
+            fgr_speculative = rng.NextBounded32(2);
         }
 
         dut_ptr->i_acquire_fgr              = fgr;
@@ -172,8 +175,8 @@ int testbench_1(int& t)
         //
         if (!acquire_count)
         {
-            acquire_count       = (rand() % 8) + 1;
-            acquire_interval    = (rand() % 8) + 1;
+            acquire_count       = rng.NextBounded32(8) + 1;
+            acquire_interval    = rng.NextBounded32(8) + 1;
 
             dut_ptr->i_acquire_valid = 0;
         }
@@ -193,8 +196,8 @@ int testbench_1(int& t)
         {
             if (!on_flight_prfs.empty())
             {
-                redeem_count    = (rand() % 8) + 1;
-                redeem_interval = (rand() % 8) + 1;
+                redeem_count    = rng.NextBounded32(8) + 1;
+                redeem_interval = rng.NextBounded32(8) + 1;
             }
 
             dut_ptr->i_redeemed_prf     = 0;
@@ -223,8 +226,8 @@ int testbench_1(int& t)
         {
             if (!on_flight_fgrs.empty())
             {
-                fgr_op_count    = (rand() % 4) + 1;
-                fgr_op_interval = (rand() % 4) + 1;
+                fgr_op_count    = rng.NextBounded32(4) + 1;
+                fgr_op_interval = rng.NextBounded32(4) + 1;
             }
 
             dut_ptr->i_abandon_fgr      = 0;
@@ -245,8 +248,8 @@ int testbench_1(int& t)
         }
         else if (!on_flight_fgrs.empty())
         {
-            int sel_op  = rand() % 2;
-            int sel_fgr = rand() % 2;
+            int sel_op  = rng.NextBounded32(2);
+            int sel_fgr = rng.NextBounded32(2);
 
             dut_ptr->i_abandon_fgr      =  sel_fgr ? on_flight_fgrs.front() : on_flight_fgrs.back();
             dut_ptr->i_abandon_valid    =  sel_op;
@@ -461,7 +464,7 @@ void test()
     unsigned long int seed = RANDOM_SEQUENCE_SEED;
 #endif
 
-    srand(seed);
+    rng.Seed(seed);
 
     int t = 0;
     int e = 0;